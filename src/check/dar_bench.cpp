@@ -0,0 +1,962 @@
+/*********************************************************************/
+// dar - disk archive - a backup/restoration program
+// Copyright (C) 2002-2026 Denis Corbin
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// to contact the author, see the AUTHOR file
+/*********************************************************************/
+
+    // dar_bench: throughput benchmark of libdar operations, run by "make bench"
+    //
+    // A synthetic tree is generated (always the same content for a given scale), then
+    // for each combination of compression algorithm, cipher and thread count of the
+    // matrix, an archive of it is created, tested, compared, restored, isolated and
+    // merged through libdar API. Timings are written as JSON to be tracked over time.
+
+#include "../my_config.h"
+
+extern "C"
+{
+#if HAVE_SYS_TYPES_H
+#include <sys/types.h>
+#endif
+
+#if HAVE_SYS_STAT_H
+#include <sys/stat.h>
+#endif
+
+#if HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+
+#if HAVE_FCNTL_H
+#include <fcntl.h>
+#endif
+
+#if HAVE_ERRNO_H
+#include <errno.h>
+#endif
+
+#if HAVE_STRING_H
+#include <string.h>
+#endif
+
+#if HAVE_DIRENT_H
+#include <dirent.h>
+#endif
+
+#if HAVE_SYS_UTSNAME_H
+#include <sys/utsname.h>
+#endif
+
+#ifdef EA_SUPPORT
+#if HAVE_ATTR_XATTR_H && ! HAVE_SYS_XATTR_H
+#include <attr/xattr.h>
+#endif
+#if HAVE_SYS_XATTR_H
+#include <sys/xattr.h>
+#endif
+#endif
+}
+
+#include "libdar.hpp"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <chrono>
+#include <ctime>
+#include <cstdlib>
+#include <vector>
+#include <functional>
+
+using namespace libdar;
+using namespace std;
+
+    // sizes of the synthetic tree for a scale of 1
+static constexpr U_I SMALL_DIRS = 20;              ///< directories of small files
+static constexpr U_I SMALL_FILES_PER_DIR = 250;    ///< small files per directory
+static constexpr U_I SMALL_FILE_MAX = 4096;        ///< maximum size of small files
+static constexpr U_I HUGE_FILES = 2;               ///< number of huge files
+static constexpr U_I HUGE_FILE_SIZE = 32*1024*1024; ///< size of huge files
+static constexpr U_I SPARSE_FILES = 2;             ///< number of sparse files
+static constexpr U_I SPARSE_FILE_SIZE = 256*1024*1024; ///< apparent size of sparse files
+static constexpr U_I SPARSE_EXTENTS = 16;          ///< data extents of 64 KiB per sparse file
+static constexpr U_I HARD_LINKED_FILES = 100;      ///< inodes having several hard links
+static constexpr U_I HARD_LINKS = 3;               ///< links per hard linked inode
+static constexpr U_I DEEP_LEVELS = 64;             ///< depth of the deep directory tree
+static constexpr U_I XATTR_FILES = 200;            ///< files carrying extended attributes
+
+static constexpr const char *PASS = "dar_bench";
+
+    /// deterministic pseudo-random generator (xorshift64*), for the tree to be the same from a run to another
+class generator
+{
+public:
+    generator(): state(0x9E3779B97F4A7C15ULL) {};
+
+    U_64 next()
+    {
+	state ^= state >> 12;
+	state ^= state << 25;
+	state ^= state >> 27;
+	return state * 0x2545F4914F6CDD1DULL;
+    };
+
+	/// fill buf with data compressible about as text is
+    void fill_compressible(char *buf, U_I size);
+
+	/// fill buf with uncompressible data
+    void fill_random(char *buf, U_I size);
+
+private:
+    U_64 state;
+};
+
+    /// a measure of the matrix
+struct result
+{
+    string compr;
+    string crypto;
+    U_I threads;
+    U_I run;
+    string operation;
+    double wall;
+    double cpu;
+    U_64 archive_bytes;
+    string treated;
+    string error;
+};
+
+    /// what the synthetic tree contains
+struct tree_info
+{
+    U_64 files;
+    U_64 dirs;
+    U_64 bytes;         ///< apparent size of the files
+    U_64 data_bytes;    ///< size of the data really written (holes excluded)
+    bool xattr;         ///< whether extended attributes could be set
+};
+
+static void usage(const char *argv0);
+static bool compression_available(compression algo);
+static vector<string> split(const string & list);
+static void generate_tree(const string & root, U_I scale, tree_info & info);
+static void make_dir(const string & dir);
+static void write_file(const string & name, const char *data, U_I size);
+static void remove_tree(const string & root);
+static U_64 archive_size(const string & dir, const string & basename);
+static string json_string(const string & s);
+static string now_iso8601();
+static void run_matrix(const string & work,
+		       const string & tree,
+		       const vector<string> & compr_list,
+		       const vector<string> & crypto_list,
+		       const vector<U_I> & thread_list,
+		       U_I repeat,
+		       vector<result> & results);
+static void write_json(const string & filename,
+		       U_I scale,
+		       const tree_info & info,
+		       const vector<result> & results);
+
+int main(int argc, char *argv[])
+{
+    U_I scale = 1;
+    U_I repeat = 1;
+    string compr = "none,gzip,lz4,zstd";
+    string crypto = "none,aes,aes-xts";
+    string threads = "1,4";
+    int opt;
+
+    while((opt = getopt(argc, argv, "s:r:z:K:G:h")) != -1)
+    {
+	switch(opt)
+	{
+	case 's':
+	    scale = atoi(optarg);
+	    break;
+	case 'r':
+	    repeat = atoi(optarg);
+	    break;
+	case 'z':
+	    compr = optarg;
+	    break;
+	case 'K':
+	    crypto = optarg;
+	    break;
+	case 'G':
+	    threads = optarg;
+	    break;
+	default:
+	    usage(argv[0]);
+	    return 1;
+	}
+    }
+
+    if(argc - optind != 2 || scale == 0 || repeat == 0)
+    {
+	usage(argv[0]);
+	return 1;
+    }
+
+    try
+    {
+	get_version();
+    }
+    catch(...)
+    {
+	cerr << "libdar library error, cannot initialize library" << endl;
+	return 1;
+    }
+
+    try
+    {
+	string work = argv[optind];
+	string tree = work + "/tree";
+	vector<string> compr_list;
+	vector<string> crypto_list;
+	vector<U_I> thread_list;
+	vector<result> results;
+	tree_info info;
+
+	    // dropping from the matrix what this libdar has not been built with
+
+	for(const string & c: split(compr))
+	{
+	    try
+	    {
+		compression algo = string2compression(c);
+
+		if(!compression_available(algo))
+		    cerr << "compression " << c << " not available, skipped" << endl;
+		else
+		    compr_list.push_back(c);
+	    }
+	    catch(Egeneric & e)
+	    {
+		cerr << "unknown compression " << c << ", skipped" << endl;
+	    }
+	}
+
+	for(const string & c: split(crypto))
+	{
+	    if(c != "none" && !compile_time::libgcrypt())
+		cerr << "cipher " << c << " not available, skipped" << endl;
+	    else
+		crypto_list.push_back(c);
+	}
+
+	for(const string & t: split(threads))
+	{
+	    U_I num = atoi(t.c_str());
+
+	    if(num == 0)
+		cerr << "invalid thread count " << t << ", skipped" << endl;
+	    else
+		if(num > 1 && !compile_time::libthreadar())
+		    cerr << "multi-threading not available, thread count " << t << " skipped" << endl;
+		else
+		    thread_list.push_back(num);
+	}
+
+	make_dir(work);
+	remove_tree(tree);
+	cerr << "generating synthetic tree in " << tree << endl;
+	generate_tree(tree, scale, info);
+
+	run_matrix(work, tree, compr_list, crypto_list, thread_list, repeat, results);
+	write_json(argv[optind + 1], scale, info, results);
+	remove_tree(tree);
+	cerr << "results written to " << argv[optind + 1] << endl;
+    }
+    catch(Egeneric & e)
+    {
+	cerr << "Error: " << e.get_message() << endl;
+	close_and_clean();
+	return 2;
+    }
+    catch(exception & e)
+    {
+	cerr << "Error: " << e.what() << endl;
+	close_and_clean();
+	return 2;
+    }
+
+    close_and_clean();
+    return 0;
+}
+
+static void usage(const char *argv0)
+{
+    cerr << "usage: " << argv0 << " [-s <scale>] [-r <repeat>] [-z <compression list>] [-K <cipher list>] [-G <thread count list>] <work dir> <json output>" << endl;
+    cerr << "   lists are comma separated, for example: -z none,gzip,zstd -K none,aes-xts -G 1,4" << endl;
+}
+
+static bool compression_available(compression algo)
+{
+    switch(algo)
+    {
+    case compression::none:
+	return true;
+    case compression::gzip:
+	return compile_time::libz();
+    case compression::bzip2:
+	return compile_time::libbz2();
+    case compression::lzo:
+    case compression::lzo1x_1_15:
+    case compression::lzo1x_1:
+	return compile_time::liblzo();
+    case compression::xz:
+	return compile_time::libxz();
+    case compression::zstd:
+	return compile_time::libzstd();
+    case compression::lz4:
+	return compile_time::liblz4();
+    default:
+	return false;
+    }
+}
+
+static vector<string> split(const string & list)
+{
+    vector<string> ret;
+    string::size_type start = 0;
+    string::size_type end;
+
+    do
+    {
+	end = list.find(',', start);
+	if(end == string::npos)
+	    end = list.size();
+	if(end > start)
+	    ret.push_back(list.substr(start, end - start));
+	start = end + 1;
+    }
+    while(start < list.size());
+
+    return ret;
+}
+
+void generator::fill_compressible(char *buf, U_I size)
+{
+    static const char *words[] = { "archive ", "slice ", "catalogue ", "backup ", "restore ",
+				   "differential ", "compression ", "the ", "of ", "and ",
+				   "data ", "file ", "directory ", "inode ", "\n", "block " };
+    U_I i = 0;
+
+    while(i < size)
+    {
+	const char *w = words[next() % 16];
+
+	while(*w != '\0' && i < size)
+	    buf[i++] = *(w++);
+    }
+}
+
+void generator::fill_random(char *buf, U_I size)
+{
+    U_I i = 0;
+
+    while(i < size)
+    {
+	U_64 val = next();
+
+	for(U_I j = 0; j < 8 && i < size; ++j, ++i)
+	{
+	    buf[i] = (char)(val & 0xFF);
+	    val >>= 8;
+	}
+    }
+}
+
+static void generate_tree(const string & root, U_I scale, tree_info & info)
+{
+    generator gen;
+    vector<char> buf(HUGE_FILE_SIZE);
+
+    info.files = 0;
+    info.dirs = 0;
+    info.bytes = 0;
+    info.data_bytes = 0;
+    info.xattr = false;
+
+    make_dir(root);
+    ++info.dirs;
+
+	// many small files, half compressible half random
+
+    make_dir(root + "/small");
+    ++info.dirs;
+    for(U_I d = 0; d < SMALL_DIRS * scale; ++d)
+    {
+	string dir = root + "/small/d" + to_string(d);
+
+	make_dir(dir);
+	++info.dirs;
+	for(U_I f = 0; f < SMALL_FILES_PER_DIR; ++f)
+	{
+	    U_I size = gen.next() % SMALL_FILE_MAX;
+
+	    if(f % 2 == 0)
+		gen.fill_compressible(buf.data(), size);
+	    else
+		gen.fill_random(buf.data(), size);
+	    write_file(dir + "/f" + to_string(f), buf.data(), size);
+	    ++info.files;
+	    info.bytes += size;
+	    info.data_bytes += size;
+	}
+    }
+
+	// few huge files, one compressible one not
+
+    make_dir(root + "/huge");
+    ++info.dirs;
+    for(U_I f = 0; f < HUGE_FILES * scale; ++f)
+    {
+	if(f % 2 == 0)
+	    gen.fill_compressible(buf.data(), HUGE_FILE_SIZE);
+	else
+	    gen.fill_random(buf.data(), HUGE_FILE_SIZE);
+	write_file(root + "/huge/h" + to_string(f), buf.data(), HUGE_FILE_SIZE);
+	++info.files;
+	info.bytes += HUGE_FILE_SIZE;
+	info.data_bytes += HUGE_FILE_SIZE;
+    }
+
+	// sparse files
+
+    make_dir(root + "/sparse");
+    ++info.dirs;
+    for(U_I f = 0; f < SPARSE_FILES * scale; ++f)
+    {
+	string name = root + "/sparse/s" + to_string(f);
+	const U_I extent = 64*1024;
+	int fd = ::open(name.c_str(), O_WRONLY|O_CREAT|O_TRUNC, 0644);
+
+	if(fd < 0)
+	    throw Erange(string("cannot create ") + name + ": " + strerror(errno));
+	try
+	{
+	    for(U_I e = 0; e < SPARSE_EXTENTS; ++e)
+	    {
+		off_t offset = (off_t)(SPARSE_FILE_SIZE / SPARSE_EXTENTS) * e;
+
+		gen.fill_random(buf.data(), extent);
+		if(pwrite(fd, buf.data(), extent, offset) != (ssize_t)extent)
+		    throw Erange(string("cannot write ") + name + ": " + strerror(errno));
+		info.data_bytes += extent;
+	    }
+	    if(ftruncate(fd, SPARSE_FILE_SIZE) != 0)
+		throw Erange(string("cannot truncate ") + name + ": " + strerror(errno));
+	}
+	catch(...)
+	{
+	    close(fd);
+	    throw;
+	}
+	close(fd);
+	++info.files;
+	info.bytes += SPARSE_FILE_SIZE;
+    }
+
+	// hard links
+
+    make_dir(root + "/hardlinks");
+    ++info.dirs;
+    for(U_I f = 0; f < HARD_LINKED_FILES * scale; ++f)
+    {
+	string name = root + "/hardlinks/l" + to_string(f);
+	U_I size = gen.next() % SMALL_FILE_MAX;
+
+	gen.fill_compressible(buf.data(), size);
+	write_file(name + "_0", buf.data(), size);
+	info.data_bytes += size;
+	for(U_I l = 0; l < HARD_LINKS; ++l)
+	{
+	    if(l > 0)
+		if(link((name + "_0").c_str(), (name + "_" + to_string(l)).c_str()) != 0)
+		    throw Erange(string("cannot create hard link: ") + strerror(errno));
+	    ++info.files;
+	    info.bytes += size;
+	}
+    }
+
+	// deep directory tree
+
+    string deep = root + "/deep";
+    for(U_I l = 0; l < DEEP_LEVELS; ++l)
+    {
+	U_I size = gen.next() % SMALL_FILE_MAX;
+
+	make_dir(deep);
+	++info.dirs;
+	gen.fill_compressible(buf.data(), size);
+	write_file(deep + "/file", buf.data(), size);
+	++info.files;
+	info.bytes += size;
+	info.data_bytes += size;
+	deep += "/level" + to_string(l);
+    }
+
+	// extended attributes
+
+    make_dir(root + "/xattrs");
+    ++info.dirs;
+    info.xattr = true;
+    for(U_I f = 0; f < XATTR_FILES * scale; ++f)
+    {
+	string name = root + "/xattrs/x" + to_string(f);
+	U_I size = gen.next() % SMALL_FILE_MAX;
+
+	gen.fill_compressible(buf.data(), size);
+	write_file(name, buf.data(), size);
+	++info.files;
+	info.bytes += size;
+	info.data_bytes += size;
+#if defined(EA_SUPPORT) && (HAVE_SYS_XATTR_H || HAVE_ATTR_XATTR_H)
+	if(info.xattr)
+	{
+	    string value = "value of " + to_string(f);
+
+	    if(setxattr(name.c_str(), "user.dar_bench", value.c_str(), value.size(), 0) != 0)
+	    {
+		cerr << "extended attributes not supported by the filesystem, tree has none: " << strerror(errno) << endl;
+		info.xattr = false;
+	    }
+	}
+#else
+	info.xattr = false;
+#endif
+    }
+}
+
+static void make_dir(const string & dir)
+{
+    if(mkdir(dir.c_str(), 0755) != 0 && errno != EEXIST)
+	throw Erange(string("cannot create directory ") + dir + ": " + strerror(errno));
+}
+
+static void write_file(const string & name, const char *data, U_I size)
+{
+    int fd = ::open(name.c_str(), O_WRONLY|O_CREAT|O_TRUNC, 0644);
+    U_I written = 0;
+
+    if(fd < 0)
+	throw Erange(string("cannot create ") + name + ": " + strerror(errno));
+
+    while(written < size)
+    {
+	ssize_t ret = write(fd, data + written, size - written);
+
+	if(ret < 0)
+	{
+	    if(errno == EINTR)
+		continue;
+	    close(fd);
+	    throw Erange(string("cannot write ") + name + ": " + strerror(errno));
+	}
+	written += ret;
+    }
+    close(fd);
+}
+
+static void remove_tree(const string & root)
+{
+    struct stat st;
+    DIR *dir;
+    struct dirent *ent;
+
+    if(lstat(root.c_str(), &st) != 0)
+	return;
+
+    if(S_ISDIR(st.st_mode))
+    {
+	dir = opendir(root.c_str());
+	if(dir == nullptr)
+	    throw Erange(string("cannot open directory ") + root + ": " + strerror(errno));
+	try
+	{
+	    while((ent = readdir(dir)) != nullptr)
+	    {
+		string name = ent->d_name;
+
+		if(name != "." && name != "..")
+		    remove_tree(root + "/" + name);
+	    }
+	}
+	catch(...)
+	{
+	    closedir(dir);
+	    throw;
+	}
+	closedir(dir);
+	if(rmdir(root.c_str()) != 0)
+	    throw Erange(string("cannot remove directory ") + root + ": " + strerror(errno));
+    }
+    else
+	if(unlink(root.c_str()) != 0)
+	    throw Erange(string("cannot remove ") + root + ": " + strerror(errno));
+}
+
+static U_64 archive_size(const string & dir, const string & basename)
+{
+    U_64 ret = 0;
+    struct stat st;
+    U_I num = 1;
+
+    while(stat((dir + "/" + basename + "." + to_string(num) + ".dar").c_str(), &st) == 0)
+    {
+	ret += st.st_size;
+	++num;
+    }
+
+    return ret;
+}
+
+static void remove_archive(const string & dir, const string & basename)
+{
+    U_I num = 1;
+
+    while(unlink((dir + "/" + basename + "." + to_string(num) + ".dar").c_str()) == 0)
+	++num;
+}
+
+static string json_string(const string & s)
+{
+    ostringstream ret;
+
+    ret << '"';
+    for(string::const_iterator it = s.begin(); it != s.end(); ++it)
+    {
+	switch(*it)
+	{
+	case '"':
+	    ret << "\\\"";
+	    break;
+	case '\\':
+	    ret << "\\\\";
+	    break;
+	case '\n':
+	    ret << "\\n";
+	    break;
+	default:
+	    if((unsigned char)(*it) < 0x20)
+		ret << "\\u" << hex << setw(4) << setfill('0') << (U_I)(unsigned char)(*it) << dec;
+	    else
+		ret << *it;
+	}
+    }
+    ret << '"';
+
+    return ret.str();
+}
+
+static string now_iso8601()
+{
+    time_t now = time(nullptr);
+    struct tm when;
+    char buf[64];
+
+    if(gmtime_r(&now, &when) == nullptr
+       || strftime(buf, sizeof(buf), "%Y-%m-%dT%H:%M:%SZ", &when) == 0)
+	return "";
+
+    return buf;
+}
+
+    /// the settings of the matrix cell being measured
+struct cell
+{
+    string work;
+    string tree;
+    compression compr;
+    crypto_algo crypto;
+    U_I threads;
+};
+
+static crypto_algo cipher_from_string(const string & name)
+{
+    static const crypto_algo all[] = { crypto_algo::none,
+				       crypto_algo::blowfish,
+				       crypto_algo::aes256,
+				       crypto_algo::twofish256,
+				       crypto_algo::serpent256,
+				       crypto_algo::camellia256,
+				       crypto_algo::aes256_xts,
+				       crypto_algo::twofish256_xts,
+				       crypto_algo::serpent256_xts,
+				       crypto_algo::camellia256_xts };
+
+    for(U_I i = 0; i < sizeof(all)/sizeof(all[0]); ++i)
+	if(crypto_algo_2_dar_cmdline_string(all[i]) == name)
+	    return all[i];
+
+    throw Erange(string("unknown cipher: ") + name);
+}
+
+static archive_options_read read_options(const cell & c)
+{
+    archive_options_read ret;
+
+    ret.set_info_details(false);
+    ret.set_multi_threaded_crypto(c.threads);
+    ret.set_multi_threaded_compress(c.threads);
+    if(c.crypto != crypto_algo::none)
+	ret.set_crypto_pass(secu_string(PASS, strlen(PASS)));
+
+    return ret;
+}
+
+static U_I block_size(const cell & c)
+{
+	// same default as dar command-line when compression is multi-threaded
+    return (c.threads > 1 && c.compr != compression::none) ? 240*1024 : 0;
+}
+
+static void measure(const cell & c,
+		    const string & compr_name,
+		    const string & crypto_name,
+		    U_I run,
+		    const string & operation,
+		    const string & basename,
+		    function<string()> action,
+		    vector<result> & results)
+{
+    result res;
+    clock_t cpu_start = clock();
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    res.compr = compr_name;
+    res.crypto = crypto_name;
+    res.threads = c.threads;
+    res.run = run;
+    res.operation = operation;
+    res.archive_bytes = 0;
+
+    try
+    {
+	res.treated = action();
+    }
+    catch(Egeneric & e)
+    {
+	res.error = e.get_message();
+    }
+
+    res.wall = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    res.cpu = (double)(clock() - cpu_start) / CLOCKS_PER_SEC;
+    if(!basename.empty())
+	res.archive_bytes = archive_size(c.work, basename);
+
+    cerr << "  " << operation << ": " << fixed << setprecision(3) << res.wall << " s"
+	 << (res.error.empty() ? string("") : string(" ERROR: ") + res.error) << endl;
+    results.push_back(res);
+}
+
+static void run_cell(const cell & c,
+		     const string & compr_name,
+		     const string & crypto_name,
+		     U_I run,
+		     vector<result> & results)
+{
+    shared_ptr<user_interaction> ui(new (nothrow) user_interaction_blind());
+    string restore = c.work + "/restore";
+    const string ext = "dar";
+
+    if(!ui)
+	throw Ememory();
+
+
+    measure(c, compr_name, crypto_name, run, "create", "full", [&]() -> string
+    {
+	archive_options_create opt;
+
+	opt.set_info_details(false);
+	opt.set_display_finished(false);
+	opt.set_compression(c.compr);
+	opt.set_compression_block_size(block_size(c));
+	opt.set_multi_threaded_crypto(c.threads);
+	opt.set_multi_threaded_compress(c.threads);
+	opt.set_crypto_algo(c.crypto);
+	if(c.crypto != crypto_algo::none)
+	    opt.set_crypto_pass(secu_string(PASS, strlen(PASS)));
+
+	statistics st;
+	archive arch(ui, path(c.tree), path(c.work), "full", ext, opt, &st);
+	return libdar::deci(st.get_treated()).human();
+    }, results);
+
+    measure(c, compr_name, crypto_name, run, "test", "", [&]() -> string
+    {
+	archive arch(ui, path(c.work), "full", ext, read_options(c));
+	archive_options_test opt;
+
+	opt.set_info_details(false);
+	opt.set_display_treated(false, false);
+	return libdar::deci(arch.op_test(opt, nullptr).get_treated()).human();
+    }, results);
+
+    measure(c, compr_name, crypto_name, run, "diff", "", [&]() -> string
+    {
+	archive arch(ui, path(c.work), "full", ext, read_options(c));
+	archive_options_diff opt;
+
+	opt.set_info_details(false);
+	opt.set_display_treated(false, false);
+	return libdar::deci(arch.op_diff(path(c.tree), opt, nullptr).get_treated()).human();
+    }, results);
+
+    remove_tree(restore);
+    make_dir(restore);
+    measure(c, compr_name, crypto_name, run, "extract", "", [&]() -> string
+    {
+	archive arch(ui, path(c.work), "full", ext, read_options(c));
+	archive_options_extract opt;
+
+	opt.set_info_details(false);
+	opt.set_display_treated(false, false);
+	opt.set_warn_over(false);
+	return libdar::deci(arch.op_extract(path(restore), opt, nullptr).get_treated()).human();
+    }, results);
+    remove_tree(restore);
+
+    measure(c, compr_name, crypto_name, run, "isolate", "isolated", [&]() -> string
+    {
+	archive arch(ui, path(c.work), "full", ext, read_options(c));
+	archive_options_isolate opt;
+
+	opt.set_info_details(false);
+	opt.set_warn_over(false);
+	opt.set_compression(c.compr);
+	opt.set_compression_block_size(block_size(c));
+	opt.set_multi_threaded_crypto(c.threads);
+	opt.set_multi_threaded_compress(c.threads);
+	opt.set_crypto_algo(c.crypto);
+	if(c.crypto != crypto_algo::none)
+	    opt.set_crypto_pass(secu_string(PASS, strlen(PASS)));
+	arch.op_isolate(path(c.work), "isolated", ext, opt);
+	return "";
+    }, results);
+
+    measure(c, compr_name, crypto_name, run, "merge", "merged", [&]() -> string
+    {
+	shared_ptr<archive> ref(new (nothrow) archive(ui, path(c.work), "full", ext, read_options(c)));
+	archive_options_merge opt;
+	statistics st;
+
+	if(!ref)
+	    throw Ememory();
+	opt.set_info_details(false);
+	opt.set_display_treated(false, false);
+	opt.set_warn_over(false);
+	opt.set_keep_compressed(false);
+	opt.set_compression(c.compr);
+	opt.set_compression_block_size(block_size(c));
+	opt.set_multi_threaded_crypto(c.threads);
+	opt.set_multi_threaded_compress(c.threads);
+	opt.set_crypto_algo(c.crypto);
+	if(c.crypto != crypto_algo::none)
+	    opt.set_crypto_pass(secu_string(PASS, strlen(PASS)));
+	archive merged(ui, path(c.work), ref, "merged", ext, opt, &st);
+	return libdar::deci(st.get_treated()).human();
+    }, results);
+
+    remove_archive(c.work, "full");
+    remove_archive(c.work, "isolated");
+    remove_archive(c.work, "merged");
+}
+
+static void run_matrix(const string & work,
+		       const string & tree,
+		       const vector<string> & compr_list,
+		       const vector<string> & crypto_list,
+		       const vector<U_I> & thread_list,
+		       U_I repeat,
+		       vector<result> & results)
+{
+    cell c;
+
+    c.work = work;
+    c.tree = tree;
+
+    for(const string & compr: compr_list)
+	for(const string & crypto: crypto_list)
+	    for(U_I threads: thread_list)
+		for(U_I run = 0; run < repeat; ++run)
+		{
+		    c.compr = string2compression(compr);
+		    c.crypto = cipher_from_string(crypto);
+		    c.threads = threads;
+		    cerr << "compression " << compr << ", cipher " << crypto << ", " << threads << " thread(s), run " << run + 1 << "/" << repeat << endl;
+		    remove_archive(work, "full");
+		    remove_archive(work, "isolated");
+		    remove_archive(work, "merged");
+		    run_cell(c, compr, crypto, run, results);
+		}
+}
+
+static void write_json(const string & filename,
+		       U_I scale,
+		       const tree_info & info,
+		       const vector<result> & results)
+{
+    ofstream out(filename.c_str());
+    U_I major, medium, minor;
+    string host;
+
+    if(!out)
+	throw Erange(string("cannot create ") + filename);
+
+    get_version(major, medium, minor);
+#if HAVE_SYS_UTSNAME_H
+    struct utsname un;
+    if(uname(&un) == 0)
+	host = string(un.nodename) + " " + un.sysname + " " + un.release + " " + un.machine;
+#endif
+
+    out << "{" << endl;
+    out << "  \"libdar_version\": " << json_string(to_string(major) + "." + to_string(medium) + "." + to_string(minor)) << "," << endl;
+    out << "  \"date\": " << json_string(now_iso8601()) << "," << endl;
+    out << "  \"host\": " << json_string(host) << "," << endl;
+    out << "  \"cpus\": " << sysconf(_SC_NPROCESSORS_ONLN) << "," << endl;
+    out << "  \"scale\": " << scale << "," << endl;
+    out << "  \"tree\": { \"files\": " << info.files
+	<< ", \"dirs\": " << info.dirs
+	<< ", \"bytes\": " << info.bytes
+	<< ", \"data_bytes\": " << info.data_bytes
+	<< ", \"xattr\": " << (info.xattr ? "true" : "false") << " }," << endl;
+    out << "  \"results\": [" << endl;
+    for(vector<result>::const_iterator it = results.begin(); it != results.end(); ++it)
+    {
+	out << "    { \"compression\": " << json_string(it->compr)
+	    << ", \"cipher\": " << json_string(it->crypto)
+	    << ", \"threads\": " << it->threads
+	    << ", \"run\": " << it->run
+	    << ", \"operation\": " << json_string(it->operation)
+	    << fixed << setprecision(6)
+	    << ", \"wall_seconds\": " << it->wall
+	    << ", \"cpu_seconds\": " << it->cpu
+	    << setprecision(3)
+	    << ", \"data_mb_per_s\": " << (it->wall > 0 ? (double)info.data_bytes / it->wall / 1e6 : 0)
+	    << ", \"archive_bytes\": " << it->archive_bytes
+	    << ", \"treated\": " << (it->treated.empty() ? string("null") : it->treated)
+	    << ", \"error\": " << (it->error.empty() ? string("null") : json_string(it->error))
+	    << " }" << (it + 1 != results.end() ? "," : "") << endl;
+    }
+    out << "  ]" << endl;
+    out << "}" << endl;
+}
@@ -736,6 +736,9 @@ if echo $* | grep "I1" > /dev/null ; then
 GO "I1-1" 0 $ROUTINE_DEBUG $DAR -N -Q -w -c $DAR_SFTP_REPO/$prefix-sftp-$full -R $src "-@" $prefix$catf_fly -B $OPT
 GO "I1-2" 0 $ROUTINE_DEBUG $DAR -N -Q -l $DAR_SFTP_REPO/$prefix-sftp-$full -B $OPT
 GO "I1-3" 0 $ROUTINE_DEBUG $DAR -N -Q -t $DAR_SFTP_REPO/$prefix-sftp-$full -B $OPT
+GO "I1-4" 0 $ROUTINE_DEBUG $DAR -N -Q -w -c $DAR_SFTP_REPO/$prefix-sftp-sliced -s 100k -R $src -B $OPT
+GO "I1-5" 0 $ROUTINE_DEBUG $DAR -N -Q -t $DAR_SFTP_REPO/$prefix-sftp-sliced -B $OPT
+GO "I1-6" 0 $ROUTINE_DEBUG $DAR -N -Q -d $DAR_SFTP_REPO/$prefix-sftp-sliced -R $src -B $OPT
 ../sftp_mdelete "$DAR_SFTP_REPO" "$prefix-sftp-*"
 fi
 
@@ -72,7 +72,7 @@ extern "C"
 #include "libdar.hpp"
 #include "fichier_local.hpp"
 
-#define OPT_STRING "c:A:x:d:t:l:v::z::y:nw::p::k::R:s:S:X:I:P:bhLWDru:U:VC:i:o:OT:E:F:K:J:Y:Z:B:fm:NH::a::eQG:M::g:#:*:,[:]:+:@:$:~:%:q::/:^:_:01:2:.:3:9:<:>:=:4:5::6:7:8:{:}:j:\\:"
+#define OPT_STRING "c:A:x:d:t:l:v::z::y:nw::p::k::R:s:S:X:I:P:bhLWDru:U:VC:i:o:OT:E:F:K:J:Y:Z:B:fm:NH::a::eQG:M::g:#:*:,[:]:+:@:$:~:%:q::/:^:_:01:2:.:3:9:<:>:=:4:5::6:7:8:{:}:j:\\:&:"
 
 #define ONLY_ONCE "Only one -%c is allowed, ignoring this extra option"
 #define MISSING_ARG "Missing argument to -%c option"
@@ -249,6 +249,7 @@ bool get_args(shared_ptr<user_interaction> & dialog,
     p.what_to_check = comparison_fields::all;
     p.execute = "";
     p.execute_ref = "";
+    p.async_execute = 0;
     p.pass.clear();
     p.signatories.clear();
     p.blind_signatures = false;
@@ -296,7 +297,7 @@ bool get_args(shared_ptr<user_interaction> & dialog,
     p.dirty = dirtyb_warn;
     p.security_check = true;
     p.user_comment = "";
-    p.hash = hash_algo::none;
+    p.hash.clear();
     p.num_digits = 0;
     p.ref_num_digits = 0;
     p.aux_num_digits = 0;
@@ -310,6 +311,7 @@ bool get_args(shared_ptr<user_interaction> & dialog,
     p.scope = all_fsa_families();
     p.multi_threaded_crypto = 0;
     p.multi_threaded_compress = 0;
+    p.restore_writers = 1;
     p.delta_sig = rsync_sig_magic::none;
     p.delta_mask = nullptr;
     p.delta_diff = true;
@@ -334,6 +336,10 @@ bool get_args(shared_ptr<user_interaction> & dialog,
     p.isolation_repair = false;
     p.extract_from_database = false;
     p.ignore_external_sh = false;
+    p.layer_stats = false;
+    p.streamed_ref = false;
+    p.spill_catalogue = false;
+    p.spill_dir = "";
 
     if(!dialog)
 	throw SRC_BUG;
@@ -1740,6 +1746,16 @@ static bool get_args_recursive(recursive_param & rec,
 			    p.multi_threaded_compress = (U_I)tmp;
 			}
 			break;
+		    case 3:
+			if(! tools_my_atoi(split[2].c_str(), tmp))
+			    throw Erange(tools_printf(gettext(INVALID_ARG), char(lu)));
+			else
+			{
+			    if(tmp < 1)
+				throw Erange(tools_printf(gettext(INVALID_ARG), char(lu)));
+			    p.restore_writers = (U_I)tmp;
+			}
+			    // NO BREAK HERE !!! This is intended, the two first numbers are read as for case 2
 		    case 2:
 			if(! tools_my_atoi(split[0].c_str(), tmp))
 			    throw Erange(tools_printf(gettext(INVALID_ARG), char(lu)));
@@ -1984,8 +2000,14 @@ static bool get_args_recursive(recursive_param & rec,
             case '3':
                 if(optarg == nullptr)
                     throw Erange(tools_printf(gettext("Missing argument to --hash"), char(lu)));
-		if(!string_to_hash_algo(optarg, p.hash) || p.hash == hash_algo::none)
-		    throw Erange(string(gettext("Unknown parameter given to --hash option: ")) + optarg);
+		{
+		    hash_algo tmp_hash;
+
+		    if(!string_to_hash_algo(optarg, tmp_hash) || tmp_hash == hash_algo::none)
+			throw Erange(string(gettext("Unknown parameter given to --hash option: ")) + optarg);
+		    if(find(p.hash.begin(), p.hash.end(), tmp_hash) == p.hash.end())
+			p.hash.push_back(tmp_hash); // several --hash options compute several hashes at once
+		}
                 break;
             case '9':
                 if(optarg == nullptr)
@@ -2191,6 +2213,18 @@ static bool get_args_recursive(recursive_param & rec,
 		    throw Erange(tools_printf(gettext(MISSING_ARG), char(lu)));
 		p.ignored_as_symlink = optarg;
 		break;
+	    case '&':
+		if(optarg == nullptr)
+		    throw Erange(tools_printf(gettext(MISSING_ARG), char(lu)));
+		if(compile_time::libthreadar())
+		{
+		    if(! tools_my_atoi(optarg, tmp) || tmp < 1)
+			throw Erange(tools_printf(gettext(INVALID_ARG), char(lu)));
+		    p.async_execute = (U_I)tmp;
+		}
+		else
+		    throw Ecompilation(gettext("libthreadar is required to execute commands between slices in background"));
+		break;
 	    case '\'':
 		if(optarg == nullptr)
 		    throw Erange(tools_printf(gettext(MISSING_ARG), char(lu)));
@@ -2201,6 +2235,23 @@ static bool get_args_recursive(recursive_param & rec,
 		else
 		    throw Erange(string(gettext("Unknown parameter given to --modified-data-detection option: ")) + optarg);
 		break;
+	    case '(':
+		p.layer_stats = true;
+		break;
+	    case ')':
+		p.streamed_ref = true;
+		break;
+	    case '!':
+		p.spill_catalogue = true;
+		if(optarg != nullptr)
+		{
+		    p.spill_dir = optarg;
+		    if(p.spill_dir.empty())
+			throw Erange(gettext("Empty string given to --spill-catalogue option"));
+		}
+		else
+		    p.spill_dir = "";
+		break;
             case ':':
                 throw Erange(tools_printf(gettext(MISSING_ARG), char(optopt)));
             case '?':
@@ -2252,10 +2303,12 @@ static void usage(user_interaction & dialog, const char *command_name)
     dialog.printf(gettext("   -/ <policy>     define an overwriting policy\n"));
     dialog.printf(gettext("   -b              ring the terminal bell when user action is required\n"));
     if(compile_time::libthreadar())
-	dialog.printf(gettext("   -G <num>,<num>  number of threads for de/ciphering and de/compression\n"));
+	dialog.printf(gettext("   -G <num>,<num>[,<num>] number of threads for de/ciphering, de/compression\n                   and for writing restored files\n"));
     dialog.printf(gettext("   -O[ignore-owner | mtime | inode-type] do not consider user and group\n                   ownership\n"));
     dialog.printf(gettext("   -H [N]          ignore shift in dates of an exact number of hours\n"));
     dialog.printf(gettext("   -E <string>     command to execute between slices\n"));
+    if(compile_time::libthreadar())
+	dialog.printf(gettext("   -& <num>        run up to <num> -E commands in background\n"));
     dialog.printf(gettext("   -F <string>     same as -E but for the archive of reference\n"));
     dialog.printf(gettext("   -~ <string>     same as -E but for the auxiliary archive of reference\n"));
     dialog.printf(gettext("   -u <mask>       mask to ignore certain EA\n"));
@@ -2761,6 +2814,7 @@ const struct option *get_long_opt()
         {"execute", required_argument, nullptr, 'E'},
         {"execute-ref",required_argument, nullptr, 'F'},
         {"ref-execute",required_argument, nullptr, 'F'},
+        {"execute-async", required_argument, nullptr, '&'},
         {"key", required_argument, nullptr, 'K'},
         {"key-ref", required_argument, nullptr, 'J'},
         {"ref-key", required_argument, nullptr, 'J'},
@@ -2818,6 +2872,9 @@ const struct option *get_long_opt()
 	{"add-missing-catalogue", required_argument, nullptr, 'y'},
 	{"modified-data-detection", required_argument, nullptr, '\''},
 	{"kdf-param", required_argument, nullptr, 'T'},
+	{"layer-stats", no_argument, nullptr, '('},
+	{"streamed-ref", no_argument, nullptr, ')'},
+	{"spill-catalogue", optional_argument, nullptr, '!'},
         { nullptr, 0, nullptr, 0 }
     };
 
@@ -94,6 +94,7 @@ struct line_param
     comparison_fields what_to_check; ///< what fields to take into account when comparing/restoring files,
     string execute;               ///< if not an empty string, the command to execute between slices
     string execute_ref;           ///< if not an empty string, the command to execute between slices of the archive of reference
+    U_I async_execute;            ///< max number of commands between slices to run in background (zero for synchronous execution)
     secu_string pass;             ///< if not an empty string, encrypt the archive with the given algo:pass string
     vector<string> signatories;   ///< list of email's key to use to sign the archive
     bool blind_signatures;        ///< whether to ignore signature check failures
@@ -141,7 +142,7 @@ struct line_param
     dirty_behavior dirty;         ///< what to do when comes the time to restore a file that is flagged as dirty
     bool  security_check;         ///< whether to signal possible root-kit presence
     string user_comment;          ///< user comment to add to the archive
-    hash_algo hash;               ///< whether to produce a hash file, and which algoritm to use for that hash
+    std::deque<hash_algo> hash;   ///< algorithms to produce a hash file with, none if empty
     infinint num_digits;          ///< minimum number of decimal for the slice number
     infinint ref_num_digits;      ///< minimum number of decimal for the slice number of the archive of reference
     infinint aux_num_digits;      ///< minimum number of decimal for the slice number of the auxiliary archive of reference
@@ -155,6 +156,7 @@ struct line_param
     fsa_scope scope;              ///< FSA scope to consider for the operation
     U_I multi_threaded_crypto;    ///< number of crypto worker threads (requires libthreadar)
     U_I multi_threaded_compress;  ///< number of compress worker threads (requires libthreadar and per block compression)
+    U_I restore_writers;          ///< number of threads completing restored inodes (requires libthreadar)
     rsync_sig_magic delta_sig;    ///< whether to calculate rsync signature of files and which hash to use
     mask *delta_mask;             ///< which file to calculate delta sig when not using the default mask
     bool delta_diff;              ///< whether to save binary diff or whole file's data during a differential backup
@@ -179,6 +181,10 @@ struct line_param
     bool isolation_repair;        ///< whether to try isolate content of a truncated archive
     bool extract_from_database;   ///< whether to extract from a dar_manager database or from a dar archive
     bool ignore_external_sh;      ///< whether to ignore external slice header when reading a backup with the help of an isolated catalogue
+    bool layer_stats;             ///< whether to display the activity of each layer of the archive at the end of the operation
+    bool streamed_ref;            ///< whether to stream the catalogue of the archive of reference instead of loading it in memory
+    bool spill_catalogue;         ///< whether to spill the catalogue under construction to disk
+    std::string spill_dir;        ///< where to spill the catalogue (empty string for the default temporary directory)
 
 	// constructor for line_param
     line_param()
@@ -73,6 +73,7 @@ static S_I little_main(shared_ptr<user_interaction> & dialog, S_I argc, char * c
     const char *env_pub_filekey = line_tools_get_from_env(env, "DAR_SFTP_PUBLIC_KEYFILE");
     const char *env_prv_filekey = line_tools_get_from_env(env, "DAR_SFTP_PRIVATE_KEYFILE");
     const char *env_ignored_as_symlink = line_tools_get_from_env(env, "DAR_IGNORED_AS_SYMLINK");
+    const char *env_tmpdir = line_tools_get_from_env(env, "TMPDIR");
     shell_interaction *shelli = dynamic_cast<shell_interaction *>(dialog.get());
     string home_pref;
 
@@ -119,6 +120,7 @@ static S_I little_main(shared_ptr<user_interaction> & dialog, S_I argc, char * c
 	shared_ptr<entrepot> repo;
 	shared_ptr<entrepot> ref_repo;
 	shared_ptr<entrepot> aux_repo;
+	shared_ptr<layer_statistics> layer_stats;
 	shell_interaction *ptr = dynamic_cast<shell_interaction *>(dialog.get());
 
 	if(ptr != nullptr)
@@ -127,6 +129,13 @@ static S_I little_main(shared_ptr<user_interaction> & dialog, S_I argc, char * c
 	    ptr->set_fully_detailed_datetime(param.fully_detailed_dates);
 	}
 
+	if(param.layer_stats)
+	{
+	    layer_stats.reset(new (nothrow) layer_statistics());
+	    if(!layer_stats)
+		throw Ememory();
+	}
+
 	if(param.display_masks)
 	{
 	    const string initial_prefix = "    ";
@@ -298,6 +307,16 @@ static S_I little_main(shared_ptr<user_interaction> & dialog, S_I argc, char * c
 			else
 			    read_options.set_sequential_read(true);
 		    }
+		    if(param.streamed_ref)
+		    {
+			if(param.op != create)
+			    throw Erange(gettext("--streamed-ref option is only available when creating an archive"));
+			if(param.sequential_read)
+			    throw Erange(gettext("--streamed-ref option cannot be used with --sequential-read"));
+			if(param.delta_sig != rsync_sig_magic::none)
+			    throw Erange(gettext("--streamed-ref option cannot be used while computing delta signatures"));
+			read_options.set_streaming_catalogue(true);
+		    }
 		    if(ref_repo)
 			read_options.set_entrepot(ref_repo);
 
@@ -373,9 +392,10 @@ static S_I little_main(shared_ptr<user_interaction> & dialog, S_I argc, char * c
 		{
 		case create:
 		    create_options.clear();
+		    create_options.set_layer_statistics(layer_stats);
 		    if(arch)
 		    {
-			if(param.delta_sig == rsync_sig_magic::none && !param.delta_diff)
+			if(param.delta_sig == rsync_sig_magic::none && !param.delta_diff && !param.streamed_ref)
 				// we may need to copy delta_sig
 				// from the archive of reference
 				// to the resulting archive so we
@@ -383,6 +403,8 @@ static S_I little_main(shared_ptr<user_interaction> & dialog, S_I argc, char * c
 				// is requested
 				// We may also need to read delta_sig
 				// to perform the delta difference
+				// And the streamed catalogue is read from the archive of reference
+				// while the backup is performed
 			    arch->drop_all_filedescriptors(false);
 			create_options.set_reference(arch);
 		    }
@@ -403,6 +425,7 @@ static S_I little_main(shared_ptr<user_interaction> & dialog, S_I argc, char * c
 		    create_options.set_slicing(param.file_size, param.first_file_size);
 		    create_options.set_ea_mask(*param.ea_mask);
 		    create_options.set_execute(param.execute);
+		    create_options.set_async_execute(param.async_execute);
 		    create_options.set_crypto_algo(crypto);
 		    create_options.set_crypto_pass(tmp_pass);
 		    create_options.set_crypto_size(param.crypto_size);
@@ -452,7 +475,8 @@ static S_I little_main(shared_ptr<user_interaction> & dialog, S_I argc, char * c
 		    create_options.set_sparse_file_min_size(param.sparse_file_min_size);
 		    create_options.set_security_check(param.security_check);
 		    create_options.set_user_comment(param.user_comment);
-		    create_options.set_hash_algo(param.hash);
+		    for(deque<hash_algo>::const_iterator it = param.hash.begin(); it != param.hash.end(); ++it)
+			create_options.add_hash_algo(*it);
 		    create_options.set_slice_min_digits(param.num_digits);
 		    create_options.set_fsa_scope(param.scope);
 		    create_options.set_multi_threaded_crypto(param.multi_threaded_crypto);
@@ -490,6 +514,17 @@ static S_I little_main(shared_ptr<user_interaction> & dialog, S_I argc, char * c
 		    }
 		    create_options.set_ignored_as_symlink(ignored_as_symlink_listing);
 		    create_options.set_modified_data_detection(param.modet);
+		    if(param.spill_catalogue)
+		    {
+			if(arch && !param.streamed_ref)
+			    throw Erange(gettext("--spill-catalogue option requires --streamed-ref when an archive of reference is given"));
+			if(param.delta_sig != rsync_sig_magic::none)
+			    throw Erange(gettext("--spill-catalogue option cannot be used while computing delta signatures"));
+			if(!param.spill_dir.empty())
+			    create_options.set_spill_directory(param.spill_dir);
+			else
+			    create_options.set_spill_directory(env_tmpdir != nullptr && env_tmpdir[0] != '\0' ? env_tmpdir : "/tmp");
+		    }
 		    if(param.iteration_count > 0)
 			create_options.set_iteration_count(param.iteration_count);
 		    if(param.kdf_hash != hash_algo::none)
@@ -529,6 +564,7 @@ static S_I little_main(shared_ptr<user_interaction> & dialog, S_I argc, char * c
 		    merge_options.set_slicing(param.file_size, param.first_file_size);
 		    merge_options.set_ea_mask(*param.ea_mask);
 		    merge_options.set_execute(param.execute);
+		    merge_options.set_async_execute(param.async_execute);
 		    merge_options.set_crypto_algo(crypto);
 		    merge_options.set_crypto_pass(tmp_pass);
 		    merge_options.set_crypto_size(param.crypto_size);
@@ -547,7 +583,8 @@ static S_I little_main(shared_ptr<user_interaction> & dialog, S_I argc, char * c
 		    merge_options.set_sequential_marks(param.use_sequential_marks);
 		    merge_options.set_sparse_file_min_size(param.sparse_file_min_size);
 		    merge_options.set_user_comment(param.user_comment);
-		    merge_options.set_hash_algo(param.hash);
+		    for(deque<hash_algo>::const_iterator it = param.hash.begin(); it != param.hash.end(); ++it)
+			merge_options.add_hash_algo(*it);
 		    merge_options.set_slice_min_digits(param.num_digits);
 		    merge_options.set_fsa_scope(param.scope);
 		    merge_options.set_multi_threaded_crypto(param.multi_threaded_crypto);
@@ -589,6 +626,7 @@ static S_I little_main(shared_ptr<user_interaction> & dialog, S_I argc, char * c
 		    repair_options.set_pause(param.pause);
 		    repair_options.set_slicing(param.file_size, param.first_file_size);
 		    repair_options.set_execute(param.execute);
+		    repair_options.set_async_execute(param.async_execute);
 		    repair_options.set_crypto_algo(crypto);
 		    repair_options.set_crypto_pass(tmp_pass);
 		    repair_options.set_crypto_size(param.crypto_size);
@@ -601,7 +639,8 @@ static S_I little_main(shared_ptr<user_interaction> & dialog, S_I argc, char * c
 		    repair_options.set_slice_user_ownership(param.slice_user);
 		    repair_options.set_slice_group_ownership(param.slice_group);
 		    repair_options.set_user_comment(param.user_comment);
-		    repair_options.set_hash_algo(param.hash);
+		    for(deque<hash_algo>::const_iterator it = param.hash.begin(); it != param.hash.end(); ++it)
+			repair_options.add_hash_algo(*it);
 		    repair_options.set_slice_min_digits(param.num_digits);
 		    repair_options.set_multi_threaded_crypto(param.multi_threaded_crypto);
 		    repair_options.set_multi_threaded_compress(param.multi_threaded_compress);
@@ -686,7 +725,8 @@ static S_I little_main(shared_ptr<user_interaction> & dialog, S_I argc, char * c
 			    isolate_options.set_slice_permission(param.slice_perm);
 			    isolate_options.set_slice_user_ownership(param.slice_user);
 			    isolate_options.set_slice_group_ownership(param.slice_group);
-			    isolate_options.set_hash_algo(param.hash);
+			    for(deque<hash_algo>::const_iterator it = param.hash.begin(); it != param.hash.end(); ++it)
+				isolate_options.add_hash_algo(*it);
 			    isolate_options.set_slice_min_digits(param.aux_num_digits);
 			    isolate_options.set_user_comment(param.user_comment);
 			    isolate_options.set_sequential_marks(param.use_sequential_marks);
@@ -719,6 +759,7 @@ static S_I little_main(shared_ptr<user_interaction> & dialog, S_I argc, char * c
 						  no_cipher_given,
 						  recipients);
 		read_options.clear();
+		read_options.set_layer_statistics(layer_stats);
 		if(no_cipher_given)
 			// since archive format 9 crypto algo used
 			// is stored in the archive, it will be used
@@ -778,6 +819,7 @@ static S_I little_main(shared_ptr<user_interaction> & dialog, S_I argc, char * c
 		isolate_options.set_compression_block_size(param.compression_block_size);
 		isolate_options.set_slicing(param.file_size, param.first_file_size);
 		isolate_options.set_execute(param.execute);
+		isolate_options.set_async_execute(param.async_execute);
 		isolate_options.set_crypto_algo(crypto);
 		isolate_options.set_crypto_pass(tmp_pass);
 		isolate_options.set_crypto_size(param.crypto_size);
@@ -790,7 +832,8 @@ static S_I little_main(shared_ptr<user_interaction> & dialog, S_I argc, char * c
 		isolate_options.set_slice_user_ownership(param.slice_user);
 		isolate_options.set_slice_group_ownership(param.slice_group);
 		isolate_options.set_user_comment(param.user_comment);
-		isolate_options.set_hash_algo(param.hash);
+		for(deque<hash_algo>::const_iterator it = param.hash.begin(); it != param.hash.end(); ++it)
+		    isolate_options.add_hash_algo(*it);
 		isolate_options.set_slice_min_digits(param.num_digits);
 		isolate_options.set_sequential_marks(param.use_sequential_marks);
 		isolate_options.set_multi_threaded_crypto(param.multi_threaded_crypto);
@@ -823,6 +866,7 @@ static S_I little_main(shared_ptr<user_interaction> & dialog, S_I argc, char * c
 						  no_cipher_given,
 						  recipients);
 		read_options.clear();
+		read_options.set_layer_statistics(layer_stats);
 		if(no_cipher_given)
 			// since archive format 9 crypto algo used
 			// is stored in the archive, it will be used
@@ -948,6 +992,7 @@ static S_I little_main(shared_ptr<user_interaction> & dialog, S_I argc, char * c
 		extract_options.set_fsa_scope(param.scope);
 		extract_options.set_ignore_unix_sockets(param.unix_sockets);
 		extract_options.set_in_place(param.in_place);
+		extract_options.set_restore_writers(param.restore_writers);
 
 		if(param.extract_from_database)
 		{
@@ -983,6 +1028,7 @@ static S_I little_main(shared_ptr<user_interaction> & dialog, S_I argc, char * c
 						  no_cipher_given,
 						  recipients);
 		read_options.clear();
+		read_options.set_layer_statistics(layer_stats);
 		if(no_cipher_given)
 			// since archive format 9 crypto algo used
 			// is stored in the archive, it will be used
@@ -1075,6 +1121,7 @@ static S_I little_main(shared_ptr<user_interaction> & dialog, S_I argc, char * c
 						  no_cipher_given,
 						  recipients);
 		read_options.clear();
+		read_options.set_layer_statistics(layer_stats);
 		if(no_cipher_given)
 			// since archive format 9 crypto algo used
 			// is stored in the archive, it will be used
@@ -1157,6 +1204,7 @@ static S_I little_main(shared_ptr<user_interaction> & dialog, S_I argc, char * c
 						  no_cipher_given,
 						  recipients);
 		read_options.clear();
+		read_options.set_layer_statistics(layer_stats);
 		if(no_cipher_given)
 			// since archive format 9 crypto algo used
 			// is stored in the archive, it will be used
@@ -1235,6 +1283,11 @@ static S_I little_main(shared_ptr<user_interaction> & dialog, S_I argc, char * c
 	    throw;
 	}
 
+	    // archive objects have been destroyed at this point, which
+	    // had the threads of their layers report their activity
+	if(layer_stats)
+	    layer_stats->listing(*dialog);
+
 	if(param.info_details)
 	    dialog->message(gettext("Final memory cleanup..."));
 
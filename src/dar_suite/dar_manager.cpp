@@ -75,6 +75,7 @@ using namespace libdar;
 #define MISSING_ARG "Missing argument to -%c"
 #define INVALID_ARG "Invalid argument given to -%c (requires integer)"
 #define OPT_STRING "C:B:A:lD:b:p:od:ru:f:shVm:vQjw:ie:c@:N;:ka:9:z:xJ:K:L:"
+#define DEFAULT_READ_AHEAD 2 // number of archives opened in advance when restoring in-process
 
 enum operation {
     none_op,
@@ -119,6 +120,9 @@ static bool command_line(shell_interaction & dialog,
 			 string & arch_crypto_params,
 			 string & base_crypto_params,
 			 secu_string & password,
+			 bool & legacy_format,
+			 bool & in_process,
+			 U_I & read_ahead,
 			 bool recursive); // true if called from op_batch
 
 static void show_usage(shell_interaction & dialog, const char *command);
@@ -132,7 +136,8 @@ static void op_create(shared_ptr<user_interaction> & dialog,
 		      compression algozip,
 		      U_I compr_level,
 		      const string & base_crypto_params,
-		      bool info_details);
+		      bool info_details,
+		      bool legacy_format);
 static void op_add(shared_ptr<user_interaction> & dialog,
 		   database *dat,
 		   const string &arg,
@@ -154,7 +159,9 @@ static void op_restore(shared_ptr<user_interaction> & dialog,
 		       bool info_details,
 		       bool early_release,
 		       bool ignore_dar_options_in_base,
-		       bool even_when_removed);
+		       bool even_when_removed,
+		       bool in_process,
+		       U_I read_ahead);
 static void op_used(shell_interaction & dialog, const database *dat, S_I num, bool info_details);
 static void op_files(shell_interaction & dialog,
 		     const database *dat,
@@ -183,7 +190,8 @@ static void write_base(shared_ptr<user_interaction> & dialog,
 		       bool overwrite,
 		       bool change_compression,
 		       compression new_compression,
-		       U_I compression_level);
+		       U_I compression_level,
+		       bool legacy_format);
 static vector<string> read_vector(shared_ptr<user_interaction> & dialog);
 static void finalize(shared_ptr<user_interaction> & dialog,
 		     operation op,
@@ -192,7 +200,8 @@ static void finalize(shared_ptr<user_interaction> & dialog,
 		     bool info_details,
 		     bool change_compression,
 		     compression new_compression,
-		     U_I compression_level);
+		     U_I compression_level,
+		     bool legacy_format);
 static void action(shared_ptr<user_interaction> & dialog,
 		   operation op,
 		   database *dat,
@@ -208,7 +217,9 @@ static void action(shared_ptr<user_interaction> & dialog,
 		   bool even_when_removed,
 		   bool detailed_dates,
 		   const string & arch_crypto_params,
-		   const string & base_crypto_params);
+		   const string & base_crypto_params,
+		   bool in_process,
+		   U_I read_ahead);
 static void signed_int_to_archive_num(S_I input, archive_num &num, bool & positive);
 static void split_arch_crypto_params(shared_ptr<user_interaction> & dialog, ///< user interaction
 				     const string & arch_crypto_params, ///< input string to be split
@@ -260,6 +271,9 @@ S_I little_main(shared_ptr<user_interaction> & dialog, S_I argc, char * const ar
     string arch_crypto_params;
     string base_crypto_params;
     secu_string password;
+    bool legacy_format;
+    bool in_process;
+    U_I read_ahead;
     shell_interaction *shelli = dynamic_cast<shell_interaction *>(dialog.get());
 
     if(!dialog)
@@ -290,6 +304,9 @@ S_I little_main(shared_ptr<user_interaction> & dialog, S_I argc, char * const ar
 		     arch_crypto_params,
 		     base_crypto_params,
 		     password,
+		     legacy_format,
+		     in_process,
+		     read_ahead,
 		     false))
 	return EXIT_SYNTAX;
 
@@ -302,10 +319,6 @@ S_I little_main(shared_ptr<user_interaction> & dialog, S_I argc, char * const ar
 	break;
     case add:
     case del:
-    case restore:
-    case used:
-    case files:
-    case stats:
     case moving:
     case interactive:
     case check:
@@ -313,6 +326,15 @@ S_I little_main(shared_ptr<user_interaction> & dialog, S_I argc, char * const ar
     case basecrypto:
 	partial_read = false;
 	break;
+    case restore:
+    case used:
+    case files:
+    case stats:
+	    // with the streamed database format, libdar only loads
+	    // in memory the part of the file tree the query needs,
+	    // older database formats are still completely loaded
+	partial_read_only = true;
+	break;
     case listing:
 	partial_read_only = true;
 	if(change_compression)
@@ -323,7 +345,7 @@ S_I little_main(shared_ptr<user_interaction> & dialog, S_I argc, char * const ar
     case options:
     case dar:
     case archcrypto:
-	partial_read = true;
+	partial_read = !legacy_format; // changing the format requires the whole database
 	if(change_compression)
 	    throw Erange(gettext("Cannot change compression when the requested operation only modifies the database header"));
 	break;
@@ -337,7 +359,8 @@ S_I little_main(shared_ptr<user_interaction> & dialog, S_I argc, char * const ar
 		  algozip,
 		  compression_level,
 		  base_crypto_params,
-		  info_details);
+		  info_details,
+		  legacy_format);
     else
     {
 	if(info_details)
@@ -356,13 +379,15 @@ S_I little_main(shared_ptr<user_interaction> & dialog, S_I argc, char * const ar
 		       info_details, true, ignore_dat_options, even_when_removed,
 		       detailed_dates,
 		       arch_crypto_params,
-		       base_crypto_params);
-		finalize(dialog, op, dat, base, info_details, change_compression, algozip, compression_level);
+		       base_crypto_params,
+		       in_process,
+		       read_ahead);
+		finalize(dialog, op, dat, base, info_details, change_compression, algozip, compression_level, legacy_format);
 	    }
 	    catch(Edata & e)
 	    {
 		dialog->message(string(gettext("Error met while processing operation: ")) + e.get_message());
-		finalize(dialog, op, dat, base, info_details, change_compression, algozip, compression_level);
+		finalize(dialog, op, dat, base, info_details, change_compression, algozip, compression_level, legacy_format);
 		throw;
 	    }
 	}
@@ -399,6 +424,9 @@ static bool command_line(shell_interaction & dialog,
 			 string & arch_crypto_params,
 			 string & base_crypto_params,
 			 secu_string & password,
+			 bool & legacy_format,
+			 bool & in_process,
+			 U_I & read_ahead,
 			 bool recursive)
 {
     S_I lu, min;
@@ -421,6 +449,9 @@ static bool command_line(shell_interaction & dialog,
     change_compression = false;
     detailed_dates = false;
     password.clear();
+    legacy_format = false;
+    in_process = false;
+    read_ahead = DEFAULT_READ_AHEAD;
     string extra = "";
 
     try
@@ -617,6 +648,19 @@ static bool command_line(shell_interaction & dialog,
 			throw Erange(tools_printf(gettext(MISSING_ARG), char(lu)));
 		    if(strcasecmp("i", optarg) == 0 || strcasecmp("ignore-order", optarg) == 0)
 			check_order = false;
+		    else if(strcasecmp("l", optarg) == 0 || strcasecmp("legacy-format", optarg) == 0)
+			legacy_format = true;
+		    else if(strcasecmp("p", optarg) == 0 || strcasecmp("in-process", optarg) == 0)
+			in_process = true;
+		    else if(strncasecmp("p:", optarg, 2) == 0 || strncasecmp("in-process:", optarg, 11) == 0)
+		    {
+			S_I tmp = line_tools_str2signed_int(strchr(optarg, ':') + 1);
+
+			if(tmp < 0)
+			    throw Erange(tools_printf(gettext("Negative number of archives given to -ap option: %s"), optarg));
+			in_process = true;
+			read_ahead = tmp;
+		    }
 		    else
 			throw Erange(tools_printf(gettext(INVALID_ARG), char(lu)));
 		    break;
@@ -842,7 +886,8 @@ static void op_create(shared_ptr<user_interaction> & dialog,
 		      compression algozip,
 		      U_I compr_level,
 		      const string & base_crypto_params,
-		      bool info_details)
+		      bool info_details,
+		      bool legacy_format)
 {
     database dat(dialog); // created empty;
 
@@ -855,7 +900,7 @@ static void op_create(shared_ptr<user_interaction> & dialog,
         dialog->message(gettext("Creating file..."));
         dialog->message(gettext("Formatting file as an empty database..."));
     }
-    write_base(dialog, base, &dat, false, true, algozip, compr_level);
+    write_base(dialog, base, &dat, false, true, algozip, compr_level, legacy_format);
     if(info_details)
         dialog->message(gettext("Database has been successfully created empty."));
 }
@@ -1031,7 +1076,7 @@ static void op_dar(shared_ptr<user_interaction> & dialog, database *dat, const s
     thr.check_self_cancellation();
 }
 
-static void op_restore(shared_ptr<user_interaction> & dialog, database *dat, const vector<string> & rest, const infinint & date, const string & options_for_dar, bool info_details, bool early_release, bool ignore_dar_options_in_base, bool even_when_removed)
+static void op_restore(shared_ptr<user_interaction> & dialog, database *dat, const vector<string> & rest, const infinint & date, const string & options_for_dar, bool info_details, bool early_release, bool ignore_dar_options_in_base, bool even_when_removed, bool in_process, U_I read_ahead)
 {
     thread_cancellation thr;
     vector<string> options;
@@ -1050,7 +1095,35 @@ static void op_restore(shared_ptr<user_interaction> & dialog, database *dat, con
     dat_opt.set_extra_options_for_dar(options);
     dat_opt.set_ignore_dar_options_in_database(ignore_dar_options_in_base);
     dat_opt.set_even_when_removed(even_when_removed);
-    dat->restore(rest, dat_opt);
+    if(in_process)
+    {
+	archive_options_read read_opt;
+	archive_options_extract extract_opt;
+	path fs_root = tools_getcwd();
+
+	    // dar is not called, the options for dar
+	    // stored in the database or given with -e
+	    // cannot be used. Files are restored under
+	    // the current directory like dar does by default
+
+	if(!options.empty())
+	    dialog->message(gettext("Options for dar given with -e are ignored when restoring in-process"));
+
+	if(!rest.empty())
+	{
+	    ou_mask wanted;
+
+	    for(vector<string>::const_iterator it = rest.begin(); it != rest.end(); ++it)
+		wanted.add_mask(simple_path_mask(fs_root + path(*it), true));
+	    extract_opt.set_subtree(wanted);
+	}
+
+	extract_opt.set_info_details(info_details);
+	dat_opt.set_read_ahead(read_ahead);
+	dat->restore(read_opt, fs_root, extract_opt, dat_opt, nullptr);
+    }
+    else
+	dat->restore(rest, dat_opt);
 }
 
 static void op_used(shell_interaction & dialog, const database *dat, S_I num, bool info_details)
@@ -1278,12 +1351,14 @@ static void write_base(shared_ptr<user_interaction> & dialog,
 		       bool overwrite,
 		       bool change_compression,
 		       compression algozip,
-		       U_I compression_level)
+		       U_I compression_level,
+		       bool legacy_format)
 {
     thread_cancellation thr;
     database_dump_options dat_opt;
 
     dat_opt.set_overwrite(overwrite);
+    dat_opt.set_legacy_format(legacy_format);
     if(change_compression)
     {
 	base->set_compression(algozip);
@@ -1406,13 +1481,13 @@ static void op_interactive(shared_ptr<user_interaction> & dialog, database *dat,
 		break;
 	    case 'w':
 		dialog->message(gettext("Compressing and writing back database to file..."));
-		write_base(dialog, base, dat, true, change_compression, zipname, compr_level);
+		write_base(dialog, base, dat, true, change_compression, zipname, compr_level, false);
 		saved = true;
 		break;
 	    case 'a':
 		input = dialog->get_string(gettext("New database name: "), true);
 		dialog->message(gettext("Compressing and writing back database to file..."));
-		write_base(dialog, input, dat, false, change_compression, zipname, compr_level);
+		write_base(dialog, input, dat, false, change_compression, zipname, compr_level, false);
 		base = input;
 		saved = true;
 		break;
@@ -1617,6 +1692,9 @@ static void op_batch(shared_ptr<user_interaction> & dialog, database *dat, const
     string arch_crypto_params;
     string base_crypto_params;
     secu_string unused_pass_here;
+    bool legacy_format; // not used here neither but at the level of the function that called op_batch
+    bool in_process;
+    U_I read_ahead;
     shell_interaction *shelli = dynamic_cast<shell_interaction *>(dialog.get());
 
     if(shelli == nullptr)
@@ -1681,6 +1759,9 @@ static void op_batch(shared_ptr<user_interaction> & dialog, database *dat, const
 			     arch_crypto_params,
 			     base_crypto_params,
 			     unused_pass_here,
+			     legacy_format,
+			     in_process,
+			     read_ahead,
 			     true))
 		throw Erange(tools_printf(gettext("Syntax error in batch file: %S"), &line));
 
@@ -1693,7 +1774,9 @@ static void op_batch(shared_ptr<user_interaction> & dialog, database *dat, const
 	    action(dialog, sub_op, dat, arg, num, rest, num2, date, faked_base, sub_info_details, false,
 		   ignore_dat_options, even_when_removed, detailed_dates,
 		   arch_crypto_params,
-		   base_crypto_params);
+		   base_crypto_params,
+		   in_process,
+		   read_ahead);
 	}
 	while(tmp == '\n');
     }
@@ -1881,7 +1964,8 @@ static void finalize(shared_ptr<user_interaction> & dialog,
 		     bool info_details,
 		     bool change_compression,
 		     compression new_compression,
-		     U_I compression_level)
+		     U_I compression_level,
+		     bool legacy_format)
 {
     switch(op)
     {
@@ -1911,7 +1995,8 @@ static void finalize(shared_ptr<user_interaction> & dialog,
 		   true, // overwriting
 		   change_compression,
 		   new_compression,
-		   compression_level);
+		   compression_level,
+		   legacy_format);
 	break;
     default:
 	throw SRC_BUG;
@@ -1933,7 +2018,9 @@ static void action(shared_ptr<user_interaction> & dialog,
 		   bool even_when_removed,
 		   bool detailed_dates,
 		   const string & arch_crypto_params,
-		   const string & base_crypto_params)
+		   const string & base_crypto_params,
+		   bool in_process,
+		   U_I read_ahead)
 {
     shell_interaction *shelli = dynamic_cast<shell_interaction *>(dialog.get());
 
@@ -1968,7 +2055,7 @@ static void action(shared_ptr<user_interaction> & dialog,
 	op_dar(dialog, dat, arg, info_details);
 	break;
     case restore:
-	op_restore(dialog, dat, rest, date, arg, info_details, early_release, ignore_database_options, even_when_removed);
+	op_restore(dialog, dat, rest, date, arg, info_details, early_release, ignore_database_options, even_when_removed, in_process, read_ahead);
 	break;
     case used:
 	op_used(*shelli, dat, num, info_details);
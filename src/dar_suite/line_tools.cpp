@@ -776,7 +776,19 @@ libdar::crypto_algo line_tools_crypto_string_to_crypto_algo(const string & val)
 			    if(val == "camellia" || val == "camellia256")
 				algo = crypto_algo::camellia256;
 			    else
-				throw Erange(string(gettext("unknown cryptographic algorithm: ")) + val);
+				if(val == "aes-xts" || val == "aes256-xts")
+				    algo = crypto_algo::aes256_xts;
+				else
+				    if(val == "twofish-xts" || val == "twofish256-xts")
+					algo = crypto_algo::twofish256_xts;
+				    else
+					if(val == "serpent-xts" || val == "serpent256-xts")
+					    algo = crypto_algo::serpent256_xts;
+					else
+					    if(val == "camellia-xts" || val == "camellia256-xts")
+						algo = crypto_algo::camellia256_xts;
+					    else
+						throw Erange(string(gettext("unknown cryptographic algorithm: ")) + val);
 
     return algo;
 }
@@ -1574,7 +1586,7 @@ void line_tools_check_min_digits(user_interaction & dialog, const path & loc, co
     string cur;
     inode_type tp;
 
-    etage contents(dialog, loc.display().c_str(), datetime(0), datetime(0), false, false);
+    etage contents(dialog, loc.display().c_str(), datetime(0), datetime(0), false, false, false);
 
     regular_mask slice = regular_mask(base + "\\.0+[1-9][0-9]*\\." + extension + "$", true);
 
@@ -2023,7 +2035,7 @@ static bool is_a_slice_available(user_interaction & ui, const string & base, con
 
 	try
 	{
-	    etage contents = etage(ui, chem->display().c_str(), datetime(0), datetime(0), false, false);  // we don't care the dates here so we set them to zero
+	    etage contents = etage(ui, chem->display().c_str(), datetime(0), datetime(0), false, false, false);  // we don't care the dates here so we set them to zero
 	    regular_mask slice = regular_mask(rest + "\\.[0-9]+\\."+ extension, true);
 
 	    while(!ret && contents.read(rest, tp))
@@ -357,6 +357,31 @@ namespace libdar
         return tmp;
     }
 
+    U_I archive::get_children_in_columns(const string & dir,
+					 list_columns & batch,
+					 U_I start,
+					 U_I max_entries) const
+    {
+	U_I tmp;
+
+        NLS_SWAP_IN;
+        try
+        {
+	    tmp = pimpl->get_children_in_columns(dir,
+						 batch,
+						 start,
+						 max_entries);
+        }
+        catch(...)
+        {
+            NLS_SWAP_OUT;
+            throw;
+        }
+        NLS_SWAP_OUT;
+
+        return tmp;
+    }
+
     bool archive::has_subdirectory(const string & dir) const
     {
 	bool tmp;
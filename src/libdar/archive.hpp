@@ -37,6 +37,7 @@
 #include "statistics.hpp"
 #include "archive_options.hpp"
 #include "list_entry.hpp"
+#include "list_columns.hpp"
 #include "crypto.hpp"
 #include "archive_summary.hpp"
 #include "archive_listing_callback.hpp"
@@ -312,6 +313,25 @@ namespace libdar
 	    /// mandatory
 	const std::vector<list_entry> get_children_in_table(const std::string & dir, bool fetch_ea = false) const;
 
+	    /// getting information about a batch of entries of the given directory (alternative to get_children_in_table)
+
+	    /// \param[in] dir relative path the directory to get information about, use empty string for root directory
+	    /// \param[out] batch is cleared then filled with the entries found
+	    /// \param[in] start index of the first children of dir to provide
+	    /// \param[in] max_entries maximum number of entries to provide, zero for no limit
+	    /// \return the number of entries provided, zero if start is at or beyond the last children
+	    /// \note the whole directory can be read by batches of N entries calling this method with
+	    /// start set to 0 then N, 2N,... until zero is returned.
+	    /// \note list_columns does not provide all the information available from list_entry but
+	    /// avoids the creation of an object per entry and the conversion of fields to strings, it is
+	    /// thus intended to programs that read large directories.
+	    /// \note before calling this method on this object, a single call to init_catalogue() is
+	    /// mandatory
+	U_I get_children_in_columns(const std::string & dir,
+				    list_columns & batch,
+				    U_I start = 0,
+				    U_I max_entries = 0) const;
+
 	    /// returns true if the pointed directory has one or more subdirectories
 	bool has_subdirectory(const std::string & dir) const;
 
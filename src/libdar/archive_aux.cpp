@@ -53,7 +53,7 @@ namespace libdar
 
 	/// this is the archive version format generated by the application
 	/// this is also the highest version of format that can be read
-    const archive_version archive_format_supported_version = archive_version(12,0);
+    const archive_version archive_format_supported_version = archive_version(12,1);
 
 
     string hash_algo_to_string(hash_algo algo)
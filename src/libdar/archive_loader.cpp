@@ -0,0 +1,304 @@
+/*********************************************************************/
+// dar - disk archive - a backup/restoration program
+// Copyright (C) 2002-2026 Denis Corbin
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// to contact the author, see the AUTHOR file
+/*********************************************************************/
+
+#include "../my_config.h"
+
+extern "C"
+{
+}
+
+#include "archive_loader.hpp"
+#include "erreurs.hpp"
+
+using namespace std;
+
+namespace libdar
+{
+
+	/////////////////////////////////////////////////////
+        //
+        // archive_loader_ui class implementation
+        //
+        //
+
+    archive_loader_ui::archive_loader_ui(const shared_ptr<user_interaction> & dialog):
+	real(dialog),
+	foreground(false)
+    {
+	if(!real)
+	    throw SRC_BUG;
+    }
+
+    void archive_loader_ui::set_foreground()
+    {
+	serial.reset();
+	foreground = true;
+	while(!recorded.empty())
+	{
+	    real->message(recorded.front());
+	    recorded.pop_front();
+	}
+    }
+
+    void archive_loader_ui::set_serialized(const shared_ptr<libthreadar::mutex> & lock)
+    {
+	if(!lock)
+	    throw SRC_BUG;
+
+	lock->lock();
+	try
+	{
+	    set_foreground();
+	}
+	catch(...)
+	{
+	    lock->unlock();
+	    throw;
+	}
+	lock->unlock();
+	serial = lock;
+    }
+
+    void archive_loader_ui::inherited_message(const string & message)
+    {
+	if(foreground)
+	{
+	    if(serial)
+		serial->lock();
+	    try
+	    {
+		real->message(message);
+	    }
+	    catch(...)
+	    {
+		if(serial)
+		    serial->unlock();
+		throw;
+	    }
+	    if(serial)
+		serial->unlock();
+	}
+	else
+	    recorded.push_back(message);
+    }
+
+    bool archive_loader_ui::inherited_pause(const string & message)
+    {
+	if(foreground)
+	{
+	    bool ret = true;
+
+	    if(serial)
+		serial->lock();
+	    try
+	    {
+		real->pause(message);
+	    }
+	    catch(Euser_abort & e)
+	    {
+		ret = false;
+	    }
+	    catch(...)
+	    {
+		if(serial)
+		    serial->unlock();
+		throw;
+	    }
+	    if(serial)
+		serial->unlock();
+
+	    return ret;
+	}
+	else
+	    return false;
+    }
+
+    string archive_loader_ui::inherited_get_string(const string & message, bool echo)
+    {
+	if(foreground)
+	{
+	    string ret;
+
+	    if(serial)
+		serial->lock();
+	    try
+	    {
+		ret = real->get_string(message, echo);
+	    }
+	    catch(...)
+	    {
+		if(serial)
+		    serial->unlock();
+		throw;
+	    }
+	    if(serial)
+		serial->unlock();
+
+	    return ret;
+	}
+	else
+	    throw Euser_abort(message);
+    }
+
+    secu_string archive_loader_ui::inherited_get_secu_string(const string & message, bool echo)
+    {
+	if(foreground)
+	{
+	    secu_string ret;
+
+	    if(serial)
+		serial->lock();
+	    try
+	    {
+		ret = real->get_secu_string(message, echo);
+	    }
+	    catch(...)
+	    {
+		if(serial)
+		    serial->unlock();
+		throw;
+	    }
+	    if(serial)
+		serial->unlock();
+
+	    return ret;
+	}
+	else
+	    throw Euser_abort(message);
+    }
+
+
+	/////////////////////////////////////////////////////
+        //
+        // archive_loader class implementation
+        //
+        //
+
+    archive_loader::archive_loader(const shared_ptr<user_interaction> & dialog,
+				   const path & chem,
+				   const string & basename,
+				   const string & extension,
+				   const archive_options_read & options):
+	x_chem(chem),
+	x_basename(basename),
+	x_extension(extension),
+	x_options(options),
+	done(false)
+    {
+	relay.reset(new (nothrow) archive_loader_ui(dialog));
+	if(!relay)
+	    throw Ememory();
+	run();
+    }
+
+    archive_loader::archive_loader(const shared_ptr<user_interaction> & dialog,
+				   const path & chem,
+				   const string & basename,
+				   const string & extension,
+				   const archive_options_read & options,
+				   const path & fs_root,
+				   const archive_options_extract & extract_options,
+				   const shared_ptr<libthreadar::mutex> & ui_lock):
+	x_chem(chem),
+	x_basename(basename),
+	x_extension(extension),
+	x_options(options),
+	x_ui_lock(ui_lock),
+	done(false)
+    {
+	if(!x_ui_lock)
+	    throw SRC_BUG;
+	relay.reset(new (nothrow) archive_loader_ui(dialog));
+	if(!relay)
+	    throw Ememory();
+	x_fs_root.reset(new (nothrow) path(fs_root));
+	if(!x_fs_root)
+	    throw Ememory();
+	x_extract.reset(new (nothrow) archive_options_extract(extract_options));
+	if(!x_extract)
+	    throw Ememory();
+	run();
+    }
+
+    archive_loader::~archive_loader()
+    {
+	try
+	{
+	    wait_for_thread();
+	}
+	catch(...)
+	{
+		// ignore all exceptions
+	}
+    }
+
+    unique_ptr<archive> archive_loader::release()
+    {
+	wait_for_thread();
+	if(loaded)
+	    relay->set_foreground();
+
+	return std::move(loaded);
+    }
+
+    void archive_loader::inherited_run()
+    {
+	try
+	{
+	    loaded.reset(new (nothrow) archive(relay,
+					       x_chem,
+					       x_basename,
+					       x_extension,
+					       x_options));
+	}
+	catch(...)
+	{
+	    loaded.reset();
+		// the caller will open the archive the usual way
+	}
+
+	if(x_extract && loaded)
+	{
+		// failures are reported by release()
+	    relay->set_serialized(x_ui_lock);
+	    (void)loaded->op_extract(*x_fs_root, *x_extract, nullptr);
+	    done = true;
+	}
+    }
+
+    void archive_loader::wait_for_thread()
+    {
+	try
+	{
+	    join();
+	}
+	catch(...)
+	{
+	    bool extracting = x_extract && loaded;
+
+	    loaded.reset();
+	    if(extracting)
+		throw;
+		// else the caller will open the archive the usual way
+	}
+    }
+
+} // end of namespace
@@ -0,0 +1,164 @@
+/*********************************************************************/
+// dar - disk archive - a backup/restoration program
+// Copyright (C) 2002-2026 Denis Corbin
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// to contact the author, see the AUTHOR file
+/*********************************************************************/
+
+    /// \file archive_loader.hpp
+    /// \brief opens an archive (reading its catalogue) from a separated thread
+    /// \ingroup Private
+    ///
+    /// The archive object keeps the user_interaction it has been created with,
+    /// for it can be used from the caller thread once loaded, the archive is given
+    /// a relay (class archive_loader_ui) which, while the thread runs, records
+    /// messages and answers negatively to any question. Once the archive is
+    /// handed to the caller, the recorded messages are displayed and the relay
+    /// forwards any further interaction to the user_interaction of the caller.
+    ///
+    /// The thread may also extract the archive once opened, for database::restore()
+    /// to extract several archives concurrently. The relay then forwards messages
+    /// and questions to the user_interaction of the caller, one thread at a time.
+
+#ifndef ARCHIVE_LOADER_HPP
+#define ARCHIVE_LOADER_HPP
+
+#include "../my_config.h"
+
+#include <string>
+#include <deque>
+#include <memory>
+#include "user_interaction.hpp"
+#include "archive.hpp"
+#include "archive_options.hpp"
+#include "path.hpp"
+
+#include <libthreadar/libthreadar.hpp>
+
+namespace libdar
+{
+
+	/// \addtogroup Private
+	/// @{
+
+	/// user_interaction given to an archive opened from a separated thread
+
+    class archive_loader_ui: public user_interaction
+    {
+    public:
+	archive_loader_ui(const std::shared_ptr<user_interaction> & dialog);
+	archive_loader_ui(const archive_loader_ui & ref) = delete;
+	archive_loader_ui(archive_loader_ui && ref) noexcept = delete;
+	archive_loader_ui & operator = (const archive_loader_ui & ref) = delete;
+	archive_loader_ui & operator = (archive_loader_ui && ref) noexcept = delete;
+	~archive_loader_ui() = default;
+
+	    /// displays the recorded messages and forwards to the caller's user_interaction from now on
+	void set_foreground();
+
+	    /// forwards to the caller's user_interaction from now on, one thread at a time
+
+	    /// \param[in] lock shared by the relays used concurrently, the caller thread
+	    /// must not use its user_interaction while these relays may do so
+	void set_serialized(const std::shared_ptr<libthreadar::mutex> & lock);
+
+    protected:
+	virtual void inherited_message(const std::string & message) override;
+	virtual bool inherited_pause(const std::string & message) override;
+	virtual std::string inherited_get_string(const std::string & message, bool echo) override;
+	virtual secu_string inherited_get_secu_string(const std::string & message, bool echo) override;
+
+    private:
+	std::shared_ptr<user_interaction> real;  ///< the user_interaction of the caller
+	bool foreground;                         ///< whether the relay forwards to real
+	std::deque<std::string> recorded;        ///< messages received while in background
+	std::shared_ptr<libthreadar::mutex> serial; ///< if set, taken while using real
+    };
+
+
+	/// opens an archive from a separated thread
+
+	/// if the archive cannot be opened without user interaction or for any
+	/// other reason, the failure is silently recorded and the caller is expected
+	/// to fall back to the usual way of opening the archive, which will report
+	/// the problem (or ask the user) from the caller thread
+    class archive_loader: public libthreadar::thread
+    {
+    public:
+	    /// constructor, starts the thread
+
+	    /// \note the arguments are those of the archive class constructor used to read an archive
+	archive_loader(const std::shared_ptr<user_interaction> & dialog,
+		       const path & chem,
+		       const std::string & basename,
+		       const std::string & extension,
+		       const archive_options_read & options);
+
+	    /// constructor, starts the thread which also extracts the archive once opened
+
+	    /// \param[in] dialog, chem, basename, extension, options are those of the archive class constructor used to read an archive
+	    /// \param[in] fs_root, extract_options are those of archive::op_extract()
+	    /// \param[in] ui_lock shared by the archive_loader objects extracting concurrently
+	archive_loader(const std::shared_ptr<user_interaction> & dialog,
+		       const path & chem,
+		       const std::string & basename,
+		       const std::string & extension,
+		       const archive_options_read & options,
+		       const path & fs_root,
+		       const archive_options_extract & extract_options,
+		       const std::shared_ptr<libthreadar::mutex> & ui_lock);
+	archive_loader(const archive_loader & ref) = delete;
+	archive_loader(archive_loader && ref) noexcept = delete;
+	archive_loader & operator = (const archive_loader & ref) = delete;
+	archive_loader & operator = (archive_loader && ref) noexcept = delete;
+
+	    /// destructor waits for the thread to end and deletes the archive if not released
+	~archive_loader();
+
+	    /// wait for the archive to be opened and get the resulting object
+
+	    /// \return the archive object which becomes owned by the caller, or
+	    /// nullptr if the archive could not be opened from the thread
+	    /// \note when the thread also extracts the archive, an exception met by the extraction is rethrown here
+	std::unique_ptr<archive> release();
+
+	    /// whether the thread has extracted the archive, to be called once release() has returned
+	bool extracted() const { return done; };
+
+    protected:
+	virtual void inherited_run() override;
+
+    private:
+	std::shared_ptr<archive_loader_ui> relay;
+	path x_chem;
+	std::string x_basename;
+	std::string x_extension;
+	archive_options_read x_options;
+	std::unique_ptr<archive> loaded;  ///< set by the thread upon success
+	std::unique_ptr<path> x_fs_root;  ///< set if the thread has to extract the archive
+	std::unique_ptr<archive_options_extract> x_extract;
+	std::shared_ptr<libthreadar::mutex> x_ui_lock;
+	bool done;                        ///< whether the archive has been extracted by the thread
+
+	void wait_for_thread();
+    };
+
+	/// @}
+
+} // end of namespace
+
+#endif
@@ -26,6 +26,7 @@ extern "C"
 } // end extern "C"
 
 #include <vector>
+#include <algorithm>
 
 #include "archive_options.hpp"
 #include "entrepot_local.hpp"
@@ -131,10 +132,12 @@ namespace libdar
 	x_ignore_signature_check_failure = false;
 	x_multi_threaded_crypto = 2;
 	x_multi_threaded_compress = 1;
+	x_layer_stats.reset();
 	x_header_only = false;
 	x_silent = false;
 	x_early_memory_release = false;
 	x_force_first_slice = false;
+	x_streaming_catalogue = false;
 
 	    //
 	external_cat = false;
@@ -219,10 +222,12 @@ namespace libdar
 	x_ignore_signature_check_failure = ref.x_ignore_signature_check_failure;
 	x_multi_threaded_crypto = ref.x_multi_threaded_crypto;
 	x_multi_threaded_compress = ref.x_multi_threaded_compress;
+	x_layer_stats = ref.x_layer_stats;
 	x_header_only = ref.x_header_only;
 	x_silent = ref.x_silent;
 	x_early_memory_release = ref.x_early_memory_release;
 	x_force_first_slice = ref.x_force_first_slice;
+	x_streaming_catalogue = ref.x_streaming_catalogue;
 
 	    //
 
@@ -256,10 +261,12 @@ namespace libdar
 	x_ignore_signature_check_failure = std::move(ref.x_ignore_signature_check_failure);
 	x_multi_threaded_crypto = std::move(ref.x_multi_threaded_crypto);
 	x_multi_threaded_compress = std::move(ref.x_multi_threaded_compress);
+	x_layer_stats = std::move(ref.x_layer_stats);
 	x_header_only = std::move(ref.x_header_only);
 	x_silent = std::move(ref.x_silent);
 	x_early_memory_release = std::move(ref.x_early_memory_release);
 	x_force_first_slice = std::move(ref.x_force_first_slice);
+	x_streaming_catalogue = std::move(ref.x_streaming_catalogue);
 
 	    //
 
@@ -340,6 +347,7 @@ namespace libdar
 	    x_file_size = 0;
 	    x_first_file_size = 0;
 	    x_execute = "";
+	    x_async_execute = 0;
 	    x_crypto = crypto_algo::none;
 	    x_pass.clear();
 	    x_crypto_size = default_crypto_size;
@@ -373,7 +381,7 @@ namespace libdar
 	    x_sparse_file_min_size = 15;  // min value to activate the feature (0 means no detection of sparse_file)
 	    x_security_check = true;
 	    x_user_comment = default_user_comment;
-	    x_hash = hash_algo::none;
+	    x_hash.clear();
 	    x_slice_min_digits = 0;
 	    x_backup_hook_file_execute = "";
 	    x_ignore_unknown = false;
@@ -383,6 +391,7 @@ namespace libdar
 	    x_scope = all_fsa_families();
 	    x_multi_threaded_crypto = 2;
 	    x_multi_threaded_compress = 1;
+	    x_layer_stats.reset();
 	    x_delta_diff = true;
 	    x_delta_signature = rsync_sig_magic::none;
 	    has_delta_mask_been_set = false;
@@ -402,6 +411,7 @@ namespace libdar
 	    }
 	    x_sig_block_len.reset();
 	    x_never_resave_uncompressed = false;
+	    x_spill_directory = "";
 	}
 	catch(...)
 	{
@@ -555,10 +565,17 @@ namespace libdar
     }
 
     void archive_options_create::set_hash_algo(hash_algo hash)
+    {
+	x_hash.clear();
+	add_hash_algo(hash);
+    }
+
+    void archive_options_create::add_hash_algo(hash_algo hash)
     {
 	if(hash == hash_algo::argon2)
 	    throw Erange(gettext("argon2 hash algorithm is only used for key derivation function, it is not adapted to file or slice hashing"));
-	x_hash = hash;
+	if(hash != hash_algo::none && find(x_hash.begin(), x_hash.end(), hash) == x_hash.end())
+	    x_hash.push_back(hash);
     }
 
     void archive_options_create::nullifyptr() noexcept
@@ -620,6 +637,7 @@ namespace libdar
 	x_file_size = ref.x_file_size;
 	x_first_file_size = ref.x_first_file_size;
 	x_execute = ref.x_execute;
+	x_async_execute = ref.x_async_execute;
 	x_crypto = ref.x_crypto;
 	x_pass = ref.x_pass;
 	x_crypto_size = ref.x_crypto_size;
@@ -660,6 +678,7 @@ namespace libdar
 	x_scope = ref.x_scope;
 	x_multi_threaded_crypto = ref.x_multi_threaded_crypto;
 	x_multi_threaded_compress = ref.x_multi_threaded_compress;
+	x_layer_stats = ref.x_layer_stats;
 	x_delta_diff = ref.x_delta_diff;
 	x_delta_signature = ref.x_delta_signature;
 	x_delta_mask = ref.x_delta_mask->clone();
@@ -672,6 +691,7 @@ namespace libdar
 	x_kdf_hash = ref.x_kdf_hash;
 	x_sig_block_len = ref.x_sig_block_len;
 	x_never_resave_uncompressed = ref.x_never_resave_uncompressed;
+	x_spill_directory = ref.x_spill_directory;
     }
 
     void archive_options_create::move_from(archive_options_create && ref) noexcept
@@ -699,6 +719,7 @@ namespace libdar
 	x_file_size = std::move(ref.x_file_size);
 	x_first_file_size = std::move(ref.x_first_file_size);
 	x_execute = std::move(ref.x_execute);
+	x_async_execute = std::move(ref.x_async_execute);
 	x_crypto = std::move(ref.x_crypto);
 	x_pass = std::move(ref.x_pass);
 	x_crypto_size = std::move(ref.x_crypto_size);
@@ -734,6 +755,7 @@ namespace libdar
 	x_scope = std::move(ref.x_scope);
 	x_multi_threaded_crypto = std::move(ref.x_multi_threaded_crypto);
 	x_multi_threaded_compress = std::move(ref.x_multi_threaded_compress);
+	x_layer_stats = std::move(ref.x_layer_stats);
 	x_delta_diff = std::move(ref.x_delta_diff);
 	x_delta_signature = std::move(ref.x_delta_signature);
 	x_delta_mask = std::move(ref.x_delta_mask->clone());
@@ -746,6 +768,7 @@ namespace libdar
 	x_kdf_hash = std::move(ref.x_kdf_hash);
 	x_sig_block_len = std::move(ref.x_sig_block_len);
 	x_never_resave_uncompressed = std::move(ref.x_never_resave_uncompressed);
+	x_spill_directory = std::move(ref.x_spill_directory);
     }
 
 	/////////////////////////////////////////////////////////
@@ -797,6 +820,7 @@ namespace libdar
 	    x_file_size = 0;
 	    x_first_file_size = 0;
 	    x_execute = "";
+	    x_async_execute = 0;
 	    x_crypto = crypto_algo::none;
 	    x_pass.clear();
 	    x_crypto_size = default_crypto_size;
@@ -807,7 +831,7 @@ namespace libdar
 	    x_slice_user_ownership = "";
 	    x_slice_group_ownership = "";
 	    x_user_comment = default_user_comment;
-	    x_hash = hash_algo::none;
+	    x_hash.clear();
 	    x_slice_min_digits = 0;
 	    x_sequential_marks = true;
 	    x_entrepot = shared_ptr<entrepot>(new (nothrow) entrepot_local("", "", false)); // never using furtive_mode to read slices
@@ -865,10 +889,17 @@ namespace libdar
     }
 
     void archive_options_isolate::set_hash_algo(hash_algo hash)
+    {
+	x_hash.clear();
+	add_hash_algo(hash);
+    }
+
+    void archive_options_isolate::add_hash_algo(hash_algo hash)
     {
 	if(hash == hash_algo::argon2)
 	    throw Erange(gettext("argon2 hash algorithm is only used for key derivation function, it is not adapted to file or slice hashing"));
-	x_hash = hash;
+	if(hash != hash_algo::none && find(x_hash.begin(), x_hash.end(), hash) == x_hash.end())
+	    x_hash.push_back(hash);
     }
 
 
@@ -889,6 +920,7 @@ namespace libdar
 	x_file_size = ref.x_file_size;
 	x_first_file_size = ref.x_first_file_size;
 	x_execute = ref.x_execute;
+	x_async_execute = ref.x_async_execute;
 	x_crypto = ref.x_crypto;
 	x_pass = ref.x_pass;
 	x_crypto_size = ref.x_crypto_size;
@@ -934,6 +966,7 @@ namespace libdar
 	x_file_size = std::move(ref.x_file_size);
 	x_first_file_size = std::move(ref.x_first_file_size);
 	x_execute = std::move(ref.x_execute);
+	x_async_execute = std::move(ref.x_async_execute);
 	x_crypto = std::move(ref.x_crypto);
 	x_pass = std::move(ref.x_pass);
 	x_crypto_size = std::move(ref.x_crypto_size);
@@ -998,6 +1031,7 @@ namespace libdar
 	    x_file_size = 0;
 	    x_first_file_size = 0;
 	    x_execute = "";
+	    x_async_execute = 0;
 	    x_crypto = crypto_algo::none;
 	    x_pass.clear();
 	    x_crypto_size = default_crypto_size;
@@ -1013,7 +1047,7 @@ namespace libdar
 	    x_sequential_marks = true;
 	    x_sparse_file_min_size = 0; // disabled by default
 	    x_user_comment = default_user_comment;
-	    x_hash = hash_algo::none;
+	    x_hash.clear();
 	    x_slice_min_digits = 0;
 	    x_entrepot = shared_ptr<entrepot>(new (nothrow) entrepot_local("", "", false)); // never using furtive_mode to read slices
 	    if(x_entrepot == nullptr)
@@ -1161,10 +1195,17 @@ namespace libdar
     }
 
     void archive_options_merge::set_hash_algo(hash_algo hash)
+    {
+	x_hash.clear();
+	add_hash_algo(hash);
+    }
+
+    void archive_options_merge::add_hash_algo(hash_algo hash)
     {
 	if(hash == hash_algo::argon2)
 	    throw Erange(gettext("argon2 hash algorithm is only used for key derivation function, it is not adapted to file or slice hashing"));
-	x_hash = hash;
+	if(hash != hash_algo::none && find(x_hash.begin(), x_hash.end(), hash) == x_hash.end())
+	    x_hash.push_back(hash);
     }
 
 
@@ -1231,6 +1272,7 @@ namespace libdar
 	    x_file_size = ref.x_file_size;
 	    x_first_file_size = ref.x_first_file_size;
 	    x_execute = ref.x_execute;
+	    x_async_execute = ref.x_async_execute;
 	    x_crypto = ref.x_crypto;
 	    x_pass = ref.x_pass;
 	    x_crypto_size = ref.x_crypto_size;
@@ -1291,6 +1333,7 @@ namespace libdar
 	x_file_size = std::move(ref.x_file_size);
 	x_first_file_size = std::move(ref.x_first_file_size);
 	x_execute = std::move(ref.x_execute);
+	x_async_execute = std::move(ref.x_async_execute);
 	x_crypto = std::move(ref.x_crypto);
 	x_pass = std::move(ref.x_pass);
 	x_crypto_size = std::move(ref.x_crypto_size);
@@ -1357,6 +1400,8 @@ namespace libdar
 	    x_scope = all_fsa_families();
 	    x_ignore_unix_sockets = false;
 	    x_in_place = false;
+	    x_restore_writers = 1;
+	    x_dir_journal.reset();
 	}
 	catch(...)
 	{
@@ -1490,6 +1535,8 @@ namespace libdar
 	    x_scope = ref.x_scope;
 	    x_ignore_unix_sockets = ref.x_ignore_unix_sockets;
 	    x_in_place = ref.x_in_place;
+	    x_restore_writers = ref.x_restore_writers;
+	    x_dir_journal = ref.x_dir_journal;
 	}
 	catch(...)
 	{
@@ -1521,6 +1568,8 @@ namespace libdar
 	x_scope = std::move(ref.x_scope);
 	x_ignore_unix_sockets = std::move(ref.x_ignore_unix_sockets);
 	x_in_place = std::move(ref.x_in_place);
+	x_restore_writers = std::move(ref.x_restore_writers);
+	x_dir_journal = std::move(ref.x_dir_journal);
     }
 
 	/////////////////////////////////////////////////////////
@@ -2071,6 +2120,7 @@ namespace libdar
             x_file_size = 0;
             x_first_file_size = 0;
             x_execute = "";
+            x_async_execute = 0;
             x_crypto = crypto_algo::none;
             x_pass.clear();
             x_crypto_size = default_crypto_size;
@@ -2081,7 +2131,7 @@ namespace libdar
             x_slice_user_ownership = "";
             x_slice_group_ownership = "";
             x_user_comment = default_user_comment;
-            x_hash = hash_algo::none;
+            x_hash.clear();
             x_slice_min_digits = 0;
             x_entrepot = shared_ptr<entrepot>(new (nothrow) entrepot_local( "", "", false)); // never using furtive_mode to read slices
             if(x_entrepot == nullptr)
@@ -2108,10 +2158,17 @@ namespace libdar
     }
 
     void archive_options_repair::set_hash_algo(hash_algo hash)
+    {
+	x_hash.clear();
+	add_hash_algo(hash);
+    }
+
+    void archive_options_repair::add_hash_algo(hash_algo hash)
     {
 	if(hash == hash_algo::argon2)
 	    throw Erange(gettext("argon2 hash algorithm is only used for key derivation function, it is not adapted to file or slice hashing"));
-	x_hash = hash;
+	if(hash != hash_algo::none && find(x_hash.begin(), x_hash.end(), hash) == x_hash.end())
+	    x_hash.push_back(hash);
     }
 
     void archive_options_repair::copy_from(const archive_options_repair & ref)
@@ -2127,6 +2184,7 @@ namespace libdar
         x_file_size = ref.x_file_size;
         x_first_file_size = ref.x_first_file_size;
         x_execute = ref.x_execute;
+        x_async_execute = ref.x_async_execute;
         x_crypto = ref.x_crypto;
         x_pass = ref.x_pass;
         x_crypto_size = ref.x_crypto_size;
@@ -2160,6 +2218,7 @@ namespace libdar
         x_file_size = std::move(ref.x_file_size);
         x_first_file_size = std::move(ref.x_first_file_size);
         x_execute = std::move(ref.x_execute);
+        x_async_execute = std::move(ref.x_async_execute);
         x_crypto = std::move(ref.x_crypto);
         x_pass = std::move(ref.x_pass);
         x_crypto_size = std::move(ref.x_crypto_size);
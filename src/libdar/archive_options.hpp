@@ -40,9 +40,11 @@
 #include "compression.hpp"
 #include "delta_sig_block_size.hpp"
 #include "filesystem_ids.hpp"
+#include "layer_statistics.hpp"
 
 #include <string>
 #include <vector>
+#include <deque>
 #include <set>
 #include <memory>
 
@@ -53,6 +55,7 @@ namespace libdar
 
 
     class archive; // needed to be able to use pointer on archive object.
+    class restore_dir_journal; // used by database::restore() only
 
 
 	/////////////////////////////////////////////////////////
@@ -172,6 +175,11 @@ namespace libdar
 	    /// how much thread libdar will use for compression (need libthreadar too and compression_block_size > 0)
 	void set_multi_threaded_compress(U_I num) { x_multi_threaded_compress = num; };
 
+	    /// record the activity of each layer of the archive (bytes, calls, time) and of their threads into the given object
+
+	    /// \note nullptr (the default) disables recording
+	void set_layer_statistics(const std::shared_ptr<layer_statistics> & stats) { x_layer_stats = stats; };
+
 	    /// whether we only read the archive header and exit
 	void set_header_only(bool val) { x_header_only = val; };
 
@@ -184,6 +192,16 @@ namespace libdar
 	    /// whether to ask the first slice in place of the last slice when reading an archive with the help of an isolated catalogue
 	void set_force_first_slice(bool val) { x_force_first_slice = val; };
 
+	    /// whether to only load the skeleton of the catalogue, the rest being read on demand when the archive is used as reference for a differential backup
+
+	    /// \note the archive cannot be used for any other purpose than being the reference of an archive creation
+	    /// and the entries of each of its directories must be sorted by name, which is checked while the catalogue is read:
+	    /// the archive creation fails if this is not the case (archives made before libdar 2.9.0 for example), such archive of
+	    /// reference has to be loaded in memory instead.
+	    /// Delta signatures of such archive are not available, the archive creation cannot compute
+	    /// delta signatures and saves changed files in whole
+	void set_streaming_catalogue(bool val) { x_streaming_catalogue = val; };
+
 
 	    //////// what follows concerne the use of an external catalogue instead of the archive's internal one
 
@@ -244,10 +262,12 @@ namespace libdar
 	bool get_ignore_signature_check_failure() const { return x_ignore_signature_check_failure; };
 	U_I get_multi_threaded_crypto() const { return x_multi_threaded_crypto; };
 	U_I get_multi_threaded_compress() const { return x_multi_threaded_compress; };
+	const std::shared_ptr<layer_statistics> & get_layer_statistics() const { return x_layer_stats; };
 	bool get_header_only() const { return x_header_only; };
 	bool get_silent() const { return x_silent; };
 	bool get_early_memory_release() const { return x_early_memory_release; };
 	bool get_force_first_slice() const { return x_force_first_slice; };
+	bool get_streaming_catalogue() const { return x_streaming_catalogue; };
 
 	    // All methods that follow concern the archive where to fetch the (isolated) catalogue from
 	bool is_external_catalogue_set() const { return external_cat; };
@@ -276,10 +296,12 @@ namespace libdar
 	bool x_ignore_signature_check_failure;
 	U_I x_multi_threaded_crypto;
 	U_I x_multi_threaded_compress;
+	std::shared_ptr<layer_statistics> x_layer_stats;
 	bool x_header_only;
 	bool x_silent;
 	bool x_early_memory_release;
 	bool x_force_first_slice;
+	bool x_streaming_catalogue;
 
 	    // external catalogue relative fields
 	bool external_cat;
@@ -427,6 +449,15 @@ namespace libdar
 	    /// .
 	void set_execute(const std::string & execute) { x_execute = execute; };
 
+	    /// set the maximum number of commands set by set_execute() to run in background
+
+	    /// \note zero (the default) runs the command synchronously after each slice completion. A positive value
+	    /// runs it in background for all slices but the last one, at most max_in_flight commands being in flight
+	    /// at any given time, slicing thus no more pauses the backup. When slices are written to a local directory
+	    /// without pause nor slice hashing, the next slice is also created ahead of time.
+	    /// \note requires libthreadar
+	void set_async_execute(U_I max_in_flight) { x_async_execute = max_in_flight; };
+
 	    /// set the cypher to use
 	void set_crypto_algo(crypto_algo crypto) { x_crypto = crypto; };
 
@@ -547,6 +578,11 @@ namespace libdar
 	    /// are for examle libdar::hash_none, libdar::hash_md5, libdar::hash_sha1, libdar::hash_sha512...
 	void set_hash_algo(hash_algo hash);
 
+	    /// add another hash algorithm, the hashes being all computed in a single pass over the slice data
+
+	    /// \note a hash file is created for each algorithm
+	void add_hash_algo(hash_algo hash);
+
 	    /// defines the minimum digit a slice must have concerning its number, zeros will be prepended as much as necessary to respect this
 	void set_slice_min_digits(infinint val) { x_slice_min_digits = val; };
 
@@ -574,6 +610,11 @@ namespace libdar
 		    /// how much thread libdar will use for compression (need libthreadar too and compression_block_size > 0)
 	void set_multi_threaded_compress(U_I num) { x_multi_threaded_compress = num; };
 
+	    /// record the activity of each layer of the archive (bytes, calls, time) and of their threads into the given object
+
+	    /// \note nullptr (the default) disables recording
+	void set_layer_statistics(const std::shared_ptr<layer_statistics> & stats) { x_layer_stats = stats; };
+
 	    /// whether binary delta has to be computed for differential/incremental backup
 
 	    /// \note this requires delta signature to be present in the archive of reference
@@ -618,6 +659,13 @@ namespace libdar
 	    /// never try resaving uncompressed when compression ratio is bad
 	void set_never_resave_uncompressed(bool val) { x_never_resave_uncompressed = val; };
 
+	    /// directory where to spill the catalogue parts already completed, an empty string keeps the whole catalogue in memory
+
+	    /// \note the catalogue of the resulting archive object can then only be used for isolation.
+	    /// This is not compatible with delta signature nor with an archive of reference unless
+	    /// its catalogue is streamed (see archive_options_read::set_streaming_catalogue())
+	void set_spill_directory(const std::string & dir) { x_spill_directory = dir; };
+
 	    /////////////////////////////////////////////////////////////////////
 	    // getting methods
 
@@ -640,6 +688,7 @@ namespace libdar
 	const infinint & get_first_slice_size() const { return x_first_file_size; };
 	const mask & get_ea_mask() const { if(x_ea_mask == nullptr) throw SRC_BUG; return *x_ea_mask; };
 	const std::string & get_execute() const { return x_execute; };
+	U_I get_async_execute() const { return x_async_execute; };
 	crypto_algo get_crypto_algo() const { return x_crypto; };
 	const secu_string & get_crypto_pass() const { return x_pass; };
 	U_32 get_crypto_size() const { return x_crypto_size; };
@@ -669,7 +718,8 @@ namespace libdar
 	infinint get_sparse_file_min_size() const { return x_sparse_file_min_size; };
 	bool get_security_check() const { return  x_security_check; };
 	const std::string & get_user_comment() const { return x_user_comment; };
-	hash_algo get_hash_algo() const { return x_hash; };
+	hash_algo get_hash_algo() const { return x_hash.empty() ? hash_algo::none : x_hash.front(); };
+	const std::deque<hash_algo> & get_hash_algos() const { return x_hash; };
 	infinint get_slice_min_digits() const { return x_slice_min_digits; };
 	const std::string & get_backup_hook_file_execute() const { return x_backup_hook_file_execute; };
 	const mask & get_backup_hook_file_mask() const { return *x_backup_hook_file_mask; };
@@ -678,6 +728,7 @@ namespace libdar
 	const fsa_scope & get_fsa_scope() const { return x_scope; };
 	U_I get_multi_threaded_crypto() const { return x_multi_threaded_crypto; };
 	U_I get_multi_threaded_compress() const { return x_multi_threaded_compress; };
+	const std::shared_ptr<layer_statistics> & get_layer_statistics() const { return x_layer_stats; };
 	bool get_delta_diff() const { return x_delta_diff; };
 	bool get_delta_signature() const { return x_delta_signature != rsync_sig_magic::none; };
 	rsync_sig_magic get_sig_magic() const { return x_delta_signature; };
@@ -691,6 +742,7 @@ namespace libdar
 	const infinint & get_iteration_count() const { return x_iteration_count; };
 	hash_algo get_kdf_hash() const { return x_kdf_hash; };
 	bool get_never_resave_uncompressed() const { return x_never_resave_uncompressed; };
+	const std::string & get_spill_directory() const { return x_spill_directory; };
 
     private:
 	std::shared_ptr<archive> x_ref_arch; ///< just contains the address of an existing object, no local copy of object is done here
@@ -712,6 +764,7 @@ namespace libdar
 	infinint x_first_file_size;
 	mask * x_ea_mask;    ///< points to a local copy of mask (must be allocated / releases by the archive_option_create objects)
 	std::string x_execute;
+	U_I x_async_execute;
 	crypto_algo x_crypto;
 	secu_string x_pass;
 	U_32 x_crypto_size;
@@ -742,7 +795,7 @@ namespace libdar
 	infinint x_sparse_file_min_size;
 	bool x_security_check;
 	std::string x_user_comment;
-	hash_algo x_hash;
+	std::deque<hash_algo> x_hash;
 	infinint x_slice_min_digits;
 	mask * x_backup_hook_file_mask;
 	std::string x_backup_hook_file_execute;
@@ -751,6 +804,7 @@ namespace libdar
 	fsa_scope x_scope;
 	U_I x_multi_threaded_crypto;
 	U_I x_multi_threaded_compress;
+	std::shared_ptr<layer_statistics> x_layer_stats;
 	bool x_delta_diff;
 	rsync_sig_magic x_delta_signature;
 	mask *x_delta_mask;
@@ -763,6 +817,7 @@ namespace libdar
 	infinint x_iteration_count;
 	hash_algo x_kdf_hash;
 	bool x_never_resave_uncompressed;
+	std::string x_spill_directory;
 
 	void nullifyptr() noexcept;
 	void destroy() noexcept;
@@ -849,6 +904,9 @@ namespace libdar
 	    /// .
 	void set_execute(const std::string & execute) { x_execute = execute; };
 
+	    /// set the maximum number of commands set by set_execute() to run in background (see archive_options_create::set_async_execute())
+	void set_async_execute(U_I max_in_flight) { x_async_execute = max_in_flight; };
+
 	    /// cypher to use
 	void set_crypto_algo(crypto_algo crypto) { x_crypto = crypto; };
 
@@ -887,6 +945,11 @@ namespace libdar
 	    /// specify whether to produce a hash file of the slice and which hash algo to use
 	void set_hash_algo(hash_algo hash);
 
+	    /// add another hash algorithm, the hashes being all computed in a single pass over the slice data
+
+	    /// \note a hash file is created for each algorithm
+	void add_hash_algo(hash_algo hash);
+
 	    /// defines the minimum digit a slice must have concerning its number, zeros will be prepended as much as necessary to respect this
 	void set_slice_min_digits(infinint val) { x_slice_min_digits = val; };
 
@@ -959,6 +1022,7 @@ namespace libdar
 	const infinint & get_slice_size() const { return x_file_size; };
 	const infinint & get_first_slice_size() const { return x_first_file_size; };
 	const std::string & get_execute() const { return x_execute; };
+	U_I get_async_execute() const { return x_async_execute; };
 	crypto_algo get_crypto_algo() const { return x_crypto; };
 	const secu_string & get_crypto_pass() const { return x_pass; };
 	U_32 get_crypto_size() const { return x_crypto_size; };
@@ -969,7 +1033,8 @@ namespace libdar
 	const std::string & get_slice_user_ownership() const { return x_slice_user_ownership; };
 	const std::string & get_slice_group_ownership() const { return x_slice_group_ownership; };
 	const std::string & get_user_comment() const { return x_user_comment; };
-	hash_algo get_hash_algo() const { return x_hash; };
+	hash_algo get_hash_algo() const { return x_hash.empty() ? hash_algo::none : x_hash.front(); };
+	const std::deque<hash_algo> & get_hash_algos() const { return x_hash; };
 	infinint get_slice_min_digits() const { return x_slice_min_digits; };
 	bool get_sequential_marks() const { return x_sequential_marks; };
 	const std::shared_ptr<entrepot> & get_entrepot() const { return x_entrepot; };
@@ -996,6 +1061,7 @@ namespace libdar
 	infinint x_file_size;
 	infinint x_first_file_size;
 	std::string x_execute;
+	U_I x_async_execute;
 	crypto_algo x_crypto;
 	secu_string x_pass;
 	U_32 x_crypto_size;
@@ -1006,7 +1072,7 @@ namespace libdar
 	std::string x_slice_user_ownership;
 	std::string x_slice_group_ownership;
 	std::string x_user_comment;
-	hash_algo x_hash;
+	std::deque<hash_algo> x_hash;
 	infinint x_slice_min_digits;
 	bool x_sequential_marks;
 	std::shared_ptr<entrepot> x_entrepot;
@@ -1139,6 +1205,9 @@ namespace libdar
 	    /// .
 	void set_execute(const std::string & execute) { x_execute = execute; };
 
+	    /// set the maximum number of commands set by set_execute() to run in background (see archive_options_create::set_async_execute())
+	void set_async_execute(U_I max_in_flight) { x_async_execute = max_in_flight; };
+
 	    /// set the cypher to use
 	void set_crypto_algo(crypto_algo crypto) { x_crypto = crypto; };
 
@@ -1196,6 +1265,11 @@ namespace libdar
 	    /// specify whether to produce a hash file of the slice and which hash algo to use
 	void set_hash_algo(hash_algo hash);
 
+	    /// add another hash algorithm, the hashes being all computed in a single pass over the slice data
+
+	    /// \note a hash file is created for each algorithm
+	void add_hash_algo(hash_algo hash);
+
 	    /// defines the minimum digit a slice must have concerning its number, zeros will be prepended as much as necessary to respect this
 	void set_slice_min_digits(infinint val) { x_slice_min_digits = val; };
 
@@ -1275,6 +1349,7 @@ namespace libdar
 	const infinint & get_first_slice_size() const { return x_first_file_size; };
 	const mask & get_ea_mask() const { if(x_ea_mask == nullptr) throw SRC_BUG; return *x_ea_mask; };
 	const std::string & get_execute() const { return x_execute; };
+	U_I get_async_execute() const { return x_async_execute; };
 	crypto_algo get_crypto_algo() const { return x_crypto; };
 	const secu_string & get_crypto_pass() const { return x_pass; };
 	U_32 get_crypto_size() const { return x_crypto_size; };
@@ -1291,7 +1366,8 @@ namespace libdar
 	bool get_sequential_marks() const { return x_sequential_marks; };
 	infinint get_sparse_file_min_size() const { return x_sparse_file_min_size; };
 	const std::string & get_user_comment() const { return x_user_comment; };
-	hash_algo get_hash_algo() const { return x_hash; };
+	hash_algo get_hash_algo() const { return x_hash.empty() ? hash_algo::none : x_hash.front(); };
+	const std::deque<hash_algo> & get_hash_algos() const { return x_hash; };
 	infinint get_slice_min_digits() const { return x_slice_min_digits; };
 	const std::shared_ptr<entrepot> & get_entrepot() const { return x_entrepot; };
 	const fsa_scope & get_fsa_scope() const { return x_scope; };
@@ -1327,6 +1403,7 @@ namespace libdar
 	infinint x_first_file_size;
 	mask * x_ea_mask;
 	std::string x_execute;
+	U_I x_async_execute;
 	crypto_algo x_crypto;
 	secu_string x_pass;
 	U_32 x_crypto_size;
@@ -1343,7 +1420,7 @@ namespace libdar
 	bool x_sequential_marks;
 	infinint x_sparse_file_min_size;
 	std::string x_user_comment;
-	hash_algo x_hash;
+	std::deque<hash_algo> x_hash;
 	infinint x_slice_min_digits;
 	std::shared_ptr<entrepot> x_entrepot;
 	fsa_scope x_scope;
@@ -1472,6 +1549,24 @@ namespace libdar
 	    /// whether to ignore fs_root and use in-place path stored in the archive
 	void set_in_place(bool arg) { x_in_place = arg; };
 
+	    /// number of threads completing the restoration of newly created inodes
+
+	    /// \note with a value greater than 1 (requires libthreadar), the archive is still read by
+	    /// the calling thread, but the creation of small plain files from their data and the restoration of
+	    /// EA, FSA, dates, ownership and permissions of new inodes are done by that number of threads.
+	    /// Directories get their dates and permissions once all their entries have been completed.
+	    /// Failures met by these threads are reported as messages and the inode is counted as errored, or
+	    /// as ignored if the failure comes from a negative answer of the user, the questions these threads
+	    /// ask being relayed from the calling thread.
+	void set_restore_writers(U_I num) { x_restore_writers = num; };
+
+	    /// record or replay what the extraction does to directories
+
+	    /// \note this is used by database::restore() to extract several archives concurrently,
+	    /// the journal (see restore_dir_journal.hpp) is not usable outside libdar. While recording, directories
+	    /// are only created when missing, their metadata is left unchanged
+	void set_dir_journal(const std::shared_ptr<restore_dir_journal> & journal) { x_dir_journal = journal; };
+
 
 	    /////////////////////////////////////////////////////////////////////
 	    // getting methods
@@ -1496,6 +1591,8 @@ namespace libdar
 	const fsa_scope & get_fsa_scope() const { return x_scope; };
 	bool get_ignore_unix_sockets() const { return x_ignore_unix_sockets; };
 	bool get_in_place() const { return x_in_place; };
+	U_I get_restore_writers() const { return x_restore_writers; };
+	const std::shared_ptr<restore_dir_journal> & get_dir_journal() const { return x_dir_journal; };
 
     private:
 	mask * x_selection;
@@ -1518,6 +1615,8 @@ namespace libdar
 	fsa_scope x_scope;
 	bool x_ignore_unix_sockets;
 	bool x_in_place;
+	U_I x_restore_writers;
+	std::shared_ptr<restore_dir_journal> x_dir_journal;
 
 	void destroy() noexcept;
 	void nullifyptr() noexcept;
@@ -1919,6 +2018,9 @@ namespace libdar
 	    /// .
 	void set_execute(const std::string & execute) { x_execute = execute; };
 
+	    /// set the maximum number of commands set by set_execute() to run in background (see archive_options_create::set_async_execute())
+	void set_async_execute(U_I max_in_flight) { x_async_execute = max_in_flight; };
+
 	    /// set the cypher to use
 	void set_crypto_algo(crypto_algo crypto) { x_crypto = crypto; };
 
@@ -1964,6 +2066,11 @@ namespace libdar
 	    /// are for examle libdar::hash_none, libdar::hash_md5, libdar::hash_sha1, libdar::hash_sha512...
 	void set_hash_algo(hash_algo hash);
 
+	    /// add another hash algorithm, the hashes being all computed in a single pass over the slice data
+
+	    /// \note a hash file is created for each algorithm
+	void add_hash_algo(hash_algo hash);
+
 	    /// defines the minimum digit a slice must have concerning its number, zeros will be prepended as much as necessary to respect this
 	void set_slice_min_digits(infinint val) { x_slice_min_digits = val; };
 
@@ -2004,6 +2111,7 @@ namespace libdar
 	const infinint & get_slice_size() const { return x_file_size; };
 	const infinint & get_first_slice_size() const { return x_first_file_size; };
 	const std::string & get_execute() const { return x_execute; };
+	U_I get_async_execute() const { return x_async_execute; };
 	crypto_algo get_crypto_algo() const { return x_crypto; };
 	const secu_string & get_crypto_pass() const { return x_pass; };
 	U_32 get_crypto_size() const { return x_crypto_size; };
@@ -2014,7 +2122,8 @@ namespace libdar
 	const std::string & get_slice_user_ownership() const { return x_slice_user_ownership; };
 	const std::string & get_slice_group_ownership() const { return x_slice_group_ownership; };
 	const std::string & get_user_comment() const { return x_user_comment; };
-	hash_algo get_hash_algo() const { return x_hash; };
+	hash_algo get_hash_algo() const { return x_hash.empty() ? hash_algo::none : x_hash.front(); };
+	const std::deque<hash_algo> & get_hash_algos() const { return x_hash; };
 	infinint get_slice_min_digits() const { return x_slice_min_digits; };
 	const std::shared_ptr<entrepot> & get_entrepot() const { return x_entrepot; };
 	U_I get_multi_threaded_crypto() const { return x_multi_threaded_crypto; };
@@ -2035,6 +2144,7 @@ namespace libdar
 	infinint x_file_size;
 	infinint x_first_file_size;
 	std::string x_execute;
+	U_I x_async_execute;
 	crypto_algo x_crypto;
 	secu_string x_pass;
 	U_32 x_crypto_size;
@@ -2045,7 +2155,7 @@ namespace libdar
 	std::string x_slice_user_ownership;
 	std::string x_slice_group_ownership;
 	std::string x_user_comment;
-	hash_algo x_hash;
+	std::deque<hash_algo> x_hash;
 	infinint x_slice_min_digits;
 	std::shared_ptr<entrepot> x_entrepot;
 	U_I x_multi_threaded_crypto;
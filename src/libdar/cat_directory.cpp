@@ -25,6 +25,8 @@ extern "C"
 {
 } // end extern "C"
 
+#include <algorithm>
+
 #include "cat_all_entrees.hpp"
 #include "tools.hpp"
 
@@ -33,6 +35,9 @@ using namespace std;
 namespace libdar
 {
 
+	/// sorting order of the children
+    static bool name_lower(const cat_nomme *a, const cat_nomme *b) { return a->get_name() < b->get_name(); };
+
 	// static field of class cat_directory
 
     const cat_eod cat_directory::fin;
@@ -251,24 +256,9 @@ namespace libdar
 
     void cat_directory::inherited_dump(const pile_descriptor & pdesc, bool small) const
     {
-	deque<cat_nomme *>::const_iterator x = ordered_fils.begin();
-
 	cat_inode::inherited_dump(pdesc, small);
 	if(!small)
-	{
-	    while(x != ordered_fils.end())
-	    {
-		if(*x == nullptr)
-		    throw SRC_BUG;
-		if(dynamic_cast<cat_ignored *>(*x) != nullptr)
-		    ++x; // "cat_ignored" need not to be saved, they are only useful when updating_destroyed
-		else
-		{
-		    (*x)->specific_dump(pdesc, small);
-		    ++x;
-		}
-	    }
-	}
+	    dump_children(pdesc, nullptr);
 	    // else in small mode, we do not dump any children
 	    // an inode may have children while small dump is asked
 	    // when performing a merging operation
@@ -278,6 +268,42 @@ namespace libdar
 	    // this hack avoids recurrent construction/destruction of a cat_eod object.
     }
 
+    void cat_directory::dump_omitting(const pile_descriptor & pdesc, const set<const cat_nomme *> & omitted) const
+    {
+	pdesc.check(false);
+	cat_inode::inherited_dump(pdesc, false);
+	dump_children(pdesc, &omitted);
+	fin.specific_dump(pdesc, false);
+    }
+
+    void cat_directory::dump_children(const pile_descriptor & pdesc, const set<const cat_nomme *> *omitted) const
+    {
+	deque<cat_nomme *>::const_iterator x = ordered_fils.begin();
+
+	while(x != ordered_fils.end())
+	{
+	    if(*x == nullptr)
+		throw SRC_BUG;
+
+	    if(dynamic_cast<cat_ignored *>(*x) != nullptr)
+		; // "cat_ignored" need not to be saved, they are only useful when updating_destroyed
+	    else if(omitted == nullptr)
+		(*x)->specific_dump(pdesc, false);
+	    else if(omitted->find(*x) == omitted->end())
+	    {
+		const cat_directory *x_dir = dynamic_cast<const cat_directory *>(*x);
+
+		if(x_dir != nullptr)
+		    x_dir->dump_omitting(pdesc, *omitted);
+		else
+		    (*x)->specific_dump(pdesc, false);
+	    }
+		// else entry has been dumped apart by the caller
+
+	    ++x;
+	}
+    }
+
     void cat_directory::recursive_update_sizes() const
     {
 	if(!updated_sizes)
@@ -333,6 +359,38 @@ namespace libdar
 	}
     }
 
+    void cat_directory::insert_children(U_I position, deque<cat_nomme *> & entries)
+    {
+	U_I num = entries.size();
+
+	if(position > ordered_fils.size())
+	    position = ordered_fils.size();
+
+	for(deque<cat_nomme *>::iterator ent = entries.begin(); ent != entries.end(); ++ent)
+	    if(*ent == nullptr)
+		throw SRC_BUG;
+
+	ordered_fils.insert(ordered_fils.begin() + position, entries.begin(), entries.end());
+	entries.clear();
+	    // from here the new children are owned by "this"
+
+	for(deque<cat_nomme *>::iterator ent = ordered_fils.begin() + position;
+	    ent != ordered_fils.begin() + position + num;
+	    ++ent)
+	{
+	    cat_directory *d = dynamic_cast<cat_directory *>(*ent);
+
+#ifdef LIBDAR_FAST_DIR
+	    fils[(*ent)->get_name()] = *ent;
+#endif
+	    if(d != nullptr)
+		d->parent = this;
+	}
+
+	it = ordered_fils.begin();
+	recursive_flag_size_to_update();
+    }
+
     void cat_directory::add_children(cat_nomme *r)
     {
 	cat_directory *d = dynamic_cast<cat_directory *>(r);
@@ -395,6 +453,22 @@ namespace libdar
 	recursive_flag_size_to_update();
     }
 
+    void cat_directory::merge_sorted_children(U_I already_sorted)
+    {
+	deque<cat_nomme *>::iterator middle;
+
+	if(already_sorted >= ordered_fils.size())
+	    return;
+
+	middle = ordered_fils.begin() + already_sorted;
+	if(is_sorted(ordered_fils.begin(), middle, name_lower)
+	   && is_sorted(middle, ordered_fils.end(), name_lower))
+	{
+	    inplace_merge(ordered_fils.begin(), middle, ordered_fils.end(), name_lower);
+	    it = ordered_fils.begin();
+	}
+    }
+
     void cat_directory::reset_read_children() const
     {
 	it = ordered_fils.begin();
@@ -582,6 +656,32 @@ namespace libdar
 	recursive_flag_size_to_update();
     }
 
+    void cat_directory::release_children(U_I start, U_I num)
+    {
+	if(start > ordered_fils.size() || ordered_fils.size() - start < num)
+	    throw SRC_BUG;
+
+	deque<cat_nomme *>::const_iterator debut = ordered_fils.begin() + start;
+	deque<cat_nomme *>::const_iterator fin = debut + num;
+
+#ifdef LIBDAR_FAST_DIR
+	for(deque<cat_nomme *>::const_iterator ut = debut; ut != fin; ++ut)
+	{
+	    if(*ut == nullptr)
+		throw SRC_BUG;
+
+	    map<string, cat_nomme *>::iterator ft = fils.find((*ut)->get_name());
+	    if(ft == fils.end())
+		throw SRC_BUG;
+	    fils.erase(ft);
+	}
+#endif
+
+	erase_ordered_fils(debut, fin);
+	it = ordered_fils.end();
+	recursive_flag_size_to_update();
+    }
+
     void cat_directory::remove_if_no_mirage(const std::string & name)
     {
 	const cat_nomme* ref = nullptr;
@@ -38,6 +38,8 @@ extern "C"
 #include <map>
 #endif
 #include <list>
+#include <set>
+#include <deque>
 
 namespace libdar
 {
@@ -79,6 +81,45 @@ namespace libdar
 	virtual bool operator == (const cat_entree & ref) const override;
 
         void add_children(cat_nomme *r); // when r is a cat_directory, 'parent' is set to 'this'
+
+	    /// put the children added by add_children() after the given number of children at their place by name
+
+	    /// \param[in] already_sorted number of first children, the children are expected to be sorted by name
+	    /// up to this number and from it, the two lists being merged in one pass
+	    /// \note nothing is changed if one of the two lists is not sorted, else this keeps the children sorted
+	    /// as expected from the catalogue of reference when it is streamed (see catalogue_stream.hpp)
+	void merge_sorted_children(U_I already_sorted);
+
+	    /// insert entries read from the archive before the entry found at the given position
+
+	    /// \param[in] position index among the children of the first inserted entry, it is reduced to
+	    /// the number of children if greater
+	    /// \param[in,out] entries the objects to add, they are owned by the cat_directory and the argument
+	    /// is cleared upon success
+	    /// \note unlike add_children() no check is done about entries already present with the same name
+	void insert_children(U_I position, std::deque<cat_nomme *> & entries);
+
+	    /// call f(cat_nomme *) for each direct children in their order, read_children() position is not modified
+	template <class F> void for_each_children(F f) const
+	{
+	    for(std::deque<cat_nomme *>::const_iterator ot = ordered_fils.begin(); ot != ordered_fils.end(); ++ot)
+		f(*ot);
+	};
+
+	    /// call f(cat_nomme *) for at most num children starting at index start, returns the number of children passed to f
+	template <class F> U_I for_each_children(U_I start, U_I num, F f) const
+	{
+	    U_I ret = 0;
+
+	    if(start >= ordered_fils.size())
+		return 0;
+	    for(std::deque<cat_nomme *>::const_iterator ot = ordered_fils.begin() + start; ot != ordered_fils.end() && ret < num; ++ot, ++ret)
+		f(*ot);
+	    return ret;
+	};
+
+	    /// the direct children found at the given index in their order, nullptr if index is out of range
+	const cat_nomme *get_children_at(U_I index) const { return index < ordered_fils.size() ? ordered_fils[index] : nullptr; };
 	bool has_children() const { return !ordered_fils.empty(); };
         void reset_read_children() const;
 	void end_read() const;
@@ -115,6 +156,12 @@ namespace libdar
 	    /// remove all entries contained in this directory (recursively)
 	void clear();
 
+	    /// remove num children starting at index start, with their subtree
+
+	    /// \note this is used to free memory of entries that have been stored elsewhere,
+	    /// the size of the directory does not take them into account anymore
+	void release_children(U_I start, U_I num);
+
         cat_directory * get_parent() const { return parent; };
         bool search_children(const std::string &name, const cat_nomme *&ref) const;
 
@@ -137,6 +184,9 @@ namespace libdar
 	    /// get the number of "cat_nomme" entry directly containted in this cat_directory (no recursive call)
 	infinint get_dir_size() const { return ordered_fils.size(); };
 
+	    /// same as get_dir_size() as an U_I
+	U_I get_children_count() const { return ordered_fils.size(); };
+
 	    /// get then number of "cat_nomme" entry contained in this cat_directory and subdirectories (recursive call)
 	infinint get_tree_size() const;
 
@@ -176,6 +226,9 @@ namespace libdar
 	    /// overwrite virtual method of cat_entree to propagate the action to all entries of the directory tree
 	virtual void change_location(const smart_pointer<pile_descriptor> & pdesc) override;
 
+	    /// write down the directory and its subdirectories without the given entries (and their subtree)
+	void dump_omitting(const pile_descriptor & pdesc, const std::set<const cat_nomme *> & omitted) const;
+
     protected:
         virtual void inherited_dump(const pile_descriptor & pdesc, bool small) const override;
 
@@ -196,6 +249,7 @@ namespace libdar
 	void init() noexcept;
 	void recursive_update_sizes() const;
 	void recursive_flag_size_to_update() const;
+	void dump_children(const pile_descriptor & pdesc, const std::set<const cat_nomme *> *omitted) const;
 	void erase_ordered_fils(std::deque<cat_nomme *>::const_iterator debut,
 				std::deque<cat_nomme *>::const_iterator fin);
 
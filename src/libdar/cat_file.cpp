@@ -1566,7 +1566,8 @@ namespace libdar
 				    f_other->get_storage_size(),
 				    crc_size,
 				    value,
-				    err_offset))
+				    err_offset,
+				    true)) // "you" is read from filesystem, independently from "me"
 			    throw Erange(tools_printf(gettext("different file data, offset of first difference is: %i"), &err_offset));
 			    // data is the same, comparing the CRC values
 
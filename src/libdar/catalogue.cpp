@@ -57,6 +57,9 @@ extern "C"
 #include <typeinfo>
 #include <algorithm>
 #include <map>
+#include <set>
+#include <deque>
+#include <memory>
 #include "catalogue.hpp"
 #include "tools.hpp"
 #include "tronc.hpp"
@@ -72,12 +75,34 @@ extern "C"
 #include "range.hpp"
 #include "cat_all_entrees.hpp"
 #include "cat_signature.hpp"
+#include "catalogue_chunk.hpp"
+
+#ifdef LIBTHREADAR_AVAILABLE
+#include "catalogue_decoder.hpp"
+#endif
 
 using namespace std;
 
 namespace libdar
 {
 
+	/// what catalogue dumping needs to know about a directory tree
+    struct chunk_tree_info
+    {
+	U_I entries; ///< number of entries in the tree
+	U_I dirs;    ///< number of directories in the tree, the root of the tree included
+	bool mirage; ///< whether the tree contains hard linked inodes
+    };
+
+    static chunk_tree_info chunk_scan_tree(const cat_directory *dir, map<const cat_directory *, chunk_tree_info> & info);
+    static void chunk_dump_tree(generic_file & f,
+				const cat_directory *dir,
+				U_I & dir_counter,
+				const map<const cat_directory *, chunk_tree_info> & info,
+				const catalogue_spill *spill,
+				set<const cat_nomme *> & omitted);
+    static void chunk_list_dirs(cat_directory *dir, deque<cat_directory *> & dirs);
+
     catalogue::catalogue(const std::shared_ptr<user_interaction> & ui,
 			 const datetime & root_last_modif,
 			 const label & data_name): mem_ui(ui),
@@ -116,10 +141,12 @@ namespace libdar
 			 compression default_algo,
 			 bool lax,
 			 const label & lax_layer1_data_name,
-			 bool only_detruit): mem_ui(ui),
-					     out_compare("/"),
-					     in_place("."),
-					     faked_escape(nullptr)
+			 bool only_detruit,
+			 U_I decoding_threads,
+			 bool skeleton_only): mem_ui(ui),
+						out_compare("/"),
+						in_place("."),
+						faked_escape(nullptr)
     {
 	string tmp;
 	saved_status st;
@@ -127,6 +154,10 @@ namespace libdar
 	map <infinint, cat_etoile *> corres;
 	crc *calc_crc = nullptr;
 	crc *read_crc = nullptr;
+	deque<unique_ptr<catalogue_chunk> > chunks;
+#ifdef LIBTHREADAR_AVAILABLE
+	unique_ptr<catalogue_decoder> decoder; // must be destroyed before chunks
+#endif
 	contenu = nullptr;
 	early_mem_release = false;
 	mem_released = false;
@@ -190,6 +221,53 @@ namespace libdar
 		    }
 		}
 
+		if(reading_ver >= archive_version(12,1))
+		{
+		    infinint chunk_size;
+
+#ifdef LIBTHREADAR_AVAILABLE
+		    if(decoding_threads > 1 && !lax && !skeleton_only)
+		    {
+			decoder.reset(new (nothrow) catalogue_decoder(decoding_threads, reading_ver, default_algo, only_detruit));
+			if(!decoder)
+			    throw Ememory();
+		    }
+#endif
+
+		    do
+		    {
+			try
+			{
+			    chunk_size.read(*pdesc.stack);
+			    if(!chunk_size.is_zero())
+			    {
+				if(skeleton_only)
+				    catalogue_chunk::skip(*pdesc.stack, chunk_size);
+				else
+				    chunks.push_back(make_unique<catalogue_chunk>(*pdesc.stack, chunk_size));
+			    }
+			}
+			catch(Erange & e)
+			{
+			    if(!lax)
+				throw;
+			    get_ui().message(string(gettext("LAX MODE: Error met reading the catalogue chunk list, ignoring the rest of the list and continuing. Skipped error is: ")) + e.get_message());
+			    chunk_size = 0;
+			}
+
+			if(!chunk_size.is_zero() && !skeleton_only)
+			{
+#ifdef LIBTHREADAR_AVAILABLE
+			    if(decoder)
+				decoder->submit(chunks.back().get());
+			    else
+#endif
+				chunks.back()->decode(ui, reading_ver, default_algo, lax, only_detruit);
+			}
+		    }
+		    while(!chunk_size.is_zero());
+		}
+
 		cat_signature cat_sig(*pdesc.stack, reading_ver);
 
 		if(!cat_sig.get_base_and_status(base, st) && !lax)
@@ -204,6 +282,56 @@ namespace libdar
 		contenu = new (nothrow) cat_directory(ui, spdesc, reading_ver, st, stats, corres, default_algo, lax, only_detruit, false);
 		if(contenu == nullptr)
 		    throw Ememory();
+
+		if(!chunks.empty())
+		{
+		    deque<cat_directory *> dirs;
+
+#ifdef LIBTHREADAR_AVAILABLE
+		    if(decoder)
+		    {
+			string msg;
+
+			decoder->wait_all();
+			while(decoder->pop_message(msg))
+			    get_ui().message(msg);
+		    }
+#endif
+
+			// dirs must be listed before any chunk is inserted, as chunk
+			// positions only take into account directories out of chunks
+		    chunk_list_dirs(contenu, dirs);
+
+		    for(deque<unique_ptr<catalogue_chunk> >::iterator ch = chunks.begin(); ch != chunks.end(); ++ch)
+		    {
+			infinint tmp_index = (*ch)->get_dir_index();
+			infinint tmp_pos = (*ch)->get_position();
+			U_I index = 0;
+			U_I pos = 0;
+			deque<cat_nomme *> & entries = (*ch)->get_entries();
+
+			if((*ch)->has_failed())
+			    throw Erange((*ch)->get_error());
+
+			tmp_index.unstack(index);
+			tmp_pos.unstack(pos);
+			if(!tmp_index.is_zero() || !tmp_pos.is_zero() || index >= dirs.size())
+			{
+			    if(!lax)
+				throw Erange(gettext("incoherent catalogue structure"));
+			    get_ui().message(gettext("LAX MODE: catalogue chunk refers to an unknown directory, assuming data corruption occurred, placing its entries at the root of the archive"));
+			    index = 0;
+			}
+
+			for(deque<cat_nomme *>::iterator ent = entries.begin(); ent != entries.end(); ++ent)
+			    (*ent)->change_location(spdesc);
+			stats += (*ch)->get_stats();
+			dirs[index]->insert_children(pos, entries);
+		    }
+
+		    chunks.clear();
+		}
+
 		if(only_detruit)
 		    contenu->remove_all_mirages_and_reduce_dirs();
 		current_compare = contenu;
@@ -266,6 +394,9 @@ namespace libdar
 
     catalogue & catalogue::operator = (const catalogue & ref)
     {
+	if(ref.has_spilled_entries())
+	    throw Erange(gettext("Part of the catalogue has been spilled to disk, it cannot be copied"));
+
 	detruire();
 
 	    // now copying the catalogue's data
@@ -451,6 +582,8 @@ namespace libdar
 	    if(n == nullptr)
 		throw SRC_BUG; // unknown type neither "cat_eod" nor "cat_nomme"
 	    current_add->add_children(n);
+	    if(spill)
+		spill->added(n);
 	    if(t != nullptr) // ref is a directory
 		current_add = t;
 	    if(addtostats)
@@ -462,7 +595,11 @@ namespace libdar
 	    if(parent == nullptr)
 		throw SRC_BUG; // root has no parent directory, cannot change to it
 	    else
+	    {
+		if(spill)
+		    spill->closed();
 		current_add = parent;
+	    }
 	    delete ref; // all data given throw add becomes owned by the catalogue object
 	}
     }
@@ -471,6 +608,9 @@ namespace libdar
     {
 	const cat_nomme *sub = nullptr;
 
+	if(spill)
+	    throw SRC_BUG; // entries are expected to be added in order when spilling
+
 	if(current_add->search_children(subdirname, sub))
 	{
 	    const cat_directory *subdir = dynamic_cast<const cat_directory *>(sub);
@@ -503,9 +643,22 @@ namespace libdar
     {
 	if(current_add == nullptr)
 	    throw SRC_BUG;
+	if(spill)
+	    throw SRC_BUG; // the entry may have already been spilled
 	current_add->remove(name);
     }
 
+    void catalogue::set_spill_directory(const string & directory)
+    {
+	if(contenu == nullptr)
+	    throw SRC_BUG;
+	if(current_add != contenu)
+	    throw SRC_BUG;
+	spill.reset(new (nothrow) catalogue_spill(get_pointer(), directory, contenu));
+	if(!spill)
+	    throw Ememory();
+    }
+
     void catalogue::reset_compare() const
     {
 	if(mem_released)
@@ -638,7 +791,9 @@ namespace libdar
 	const cat_nomme *pro_nom;
 	const cat_mirage *pro_mir;
 	infinint count = 0;
+	deque<U_I> already_sorted; // for current and its parents, number of children before those added here
 
+	already_sorted.push_back(current->get_children_count());
 	ref.reset_read();
 	while(ref.read(projo))
 	{
@@ -653,6 +808,8 @@ namespace libdar
 		cat_directory *tmp = current->get_parent();
 		if(tmp == nullptr)
 		    throw SRC_BUG; // reached root for "contenu", and not yet for "ref";
+		current->merge_sorted_children(already_sorted.back());
+		already_sorted.pop_back();
 		current = tmp;
 		continue;
 	    }
@@ -711,12 +868,23 @@ namespace libdar
 		    const cat_directory *ici_dir = dynamic_cast<const cat_directory *>(ici);
 
 		    if(ici_dir != nullptr)
+		    {
 			current = const_cast<cat_directory *>(ici_dir);
+			already_sorted.push_back(current->get_children_count());
+		    }
 		    else
 			ref.skip_read_to_parent_dir();
 		}
 	}
 
+	    // directories not ended by a cat_eod, at least the root
+	while(!already_sorted.empty() && current != nullptr)
+	{
+	    current->merge_sorted_children(already_sorted.back());
+	    already_sorted.pop_back();
+	    current = current->get_parent();
+	}
+
 	return count;
     }
 
@@ -735,7 +903,9 @@ namespace libdar
 	    // for each etiquette from the reference catalogue
 	    // gives an cloned or original cat_etoile object
 	    // in the current catalogue
+	deque<U_I> already_sorted; // for current and its parents, number of children before those added here
 
+	already_sorted.push_back(current->get_children_count());
 	ref.reset_read();
 	while(ref.read(projo))
 	{
@@ -751,6 +921,8 @@ namespace libdar
 		cat_directory *tmp = current->get_parent();
 		if(tmp == nullptr)
 		    throw SRC_BUG; // reached root for "contenu", and not yet for "ref";
+		current->merge_sorted_children(already_sorted.back());
+		already_sorted.pop_back();
 		current = tmp;
 		continue;
 	    }
@@ -875,6 +1047,7 @@ namespace libdar
 			    if((void *)ici != (void *)clo_dir)
 				throw SRC_BUG;  // we have just added the entry we were looking for, but could find another one!?!
 			    current = clo_dir;
+			    already_sorted.push_back(0);
 			}
 			else
 			    throw SRC_BUG; // cannot find the entry we have just added!!!
@@ -897,7 +1070,10 @@ namespace libdar
 		    const cat_directory *ici_dir = dynamic_cast<const cat_directory *>(ici);
 
 		    if(ici_dir != nullptr)
+		    {
 			current = const_cast<cat_directory *>(ici_dir);
+			already_sorted.push_back(current->get_children_count());
+		    }
 		    else
 			ref.skip_read_to_parent_dir();
 		}
@@ -916,6 +1092,14 @@ namespace libdar
 		}
 	    }
 	}
+
+	    // directories not ended by a cat_eod, at least the root
+	while(!already_sorted.empty() && current != nullptr)
+	{
+	    current->merge_sorted_children(already_sorted.back());
+	    already_sorted.pop_back();
+	    current = current->get_parent();
+	}
     }
 
     void catalogue::drop_all_non_detruits()
@@ -1031,9 +1215,28 @@ namespace libdar
 	    pdesc.stack->reset_crc(CAT_CRC_SIZE);
 	    try
 	    {
+		map<const cat_directory *, chunk_tree_info> info;
+		chunk_tree_info root_info;
+
 		ref_data_name.dump(*pdesc.stack);
 		tools_write_string(*pdesc.stack, in_place.display());
-		contenu->dump(pdesc, false);
+
+		root_info = chunk_scan_tree(contenu, info);
+		if(root_info.entries >= 2*CATALOGUE_CHUNK_ENTRIES || has_spilled_entries())
+		{
+		    set<const cat_nomme *> omitted;
+		    U_I dir_counter = 0;
+
+		    chunk_dump_tree(*pdesc.stack, contenu, dir_counter, info, spill.get(), omitted);
+		    catalogue_chunk::dump_end(*pdesc.stack);
+		    info.clear();
+		    contenu->dump_omitting(pdesc, omitted);
+		}
+		else
+		{
+		    catalogue_chunk::dump_end(*pdesc.stack);
+		    contenu->dump(pdesc, false);
+		}
 	    }
 	    catch(...)
 	    {
@@ -1414,6 +1617,9 @@ namespace libdar
 	ref_data_name = ref.ref_data_name;
 	ref.ref_data_name = tmp_lab;
 
+	    // swapping the spilled entries that go with contenu
+	spill.swap(ref.spill);
+
 	    // avoid pointers to point to the now other's object tree
 	reset_all();
 	ref.reset_all();
@@ -1424,6 +1630,9 @@ namespace libdar
 	contenu = nullptr;
 	sub_tree = nullptr;
 
+	if(ref.has_spilled_entries())
+	    throw Erange(gettext("Part of the catalogue has been spilled to disk, it cannot be copied"));
+
 	try
 	{
 	    if(ref.contenu == nullptr)
@@ -1465,6 +1674,7 @@ namespace libdar
 
     void catalogue::detruire()
     {
+	spill.reset();
 	if(contenu != nullptr)
 	{
 	    delete contenu;
@@ -1481,5 +1691,150 @@ namespace libdar
     const cat_eod catalogue::r_eod;
     const U_I catalogue::CAT_CRC_SIZE = 4;
 
-} // end of namespace
+    static chunk_tree_info chunk_scan_tree(const cat_directory *dir, map<const cat_directory *, chunk_tree_info> & info)
+    {
+	chunk_tree_info ret = { 0, 1, false };
 
+	if(dir == nullptr)
+	    throw SRC_BUG;
+
+	dir->for_each_children([&](const cat_nomme *child)
+			       {
+				   const cat_directory *child_dir = dynamic_cast<const cat_directory *>(child);
+
+				   if(dynamic_cast<const cat_ignored *>(child) != nullptr)
+				       return; // not dumped
+
+				   ++ret.entries;
+				   if(dynamic_cast<const cat_mirage *>(child) != nullptr)
+				       ret.mirage = true;
+				   if(dynamic_cast<const cat_ignored_dir *>(child) != nullptr)
+				       ++ret.dirs; // dumped as an empty directory
+				   if(child_dir != nullptr)
+				   {
+				       chunk_tree_info sub = chunk_scan_tree(child_dir, info);
+
+				       ret.entries += sub.entries;
+				       ret.dirs += sub.dirs;
+				       ret.mirage = ret.mirage || sub.mirage;
+				   }
+			       });
+
+	info[dir] = ret;
+
+	return ret;
+    }
+
+    static void chunk_dump_tree(generic_file & f,
+				const cat_directory *dir,
+				U_I & dir_counter,
+				const map<const cat_directory *, chunk_tree_info> & info,
+				const catalogue_spill *spill,
+				set<const cat_nomme *> & omitted)
+    {
+	U_I dir_index = dir_counter++; // pre-order index of dir among directories out of chunks
+	deque<const cat_nomme *> run;  // consecutive children to store in a chunk
+	chunk_tree_info run_info = { 0, 0, false };
+	U_I run_pos = 0;
+	U_I pos = 0;
+	const deque<catalogue_spill::record> *spilled = spill != nullptr ? spill->get_records(dir) : nullptr;
+	deque<catalogue_spill::record>::const_iterator next_spilled;
+
+	    // run is dumped as a chunk if it is large enough, else it is left in dir
+	auto flush_run = [&]()
+	    {
+		if(run_info.entries >= CATALOGUE_CHUNK_ENTRIES / 4)
+		{
+		    catalogue_chunk::dump(f, dir_index, run_pos, run);
+		    omitted.insert(run.begin(), run.end());
+		}
+		else
+		    dir_counter += run_info.dirs;
+		run.clear();
+		run_info.entries = 0;
+		run_info.dirs = 0;
+	    };
+
+	    // chunks spilled while the catalogue was built take place of the entries they were made of
+	auto dump_spilled = [&]()
+	    {
+		while(spilled != nullptr && next_spilled != spilled->end() && next_spilled->position == pos)
+		{
+		    flush_run();
+		    spill->dump(f, dir_index, *next_spilled);
+		    pos += next_spilled->num;
+		    ++next_spilled;
+		}
+	    };
+
+	if(spilled != nullptr)
+	    next_spilled = spilled->begin();
+
+	dir->for_each_children([&](const cat_nomme *child)
+			       {
+				   const cat_directory *child_dir = dynamic_cast<const cat_directory *>(child);
+				   chunk_tree_info child_info = { 1, 0, dynamic_cast<const cat_mirage *>(child) != nullptr };
+
+				   if(dynamic_cast<const cat_ignored *>(child) != nullptr)
+				       return; // not dumped, thus not counted in positions
+
+				   dump_spilled();
+
+				   if(dynamic_cast<const cat_ignored_dir *>(child) != nullptr)
+				       child_info.dirs = 1; // read back as an empty directory
+
+				   if(child_dir != nullptr)
+				   {
+				       map<const cat_directory *, chunk_tree_info>::const_iterator it = info.find(child_dir);
+
+				       if(it == info.end())
+					   throw SRC_BUG;
+				       child_info.entries += it->second.entries;
+				       child_info.dirs = it->second.dirs;
+				       child_info.mirage = it->second.mirage;
+				   }
+
+				   if(!child_info.mirage
+				      && child_info.entries <= CATALOGUE_CHUNK_ENTRIES
+				      && (child_dir == nullptr || spill == nullptr || !spill->is_large(child_dir)))
+				   {
+				       if(run.empty())
+					   run_pos = pos;
+				       run.push_back(child);
+				       run_info.entries += child_info.entries;
+				       run_info.dirs += child_info.dirs;
+				       if(run_info.entries >= CATALOGUE_CHUNK_ENTRIES)
+					   flush_run();
+				   }
+				   else
+				   {
+				       flush_run();
+				       if(child_dir != nullptr)
+					   chunk_dump_tree(f, child_dir, dir_counter, info, spill, omitted);
+				   }
+
+				   ++pos;
+			       });
+
+	dump_spilled();
+	if(spilled != nullptr && next_spilled != spilled->end())
+	    throw SRC_BUG; // spilled chunk position does not match the entries left in memory
+	flush_run();
+    }
+
+    static void chunk_list_dirs(cat_directory *dir, deque<cat_directory *> & dirs)
+    {
+	if(dir == nullptr)
+	    throw SRC_BUG;
+
+	dirs.push_back(dir);
+	dir->for_each_children([&](cat_nomme *child)
+			       {
+				   cat_directory *child_dir = dynamic_cast<cat_directory *>(child);
+
+				   if(child_dir != nullptr)
+				       chunk_list_dirs(child_dir, dirs);
+			       });
+    }
+
+} // end of namespace
@@ -48,6 +48,7 @@ extern "C"
 #include "cat_directory.hpp"
 #include "mem_ui.hpp"
 #include "delta_sig_block_size.hpp"
+#include "catalogue_spill.hpp"
 
 namespace libdar
 {
@@ -68,7 +69,9 @@ namespace libdar
 		  compression default_algo,
 		  bool lax,
 		  const label & lax_layer1_data_name, // ignored unless in lax mode, in lax mode unless it is a cleared label, forces the catalogue label to be equal to the lax_layer1_data_name for it be considered a plain internal catalogue, even in case of corruption
-		  bool only_detruit = false); // if set to true, only directories and detruit objects are read from the archive
+		  bool only_detruit = false, // if set to true, only directories and detruit objects are read from the archive
+		  U_I decoding_threads = 1, // number of threads to build the catalogue chunks with (see catalogue_chunk.hpp), 1 for no additional thread
+		  bool skeleton_only = false); // if set to true, the catalogue chunks are skipped, only the entries stored out of chunks are read (see catalogue_stream.hpp)
         catalogue(const catalogue & ref) : mem_ui(ref), out_compare(ref.out_compare), in_place(ref.in_place) { partial_copy_from(ref); };
 	catalogue(catalogue && ref) = delete;
         catalogue & operator = (const catalogue &ref);
@@ -97,6 +100,17 @@ namespace libdar
 	    /// return true if the catalogue has been released from memory
 	bool get_memory_released() const { return mem_released; };
 
+	    /// store to a temporary file the entries of large directories as soon as they are completed
+
+	    /// \param[in] directory where to create the temporary file
+	    /// \note this must be called before any entry is added and only suits the additions done
+	    /// at backup time. The entries spilled to disk are not available anymore for reading or
+	    /// comparison, the catalogue can then only be dumped, the way it would have been without spilling
+	void set_spill_directory(const std::string & directory);
+
+	    /// whether some entries are only present in the temporary file set by set_spill_directory()
+	bool has_spilled_entries() const { return spill && spill->has_records(); };
+
 	    // reading methods. The reading is iterative and uses the current_read cat_directory pointer
 
         virtual void reset_read() const; // set the reading cursor to the beginning of the catalogue
@@ -314,6 +328,7 @@ namespace libdar
 	bool early_mem_release;                   ///< whether to release memory as soon as possible
 	mutable bool mem_released;                ///< wether the catalogue content has been released and the object is no more usable
 	escape* faked_escape;                     ///< used when reading an archive with the help of an isolated catalog to keep trace of the sequential read mode if any
+	std::unique_ptr<catalogue_spill> spill;   ///< where entries are spilled to while added, if set
 
         void partial_copy_from(const catalogue &ref);
         void detruire();
@@ -0,0 +1,256 @@
+/*********************************************************************/
+// dar - disk archive - a backup/restoration program
+// Copyright (C) 2002-2026 Denis Corbin
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// to contact the author, see the AUTHOR file
+/*********************************************************************/
+
+#include "../my_config.h"
+
+extern "C"
+{
+}
+
+#include <map>
+#include "catalogue_chunk.hpp"
+#include "cat_all_entrees.hpp"
+#include "compressor.hpp"
+#include "tronc.hpp"
+#include "pile.hpp"
+#include "pile_descriptor.hpp"
+#include "smart_pointer.hpp"
+#include "null_file.hpp"
+#include "erreurs.hpp"
+
+using namespace std;
+
+namespace libdar
+{
+
+    catalogue_chunk::catalogue_chunk(generic_file & f, const infinint & size):
+	failed(false)
+    {
+	if(size.is_zero())
+	    throw SRC_BUG;
+
+	dir_index.read(f);
+	position.read(f);
+	num.read(f);
+
+	data.reset(new (nothrow) memory_file());
+	if(!data)
+	    throw Ememory();
+
+	if(f.copy_to(*data, size) != size)
+	    throw Erange(gettext("incoherent catalogue structure"));
+
+	stats.clear();
+    }
+
+    catalogue_chunk::~catalogue_chunk()
+    {
+	for(deque<cat_nomme *>::iterator it = entries.begin(); it != entries.end(); ++it)
+	{
+	    try
+	    {
+		if(*it != nullptr)
+		    delete *it;
+	    }
+	    catch(...)
+	    {
+		    // ignore all exceptions
+	    }
+	}
+    }
+
+    void catalogue_chunk::decode(const shared_ptr<user_interaction> & dialog,
+				 const archive_version & reading_ver,
+				 compression default_algo,
+				 bool lax,
+				 bool only_detruit)
+    {
+	pile stack;
+	map <infinint, cat_etoile *> corres;
+	memory_file *mem = data.release();
+	tronc *clear = nullptr;
+	compressor *zip = nullptr;
+	infinint count = 0;
+
+	if(mem == nullptr)
+	    throw SRC_BUG; // decode() already called
+
+	stack.push(mem);
+	    // compressor only reads or writes when built over a read-only or write-only file
+	clear = new (nothrow) tronc(mem, 0, mem->size(), gf_read_only);
+	if(clear == nullptr)
+	    throw Ememory();
+	clear->check_underlying_position_while_reading_or_writing(false); // mem is not accessed by anything else
+	stack.push(clear);
+	clear->skip(0);
+	zip = new (nothrow) compressor(compression::none, *clear);
+	if(zip == nullptr)
+	    throw Ememory();
+	stack.push(zip);
+
+	smart_pointer<pile_descriptor> spdesc(new (nothrow) pile_descriptor(&stack));
+	if(spdesc.is_null())
+	    throw Ememory();
+
+	while(count < num)
+	{
+	    cat_entree *p = nullptr;
+	    cat_nomme *t = nullptr;
+
+	    try
+	    {
+		p = cat_entree::read(dialog, spdesc, reading_ver, stats, corres, default_algo, lax, only_detruit, false);
+	    }
+	    catch(Euser_abort & e)
+	    {
+		throw;
+	    }
+	    catch(Ethread_cancel & e)
+	    {
+		throw;
+	    }
+	    catch(Egeneric & e)
+	    {
+		if(!lax)
+		    throw;
+		dialog->message(string(gettext("LAX MODE: Error met building a catalogue entry, skipping the rest of the catalogue chunk and continuing. Skipped error is: ")) + e.get_message());
+		break;
+	    }
+
+	    if(p == nullptr)
+	    {
+		if(!lax)
+		    throw Erange(gettext("incoherent catalogue structure"));
+		break;
+	    }
+
+	    t = dynamic_cast<cat_nomme *>(p);
+	    if(t == nullptr || dynamic_cast<cat_mirage *>(p) != nullptr)
+	    {
+		    // no cat_eod nor hard linked inode can be found at first level of a chunk
+		delete p;
+		if(!lax)
+		    throw Erange(gettext("incoherent catalogue structure"));
+		break;
+	    }
+
+	    if(!only_detruit
+	       || dynamic_cast<cat_directory *>(t) != nullptr
+	       || dynamic_cast<cat_detruit *>(t) != nullptr)
+	    {
+		try
+		{
+		    entries.push_back(t);
+		}
+		catch(...)
+		{
+		    delete t;
+		    throw;
+		}
+	    }
+	    else
+		delete t;
+
+	    ++count;
+	}
+    }
+
+    void catalogue_chunk::skip(generic_file & f, const infinint & size)
+    {
+	infinint tmp;
+	null_file black_hole(gf_write_only);
+
+	if(size.is_zero())
+	    throw SRC_BUG;
+
+	tmp.read(f); // dir_index
+	tmp.read(f); // position
+	tmp.read(f); // num
+
+	if(f.copy_to(black_hole, size) != size)
+	    throw Erange(gettext("incoherent catalogue structure"));
+    }
+
+    void catalogue_chunk::dump(generic_file & f,
+			       U_I dir_index,
+			       U_I position,
+			       const deque<const cat_nomme *> & entries)
+    {
+	memory_file mem;
+
+	encode(mem, entries);
+	mem.skip(0);
+	dump(f, dir_index, position, entries.size(), mem, mem.size());
+    }
+
+    void catalogue_chunk::dump(generic_file & f,
+			       U_I dir_index,
+			       U_I position,
+			       U_I num,
+			       generic_file & data,
+			       const infinint & size)
+    {
+	if(size.is_zero())
+	    throw SRC_BUG; // a zero size would be read as the end of the chunk list
+
+	size.dump(f);
+	infinint(dir_index).dump(f);
+	infinint(position).dump(f);
+	infinint(num).dump(f);
+	if(data.copy_to(f, size) != size)
+	    throw Erange(gettext("incoherent catalogue structure"));
+    }
+
+    void catalogue_chunk::encode(memory_file & mem, const deque<const cat_nomme *> & entries)
+    {
+	pile stack;
+	tronc *clear = new (nothrow) tronc(&mem, 0, gf_write_only);
+	compressor *zip = nullptr;
+
+	if(clear == nullptr)
+	    throw Ememory();
+	stack.push(clear);
+	clear->check_underlying_position_while_reading_or_writing(false); // mem is not accessed by anything else
+	zip = new (nothrow) compressor(compression::none, *clear);
+	if(zip == nullptr)
+	    throw Ememory();
+	stack.push(zip);
+
+	pile_descriptor pdesc(&stack);
+
+	for(deque<const cat_nomme *>::const_iterator it = entries.begin(); it != entries.end(); ++it)
+	{
+	    if(*it == nullptr)
+		throw SRC_BUG;
+	    (*it)->specific_dump(pdesc, false);
+	}
+	stack.sync_write();
+
+	if(mem.size().is_zero())
+	    throw SRC_BUG; // a zero size would be read as the end of the chunk list
+    }
+
+    void catalogue_chunk::dump_end(generic_file & f)
+    {
+	infinint(0).dump(f);
+    }
+
+} // end of namespace
@@ -0,0 +1,161 @@
+/*********************************************************************/
+// dar - disk archive - a backup/restoration program
+// Copyright (C) 2002-2026 Denis Corbin
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// to contact the author, see the AUTHOR file
+/*********************************************************************/
+
+    /// \file catalogue_chunk.hpp
+    /// \brief part of a catalogue that can be decoded independently from the rest of the catalogue
+    /// \ingroup Private
+    ///
+    /// Since archive format 12.1 the catalogue starts with a list of chunks, each holding a run of
+    /// consecutive entries of a directory with their whole subtree. These entries do not contain
+    /// any hard linked inode, thus they do not depend on anything read before. The rest of the
+    /// catalogue follows the chunk list, the way it was stored in previous formats but without
+    /// the entries found in chunks, which are put back in place once both have been read.
+    ///
+    /// On disk, a chunk is made of its size in byte, the pre-order index of the directory it
+    /// belongs to, counting only directories stored outside chunks, the position of its first entry
+    /// among the children of that directory, the number of entries it contains and the entries
+    /// themselves. A zero size ends the chunk list.
+
+#ifndef CATALOGUE_CHUNK_HPP
+#define CATALOGUE_CHUNK_HPP
+
+#include "../my_config.h"
+
+#include <deque>
+#include <memory>
+#include <string>
+#include "infinint.hpp"
+#include "user_interaction.hpp"
+#include "archive_version.hpp"
+#include "compression.hpp"
+#include "entree_stats.hpp"
+#include "memory_file.hpp"
+#include "cat_nomme.hpp"
+
+namespace libdar
+{
+
+	/// \addtogroup Private
+	/// @{
+
+	/// number of entries a catalogue chunk is made of
+
+	/// entries of catalogues smaller than twice this value are not split in chunks
+    constexpr U_I CATALOGUE_CHUNK_ENTRIES = 16384;
+
+	/// a catalogue chunk read from an archive
+
+    class catalogue_chunk
+    {
+    public:
+	    /// read the chunk header and data from the given file
+
+	    /// \param[in,out] f the file to read from
+	    /// \param[in] size the chunk size already read from f
+	catalogue_chunk(generic_file & f, const infinint & size);
+	catalogue_chunk(const catalogue_chunk & ref) = delete;
+	catalogue_chunk(catalogue_chunk && ref) noexcept = delete;
+	catalogue_chunk & operator = (const catalogue_chunk & ref) = delete;
+	catalogue_chunk & operator = (catalogue_chunk && ref) noexcept = delete;
+	~catalogue_chunk();
+
+	    /// build the entries from the chunk data, which is released afterward
+
+	    /// \note entries are built with a pile_descriptor that only lives for the duration of
+	    /// the call, change_location() has to be called on them before any further use
+	void decode(const std::shared_ptr<user_interaction> & dialog,
+		    const archive_version & reading_ver,
+		    compression default_algo,
+		    bool lax,
+		    bool only_detruit);
+
+	    /// record the reason decode() failed, when run from another thread
+	void set_error(const std::string & message) { error = message; failed = true; };
+
+	    /// whether decode() failed
+	bool has_failed() const { return failed; };
+
+	    /// the reason decode() failed
+	const std::string & get_error() const { return error; };
+
+	const infinint & get_dir_index() const { return dir_index; };
+	const infinint & get_position() const { return position; };
+
+	    /// entries built by decode(), the caller may take their ownership by clearing the deque
+	std::deque<cat_nomme *> & get_entries() { return entries; };
+
+	    /// statistics of the entries built by decode()
+	const entree_stats & get_stats() const { return stats; };
+
+	    /// read the chunk header and data from the given file without keeping them
+
+	    /// \param[in,out] f the file to read from
+	    /// \param[in] size the chunk size already read from f
+	static void skip(generic_file & f, const infinint & size);
+
+	    /// write a chunk made of the given entries to f
+
+	    /// \param[in,out] f where to write the chunk to
+	    /// \param[in] dir_index pre-order index of the directory the entries belong to
+	    /// \param[in] position index of the first entry among the children of that directory
+	    /// \param[in] entries entries to write, with their subtree
+	static void dump(generic_file & f,
+			 U_I dir_index,
+			 U_I position,
+			 const std::deque<const cat_nomme *> & entries);
+
+	    /// write a chunk which data has already been produced by encode()
+
+	    /// \param[in,out] f where to write the chunk to
+	    /// \param[in] dir_index pre-order index of the directory the entries belong to
+	    /// \param[in] position index of the first entry among the children of that directory
+	    /// \param[in] num number of entries the data is made of
+	    /// \param[in,out] data where to read the chunk data from, at its current position
+	    /// \param[in] size amount of byte of chunk data to copy from data
+	static void dump(generic_file & f,
+			 U_I dir_index,
+			 U_I position,
+			 U_I num,
+			 generic_file & data,
+			 const infinint & size);
+
+	    /// write the chunk data of the given entries to mem, which is expected empty
+	static void encode(memory_file & mem, const std::deque<const cat_nomme *> & entries);
+
+	    /// write the end of the chunk list to f
+	static void dump_end(generic_file & f);
+
+    private:
+	infinint dir_index;
+	infinint position;
+	infinint num;
+	std::unique_ptr<memory_file> data;
+	std::deque<cat_nomme *> entries;
+	entree_stats stats;
+	bool failed;
+	std::string error;
+    };
+
+	/// @}
+
+} // end of namespace
+
+#endif
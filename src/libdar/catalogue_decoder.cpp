@@ -0,0 +1,240 @@
+/*********************************************************************/
+// dar - disk archive - a backup/restoration program
+// Copyright (C) 2002-2026 Denis Corbin
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// to contact the author, see the AUTHOR file
+/*********************************************************************/
+
+#include "../my_config.h"
+
+extern "C"
+{
+}
+
+#include "catalogue_decoder.hpp"
+#include "erreurs.hpp"
+
+using namespace std;
+using namespace libthreadar;
+
+namespace libdar
+{
+
+	/////////////////////////////////////////////////////
+        //
+        // catalogue_decoder class implementation
+        //
+        //
+
+    catalogue_decoder::catalogue_decoder(U_I num_workers,
+					 const archive_version & x_reading_ver,
+					 compression x_default_algo,
+					 bool x_only_detruit):
+	reading_ver(x_reading_ver),
+	default_algo(x_default_algo),
+	only_detruit(x_only_detruit),
+	cond(2),
+	in_flight(0),
+	stop(false)
+    {
+	if(num_workers == 0)
+	    throw SRC_BUG;
+
+	for(U_I i = 0; i < num_workers; ++i)
+	{
+	    workers.push_back(make_unique<catalogue_decoder_worker>(*this));
+	    workers.back()->run();
+	}
+    }
+
+    catalogue_decoder::~catalogue_decoder()
+    {
+	cond.lock();
+	stop = true;
+	cond.broadcast(cond_worker);
+	cond.unlock();
+
+	for(deque<unique_ptr<catalogue_decoder_worker> >::iterator it = workers.begin();
+	    it != workers.end();
+	    ++it)
+	{
+	    try
+	    {
+		if(*it)
+		    (*it)->join();
+	    }
+	    catch(...)
+	    {
+		    // ignore all exceptions
+	    }
+	}
+    }
+
+    void catalogue_decoder::submit(catalogue_chunk *chunk)
+    {
+	if(chunk == nullptr)
+	    throw SRC_BUG;
+
+	cond.lock();
+	try
+	{
+	    pending.push_back(chunk);
+	    ++in_flight;
+	    cond.signal(cond_worker);
+	}
+	catch(...)
+	{
+	    cond.unlock();
+	    throw;
+	}
+	cond.unlock();
+    }
+
+    void catalogue_decoder::wait_all()
+    {
+	cond.lock();
+	try
+	{
+	    while(in_flight > 0)
+		cond.wait(cond_caller);
+	}
+	catch(...)
+	{
+	    cond.unlock();
+	    throw;
+	}
+	cond.unlock();
+    }
+
+    bool catalogue_decoder::pop_message(string & message)
+    {
+	bool ret = false;
+
+	cond.lock();
+	if(!messages.empty())
+	{
+	    message = messages.front();
+	    messages.pop_front();
+	    ret = true;
+	}
+	cond.unlock();
+
+	return ret;
+    }
+
+    catalogue_chunk *catalogue_decoder::next_chunk()
+    {
+	catalogue_chunk *ret = nullptr;
+
+	cond.lock();
+	try
+	{
+	    while(pending.empty() && !stop)
+		cond.wait(cond_worker);
+
+	    if(!pending.empty())
+	    {
+		ret = pending.front();
+		pending.pop_front();
+	    }
+	}
+	catch(...)
+	{
+	    cond.unlock();
+	    throw;
+	}
+	cond.unlock();
+
+	return ret;
+    }
+
+    void catalogue_decoder::chunk_done()
+    {
+	cond.lock();
+	if(in_flight == 0)
+	{
+	    cond.unlock();
+	    throw SRC_BUG;
+	}
+	--in_flight;
+	cond.broadcast(cond_caller);
+	cond.unlock();
+    }
+
+    void catalogue_decoder::record_message(const string & message)
+    {
+	cond.lock();
+	messages.push_back(message);
+	cond.unlock();
+    }
+
+
+	/////////////////////////////////////////////////////
+        //
+        // catalogue_decoder_ui class implementation
+        //
+        //
+
+    string catalogue_decoder_ui::inherited_get_string(const string & message, bool echo)
+    {
+	throw Euser_abort(message);
+    }
+
+    secu_string catalogue_decoder_ui::inherited_get_secu_string(const string & message, bool echo)
+    {
+	throw Euser_abort(message);
+    }
+
+
+	/////////////////////////////////////////////////////
+        //
+        // catalogue_decoder_worker class implementation
+        //
+        //
+
+    catalogue_decoder_worker::catalogue_decoder_worker(catalogue_decoder & owner):
+	pool(owner)
+    {
+	ui.reset(new (nothrow) catalogue_decoder_ui(owner));
+	if(!ui)
+	    throw Ememory();
+    }
+
+    void catalogue_decoder_worker::inherited_run()
+    {
+	catalogue_chunk *chunk = nullptr;
+
+	while((chunk = pool.next_chunk()) != nullptr)
+	{
+	    try
+	    {
+		chunk->decode(ui, pool.reading_ver, pool.default_algo, false, pool.only_detruit);
+	    }
+	    catch(Egeneric & e)
+	    {
+		chunk->set_error(e.get_message());
+	    }
+	    catch(...)
+	    {
+		chunk->set_error(gettext("Unexpected exception caught while reading the catalogue"));
+	    }
+
+	    pool.chunk_done();
+	}
+    }
+
+} // end of namespace
@@ -0,0 +1,153 @@
+/*********************************************************************/
+// dar - disk archive - a backup/restoration program
+// Copyright (C) 2002-2026 Denis Corbin
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// to contact the author, see the AUTHOR file
+/*********************************************************************/
+
+    /// \file catalogue_decoder.hpp
+    /// \brief worker threads building catalogue entries from catalogue chunks
+    /// \ingroup Private
+    ///
+    /// The caller thread reads the catalogue from the archive and hands each catalogue_chunk
+    /// to a catalogue_decoder as soon as it has been read, then goes on reading the rest of
+    /// the catalogue while the worker threads build the entries of the chunks.
+
+#ifndef CATALOGUE_DECODER_HPP
+#define CATALOGUE_DECODER_HPP
+
+#include "../my_config.h"
+
+#include <string>
+#include <deque>
+#include <memory>
+#include "integers.hpp"
+#include "user_interaction.hpp"
+#include "archive_version.hpp"
+#include "compression.hpp"
+#include "catalogue_chunk.hpp"
+
+#include <libthreadar/libthreadar.hpp>
+
+namespace libdar
+{
+
+	/// \addtogroup Private
+	/// @{
+
+    class catalogue_decoder_worker;
+
+	/// pool of threads decoding catalogue chunks
+
+    class catalogue_decoder
+    {
+    public:
+	    /// constructor
+
+	    /// \param[in] num_workers number of threads to launch
+	    /// \param[in] x_reading_ver format of the archive the chunks come from
+	    /// \param[in] x_default_algo default compression algorithm for old archive formats
+	    /// \param[in] x_only_detruit whether only directories and detruit objects have to be kept
+	catalogue_decoder(U_I num_workers,
+			  const archive_version & x_reading_ver,
+			  compression x_default_algo,
+			  bool x_only_detruit);
+	catalogue_decoder(const catalogue_decoder & ref) = delete;
+	catalogue_decoder(catalogue_decoder && ref) noexcept = delete;
+	catalogue_decoder & operator = (const catalogue_decoder & ref) = delete;
+	catalogue_decoder & operator = (catalogue_decoder && ref) noexcept = delete;
+
+	    /// destructor completes the submitted chunks and stops the threads
+	~catalogue_decoder();
+
+	    /// hand a chunk to the worker threads
+
+	    /// \note the chunk is not owned and must survive until wait_all() returns or the object is destroyed
+	void submit(catalogue_chunk *chunk);
+
+	    /// wait for all submitted chunks to be decoded
+	void wait_all();
+
+	    /// fetch and remove the oldest message recorded by the worker threads
+
+	    /// \return false if no message is pending, in which case the argument is not modified
+	bool pop_message(std::string & message);
+
+    private:
+	static constexpr unsigned int cond_worker = 0; ///< condition instance workers wait on for a new chunk
+	static constexpr unsigned int cond_caller = 1; ///< condition instance the caller waits on for a chunk completion
+
+	archive_version reading_ver;
+	compression default_algo;
+	bool only_detruit;
+
+	libthreadar::condition cond;                 ///< protects the following fields
+	std::deque<catalogue_chunk *> pending;       ///< chunks not yet started
+	U_I in_flight;                               ///< number of chunks pending or being decoded
+	bool stop;                                   ///< whether workers have to end once no more chunk is pending
+	std::deque<std::string> messages;            ///< messages recorded by the workers
+	std::deque<std::unique_ptr<catalogue_decoder_worker> > workers; ///< the threads
+
+	catalogue_chunk *next_chunk();  ///< called by workers, nullptr means the worker has to end
+	void chunk_done();
+	void record_message(const std::string & message);
+
+	friend class catalogue_decoder_worker;
+	friend class catalogue_decoder_ui;
+    };
+
+
+	/// user_interaction given to the catalogue entries built by a catalogue_decoder_worker
+
+	/// messages are recorded in the pool for the caller thread to display them,
+	/// questions are answered negatively
+    class catalogue_decoder_ui: public user_interaction
+    {
+    public:
+	catalogue_decoder_ui(catalogue_decoder & owner): pool(owner) {};
+
+    protected:
+	virtual void inherited_message(const std::string & message) override { pool.record_message(message); };
+	virtual bool inherited_pause(const std::string & message) override { pool.record_message(message); return false; };
+	virtual std::string inherited_get_string(const std::string & message, bool echo) override;
+	virtual secu_string inherited_get_secu_string(const std::string & message, bool echo) override;
+
+    private:
+	catalogue_decoder & pool;
+    };
+
+
+	/// thread of a catalogue_decoder
+
+    class catalogue_decoder_worker: public libthreadar::thread
+    {
+    public:
+	catalogue_decoder_worker(catalogue_decoder & owner);
+
+    protected:
+	virtual void inherited_run() override;
+
+    private:
+	catalogue_decoder & pool;
+	std::shared_ptr<user_interaction> ui;
+    };
+
+	/// @}
+
+} // end of namespace
+
+#endif
@@ -0,0 +1,222 @@
+/*********************************************************************/
+// dar - disk archive - a backup/restoration program
+// Copyright (C) 2002-2026 Denis Corbin
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// to contact the author, see the AUTHOR file
+/*********************************************************************/
+
+#include "../my_config.h"
+
+extern "C"
+{
+}
+
+#include "catalogue_spill.hpp"
+#include "catalogue_chunk.hpp"
+#include "cat_all_entrees.hpp"
+#include "memory_file.hpp"
+#include "filesystem_tools.hpp"
+#include "path.hpp"
+#include "tools.hpp"
+#include "erreurs.hpp"
+
+using namespace std;
+
+namespace libdar
+{
+
+    catalogue_spill::dir_state::dir_state(cat_directory *x_dir):
+	dir(x_dir),
+	count(0),
+	pos(0),
+	entries(0),
+	mirage(false),
+	run_start(0),
+	run_end(0),
+	run_pos(0),
+	run_num(0),
+	run_entries(0),
+	run_full(false)
+    {
+	if(dir == nullptr)
+	    throw SRC_BUG;
+    }
+
+    catalogue_spill::catalogue_spill(const shared_ptr<user_interaction> & dialog,
+				     const string & directory,
+				     cat_directory *root): mem_ui(dialog)
+    {
+	string filename;
+
+	if(root == nullptr)
+	    throw SRC_BUG;
+	if(root->has_children())
+	    throw SRC_BUG; // entries added so far would not be accounted
+
+	tmp.reset(filesystem_tools_create_non_existing_file_based_on(dialog,
+								     "dar_catalogue_spill",
+								     path(directory),
+								     filename));
+	if(!tmp)
+	    throw Ememory();
+	    // the file disappears with the last descriptor on it, even if we crash
+	tools_unlink(filename);
+
+	stack.push_back(dir_state(root));
+    }
+
+    void catalogue_spill::added(cat_nomme *ref)
+    {
+	cat_directory *ref_dir = dynamic_cast<cat_directory *>(ref);
+
+	if(stack.empty())
+	    throw SRC_BUG;
+
+	dir_state & st = stack.back();
+
+	if(st.run_full)
+	    flush_run(st);
+
+	++st.count;
+	if(st.dir->get_children_at(st.count - 1) != ref)
+	    throw SRC_BUG; // ref has not been added to the directory we expected
+
+	if(dynamic_cast<cat_ignored *>(ref) != nullptr)
+	    return; // not dumped, thus not accounted
+
+	if(ref_dir != nullptr)
+	    stack.push_back(dir_state(ref_dir)); // accounted in its parent once completed
+	else
+	    account(st, 1, dynamic_cast<cat_mirage *>(ref) != nullptr, false);
+    }
+
+    void catalogue_spill::closed()
+    {
+	if(stack.size() < 2)
+	    throw SRC_BUG; // the root directory is never closed
+
+	dir_state & st = stack.back();
+	bool dir_large = st.mirage
+	    || st.entries >= CATALOGUE_CHUNK_ENTRIES
+	    || is_large(st.dir);
+
+	    // this is the only time the end of the run of a large directory is known,
+	    // the run of a small directory is part of the run its parent directory has
+	if(dir_large)
+	    flush_run(st);
+	dir_large = dir_large || is_large(st.dir);
+
+	dir_state done = st;
+	stack.pop_back();
+
+	dir_state & parent = stack.back();
+	if(parent.count == 0 || parent.dir->get_children_at(parent.count - 1) != done.dir)
+	    throw SRC_BUG;
+	account(parent, done.entries + 1, done.mirage, dir_large);
+    }
+
+    const deque<catalogue_spill::record> *catalogue_spill::get_records(const cat_directory *dir) const
+    {
+	map<const cat_directory *, deque<record> >::const_iterator it = records.find(dir);
+
+	if(it == records.end())
+	    return nullptr;
+	else
+	    return &(it->second);
+    }
+
+    void catalogue_spill::dump(generic_file & f, U_I dir_index, const record & rec) const
+    {
+	if(!tmp)
+	    throw SRC_BUG;
+	if(!tmp->skip(rec.offset))
+	    throw Erange(gettext("Cannot read back the catalogue parts spilled to disk"));
+	catalogue_chunk::dump(f, dir_index, rec.position, rec.num, *tmp, rec.size);
+    }
+
+    void catalogue_spill::account(dir_state & st, U_I entries, bool mirage, bool is_large)
+    {
+	st.entries += entries;
+	st.mirage = st.mirage || mirage;
+
+	    // same decision as the one taken when the catalogue is dumped
+	if(!is_large && !mirage && entries <= CATALOGUE_CHUNK_ENTRIES)
+	{
+	    if(st.run_num == 0)
+	    {
+		st.run_start = st.count - 1;
+		st.run_pos = st.pos;
+	    }
+	    st.run_end = st.count;
+	    ++st.run_num;
+	    st.run_entries += entries;
+		// the entry just added may still be used by the caller, the run is thus
+		// spilled when the next entry comes or when the directory ends
+	    if(st.run_entries >= CATALOGUE_CHUNK_ENTRIES)
+		st.run_full = true;
+	}
+	else
+	    flush_run(st);
+
+	++st.pos;
+    }
+
+    void catalogue_spill::flush_run(dir_state & st)
+    {
+	if(st.run_num > 0 && st.run_entries >= CATALOGUE_CHUNK_ENTRIES / 4)
+	{
+	    deque<const cat_nomme *> run;
+	    memory_file mem;
+	    record rec;
+	    U_I span = st.run_end - st.run_start;
+
+	    (void)st.dir->for_each_children(st.run_start, span, [&run](const cat_nomme *child)
+					    {
+						if(dynamic_cast<const cat_ignored *>(child) == nullptr)
+						    run.push_back(child);
+					    });
+	    if(run.size() != st.run_num)
+		throw SRC_BUG;
+
+	    catalogue_chunk::encode(mem, run);
+	    run.clear();
+
+	    if(!tmp)
+		throw SRC_BUG;
+	    tmp->skip_to_eof();
+	    rec.position = st.run_pos;
+	    rec.num = st.run_num;
+	    rec.offset = tmp->get_position();
+	    rec.size = mem.size();
+	    mem.skip(0);
+	    if(mem.copy_to(*tmp, rec.size) != rec.size)
+		throw SRC_BUG;
+	    records[st.dir].push_back(rec);
+
+	    st.dir->release_children(st.run_start, span);
+	    st.count -= span;
+
+	    for(const cat_directory *d = st.dir; d != nullptr; d = d->get_parent())
+		large.insert(d);
+	}
+
+	st.run_num = 0;
+	st.run_entries = 0;
+	st.run_full = false;
+    }
+
+} // end of namespace
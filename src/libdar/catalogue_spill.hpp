@@ -0,0 +1,141 @@
+/*********************************************************************/
+// dar - disk archive - a backup/restoration program
+// Copyright (C) 2002-2026 Denis Corbin
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// to contact the author, see the AUTHOR file
+/*********************************************************************/
+
+    /// \file catalogue_spill.hpp
+    /// \brief catalogue chunks written to a temporary file while the catalogue is built
+    /// \ingroup Private
+    ///
+    /// When dumped, the catalogue stores runs of consecutive entries of large directories
+    /// as catalogue chunks (see catalogue_chunk.hpp). As entries are added in order during
+    /// a backup, the runs that will become chunks are known as soon as they are complete:
+    /// they are encoded at that time to an unlinked temporary file and removed from memory,
+    /// the catalogue copying them back from that file in place of the chunks it would have
+    /// produced from these entries when it is dumped. The archive format is thus unchanged.
+
+#ifndef CATALOGUE_SPILL_HPP
+#define CATALOGUE_SPILL_HPP
+
+#include "../my_config.h"
+
+#include <deque>
+#include <map>
+#include <set>
+#include <memory>
+#include <string>
+#include "infinint.hpp"
+#include "mem_ui.hpp"
+#include "generic_file.hpp"
+#include "fichier_local.hpp"
+#include "cat_directory.hpp"
+
+namespace libdar
+{
+
+	/// \addtogroup Private
+	/// @{
+
+	/// chunks of the catalogue under construction stored in a temporary file
+
+    class catalogue_spill: public mem_ui
+    {
+    public:
+	    /// a chunk spilled to the temporary file
+	struct record
+	{
+	    U_I position;   ///< position of the first entry among the children of the directory
+	    U_I num;        ///< number of entries of the chunk
+	    infinint offset; ///< where the chunk data is located in the temporary file
+	    infinint size;  ///< size of the chunk data
+	};
+
+	    /// constructor
+
+	    /// \param[in] dialog for user interaction
+	    /// \param[in] directory where to create the temporary file, which is unlinked right after its creation
+	    /// \param[in] root the root directory of the catalogue entries will be added to
+	catalogue_spill(const std::shared_ptr<user_interaction> & dialog,
+			const std::string & directory,
+			cat_directory *root);
+	catalogue_spill(const catalogue_spill & ref) = delete;
+	catalogue_spill(catalogue_spill && ref) noexcept = delete;
+	catalogue_spill & operator = (const catalogue_spill & ref) = delete;
+	catalogue_spill & operator = (catalogue_spill && ref) noexcept = delete;
+	~catalogue_spill() = default;
+
+	    /// to be called each time an entry has been added to the current directory of the catalogue
+
+	    /// \note this may release from memory some previously added siblings of the entry
+	void added(cat_nomme *ref);
+
+	    /// to be called when the end of the current directory of the catalogue has been reached
+	void closed();
+
+	    /// whether some entries have been spilled
+	bool has_records() const { return !records.empty(); };
+
+	    /// whether the directory has to be considered large when dumping the catalogue
+
+	    /// \note this is the case of directories which part of the tree has been spilled
+	bool is_large(const cat_directory *dir) const { return large.find(dir) != large.end(); };
+
+	    /// the chunks spilled from the given directory in their order, nullptr if none
+	const std::deque<record> *get_records(const cat_directory *dir) const;
+
+	    /// copy a chunk spilled from a directory to f
+
+	    /// \param[in,out] f where to write the chunk to
+	    /// \param[in] dir_index pre-order index of the directory the chunk belongs to
+	    /// \param[in] rec the chunk to copy, as returned by get_records()
+	void dump(generic_file & f, U_I dir_index, const record & rec) const;
+
+    private:
+	    /// a directory of the catalogue under construction not yet completed
+	struct dir_state
+	{
+	    cat_directory *dir;  ///< the directory
+	    U_I count;           ///< number of children dir has in memory
+	    U_I pos;             ///< number of non ignored children accounted so far
+	    U_I entries;         ///< number of entries in the tree accounted so far
+	    bool mirage;         ///< whether the tree contains hard linked inodes
+	    U_I run_start;       ///< index in dir of the first entry of the run
+	    U_I run_end;         ///< index in dir following the last entry of the run
+	    U_I run_pos;         ///< position of the first entry of the run
+	    U_I run_num;         ///< number of entries of the run
+	    U_I run_entries;     ///< number of entries in the run, subtrees included
+	    bool run_full;       ///< whether the run must be spilled before any other change in dir
+
+	    dir_state(cat_directory *x_dir);
+	};
+
+	std::unique_ptr<fichier_local> tmp;   ///< where chunk data is spilled, unlinked from the filesystem
+	std::deque<dir_state> stack;          ///< the directories being built, the root first
+	std::map<const cat_directory *, std::deque<record> > records; ///< spilled chunks per directory
+	std::set<const cat_directory *> large; ///< directories which tree has been partially spilled
+
+	void account(dir_state & st, U_I entries, bool mirage, bool is_large);
+	void flush_run(dir_state & st);
+    };
+
+	/// @}
+
+} // end of namespace
+
+#endif
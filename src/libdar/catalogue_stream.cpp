@@ -0,0 +1,477 @@
+/*********************************************************************/
+// dar - disk archive - a backup/restoration program
+// Copyright (C) 2002-2026 Denis Corbin
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// to contact the author, see the AUTHOR file
+/*********************************************************************/
+
+#include "../my_config.h"
+
+extern "C"
+{
+}
+
+#include "catalogue_stream.hpp"
+#include "cat_all_entrees.hpp"
+#include "label.hpp"
+#include "tools.hpp"
+#include "erreurs.hpp"
+
+using namespace std;
+
+namespace libdar
+{
+
+    catalogue_stream::frame::frame(const cat_directory *x_dir,
+				   bool x_indexed,
+				   U_I x_dir_index,
+				   const cat_directory *x_dest_parent):
+	dir(x_dir),
+	indexed(x_indexed),
+	dir_index(x_dir_index),
+	index(0),
+	position(0),
+	chunk_index(0),
+	fetched(false),
+	ahead(nullptr),
+	ahead_from_chunk(false),
+	dest_parent(x_dest_parent)
+    {
+	if(dir == nullptr)
+	    throw SRC_BUG;
+    }
+
+    catalogue_stream::catalogue_stream(const shared_ptr<user_interaction> & dialog,
+				       const catalogue & skeleton,
+				       pile & stack,
+				       const infinint & cat_start,
+				       const archive_version & reading_ver,
+				       compression default_algo,
+				       const path & fs_root,
+				       bool display_treated):
+	mem_ui(dialog),
+	skel(skeleton),
+	x_stack(stack),
+	x_ver(reading_ver),
+	x_algo(default_algo),
+	x_fs_root(fs_root),
+	x_display(display_treated),
+	dest(nullptr),
+	started(false),
+	out_depth(0),
+	dir_counter(0),
+	pending_dir(0),
+	pending_pos(0),
+	no_more_chunk(true),
+	destroyed(0)
+    {
+	spdesc.assign(new (nothrow) pile_descriptor(&x_stack));
+	if(spdesc.is_null())
+	    throw Ememory();
+
+	if(reading_ver >= archive_version(12,1))
+	{
+	    label data_name;
+	    string in_place;
+
+		// the catalogue chunks are located right after
+		// the data_name and the in_place path
+
+	    if(!x_stack.skip(cat_start))
+		throw Erange(gettext("Cannot skip back to the catalogue of the archive of reference"));
+	    data_name.read(x_stack);
+	    tools_read_string(x_stack, in_place);
+	    no_more_chunk = false;
+	    fetch_pending();
+	}
+	    // else, older formats have no chunk, the skeleton is the whole catalogue
+    }
+
+    void catalogue_stream::reset_compare(catalogue & x_dest)
+    {
+	if(started)
+	    throw Erange(gettext("A streamed catalogue of reference can only be compared once"));
+	if(skel.get_contenu() == nullptr)
+	    throw SRC_BUG;
+
+	dest = & x_dest;
+	started = true;
+	walk.clear();
+	walk.push_back(frame(skel.get_contenu(), true, 0, nullptr));
+	dir_counter = 1;
+	out_depth = 0;
+    }
+
+    bool catalogue_stream::compare(const cat_entree * target, const cat_entree * & extracted)
+    {
+	const cat_mirage *mir = dynamic_cast<const cat_mirage *>(target);
+	const cat_directory *dir = dynamic_cast<const cat_directory *>(target);
+	const cat_eod *fin = dynamic_cast<const cat_eod *>(target);
+	const cat_nomme *nom = dynamic_cast<const cat_nomme *>(target);
+	const cat_nomme *found = nullptr;
+	bool found_from_chunk = false;
+	const cat_nomme *cur = nullptr;
+
+	if(dest == nullptr || walk.empty())
+	    throw SRC_BUG; // reset_compare() not called
+
+	if(mir != nullptr)
+	    dir = dynamic_cast<const cat_directory *>(mir->get_inode());
+
+	if(out_depth > 0) // actually scanning a directory absent from the catalogue of reference
+	{
+	    if(dir != nullptr)
+		++out_depth;
+	    else
+		if(fin != nullptr)
+		    --out_depth;
+	    return false;
+	}
+
+	frame & here = walk.back();
+
+	if(fin != nullptr)
+	{
+	    if(walk.size() < 2)
+		throw Erange(gettext("root has no parent directory"));
+	    drain();
+	    leave();
+	    extracted = target;
+	    return true;
+	}
+
+	if(nom == nullptr)
+	    throw SRC_BUG; // neither a cat_eod nor a cat_nomme
+
+	if(!here.last_target.empty() && !(here.last_target < nom->get_name()))
+	    throw SRC_BUG; // the filesystem is not read in sorted order
+	here.last_target = nom->get_name();
+
+	    // entries of reference located before the target are no more present
+
+	while((cur = peek(here)) != nullptr && cur->get_name() < nom->get_name())
+	{
+	    bool cur_from_chunk = here.ahead_from_chunk;
+
+	    here.fetched = false;
+	    record_removed(cur, cur_from_chunk);
+	}
+
+	if(cur != nullptr && cur->get_name() == nom->get_name())
+	{
+	    found = cur;
+	    found_from_chunk = here.ahead_from_chunk;
+	    here.fetched = false;
+	}
+
+	if(found == nullptr)
+	{
+	    if(dir != nullptr)
+		++out_depth;
+	    return false;
+	}
+
+	const cat_detruit *src_det = dynamic_cast<const cat_detruit *>(nom);
+	const cat_detruit *dst_det = dynamic_cast<const cat_detruit *>(found);
+	const cat_inode *src_ino = dynamic_cast<const cat_inode *>(nom);
+	const cat_inode *dst_ino = dynamic_cast<const cat_inode *>(found);
+	const cat_mirage *src_mir = dynamic_cast<const cat_mirage *>(nom);
+	const cat_mirage *dst_mir = dynamic_cast<const cat_mirage *>(found);
+	const cat_directory *dst_dir = dynamic_cast<const cat_directory *>(found);
+
+	    // extracting cat_inode from hard links
+	if(src_mir != nullptr)
+	    src_ino = src_mir->get_inode();
+
+	if(dst_mir != nullptr)
+	    dst_ino = dst_mir->get_inode();
+
+	    // following the directory tree
+	if(dir != nullptr)
+	{
+	    if(dst_dir != nullptr)
+		enter(dst_dir, found_from_chunk);
+	    else
+		++out_depth;
+	}
+	else
+	    if(dst_dir != nullptr)
+		skip_subtree(dst_dir, found_from_chunk);
+
+	    // now comparing the objects
+	if(src_ino != nullptr)
+	{
+	    if(dst_ino == nullptr || !src_ino->same_as(*dst_ino))
+		return false;
+	}
+	else
+	    if(src_det != nullptr)
+	    {
+		if(dst_det == nullptr || !src_det->same_as(*dst_det))
+		    return false;
+	    }
+	    else
+		throw SRC_BUG; // neither a cat_detruit nor a cat_inode
+
+	if(dst_mir != nullptr)
+	    extracted = dst_mir->get_inode();
+	else
+	    extracted = found;
+	return true;
+    }
+
+    void catalogue_stream::finish()
+    {
+	if(dest == nullptr || walk.size() != 1 || out_depth != 0)
+	    throw SRC_BUG; // the walk has not reached back the root
+
+	drain();
+	if(pending)
+	    throw Erange(gettext("incoherent catalogue structure"));
+    }
+
+    void catalogue_stream::fetch_pending()
+    {
+	infinint size;
+
+	pending.reset();
+	if(no_more_chunk)
+	    return;
+
+	size.read(x_stack);
+	if(size.is_zero())
+	    no_more_chunk = true;
+	else
+	{
+	    infinint tmp;
+
+	    pending.reset(new (nothrow) catalogue_chunk(x_stack, size));
+	    if(!pending)
+		throw Ememory();
+
+	    tmp = pending->get_dir_index();
+	    pending_dir = 0;
+	    tmp.unstack(pending_dir);
+	    if(!tmp.is_zero())
+		throw Erange(gettext("incoherent catalogue structure"));
+	    tmp = pending->get_position();
+	    pending_pos = 0;
+	    tmp.unstack(pending_pos);
+	    if(!tmp.is_zero())
+		throw Erange(gettext("incoherent catalogue structure"));
+	}
+    }
+
+    const cat_nomme *catalogue_stream::next_children(frame & f, bool & from_chunk)
+    {
+	const cat_nomme *ret = nullptr;
+
+	while(ret == nullptr)
+	{
+	    if(f.chunk)
+	    {
+		deque<cat_nomme *> & entries = f.chunk->get_entries();
+
+		if(f.chunk_index < entries.size())
+		{
+		    ret = entries[f.chunk_index++];
+		    from_chunk = true;
+		    ++f.position;
+		    continue;
+		}
+		else
+		    f.chunk.reset(); // all entries of the chunk have been passed
+	    }
+
+	    if(f.indexed && pending && pending_dir == f.dir_index && pending_pos == f.position)
+	    {
+		f.chunk = std::move(pending);
+		f.chunk_index = 0;
+		fetch_pending();
+		f.chunk->decode(get_pointer(), x_ver, x_algo, false, false);
+
+		deque<cat_nomme *> & entries = f.chunk->get_entries();
+		for(deque<cat_nomme *>::iterator it = entries.begin(); it != entries.end(); ++it)
+		    (*it)->change_location(spdesc);
+		continue;
+	    }
+
+	    ret = f.dir->get_children_at(f.index);
+	    if(ret == nullptr)
+		break; // end of directory
+	    ++f.index;
+	    ++f.position;
+		// the subtree of a directory read from a chunk is part of that chunk too
+	    from_chunk = !f.indexed;
+	}
+
+	return ret;
+    }
+
+    const cat_nomme *catalogue_stream::peek(frame & f)
+    {
+	if(!f.fetched)
+	{
+	    f.ahead = next_children(f, f.ahead_from_chunk);
+	    f.fetched = true;
+	    if(f.ahead != nullptr)
+	    {
+		if(!f.last_ref.empty() && !(f.last_ref < f.ahead->get_name()))
+		    throw Erange(gettext("The archive of reference does not store the entries of each directory in sorted order, its catalogue cannot be streamed and has to be loaded in memory instead"));
+		f.last_ref = f.ahead->get_name();
+	    }
+	}
+
+	return f.ahead;
+    }
+
+    void catalogue_stream::enter(const cat_directory *dir, bool from_chunk)
+    {
+	const cat_directory *dest_parent = dest != nullptr ? & dest->get_current_add_dir() : nullptr;
+
+	    // directories found in chunks have no pre-order index
+	    // nor any chunk to insert in their subtree
+	if(from_chunk)
+	    walk.push_back(frame(dir, false, 0, dest_parent));
+	else
+	    walk.push_back(frame(dir, true, dir_counter++, dest_parent));
+    }
+
+    void catalogue_stream::leave()
+    {
+	if(walk.empty())
+	    throw SRC_BUG;
+
+	frame & f = walk.back();
+
+	if(f.indexed)
+	{
+	    if(pending && pending_dir == f.dir_index)
+		throw Erange(gettext("incoherent catalogue structure"));
+
+		// releasing the skeleton part we will not read again
+	    const_cast<cat_directory *>(f.dir)->clear();
+	}
+
+	walk.pop_back();
+    }
+
+    void catalogue_stream::skip_subtree(const cat_directory *dir, bool from_chunk)
+    {
+	deque<frame>::size_type depth = walk.size();
+
+	if(from_chunk)
+	    return; // nothing to read from the archive for that directory
+
+	enter(dir, false);
+	while(walk.size() > depth)
+	{
+	    bool sub_from_chunk = false;
+	    const cat_nomme *sub = next_children(walk.back(), sub_from_chunk);
+
+	    if(sub == nullptr)
+		leave();
+	    else
+	    {
+		const cat_directory *sub_dir = dynamic_cast<const cat_directory *>(sub);
+
+		if(sub_dir != nullptr && !sub_from_chunk)
+		    enter(sub_dir, false);
+	    }
+	}
+    }
+
+    void catalogue_stream::drain()
+    {
+	frame & here = walk.back();
+	const cat_nomme *cur = nullptr;
+
+	while((cur = peek(here)) != nullptr)
+	{
+	    bool cur_from_chunk = here.ahead_from_chunk;
+
+	    here.fetched = false;
+	    record_removed(cur, cur_from_chunk);
+	}
+    }
+
+    void catalogue_stream::record_removed(const cat_nomme *ref, bool from_chunk)
+    {
+	const cat_directory *ref_dir = dynamic_cast<const cat_directory *>(ref);
+
+	if(ref == nullptr || dest == nullptr)
+	    throw SRC_BUG;
+
+	if(dynamic_cast<const cat_detruit *>(ref) == nullptr
+	   && recording_place(walk.back()))
+	{
+	    const cat_directory & here = dest->get_current_add_dir();
+	    const cat_nomme *already = nullptr;
+
+		// entries not compared (filtered out, hard links already known...) are
+		// nevertheless present in the catalogue under construction
+
+	    if(!here.search_children(ref->get_name(), already))
+	    {
+		const cat_mirage *ref_mir = dynamic_cast<const cat_mirage *>(ref);
+		unsigned char firm = ref_mir != nullptr ? ref_mir->get_inode()->signature() : ref->signature();
+		cat_detruit *det_tmp = new (nothrow) cat_detruit(ref->get_name(), firm, here.get_last_modif());
+
+		if(det_tmp == nullptr)
+		    throw Ememory();
+
+		try
+		{
+		    if(x_display)
+		    {
+			path where = x_fs_root;
+
+			for(deque<frame>::iterator it = walk.begin() + 1; it != walk.end(); ++it)
+			    where += it->dir->get_name();
+			where += ref->get_name();
+			get_ui().message(tools_printf(gettext("Recording removed filed: %s"),
+						      where.display().c_str()));
+		    }
+		    dest->add(det_tmp, false);
+		}
+		catch(...)
+		{
+		    delete det_tmp;
+		    throw;
+		}
+		++destroyed;
+	    }
+	}
+
+	if(ref_dir != nullptr)
+	    skip_subtree(ref_dir, from_chunk);
+    }
+
+    bool catalogue_stream::recording_place(const frame & f) const
+    {
+	const cat_directory & here = dest->get_current_add_dir();
+
+	    // the directory where entries are added in the catalogue under construction
+	    // may not be the counterpart of f.dir, for example when an excluded directory
+	    // is kept as an empty directory
+	if(f.dest_parent == nullptr)
+	    return here.get_parent() == nullptr;
+	else
+	    return here.get_parent() == f.dest_parent && here.get_name() == f.dir->get_name();
+    }
+
+} // end of namespace
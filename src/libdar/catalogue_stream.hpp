@@ -0,0 +1,159 @@
+/*********************************************************************/
+// dar - disk archive - a backup/restoration program
+// Copyright (C) 2002-2026 Denis Corbin
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// to contact the author, see the AUTHOR file
+/*********************************************************************/
+
+    /// \file catalogue_stream.hpp
+    /// \brief catalogue of reference read while the filesystem is walked for backup
+    /// \ingroup Private
+    ///
+    /// Only the skeleton of the catalogue is kept in memory (the entries not stored in catalogue
+    /// chunks, see catalogue_chunk.hpp), the chunks are read again from the archive one after the
+    /// other when the walk reaches the place they belong to, and released once passed. As the
+    /// filesystem is read in sorted order and the catalogue of reference was built the same way,
+    /// both are joined like two sorted lists, entries of the catalogue of reference that are
+    /// passed without match being recorded as removed in the catalogue under construction.
+
+#ifndef CATALOGUE_STREAM_HPP
+#define CATALOGUE_STREAM_HPP
+
+#include "../my_config.h"
+
+#include <deque>
+#include <memory>
+#include <string>
+#include "infinint.hpp"
+#include "mem_ui.hpp"
+#include "catalogue.hpp"
+#include "catalogue_chunk.hpp"
+#include "pile.hpp"
+#include "pile_descriptor.hpp"
+#include "smart_pointer.hpp"
+#include "archive_version.hpp"
+#include "compression.hpp"
+#include "path.hpp"
+
+namespace libdar
+{
+
+	/// \addtogroup Private
+	/// @{
+
+	/// streaming comparison of a filesystem walk with a catalogue of reference
+
+    class catalogue_stream: public mem_ui
+    {
+    public:
+	    /// constructor
+
+	    /// \param[in] dialog for user interaction
+	    /// \param[in] skeleton catalogue read with the skeleton_only flag set, it is emptied as the comparison goes
+	    /// \param[in] stack the layers the skeleton has been read from, where the chunks will be read from
+	    /// \param[in] cat_start offset of the catalogue in stack
+	    /// \param[in] reading_ver format of the archive the skeleton comes from
+	    /// \param[in] default_algo default compression algorithm for old archive formats
+	    /// \param[in] fs_root root of the filesystem walk, used to display removed entries
+	    /// \param[in] display_treated whether to display entries recorded as removed
+	catalogue_stream(const std::shared_ptr<user_interaction> & dialog,
+			 const catalogue & skeleton,
+			 pile & stack,
+			 const infinint & cat_start,
+			 const archive_version & reading_ver,
+			 compression default_algo,
+			 const path & fs_root,
+			 bool display_treated);
+	catalogue_stream(const catalogue_stream & ref) = delete;
+	catalogue_stream(catalogue_stream && ref) noexcept = delete;
+	catalogue_stream & operator = (const catalogue_stream & ref) = delete;
+	catalogue_stream & operator = (catalogue_stream && ref) noexcept = delete;
+	~catalogue_stream() = default;
+
+	    /// start the comparison, which can only take place once
+
+	    /// \param[in,out] dest catalogue under construction where to record removed entries
+	void reset_compare(catalogue & dest);
+
+	    /// same as catalogue::compare() for entries provided in sorted order
+
+	    /// \note entries of the catalogue of reference located before target and not
+	    /// present in the catalogue under construction are recorded there as removed
+	bool compare(const cat_entree * target, const cat_entree * & extracted);
+
+	    /// record as removed the entries of the root directory not yet compared, to be called once the walk has completed
+	void finish();
+
+	    /// number of entries recorded as removed so far
+	const infinint & get_destroyed() const { return destroyed; };
+
+    private:
+
+	    /// a directory of the catalogue of reference being walked
+	struct frame
+	{
+	    const cat_directory *dir;             ///< the directory, part of the skeleton or of a chunk
+	    bool indexed;                         ///< whether the directory is part of the skeleton
+	    U_I dir_index;                        ///< pre-order index among skeleton directories (meaningful if indexed)
+	    U_I index;                            ///< index of the next children of dir to walk
+	    U_I position;                         ///< number of children walked, chunk entries included
+	    std::unique_ptr<catalogue_chunk> chunk; ///< chunk which entries are being walked
+	    U_I chunk_index;                      ///< index of the next entry of chunk to walk
+	    bool fetched;                         ///< whether ahead is valid
+	    const cat_nomme *ahead;               ///< next children not yet compared (nullptr at end of directory)
+	    bool ahead_from_chunk;                ///< whether ahead comes from a chunk
+	    std::string last_ref;                 ///< name of the last children walked
+	    std::string last_target;              ///< name of the last filesystem entry compared
+	    const cat_directory *dest_parent;     ///< directory of the destination catalogue where dir's counterpart has been added
+
+	    frame(const cat_directory *x_dir, bool x_indexed, U_I x_dir_index, const cat_directory *x_dest_parent);
+	};
+
+	const catalogue & skel;                  ///< the skeleton of the catalogue of reference
+	pile & x_stack;                          ///< where to read chunks from
+	smart_pointer<pile_descriptor> spdesc;   ///< given to entries read from chunks
+	archive_version x_ver;
+	compression x_algo;
+	path x_fs_root;
+	bool x_display;
+	catalogue *dest;                         ///< catalogue under construction
+	bool started;                            ///< whether reset_compare() has been called
+	std::deque<frame> walk;                  ///< directories being walked, the root first
+	U_I out_depth;                           ///< depth of the filesystem walk in directories absent from the catalogue of reference
+	U_I dir_counter;                         ///< pre-order index of the next skeleton directory to walk
+	std::unique_ptr<catalogue_chunk> pending; ///< next chunk to read
+	U_I pending_dir;                         ///< dir_index of pending
+	U_I pending_pos;                         ///< position of pending
+	bool no_more_chunk;                      ///< whether the end of chunk list has been read
+	infinint destroyed;                      ///< number of entries recorded as removed
+
+	void fetch_pending();
+	const cat_nomme *next_children(frame & f, bool & from_chunk);
+	const cat_nomme *peek(frame & f);
+	void enter(const cat_directory *dir, bool from_chunk);
+	void leave();
+	void skip_subtree(const cat_directory *dir, bool from_chunk);
+	void drain();
+	void record_removed(const cat_nomme *ref, bool from_chunk);
+	bool recording_place(const frame & f) const;
+    };
+
+	/// @}
+
+} // end of namespace
+
+#endif
@@ -23,7 +23,9 @@
 
 extern "C"
 {
-
+#if HAVE_STRING_H
+#include <string.h>
+#endif
 } // end extern "C"
 
 #include "tools.hpp"
@@ -37,6 +39,10 @@ extern "C"
 #endif
 #endif
 
+    // read requests smaller than this are served from the
+    // decompressed data buffer
+#define CLEAR_BUFFER_SIZE 65536
+
 using namespace std;
 
 namespace libdar
@@ -52,6 +58,10 @@ namespace libdar
 	compressed = & compressed_side;
         algo = x_algo;
 	suspended = false;
+	clear = nullptr;
+	clear_size = 0;
+	clear_start = 0;
+	clear_end = 0;
 
         if(compression_level > 9)
             throw SRC_BUG;
@@ -109,6 +119,11 @@ namespace libdar
 	    }
 	    else
 	    {
+		clear = new (nothrow) char[CLEAR_BUFFER_SIZE];
+		if(clear == nullptr)
+		    throw Ememory();
+		clear_size = CLEAR_BUFFER_SIZE;
+
 		switch(compr->wrap.decompressInit())
 		{
 		case WR_OK:
@@ -132,6 +147,8 @@ namespace libdar
 	{
 	    if(compr != nullptr)
 		delete compr;
+	    if(clear != nullptr)
+		delete [] clear;
 	    throw;
 	}
 
@@ -149,6 +166,8 @@ namespace libdar
 	}
 	if(compr != nullptr)
 	    delete compr;
+	if(clear != nullptr)
+	    delete [] clear;
     }
 
     compression compressor::get_algo() const
@@ -229,10 +248,7 @@ namespace libdar
 
     U_I compressor::inherited_read(char *a, U_I size)
     {
-        S_I ret;
-        S_I flag = WR_NO_FLUSH;
-	U_I mem_avail_out = 0; // will stop when avail_out will reach this value
-	enum { normal, no_more_input, eof } processing = normal;
+	U_I ret = 0;
 
         if(size == 0)
             return 0;
@@ -243,6 +259,46 @@ namespace libdar
 	if(suspended || algo == compression::none)
 	    return compressed->read(a, size);
 
+	while(ret < size)
+	{
+	    if(clear_start < clear_end)
+	    {
+		U_I step = clear_end - clear_start;
+
+		if(step > size - ret)
+		    step = size - ret;
+		(void)memcpy(a + ret, clear + clear_start, step);
+		clear_start += step;
+		ret += step;
+	    }
+	    else
+	    {
+		if(size - ret >= clear_size)
+		{
+			// large request, decompressing directly to the caller's buffer
+		    ret += decompress_to(a + ret, size - ret, false);
+		    break;
+		}
+		else
+		{
+		    clear_start = 0;
+		    clear_end = decompress_to(clear, clear_size, true);
+		    if(clear_end == 0)
+			break; // end of compressed data
+		}
+	    }
+	}
+
+	return ret;
+    }
+
+    U_I compressor::decompress_to(char *a, U_I size, bool lazy)
+    {
+        S_I ret;
+        S_I flag = WR_NO_FLUSH;
+	U_I mem_avail_out = 0; // will stop when avail_out will reach this value
+	enum { normal, no_more_input, eof } processing = normal;
+
         compr->wrap.set_next_out(a);
         compr->wrap.set_avail_out(size);
 
@@ -251,6 +307,9 @@ namespace libdar
                 // feeding the input buffer if necessary
             if(compr->wrap.get_avail_in() == 0)
             {
+		if(lazy && compr->wrap.get_avail_out() != size)
+		    break; // not reading further compressed data, what has been decompressed so far is enough
+
                 compr->wrap.set_next_in(compr->buffer);
                 compr->wrap.set_avail_in(compressed->read(compr->buffer,
                                                             compr->size));
@@ -413,6 +472,8 @@ namespace libdar
             // keep in the buffer the bytes already read, these are discarded in case of a call to skip
 
 	compr->wrap.set_avail_in(0);
+	clear_start = 0;
+	clear_end = 0;
     }
 
     void compressor::flush_write()
@@ -101,7 +101,23 @@ namespace libdar
         compression algo;          ///< compression algorithm used
 	bool suspended;            ///< whether compression is temporary suspended
 
+	    // small reads (catalogue fields, infinint, names...) are served from a buffer of
+	    // already decompressed data rather than each calling the compression engine
+
+	char *clear;               ///< decompressed data not yet read (read mode only)
+	U_I clear_size;            ///< allocated size of clear
+	U_I clear_start;           ///< offset of the next byte to read in clear
+	U_I clear_end;             ///< offset of the end of decompressed data in clear
+
 	void flush_write();        ///< drop all pending write and reset compression engine
+
+	    /// decompress data to the given buffer
+
+	    /// \param[in] a where to put decompressed data
+	    /// \param[in] size available space in a
+	    /// \param[in] lazy if true, stop feeding compressed data once some decompressed data has been produced
+	    /// \return the amount of decompressed data, zero means end of compressed data
+	U_I decompress_to(char *a, U_I size, bool lazy);
     };
 
 	/// @}
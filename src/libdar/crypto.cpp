@@ -28,6 +28,7 @@ extern "C"
 
 #include "crypto.hpp"
 #include "erreurs.hpp"
+#include "crypto_sym.hpp"
 
 using namespace std;
 
@@ -52,6 +53,14 @@ namespace libdar
 	    return "serpent 256";
 	case crypto_algo::camellia256:
 	    return "camellia 256";
+	case crypto_algo::aes256_xts:
+	    return "AES 256 (XTS)";
+	case crypto_algo::twofish256_xts:
+	    return "twofish 256 (XTS)";
+	case crypto_algo::serpent256_xts:
+	    return "serpent 256 (XTS)";
+	case crypto_algo::camellia256_xts:
+	    return "camellia 256 (XTS)";
 	default:
 	    throw SRC_BUG;
 	}
@@ -76,6 +85,14 @@ namespace libdar
 	    return "serpent";
 	case crypto_algo::camellia256:
 	    return "camellia";
+	case crypto_algo::aes256_xts:
+	    return "aes-xts";
+	case crypto_algo::twofish256_xts:
+	    return "twofish-xts";
+	case crypto_algo::serpent256_xts:
+	    return "serpent-xts";
+	case crypto_algo::camellia256_xts:
+	    return "camellia-xts";
 	default:
 	    throw SRC_BUG;
 	}
@@ -99,6 +116,14 @@ namespace libdar
 	    return 'p';
 	case crypto_algo::camellia256:
 	    return 'c';
+	case crypto_algo::aes256_xts:
+	    return 'A';
+	case crypto_algo::twofish256_xts:
+	    return 'T';
+	case crypto_algo::serpent256_xts:
+	    return 'P';
+	case crypto_algo::camellia256_xts:
+	    return 'C';
 	default:
 	    throw SRC_BUG;
 	}
@@ -122,11 +147,29 @@ namespace libdar
 	    return crypto_algo::serpent256;
 	case 'c':
 	    return crypto_algo::camellia256;
+	case 'A':
+	    return crypto_algo::aes256_xts;
+	case 'T':
+	    return crypto_algo::twofish256_xts;
+	case 'P':
+	    return crypto_algo::serpent256_xts;
+	case 'C':
+	    return crypto_algo::camellia256_xts;
 	default:
 	    throw Erange(gettext("Unknown crypto algorithm"));
 	}
     }
 
+    void set_derived_key_cache(bool enabled)
+    {
+	crypto_sym::set_key_cache(enabled);
+    }
+
+    void clear_derived_key_cache()
+    {
+	crypto_sym::clear_key_cache();
+    }
+
     bool same_signatories(const std::list<signator> & a, const std::list<signator> & b)
     {
 	list<signator>::const_iterator ita = a.begin();
@@ -54,7 +54,11 @@ namespace libdar
 	aes256,        ///< AES 256 strong encryption
 	twofish256,    ///< twofish 256 strong encryption
 	serpent256,    ///< serpent 256 strong encryption
-	camellia256    ///< camellia 256 strong encryption
+	camellia256,   ///< camellia 256 strong encryption
+	aes256_xts,    ///< AES 256 strong encryption in XTS mode
+	twofish256_xts, ///< twofish 256 strong encryption in XTS mode
+	serpent256_xts, ///< serpent 256 strong encryption in XTS mode
+	camellia256_xts ///< camellia 256 strong encryption in XTS mode
     };
 
 	/// signator status
@@ -99,6 +103,19 @@ namespace libdar
 	/// return whether the two signators lists match
     extern bool same_signatories(const std::list<signator> & a, const std::list<signator> & b);
 
+	/// enable or disable the cache of keys derived from passphrases
+
+	/// deriving a key from a passphrase (see archive_options_create::set_kdf_hash() and
+	/// set_iteration_count()) is intentionally costly. By default the derived keys are
+	/// kept in secured memory, with the salt, hash algorithm and iteration count used,
+	/// so opening again an archive during the life of the process does not have to
+	/// compute them again. Disabling the cache also clears it.
+	/// \note close_and_clean() clears the cache
+    extern void set_derived_key_cache(bool enabled);
+
+	/// remove all keys from the cache of keys derived from passphrases
+    extern void clear_derived_key_cache();
+
 	/// @}
 
 } // end of namespace
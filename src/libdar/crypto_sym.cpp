@@ -47,11 +47,33 @@ extern "C"
 
 using namespace std;
 
+#if MUTEX_WORKS
+#define CRITICAL_START						\
+    sigset_t Critical_section_mask_memory;			\
+    tools_block_all_signals(Critical_section_mask_memory);	\
+    pthread_mutex_lock(&key_cache_lock)
+
+#define CRITICAL_END pthread_mutex_unlock(&key_cache_lock);		\
+    tools_set_back_blocked_signals(Critical_section_mask_memory)
+#else
+#define CRITICAL_START // not a thread-safe implementation
+#define CRITICAL_END   // not a thread-safe implementation
+#endif
+
 namespace libdar
 {
 
     constexpr const U_I MAX_RETRY_IF_WEAK_PASSWORD = 5;
 
+#if CRYPTO_AVAILABLE
+    bool crypto_sym::key_cache_enabled = true;
+    deque<crypto_sym::cached_key> crypto_sym::key_cache;
+    unique_ptr<secu_string> crypto_sym::key_cache_secret;
+#if MUTEX_WORKS
+    pthread_mutex_t crypto_sym::key_cache_lock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+#endif
+
     crypto_sym::crypto_sym(const secu_string & password,
 			   const archive_version & reading_version,
 			   crypto_algo xalgo,
@@ -122,17 +144,22 @@ namespace libdar
 	    init_algo_block_size(algo);
 	    init_ivec(algo, algo_block_size);
 
-	    U_I IV_cipher;
-	    U_I IV_hashing;
+	    if(!is_xts(algo))
+	    {
+		U_I IV_cipher;
+		U_I IV_hashing;
 
-	    get_IV_cipher_and_hashing(reading_ver, algo_id, IV_cipher, IV_hashing);
+		get_IV_cipher_and_hashing(reading_ver, algo_id, IV_cipher, IV_hashing);
 
-		// making an hash of the provided password into the digest variable
-	    init_essiv_password(hashed_password, IV_hashing);
+		    // making an hash of the provided password into the digest variable
+		init_essiv_password(hashed_password, IV_hashing);
 
-		// building the auxilliary key that will be used
-		// to derive the IV value from the block number
-	    init_essiv_clef(essiv_password, IV_cipher, algo_block_size);
+		    // building the auxilliary key that will be used
+		    // to derive the IV value from the block number
+		init_essiv_clef(essiv_password, IV_cipher, algo_block_size);
+	    }
+		// else the block number is used as tweak by the XTS mode,
+		// which has its own (second) key for that purpose
 
 #ifdef LIBDAR_NO_OPTIMIZATION
 	    self_test();
@@ -195,7 +222,10 @@ namespace libdar
 	    err = gcry_cipher_reset(main_clef);
 	    if(err != GPG_ERR_NO_ERROR)
 		throw Erange(tools_printf(gettext("Error while resetting encryption key for a new block: %s/%s"), gcry_strsource(err),gcry_strerror(err)));
-	    make_ivec(block_num, ivec, algo_block_size, essiv_clef);
+	    if(is_xts(algo))
+		make_tweak(block_num, ivec, algo_block_size);
+	    else
+		make_ivec(block_num, ivec, algo_block_size, essiv_clef);
 	    err = gcry_cipher_setiv(main_clef, (const void *)ivec, algo_block_size);
 	    if(err != GPG_ERR_NO_ERROR)
 		throw Erange(tools_printf(gettext("Error while setting IV for current block: %s/%s"), gcry_strsource(err),gcry_strerror(err)));
@@ -223,7 +253,10 @@ namespace libdar
 	if(crypt_size == 0)
 	    return 0; // nothing to decipher
 
-	make_ivec(block_num, ivec, algo_block_size, essiv_clef);
+	if(is_xts(algo))
+	    make_tweak(block_num, ivec, algo_block_size);
+	else
+	    make_ivec(block_num, ivec, algo_block_size, essiv_clef);
 	err = gcry_cipher_setiv(main_clef, (const void *)ivec, algo_block_size);
 	if(err != GPG_ERR_NO_ERROR)
 	    throw Erange(tools_printf(gettext("Error while setting IV for current block: %s/%s"), gcry_strsource(err),gcry_strerror(err)));
@@ -271,6 +304,9 @@ namespace libdar
 	if(key_len == 0)
 	    throw Erange(gettext("Failed retrieving from libgcrypt the maximum key length"));
 
+	if(is_xts(algo))
+	    key_len *= 2; // XTS mode uses two keys of the cipher key length
+
 	return key_len;
 #else
 	throw Ecompilation("Strong encryption support (libgcrypt)");
@@ -300,7 +336,7 @@ namespace libdar
 	gcry_cipher_hd_t main_clef;
 	U_I algo_id = get_algo_id(algo);
 
-	err = gcry_cipher_open(&main_clef, algo_id, GCRY_CIPHER_MODE_CBC, GCRY_CIPHER_SECURE);
+	err = gcry_cipher_open(&main_clef, algo_id, get_algo_mode(algo), GCRY_CIPHER_SECURE);
 	if(err != GPG_ERR_NO_ERROR)
 	    throw Erange(tools_printf(gettext("Error while opening libgcrypt key handle to check password strength: %s/%s"),
 				      gcry_strsource(err),
@@ -330,6 +366,40 @@ namespace libdar
 #endif
     }
 
+    void crypto_sym::set_key_cache(bool enabled)
+    {
+#if CRYPTO_AVAILABLE
+	CRITICAL_START;
+	key_cache_enabled = enabled;
+	CRITICAL_END;
+	if(!enabled)
+	    clear_key_cache();
+#endif
+    }
+
+    void crypto_sym::clear_key_cache()
+    {
+#if CRYPTO_AVAILABLE
+	CRITICAL_START;
+	key_cache.clear();
+	key_cache_secret.reset();
+	CRITICAL_END;
+#endif
+    }
+
+    U_I crypto_sym::get_key_cache_size()
+    {
+	U_I ret = 0;
+
+#if CRYPTO_AVAILABLE
+	CRITICAL_START;
+	ret = key_cache.size();
+	CRITICAL_END;
+#endif
+
+	return ret;
+    }
+
 #if CRYPTO_AVAILABLE
     string crypto_sym::generate_salt(U_I size)
     {
@@ -369,11 +439,15 @@ namespace libdar
 	if(use_pkcs5)
 	{
 	    U_I it = 0;
+	    U_I len = max_key_len_libdar(algo);
 
 	    iteration_count.unstack(it);
 	    if(!iteration_count.is_zero())
 		throw Erange(gettext("Too large value give for key derivation interation count"));
 
+	    if(key_cache_find(password, salt, kdf_hash, it, len, hashed_password))
+		return;
+
 	    switch(kdf_hash)
 	    {
 	    case hash_algo::none:
@@ -381,14 +455,16 @@ namespace libdar
 	    case hash_algo::md5:
 	    case hash_algo::sha1:
 	    case hash_algo::sha512:
-		hashed_password = pkcs5_pass2key(password, salt, it, hash_algo_to_gcrypt_hash(kdf_hash), max_key_len_libdar(algo));
+		hashed_password = pkcs5_pass2key(password, salt, it, hash_algo_to_gcrypt_hash(kdf_hash), len);
 		break;
 	    case hash_algo::argon2:
-		hashed_password = argon2_pass2key(password, salt, it, max_key_len_libdar(algo));
+		hashed_password = argon2_pass2key(password, salt, it, len);
 		break;
 	    default:
 		throw SRC_BUG;
 	    }
+
+	    key_cache_add(password, salt, kdf_hash, it, hashed_password);
 	}
 	else
 	    hashed_password = password;
@@ -419,7 +495,7 @@ namespace libdar
 
 		// key handle initialization
 
-	    err = gcry_cipher_open(&main_clef, get_algo_id(algo), GCRY_CIPHER_MODE_CBC, GCRY_CIPHER_SECURE);
+	    err = gcry_cipher_open(&main_clef, get_algo_id(algo), get_algo_mode(algo), GCRY_CIPHER_SECURE);
 	    if(err != GPG_ERR_NO_ERROR)
 		throw Erange(tools_printf(gettext("Error while opening libgcrypt key handle: %s/%s"),
 					  gcry_strsource(err),
@@ -563,10 +639,13 @@ namespace libdar
 	init_main_clef(hashed_password, algo);
 	init_algo_block_size(algo);
 	init_ivec(algo, algo_block_size);
-	U_I IV_cipher;
-	U_I IV_hashing;
-	get_IV_cipher_and_hashing(reading_ver, get_algo_id(algo), IV_cipher, IV_hashing);
-	init_essiv_clef(essiv_password, IV_cipher, algo_block_size);
+	if(!is_xts(algo))
+	{
+	    U_I IV_cipher;
+	    U_I IV_hashing;
+	    get_IV_cipher_and_hashing(reading_ver, get_algo_id(algo), IV_cipher, IV_hashing);
+	    init_essiv_clef(essiv_password, IV_cipher, algo_block_size);
+	}
 	sel = ref.sel;
     }
 
@@ -652,6 +731,17 @@ namespace libdar
 	delete [] sect;
     }
 
+    void crypto_sym::make_tweak(const infinint & ref, unsigned char *ivec, U_I size)
+    {
+	infinint ref_cp = ref;
+
+	for(U_I i = 0; i < size; ++i)
+	{
+	    ivec[i] = ref_cp[0];
+	    ref_cp >>= 8;
+	}
+    }
+
     secu_string crypto_sym::pkcs5_pass2key(const secu_string & password,
 					   const string & salt,
 					   U_I iteration_count,
@@ -789,15 +879,19 @@ namespace libdar
 	    algo_id = GCRY_CIPHER_BLOWFISH;
 	    break;
 	case crypto_algo::aes256:
+	case crypto_algo::aes256_xts:
 	    algo_id = GCRY_CIPHER_AES256;
 	    break;
 	case crypto_algo::twofish256:
+	case crypto_algo::twofish256_xts:
 	    algo_id = GCRY_CIPHER_TWOFISH;
 	    break;
 	case crypto_algo::serpent256:
+	case crypto_algo::serpent256_xts:
 	    algo_id = GCRY_CIPHER_SERPENT256;
 	    break;
 	case crypto_algo::camellia256:
+	case crypto_algo::camellia256_xts:
 	    algo_id = GCRY_CIPHER_CAMELLIA256;
 	    break;
 	default:
@@ -807,6 +901,160 @@ namespace libdar
 	return algo_id;
     }
 
+    bool crypto_sym::is_xts(crypto_algo algo)
+    {
+	switch(algo)
+	{
+	case crypto_algo::aes256_xts:
+	case crypto_algo::twofish256_xts:
+	case crypto_algo::serpent256_xts:
+	case crypto_algo::camellia256_xts:
+	    return true;
+	default:
+	    return false;
+	}
+    }
+
+    U_I crypto_sym::get_algo_mode(crypto_algo algo)
+    {
+	if(is_xts(algo))
+	{
+#if GCRYPT_VERSION_NUMBER >= 0x010800
+	    return GCRY_CIPHER_MODE_XTS;
+#else
+	    throw Ecompilation(gettext("XTS cipher mode (libgcrypt 1.8.0 or more recent)"));
+#endif
+	}
+	else
+	    return GCRY_CIPHER_MODE_CBC;
+    }
+
+    bool crypto_sym::key_cache_find(const secu_string & password,
+				    const string & salt,
+				    hash_algo kdf_hash,
+				    U_I iteration_count,
+				    U_I output_length,
+				    secu_string & key)
+    {
+	bool ret = false;
+
+	CRITICAL_START;
+	try
+	{
+	    if(key_cache_enabled && !key_cache.empty())
+	    {
+		secu_string pass_hash = key_cache_hash(password);
+		deque<cached_key>::iterator it = key_cache.begin();
+
+		while(it != key_cache.end()
+		      && (it->iteration_count != iteration_count
+			  || it->kdf_hash != kdf_hash
+			  || it->key.get_size() != output_length
+			  || it->salt != salt
+			  || it->pass_hash != pass_hash))
+		    ++it;
+
+		if(it != key_cache.end())
+		{
+		    key = it->key;
+		    if(it != key_cache.begin())
+		    {
+			cached_key tmp = std::move(*it);
+			key_cache.erase(it);
+			key_cache.push_front(std::move(tmp));
+		    }
+		    ret = true;
+		}
+	    }
+	}
+	catch(...)
+	{
+	    CRITICAL_END;
+	    throw;
+	}
+	CRITICAL_END;
+
+	return ret;
+    }
+
+    void crypto_sym::key_cache_add(const secu_string & password,
+				   const string & salt,
+				   hash_algo kdf_hash,
+				   U_I iteration_count,
+				   const secu_string & key)
+    {
+	CRITICAL_START;
+	try
+	{
+	    if(key_cache_enabled)
+	    {
+		cached_key entry;
+
+		entry.pass_hash = key_cache_hash(password);
+		entry.salt = salt;
+		entry.kdf_hash = kdf_hash;
+		entry.iteration_count = iteration_count;
+		entry.key = key;
+
+		key_cache.push_front(std::move(entry));
+		while(key_cache.size() > KEY_CACHE_MAX_ENTRIES)
+		    key_cache.pop_back();
+	    }
+	}
+	catch(...)
+	{
+	    CRITICAL_END;
+	    throw;
+	}
+	CRITICAL_END;
+    }
+
+    secu_string crypto_sym::key_cache_hash(const secu_string & password)
+    {
+	    // passphrases are hashed with HMAC keyed by a random value generated once per process
+	    // for the cache not to hold a fast to brute-force hash of them, but only what the
+	    // derived keys it contains already give access to.
+	constexpr U_I md_algo = GCRY_MD_SHA256;
+	U_I digest_len = gcry_md_get_algo_dlen(md_algo);
+	gcry_error_t err;
+	gcry_md_hd_t hmac;
+	secu_string ret;
+
+	if(digest_len == 0)
+	    throw SRC_BUG;
+
+	if(!key_cache_secret)
+	{
+	    key_cache_secret.reset(new (nothrow) secu_string(digest_len));
+	    if(!key_cache_secret)
+		throw Ememory();
+	    key_cache_secret->expand_string_size_to(digest_len);
+	    gcry_randomize(key_cache_secret->get_array(), digest_len, GCRY_STRONG_RANDOM);
+	}
+
+	err = gcry_md_open(&hmac, md_algo, GCRY_MD_FLAG_SECURE|GCRY_MD_FLAG_HMAC);
+	if(err != GPG_ERR_NO_ERROR)
+	    throw Erange(tools_printf(gettext("Error while hashing passphrase for the key cache (HMAC open): %s/%s"), gcry_strsource(err),gcry_strerror(err)));
+
+	try
+	{
+	    err = gcry_md_setkey(hmac, key_cache_secret->c_str(), key_cache_secret->get_size());
+	    if(err != GPG_ERR_NO_ERROR)
+		throw Erange(tools_printf(gettext("Error while hashing passphrase for the key cache (HMAC set key): %s/%s"), gcry_strsource(err),gcry_strerror(err)));
+	    gcry_md_write(hmac, password.c_str(), password.get_size());
+	    ret.resize(digest_len);
+	    ret.append((const char *)gcry_md_read(hmac, md_algo), digest_len);
+	}
+	catch(...)
+	{
+	    gcry_md_close(hmac);
+	    throw;
+	}
+	gcry_md_close(hmac);
+
+	return ret;
+    }
+
     secu_string crypto_sym::argon2_pass2key(const secu_string & password,
 					    const std::string & salt,
 					    U_I iteration_count,
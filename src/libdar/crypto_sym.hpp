@@ -34,10 +34,18 @@ extern "C"
 #endif
 #include <gcrypt.h>
 #endif
+
+#if MUTEX_WORKS
+#if HAVE_PTHREAD_H
+#include <pthread.h>
+#endif
+#endif
 }
 
 #include "../my_config.h"
 #include <string>
+#include <deque>
+#include <memory>
 
 #include "crypto_module.hpp"
 #include "secu_string.hpp"
@@ -109,15 +117,43 @@ namespace libdar
 	    /// check whether the given password is reported as strong in regard to the given cipher
 	static bool is_a_strong_password(crypto_algo algo, const secu_string & password);
 
+	    /// whether keys derived from passphrases are kept in memory to be reused by other crypto_sym objects
+	static void set_key_cache(bool enabled);
+
+	    /// remove all keys from the derived key cache
+	static void clear_key_cache();
+
+	    /// number of keys currently held in the derived key cache
+	static U_I get_key_cache_size();
+
     private:
 	std::string sel;               ///< the salt
 #if CRYPTO_AVAILABLE
+
+	    /// a key derived from a passphrase and the parameters used for that derivation
+	struct cached_key
+	{
+	    secu_string pass_hash;     ///< keyed hash of the passphrase (the passphrase itself is not kept)
+	    std::string salt;          ///< salt used for the derivation
+	    hash_algo kdf_hash;        ///< key derivation function
+	    U_I iteration_count;       ///< iteration count used for the derivation
+	    secu_string key;           ///< resulting key
+	};
+
+	static constexpr U_I KEY_CACHE_MAX_ENTRIES = 32; ///< oldest keys are removed from the cache passed that number
+
+	static bool key_cache_enabled;                   ///< whether derived keys are looked for and stored in the cache
+	static std::deque<cached_key> key_cache;         ///< derived keys, most recently used first
+	static std::unique_ptr<secu_string> key_cache_secret; ///< random key used to hash passphrases
+#if MUTEX_WORKS
+	static pthread_mutex_t key_cache_lock;           ///< protects the above static fields
+#endif
 	archive_version reading_ver;   ///< the currently followed archive format
 	crypto_algo algo;              ///< algo ID in libgcrypt
 	secu_string hashed_password;   ///< pkcs5 hashed password or provided password if pkcs5 is not needed
 	secu_string essiv_password;    ///< password for essiv
 	gcry_cipher_hd_t main_clef;    ///< used to encrypt/decrypt the data
-	gcry_cipher_hd_t essiv_clef;   ///< used to build the Initialization Vector
+	gcry_cipher_hd_t essiv_clef;   ///< used to build the Initialization Vector (not used in XTS mode)
 	size_t algo_block_size;        ///< the block size of the algorithm (main key)
 	unsigned char *ivec;           ///< algo_block_size allocated in secure memory to be used as Initial Vector for main_clef
 
@@ -168,15 +204,51 @@ namespace libdar
 					  U_I hash_gcrypt,                      ///< hashing fonction used for key derivation (SHA1 historically)
 					  U_I output_length);                   ///< length of the string to return
 
+	    /// look in the cache for a key derived with the given parameters
+
+	    /// \return true and set key if found
+	static bool key_cache_find(const secu_string & password,
+				   const std::string & salt,
+				   hash_algo kdf_hash,
+				   U_I iteration_count,
+				   U_I output_length,
+				   secu_string & key);
+
+	    /// record a derived key in the cache
+	static void key_cache_add(const secu_string & password,
+				  const std::string & salt,
+				  hash_algo kdf_hash,
+				  U_I iteration_count,
+				  const secu_string & key);
+
+	    /// keyed hash of the passphrase (must be called while holding the key_cache_lock)
+	static secu_string key_cache_hash(const secu_string & password);
+
 	    /// create a hash using argon2 key derivation algorithm
 	static secu_string argon2_pass2key(const secu_string & password,
 					   const std::string & salt,
 					   U_I iteration_count,
 					   U_I output_length);
 
+	    /// Fills up the XTS tweak of the given block
+
+	    /// \param[in] ref is the block number
+	    /// \param[in] ivec is the address where to drop down the tweak
+	    /// \param[in] size is the amount of data allocated at ivec address
+	    /// \note the tweak is the block number in little endian as defined by IEEE P1619
+	static void make_tweak(const infinint & ref,
+			       unsigned char *ivec,
+			       U_I size);
+
 	    /// converts libdar crypto algo designation to index used by libgcrypt
 	static U_I get_algo_id(crypto_algo algo);
 
+	    /// whether the libdar crypto algo designation uses XTS mode rather than CBC mode with ESSIV
+	static bool is_xts(crypto_algo algo);
+
+	    /// converts libdar crypto algo designation to the cipher mode used by libgcrypt
+	static U_I get_algo_mode(crypto_algo algo);
+
 	    /// generates a random salt of given size
 	static std::string generate_salt(U_I size);
 
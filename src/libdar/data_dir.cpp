@@ -47,6 +47,8 @@ extern "C"
 #include "path.hpp"
 #include "datetime.hpp"
 #include "cat_all_entrees.hpp"
+#include "memory_file.hpp"
+#include "null_file.hpp"
 
 using namespace std;
 using namespace libdar;
@@ -390,12 +392,7 @@ namespace libdar
 			string marge) const
     {
 	deque<data_tree *>::const_iterator it = rejetons.begin();
-	set<archive_num> ou_data;
-	archive_num ou_ea;
-	bool data, ea;
 	string name;
-	db_lookup lo_data, lo_ea;
-	bool even_when_removed = (num != 0);
 
 	while(it != rejetons.end())
 	{
@@ -403,25 +400,8 @@ namespace libdar
 		throw SRC_BUG;
 	    data_dir *dir = dynamic_cast<data_dir *>(*it);
 
-	    lo_data = (*it)->get_data(ou_data, datetime(0), even_when_removed);
-	    lo_ea = (*it)->get_EA(ou_ea, datetime(0), even_when_removed);
-	    data = lo_data == db_lookup::found_present && (ou_data.find(num) != ou_data.end() || num == 0);
-	    ea = lo_ea == db_lookup::found_present && (ou_ea == num || num == 0);
 	    name = marge + (*it)->get_name();
-	    if(data || ea || num == 0)
-	    {
-		if(callback == nullptr)
-		    throw Erange("nullptr provided as user callback function");
-
-		try
-		{
-		    callback(tag, name, data, ea);
-		}
-		catch(...)
-		{
-		    throw Elibcall("user provided callback function should not throw any exception");
-		}
-	    }
+	    show_entry(**it, name, callback, tag, num);
 	    if(dir != nullptr)
 		dir->show(callback, tag, num, name + "/");
 	    ++it;
@@ -633,6 +613,281 @@ namespace libdar
 	return ret;
     }
 
-} // end of namesapce
+    void data_dir::dump_streamed(generic_file & f) const
+    {
+	char tmp = streamed_end;
+
+	dump_streamed_records(f, 0);
+	f.write(&tmp, 1);
+    }
+
+    data_dir *data_dir::data_tree_read_streamed(generic_file & f,
+					       unsigned char db_version,
+					       const deque<path> *wanted)
+    {
+	char sign;
+	infinint depth;
+	string name;
+	infinint body_size;
+	vector<vector<string> > targets; ///< wanted paths split in components
+	deque<data_dir *> parents;       ///< parents[i] is the loaded directory at depth i, nullptr if skipped
+	deque<vector<U_I> > alive;       ///< alive[i] lists the targets the directory at depth i leads to or is located in
+	data_dir *ret = nullptr;
+
+	if(!read_streamed_header(f, sign, depth, name, body_size)
+	   || sign != data_dir::signature()
+	   || !depth.is_zero())
+	    throw Erange(gettext("Badly formatted database"));
+
+	ret = new (nothrow) data_dir(name);
+	if(ret == nullptr)
+	    throw Ememory();
+
+	try
+	{
+	    read_streamed_body(f, *ret, body_size, db_version);
+	    parents.push_back(ret);
+
+	    if(wanted != nullptr)
+	    {
+		vector<U_I> all;
 
+		for(deque<path>::const_iterator it = wanted->begin(); it != wanted->end(); ++it)
+		{
+		    path chemin = *it;
+		    vector<string> comp;
+		    string tmp;
+
+		    if(!chemin.is_relative())
+			throw Erange(gettext("Invalid path, path must be relative"));
+		    while(chemin.pop_front(tmp))
+			comp.push_back(tmp);
+		    comp.push_back(chemin.display());
+
+		    all.push_back(targets.size());
+		    targets.push_back(comp);
+		}
+		alive.push_back(all);
+	    }
+
+	    while(read_streamed_header(f, sign, depth, name, body_size))
+	    {
+		U_I level = 0;
+		data_dir *parent;
+		vector<U_I> still;
+		bool keep;
+
+		depth.unstack(level);
+		if(!depth.is_zero() || level == 0 || level > parents.size())
+		    throw Erange(gettext("Badly formatted database"));
+
+		parents.resize(level);
+		parent = parents.back();
+		keep = parent != nullptr;
+
+		if(keep && wanted != nullptr)
+		{
+		    alive.resize(level);
+		    for(vector<U_I>::const_iterator it = alive.back().begin(); it != alive.back().end(); ++it)
+		    {
+			const vector<string> & target = targets[*it];
+
+			if(target.size() < level || target[level - 1] == name)
+			    still.push_back(*it);
+		    }
+		    keep = !still.empty();
+		}
+
+		if(keep)
+		{
+		    data_tree *entry = nullptr;
+		    data_dir *entry_dir = nullptr;
+
+		    if(sign == data_dir::signature())
+			entry = entry_dir = new (nothrow) data_dir(name);
+		    else if(sign == data_tree::signature())
+			entry = new (nothrow) data_tree(name);
+		    else
+			throw Erange(gettext("Unknown record type"));
+
+		    if(entry == nullptr)
+			throw Ememory();
+		    parent->add_child(entry);
+		    read_streamed_body(f, *entry, body_size, db_version);
+
+		    if(entry_dir != nullptr)
+		    {
+			parents.push_back(entry_dir);
+			if(wanted != nullptr)
+			    alive.push_back(still);
+		    }
+		}
+		else
+		{
+		    skip_streamed_body(f, body_size);
+		    if(sign == data_dir::signature())
+		    {
+			    // its subtree will be skipped too
+			parents.push_back(nullptr);
+			if(wanted != nullptr)
+			    alive.push_back(still);
+		    }
+		}
+	    }
+	}
+	catch(...)
+	{
+	    delete ret;
+	    throw;
+	}
+
+	return ret;
+    }
+
+    void data_dir::show_streamed(generic_file & f,
+				unsigned char db_version,
+				database_listing_show_files_callback callback,
+				void *tag,
+				archive_num num)
+    {
+	char sign;
+	infinint depth;
+	string name;
+	infinint body_size;
+	deque<string> marge; ///< marge[i] is the path prefix of entries at depth i+1
 
+	if(!read_streamed_header(f, sign, depth, name, body_size)
+	   || sign != data_dir::signature()
+	   || !depth.is_zero())
+	    throw Erange(gettext("Badly formatted database"));
+	skip_streamed_body(f, body_size);
+	marge.push_back("");
+
+	while(read_streamed_header(f, sign, depth, name, body_size))
+	{
+	    U_I level = 0;
+	    data_tree entry(name);
+
+	    depth.unstack(level);
+	    if(!depth.is_zero() || level == 0 || level > marge.size())
+		throw Erange(gettext("Badly formatted database"));
+	    if(sign != data_dir::signature() && sign != data_tree::signature())
+		throw Erange(gettext("Unknown record type"));
+
+	    marge.resize(level);
+	    name = marge.back() + name;
+	    read_streamed_body(f, entry, body_size, db_version);
+	    show_entry(entry, name, callback, tag, num);
+	    if(sign == data_dir::signature())
+		marge.push_back(name + "/");
+	}
+    }
+
+    void data_dir::dump_streamed_records(generic_file & f, const infinint & depth) const
+    {
+	deque<data_tree *>::const_iterator it = rejetons.begin();
+	infinint sub_depth = depth + 1;
+
+	write_streamed_record(f, *this, depth);
+	while(it != rejetons.end())
+	{
+	    if(*it == nullptr)
+		throw SRC_BUG;
+
+	    const data_dir *dir = dynamic_cast<const data_dir *>(*it);
+	    if(dir != nullptr)
+		dir->dump_streamed_records(f, sub_depth);
+	    else
+		write_streamed_record(f, **it, sub_depth);
+	    ++it;
+	}
+    }
+
+    void data_dir::write_streamed_record(generic_file & f, const data_tree & entry, const infinint & depth)
+    {
+	char sign = entry.obj_signature();
+	memory_file body;
+
+	entry.dump_body(body);
+
+	f.write(&sign, 1);
+	depth.dump(f);
+	tools_write_string(f, entry.get_name());
+	body.size().dump(f);
+	body.skip(0);
+	body.copy_to(f);
+    }
+
+    bool data_dir::read_streamed_header(generic_file & f,
+				       char & sign,
+				       infinint & depth,
+				       string & name,
+				       infinint & body_size)
+    {
+	if(f.read(&sign, 1) != 1)
+	    throw Erange(gettext("Unexpected end of file"));
+
+	if(sign == streamed_end)
+	    return false;
+
+	depth.read(f);
+	tools_read_string(f, name);
+	body_size.read(f);
+
+	return true;
+    }
+
+    void data_dir::skip_streamed_body(generic_file & f, const infinint & body_size)
+    {
+	null_file black_hole(gf_write_only);
+
+	    // the database is a compressed stream, reading is the only way to move forward
+	if(f.copy_to(black_hole, body_size) != body_size)
+	    throw Erange(gettext("Unexpected end of file"));
+    }
+
+    void data_dir::read_streamed_body(generic_file & f, data_tree & entry, const infinint & body_size, unsigned char db_version)
+    {
+	memory_file body;
+
+	if(f.copy_to(body, body_size) != body_size)
+	    throw Erange(gettext("Unexpected end of file"));
+	body.skip(0);
+	entry.read_body(body, db_version);
+	if(body.get_position() != body_size)
+	    throw Erange(gettext("Badly formatted database"));
+    }
+
+    void data_dir::show_entry(const data_tree & entry,
+			      const string & name,
+			      database_listing_show_files_callback callback,
+			      void *tag,
+			      archive_num num)
+    {
+	set<archive_num> ou_data;
+	archive_num ou_ea;
+	bool data, ea;
+	db_lookup lo_data, lo_ea;
+	bool even_when_removed = (num != 0);
+
+	lo_data = entry.get_data(ou_data, datetime(0), even_when_removed);
+	lo_ea = entry.get_EA(ou_ea, datetime(0), even_when_removed);
+	data = lo_data == db_lookup::found_present && (ou_data.find(num) != ou_data.end() || num == 0);
+	ea = lo_ea == db_lookup::found_present && (ou_ea == num || num == 0);
+	if(data || ea || num == 0)
+	{
+	    if(callback == nullptr)
+		throw Erange("nullptr provided as user callback function");
+
+	    try
+	    {
+		callback(tag, name, data, ea);
+	    }
+	    catch(...)
+	    {
+		throw Elibcall("user provided callback function should not throw any exception");
+	    }
+	}
+    }
+
+} // end of namesapce
@@ -118,7 +118,37 @@ namespace libdar
 	    /// dump() result.
 	static data_dir *data_tree_read(generic_file & f, unsigned char db_version);
 
+	    /// write the whole tree in the streamed layout used since database format version 8
+
+	    /// \note each entry is written as a self-delimited record (signature, depth, name,
+	    /// size of the per archive status, per archive status), in depth-first order, "this"
+	    /// being the record at depth zero. This let a reader skip entries and whole
+	    /// subtrees it is not interested in, without decoding them.
+	void dump_streamed(generic_file & f) const;
+
+	    /// read a tree written by dump_streamed()
+
+	    /// \param[in] f where to read the records from
+	    /// \param[in] db_version database format version
+	    /// \param[in] wanted if not nullptr, only the entries leading to one of these paths and
+	    /// the entries located below them are loaded, the others are skipped
+	    /// \return the root of the loaded tree, which must be released by the caller
+	static data_dir *data_tree_read_streamed(generic_file & f,
+						unsigned char db_version,
+						const std::deque<path> *wanted);
+
+	    /// same as show() but working directly from records written by dump_streamed()
+
+	    /// \note entries are decoded one at a time, the tree is never loaded in memory
+	static void show_streamed(generic_file & f,
+				 unsigned char db_version,
+				 database_listing_show_files_callback callback,
+				 void *tag,
+				 archive_num num);
+
     private:
+	static constexpr const char streamed_end = 'e'; ///< signature of the record ending a streamed tree
+
 	std::deque<data_tree *> rejetons;          ///< subdir and subfiles of the current dir
 
 	void add_child(data_tree *fils);          ///< "this" is now responsible of "fils" disalocation
@@ -127,6 +157,27 @@ namespace libdar
 
 	    /// read signature and depening on it run data_tree or data_dir constructor
 	static data_tree *read_next_in_list_from_file(generic_file & f, unsigned char db_version);
+
+	void dump_streamed_records(generic_file & f, const infinint & depth) const;
+	static void write_streamed_record(generic_file & f, const data_tree & entry, const infinint & depth);
+
+	    /// read the header of the next streamed record
+
+	    /// \return false if the end of tree record has been met
+	static bool read_streamed_header(generic_file & f,
+					char & sign,
+					infinint & depth,
+					std::string & name,
+					infinint & body_size);
+	static void skip_streamed_body(generic_file & f, const infinint & body_size);
+	static void read_streamed_body(generic_file & f, data_tree & entry, const infinint & body_size, unsigned char db_version);
+
+	    /// the part of show() that concerns a single entry
+	static void show_entry(const data_tree & entry,
+			       const std::string & name,
+			       database_listing_show_files_callback callback,
+			       void *tag,
+			       archive_num num);
     };
 
 
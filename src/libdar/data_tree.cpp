@@ -54,6 +54,9 @@ using namespace std;
 namespace libdar
 {
 
+	// an entry cannot have more records than the number of archives a database can hold
+    static constexpr U_64 archive_num_max_records = 65534;
+
     void data_tree::status::dump(generic_file & f) const
     {
 	date.dump(f);
@@ -189,6 +192,7 @@ namespace libdar
 	case 5:
 	case 6:
 	case 7:
+	case 8:
 	    f.read((char *)&flag, 1);
 	    if((flag & STATUS_PLUS_FLAG_ME) != 0)
 		base = create_crc_from_file(f, false);
@@ -252,20 +256,33 @@ namespace libdar
     }
 
     data_tree::data_tree(generic_file & f, unsigned char db_version)
+    {
+	    // signature has already been read
+	tools_read_string(f, filename);
+	read_body(f, db_version);
+    }
+
+    void data_tree::read_body(generic_file & f, unsigned char db_version)
     {
 	archive_num k;
 	status sta;
 	status_plus sta_plus;
+	datetime prev_date;
+	U_64 count;
+
+	last_mod.clear();
+	last_change.clear();
 
-	    // signature has already been read
-	tools_read_string(f, filename);
 	infinint tmp = infinint(f); // number of entry in last_mod map
+	if(tools_infinint2U_64(tmp, count) && count <= archive_num_max_records)
+	    last_mod.reserve(count);
+	prev_date = datetime(0);
 	while(!tmp.is_zero())
 	{
-	    k.read_from_file(f);
 	    switch(db_version)
 	    {
 	    case 1:
+		k.read_from_file(f);
 		sta_plus.date = infinint(f);
 		sta_plus.present = db_etat::et_saved;
 		    // me and ref fields are already set to nullptr
@@ -277,9 +294,22 @@ namespace libdar
 	    case 5:
 	    case 6:
 	    case 7:
+		k.read_from_file(f);
 		sta_plus.read(f, db_version);
 		last_mod[k] = sta_plus;
 		break;
+	    case 8:
+		{
+		    status_plus tmp_plus;
+		    unsigned char flag = read_compact(f, db_version, k, tmp_plus, prev_date);
+
+		    if((flag & COMPACT_FLAG_ME) != 0)
+			tmp_plus.base = create_crc_from_file(f, false);
+		    if((flag & COMPACT_FLAG_REF) != 0)
+			tmp_plus.result = create_crc_from_file(f, false);
+		    last_mod[k] = std::move(tmp_plus);
+		}
+		break;
 	    default: // unsupported database version
 		throw SRC_BUG; // this statement should have been prevented earlier in the code to avoid destroying or loosing data from the database
 	    }
@@ -287,12 +317,15 @@ namespace libdar
 	}
 
 	tmp = infinint(f); // number of entry in last_change map
+	if(tools_infinint2U_64(tmp, count) && count <= archive_num_max_records)
+	    last_change.reserve(count);
+	prev_date = datetime(0);
 	while(!tmp.is_zero())
 	{
-	    k.read_from_file(f);
 	    switch(db_version)
 	    {
 	    case 1:
+		k.read_from_file(f);
 		sta.date = infinint(f);
 		sta.present = db_etat::et_saved;
 		last_change[k] = sta;
@@ -303,9 +336,15 @@ namespace libdar
 	    case 5:
 	    case 6:
 	    case 7:
+		k.read_from_file(f);
 		sta.read(f, db_version);
 		last_change[k] = sta;
 		break;
+	    case 8:
+		if((read_compact(f, db_version, k, sta, prev_date) & (COMPACT_FLAG_ME|COMPACT_FLAG_REF)) != 0)
+		    throw Erange(gettext("Unexpected value found in database"));
+		last_change[k] = sta;
+		break;
 	    default:
 		throw SRC_BUG;
 	    }
@@ -316,11 +355,57 @@ namespace libdar
     void data_tree::dump(generic_file & f) const
     {
 	char tmp = obj_signature();
-	infinint sz;
-	map<archive_num, status_plus>::const_iterator itp = last_mod.begin();
 
 	f.write(&tmp, 1);
 	tools_write_string(f, filename);
+	dump_legacy_body(f);
+    }
+
+    void data_tree::dump_body(generic_file & f) const
+    {
+	infinint sz;
+	datetime prev_date;
+	archive_records<status_plus>::const_iterator itp = last_mod.begin();
+
+	    // last mod table dump
+
+	sz = last_mod.size();
+	sz.dump(f);
+	prev_date = datetime(0);
+	while(itp != last_mod.end())
+	{
+	    unsigned char flag = 0;
+
+	    if(itp->second.base != nullptr)
+		flag |= COMPACT_FLAG_ME;
+	    if(itp->second.result != nullptr)
+		flag |= COMPACT_FLAG_REF;
+	    dump_compact(f, itp->first, itp->second, flag, prev_date);
+	    if(itp->second.base != nullptr)
+		itp->second.base->dump(f);
+	    if(itp->second.result != nullptr)
+		itp->second.result->dump(f);
+	    ++itp;
+	}
+
+	    // last change table dump
+
+	sz = last_change.size();
+	sz.dump(f);
+	prev_date = datetime(0);
+
+	archive_records<status>::const_iterator it = last_change.begin();
+	while(it != last_change.end())
+	{
+	    dump_compact(f, it->first, it->second, 0, prev_date);
+	    ++it;
+	}
+    }
+
+    void data_tree::dump_legacy_body(generic_file & f) const
+    {
+	infinint sz;
+	archive_records<status_plus>::const_iterator itp = last_mod.begin();
 
 	    // last mod table dump
 
@@ -338,7 +423,7 @@ namespace libdar
 	sz = last_change.size();
 	sz.dump(f);
 
-	map<archive_num, status>::const_iterator it = last_change.begin();
+	archive_records<status>::const_iterator it = last_change.begin();
 	while(it != last_change.end())
 	{
 	    it->first.write_to_file(f); // key
@@ -347,16 +432,130 @@ namespace libdar
 	}
     }
 
+    void data_tree::dump_compact(generic_file & f,
+				 archive_num num,
+				 const status & sta,
+				 unsigned char flag,
+				 datetime & prev_date)
+    {
+	    // most of the time a file has the same date in many archives
+	    // (differential backups where it did not change) or a more
+	    // recent date in a more recent archive, which lead to store
+	    // nothing or a small difference in place of the date
+
+	if(sta.date == prev_date)
+	    flag |= COMPACT_DATE_SAME;
+	else
+	    if(sta.date > prev_date)
+		flag |= COMPACT_DATE_DELTA;
+	    else
+		flag |= COMPACT_DATE_FULL;
+
+	switch(sta.present)
+	{
+	case db_etat::et_saved:
+	case db_etat::et_patch:
+	case db_etat::et_patch_unusable:
+	case db_etat::et_inode:
+	case db_etat::et_present:
+	case db_etat::et_removed:
+	case db_etat::et_absent:
+	    flag |= static_cast<unsigned char>(sta.present) & COMPACT_ETAT_MASK;
+	    break;
+	default:
+	    throw SRC_BUG;
+	}
+
+	num.write_to_file(f);
+	f.write((char *)&flag, 1);
+
+	switch(flag & COMPACT_DATE_MASK)
+	{
+	case COMPACT_DATE_SAME:
+	    break;
+	case COMPACT_DATE_DELTA:
+	    (sta.date - prev_date).dump(f);
+	    break;
+	case COMPACT_DATE_FULL:
+	    sta.date.dump(f);
+	    break;
+	default:
+	    throw SRC_BUG;
+	}
+
+	prev_date = sta.date;
+    }
+
+    unsigned char data_tree::read_compact(generic_file & f,
+					  unsigned char db_version,
+					  archive_num & num,
+					  status & sta,
+					  datetime & prev_date)
+    {
+	unsigned char flag;
+	datetime tmp;
+
+	num.read_from_file(f);
+	if(f.read((char *)&flag, 1) != 1)
+	    throw Erange(gettext("reached End of File before all expected data could be read"));
+
+	switch(flag & COMPACT_ETAT_MASK)
+	{
+	case static_cast<unsigned char>(db_etat::et_saved):
+	    sta.present = db_etat::et_saved;
+	    break;
+	case static_cast<unsigned char>(db_etat::et_patch):
+	    sta.present = db_etat::et_patch;
+	    break;
+	case static_cast<unsigned char>(db_etat::et_patch_unusable):
+	    sta.present = db_etat::et_patch_unusable;
+	    break;
+	case static_cast<unsigned char>(db_etat::et_inode):
+	    sta.present = db_etat::et_inode;
+	    break;
+	case static_cast<unsigned char>(db_etat::et_present):
+	    sta.present = db_etat::et_present;
+	    break;
+	case static_cast<unsigned char>(db_etat::et_removed):
+	    sta.present = db_etat::et_removed;
+	    break;
+	case static_cast<unsigned char>(db_etat::et_absent):
+	    sta.present = db_etat::et_absent;
+	    break;
+	default:
+	    throw Erange(gettext("Unexpected value found in database"));
+	}
+
+	switch(flag & COMPACT_DATE_MASK)
+	{
+	case COMPACT_DATE_SAME:
+	    sta.date = prev_date;
+	    break;
+	case COMPACT_DATE_DELTA:
+	    tmp.read(f, db2archive_version(db_version));
+	    sta.date = prev_date + tmp;
+	    break;
+	case COMPACT_DATE_FULL:
+	    sta.date.read(f, db2archive_version(db_version));
+	    break;
+	default:
+	    throw Erange(gettext("Unexpected value found in database"));
+	}
+
+	prev_date = sta.date;
+	return flag;
+    }
+
     db_lookup data_tree::get_data(set<archive_num> & archive, const datetime & date, bool even_when_removed) const
     {
 
-		// we will pass each element of the last_mod map, following the order used by std::map
-		// which is based on the order of the first element, here archive_num, thus "it" will
+		// we will pass each element of the last_mod records, which are sorted
+		// following the order of the first element, here archive_num, thus "it" will
 		// be pointing at each entry, from the smallest to the highest archive number
 
 	datetime max_seen_date = datetime(0);
 	candidates candy(even_when_removed); ///< Au pays de Candy, comme dans tous les pays...
-	map<archive_num, status_plus>::const_iterator it = last_mod.begin();
+	archive_records<status_plus>::const_iterator it = last_mod.begin();
 
 	while(it != last_mod.end())
 	{
@@ -378,7 +577,7 @@ namespace libdar
 
     db_lookup data_tree::get_EA(archive_num & archive, const datetime & date, bool even_when_removed) const
     {
-	map<archive_num, status>::const_iterator it = last_change.begin();
+	archive_records<status>::const_iterator it = last_change.begin();
 	datetime max_seen_date = datetime(0), max_real_date = datetime(0);
 	bool presence_seen = false, presence_real = false;
 	archive_num last_archive_seen = 0;
@@ -472,7 +671,7 @@ namespace libdar
 			      datetime & val,
 			      db_etat & present) const
     {
-	map<archive_num, status_plus>::const_iterator it = last_mod.find(num);
+	archive_records<status_plus>::const_iterator it = last_mod.find(num);
 
 	if(it != last_mod.end())
 	{
@@ -488,7 +687,7 @@ namespace libdar
 			    datetime & val,
 			    db_etat & present) const
     {
-	map<archive_num, status>::const_iterator it = last_change.find(num);
+	archive_records<status>::const_iterator it = last_change.find(num);
 
 	if(it != last_change.end())
 	{
@@ -504,7 +703,7 @@ namespace libdar
 			     const datetime & deleted_date,
 			     const archive_num & ignore_archives_greater_or_equal)
     {
-	map<archive_num, status_plus>::iterator itp = last_mod.begin();
+	archive_records<status_plus>::iterator itp = last_mod.begin();
 	bool presence_max = false;
 	archive_num num_max = 0;
 	datetime last_mtime = datetime(0); // used as deleted_date for EA if last mtime is found
@@ -604,7 +803,7 @@ namespace libdar
 	    //
 
 
-	map<archive_num, status>::iterator it = last_change.begin();
+	archive_records<status>::iterator it = last_change.begin();
 	presence_max = false;
 	num_max = 0;
 	found_in_archive = false;
@@ -650,7 +849,7 @@ namespace libdar
 
     bool data_tree::remove_all_from(const archive_num & archive_to_remove, const archive_num & last_archive)
     {
-	map<archive_num, status_plus>::iterator itp = last_mod.begin();
+	archive_records<status_plus>::iterator itp = last_mod.begin();
 
 
 	    // if this file was stored as "removed" in the archive we tend to remove from the database
@@ -688,7 +887,7 @@ namespace libdar
 		++itp;
 	}
 
-	map<archive_num, status>::iterator it = last_change.begin();
+	archive_records<status>::iterator it = last_change.begin();
 	while(it != last_change.end())
 	{
 	    if(it->first == archive_to_remove)
@@ -708,8 +907,8 @@ namespace libdar
     void data_tree::listing(database_listing_get_version_callback callback,
 			    void *tag) const
     {
-	map<archive_num, status_plus>::const_iterator it = last_mod.begin();
-	map<archive_num, status>::const_iterator ut = last_change.begin();
+	archive_records<status_plus>::const_iterator it = last_mod.begin();
+	archive_records<status>::const_iterator ut = last_change.begin();
 
 	while(it != last_mod.end() || ut != last_change.end())
 	{
@@ -747,33 +946,33 @@ namespace libdar
 
     void data_tree::apply_permutation(archive_num src, archive_num dst)
     {
-	map<archive_num, status_plus> transfertp;
-	map<archive_num, status_plus>::iterator itp = last_mod.begin();
+	archive_records<status_plus> transfertp;
+	archive_records<status_plus>::iterator itp = last_mod.begin();
 
 	while(itp != last_mod.end())
 	{
 	    transfertp[data_tree_permutation(src, dst, itp->first)] = itp->second;
 	    ++itp;
 	}
-	last_mod = transfertp;
+	last_mod = std::move(transfertp);
 	transfertp.clear();
 
-	map<archive_num, status> transfert;
-	map<archive_num, status>::iterator it = last_change.begin();
+	archive_records<status> transfert;
+	archive_records<status>::iterator it = last_change.begin();
 
 	while(it != last_change.end())
 	{
 	    transfert[data_tree_permutation(src, dst, it->first)] = it->second;
 	    ++it;
 	}
-	last_change = transfert;
+	last_change = std::move(transfert);
 	(void)check_delta_validity();
     }
 
     void data_tree::skip_out(archive_num num)
     {
-	map<archive_num, status_plus> resultantp;
-	map<archive_num, status_plus>::iterator itp = last_mod.begin();
+	archive_records<status_plus> resultantp;
+	archive_records<status_plus>::iterator itp = last_mod.begin();
 	infinint tmp;
 
 	while(itp != last_mod.end())
@@ -784,11 +983,11 @@ namespace libdar
 		resultantp[itp->first] = itp->second;
 	    ++itp;
 	}
-	last_mod = resultantp;
+	last_mod = std::move(resultantp);
 	resultantp.clear();
 
-	map<archive_num, status> resultant;
-	map<archive_num, status>::iterator it = last_change.begin();
+	archive_records<status> resultant;
+	archive_records<status>::iterator it = last_change.begin();
 	while(it != last_change.end())
 	{
 	    if(it->first > num)
@@ -797,7 +996,7 @@ namespace libdar
 		resultant[it->first] = it->second;
 	    ++it;
 	}
-	last_change = resultant;
+	last_change = std::move(resultant);
     }
 
     void data_tree::compute_most_recent_stats(deque<infinint> & data,
@@ -806,9 +1005,8 @@ namespace libdar
 					      deque<infinint> & total_ea,
 					      const datetime & ignore_older_than_that) const
     {
-	set<db_etat> flag_set;
+	U_I flag_set = etat_bit(db_etat::et_saved);
 
-	flag_set.insert(db_etat::et_saved);
 	compute_for_flag_set(data,
 			     ea,
 			     total_data,
@@ -825,13 +1023,11 @@ namespace libdar
 							deque<infinint> & total_ea,
 							const datetime & ignore_older_than_that) const
     {
-	set<db_etat> flag_set;
-
-	flag_set.insert(db_etat::et_saved);
-	flag_set.insert(db_etat::et_patch);
-	flag_set.insert(db_etat::et_inode);
-	flag_set.insert(db_etat::et_removed);
-	flag_set.insert(db_etat::et_absent);
+	U_I flag_set = etat_bit(db_etat::et_saved)
+	    | etat_bit(db_etat::et_patch)
+	    | etat_bit(db_etat::et_inode)
+	    | etat_bit(db_etat::et_removed)
+	    | etat_bit(db_etat::et_absent);
 
 	compute_for_flag_set(data,
 			     ea,
@@ -845,7 +1041,7 @@ namespace libdar
     bool data_tree::fix_corruption()
     {
 	bool ret = true;
-	map<archive_num, status_plus>::iterator itp = last_mod.begin();
+	archive_records<status_plus>::iterator itp = last_mod.begin();
 
 	while(itp != last_mod.end() && ret)
 	{
@@ -854,7 +1050,7 @@ namespace libdar
 	    ++itp;
 	}
 
-	map<archive_num, status>::iterator it = last_change.begin();
+	archive_records<status>::iterator it = last_change.begin();
 	while(it != last_change.end() && ret)
 	{
 	    if(it->second.present != db_etat::et_removed && it->second.present != db_etat::et_absent)
@@ -879,7 +1075,7 @@ namespace libdar
 
 
     template<class T> bool data_tree::check_map_order(user_interaction & dialog,
-						      const map<archive_num, T> the_map,
+						      const archive_records<T> & the_map,
 						      const path & current_path,
 						      const string & field_nature,
 						      bool & initial_warn) const
@@ -888,7 +1084,7 @@ namespace libdar
 
 	U_I dates_size = the_map.size()+1;
 	vector<trecord> dates = vector<trecord>(dates_size);
-	typename map<archive_num, T>::const_iterator it = the_map.begin();
+	typename archive_records<T>::const_iterator it = the_map.begin();
 	vector<trecord>::iterator rec_it;
 	datetime last_date = datetime(0);
 
@@ -954,7 +1150,7 @@ namespace libdar
 	bool ret = true;
 	const crc *prev = nullptr;
 
-	for(map<archive_num, status_plus>::iterator it = last_mod.begin(); it != last_mod.end(); ++it)
+	for(archive_records<status_plus>::iterator it = last_mod.begin(); it != last_mod.end(); ++it)
 	{
 	    switch(it->second.present)
 	    {
@@ -995,17 +1191,17 @@ namespace libdar
 					 deque<infinint> & total_data,
 					 deque<infinint> & total_ea,
 					 const datetime & ignore_older_than_that,
-					 const set<db_etat> & flag_set,
+					 U_I flag_set,
 					 bool even_when_removed) const
     {
 	archive_num most_recent = 0;
 	datetime max = datetime(0);
 	db_etat last_state = db_etat::et_absent;
-	map<archive_num, status_plus>::const_iterator itp = last_mod.begin();
+	archive_records<status_plus>::const_iterator itp = last_mod.begin();
 
 	while(itp != last_mod.end())
 	{
-	    if(flag_set.find(itp->second.present) != flag_set.end())
+	    if((flag_set & etat_bit(itp->second.present)) != 0)
 	    {
 		if(itp->second.date >= max
 		   &&
@@ -1027,11 +1223,11 @@ namespace libdar
 	most_recent = 0;
 	max = datetime(0);
 	last_state = db_etat::et_absent;
-	map<archive_num, status>::const_iterator it = last_change.begin();
+	archive_records<status>::const_iterator it = last_change.begin();
 
 	while(it != last_change.end())
 	{
-	    if(flag_set.find(it->second.present) != flag_set.end())
+	    if((flag_set & etat_bit(it->second.present)) != 0)
 	    {
 		if(it->second.date >= max
 		    &&
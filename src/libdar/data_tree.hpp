@@ -29,10 +29,11 @@
 
 #include "../my_config.h"
 
-#include <map>
 #include <string>
 #include <deque>
 #include <set>
+#include <vector>
+#include <algorithm>
 #include "infinint.hpp"
 #include "generic_file.hpp"
 #include "user_interaction.hpp"
@@ -61,7 +62,14 @@ namespace libdar
 	data_tree & operator = (data_tree && ref) noexcept = default;
 	virtual ~data_tree() = default;
 
-	virtual void dump(generic_file & f) const; ///< dump signature followed by data constructor will read
+	virtual void dump(generic_file & f) const; ///< dump signature followed by data constructor will read (format of database version 7)
+
+	    /// dump the per archive status of this entry, without signature nor name (format of the current database version)
+	void dump_body(generic_file & f) const;
+
+	    /// read what dump_body() has written, replacing the current per archive status
+	void read_body(generic_file & f, unsigned char db_version);
+
 	std::string get_name() const { return filename; };
 	void set_name(const std::string & name) { filename = name; };
 
@@ -168,6 +176,16 @@ namespace libdar
 	static constexpr unsigned char STATUS_PLUS_FLAG_ME = 0x01;
 	static constexpr unsigned char STATUS_PLUS_FLAG_REF = 0x02;
 
+	    // flags of the compact form of status used since database version 8
+	    // the three lowest bits carry the db_etat value
+	static constexpr unsigned char COMPACT_ETAT_MASK = 0x07;
+	static constexpr unsigned char COMPACT_DATE_SAME = 0x00;  ///< date is the same as the previous record, it is not stored
+	static constexpr unsigned char COMPACT_DATE_DELTA = 0x08; ///< date is stored as the difference with the previous record
+	static constexpr unsigned char COMPACT_DATE_FULL = 0x10;  ///< date is stored as is (older than the previous record)
+	static constexpr unsigned char COMPACT_DATE_MASK = 0x18;
+	static constexpr unsigned char COMPACT_FLAG_ME = 0x20;    ///< a crc of the base of the patch follows
+	static constexpr unsigned char COMPACT_FLAG_REF = 0x40;   ///< a crc of the data follows
+
 	class status
 	{
 	public:
@@ -177,14 +195,14 @@ namespace libdar
 	    status(status && ref) noexcept = default;
 	    status & operator = (const status & ref) = default;
 	    status & operator = (status && ref) noexcept = default;
-	    virtual ~status() = default;
+	    ~status() = default;
 
 	    datetime date;                             ///< date of the event
 	    db_etat present;                           ///< file's status in the archive
 
-	    virtual void dump(generic_file & f) const; ///< write the struct to file
-	    virtual void read(generic_file &f,         ///< set the struct from file
-			      unsigned char db_version);
+	    void dump(generic_file & f) const;         ///< write the struct to file
+	    void read(generic_file &f,                 ///< set the struct from file
+		      unsigned char db_version);
 	};
 
 
@@ -214,20 +232,85 @@ namespace libdar
 	};
 
 
+
+	    /// status of an entry per archive, sorted by archive number
+
+	    /// this provides the part of the std::map interface used by data_tree, but
+	    /// a database holds a very large number of entries each having only a few
+	    /// records, for which a sorted vector takes much less memory than a map
+	    /// and is faster to walk through
+	template <class T> class archive_records
+	{
+	public:
+	    typedef std::pair<archive_num, T> record;
+	    typedef typename std::vector<record>::iterator iterator;
+	    typedef typename std::vector<record>::const_iterator const_iterator;
+
+	    iterator begin() { return content.begin(); };
+	    iterator end() { return content.end(); };
+	    const_iterator begin() const { return content.begin(); };
+	    const_iterator end() const { return content.end(); };
+	    U_I size() const { return content.size(); };
+	    bool empty() const { return content.empty(); };
+	    void clear() { content.clear(); };
+	    void reserve(U_I num) { content.reserve(num); };
+	    void erase(iterator it) { content.erase(it); };
+
+	    iterator find(archive_num num) { iterator it = lower(num); return (it != content.end() && it->first == num) ? it : content.end(); };
+	    const_iterator find(archive_num num) const { const_iterator it = lower(num); return (it != content.end() && it->first == num) ? it : content.end(); };
+
+		/// access to the record of archive num, which is created if not already present
+	    T & operator [] (archive_num num)
+	    {
+		iterator it = lower(num);
+
+		if(it == content.end() || it->first != num)
+		    it = content.insert(it, record(num, T()));
+		return it->second;
+	    };
+
+	private:
+	    std::vector<record> content;
+
+	    static bool less_num(const record & a, archive_num b) { return a.first < b; };
+
+		// records are most of the time added in the increasing order of archive number
+	    iterator lower(archive_num num) { return (content.empty() || content.back().first < num) ? content.end() : std::lower_bound(content.begin(), content.end(), num, less_num); };
+	    const_iterator lower(archive_num num) const { return (content.empty() || content.back().first < num) ? content.end() : std::lower_bound(content.begin(), content.end(), num, less_num); };
+	};
+
+
 	std::string filename;
-	std::map<archive_num, status_plus> last_mod; ///< key is archive number ; value is last_mod time
-	std::map<archive_num, status> last_change;   ///< key is archive number ; value is last_change time
+	archive_records<status_plus> last_mod; ///< key is archive number ; value is last_mod time
+	archive_records<status> last_change;   ///< key is archive number ; value is last_change time
 
 
 	    // when false is returned, this means that the user wants to ignore subsequent error of the same type
 	    // else either no error yet met or user want to continue receiving the same type of error for other files
 	    // in that later case initial_warn is set to false (first warning has been shown).
 	template <class T> bool check_map_order(user_interaction & dialog,
-						const std::map<archive_num, T> the_map,
+						const archive_records<T> & the_map,
 						const path & current_path,
 						const std::string & field_nature,
 						bool & initial_warn) const;
 
+	    /// dump the per archive status in the format of database version 7
+	void dump_legacy_body(generic_file & f) const;
+
+	    /// write the compact form of a status, updating prev_date (database version 8 and above)
+	static void dump_compact(generic_file & f,
+				 archive_num num,
+				 const status & sta,
+				 unsigned char flag,
+				 datetime & prev_date);
+
+	    /// read the compact form of a status, updating prev_date, returns the flag field
+	static unsigned char read_compact(generic_file & f,
+					  unsigned char db_version,
+					  archive_num & num,
+					  status & sta,
+					  datetime & prev_date);
+
 	bool check_delta_validity(); // return true if no error has been met about delta patch (no delta is broken, missing its reference)
 
 	    /// give number of entry's last state (for data and ea) per archive number, followed by the total number of stored in each archive
@@ -237,7 +320,7 @@ namespace libdar
 	    /// \param[in,out] total_data table giving for each archive the total number of data entry (considering states from the flag_set provided set argument)
 	    /// \param[in,out] total_ea table giving for each archive the total number of EA entry (considering states from the flag_set provided set argument)
 	    /// \param[in] ignore_older_than_that focus the computation on version not more recent that this date
-	    /// \param[in] flag_set set of state to consider (other states are not taken into account when looking for the archive number of the latest entry)
+	    /// \param[in] flag_set set of state to consider given as a bit field (see etat_bit()), other states are not taken into account when looking for the archive number of the latest entry
 	    /// \param[in] even_when_removed by default, do not count in any archive a entry which latest state is removed or absent, else increment the archive
 	    /// of most recent state (as define by flag_set) for each entry, even if the most recent state is removed or absent.
 	void compute_for_flag_set(std::deque<infinint> & data,
@@ -245,9 +328,12 @@ namespace libdar
 				  std::deque<infinint> & total_data,
 				  std::deque<infinint> & total_ea,
 				  const datetime & ignore_older_than_that,
-				  const std::set<db_etat> & flag_set,
+				  U_I flag_set,
 				  bool even_when_removed) const;
 
+	    /// the bit representing a db_etat value in the flag_set field of compute_for_flag_set()
+	static U_I etat_bit(db_etat val) { return 1 << static_cast<U_I>(val); };
+
 
 	    /// gives new archive number when an database has its archive reordered
 
@@ -239,7 +239,9 @@ namespace libdar
 	    /// \param[in] num is the archive number to look at
 	    /// \param[in] opt optional parameters for this operation
 	    /// \note if "num" is set to zero all archive contents is listed
-	    /// \note this method is not available with partially extracted databases.
+	    /// \note this method is not available with partially extracted databases, except
+	    /// partial_read_only ones using the current database format where only the needed
+	    /// part of the file tree is read from file.
 	void get_files(database_listing_show_files_callback callback,
 		       void *context,
 		       archive_num num,
@@ -250,7 +252,9 @@ namespace libdar
 	    /// \param[in] callback is used to provide each entry in turn from the list
 	    /// \param[in] context is given as first argument of the callback as is provided here
 	    /// \param[in] chemin path to the file to look for
-	    /// \note this method is not available with partially extracted databases.
+	    /// \note this method is not available with partially extracted databases, except
+	    /// partial_read_only ones using the current database format where only the needed
+	    /// part of the file tree is read from file.
 	void get_version(database_listing_get_version_callback callback,
 			 void *context,
 			 path chemin) const;
@@ -259,7 +263,9 @@ namespace libdar
 
 	    /// \param[in] callback is used to provide each entry in turn from the list
 	    /// \param[in] context is given as first argument of the callback as is provided here
-	    /// \note this method is not available with partially extracted databases.
+	    /// \note this method is not available with partially extracted databases, except
+	    /// partial_read_only ones using the current database format where only the needed
+	    /// part of the file tree is read from file.
 	void show_most_recent_stats(database_listing_statistics_callback callback,
 				    void *context) const;
 
@@ -269,7 +275,9 @@ namespace libdar
 
 	    /// \param[in] filename list of filename to restore
 	    /// \param[in] opt extendable list of options to use for this operation
-	    /// \note this method is not available with partially extracted databases.
+	    /// \note this method is not available with partially extracted databases, except
+	    /// partial_read_only ones using the current database format where only the needed
+	    /// part of the file tree is read from file.
 	void restore(const std::vector<std::string> & filename,
 		     const database_restore_options & opt);
 
@@ -298,7 +306,9 @@ namespace libdar
 	    /// check that all files's Data and EA are more recent when archive number grows within the database, only warn the user
 
 	    /// \return true if check succeeded, false if warning have been issued
-	    /// \note this method is not available with partially extracted databases.
+	    /// \note this method is not available with partially extracted databases, except
+	    /// partial_read_only ones using the current database format where only the needed
+	    /// part of the file tree is read from file.
 	bool check_order() const;
 
     private:
@@ -65,7 +65,7 @@ using namespace std;
 namespace libdar
 {
 
-    static const unsigned char database_version = 7;
+    static const unsigned char database_version = 8;
 
 #define HEADER_OPTION_NONE 0x00
 #define HEADER_OPTION_COMPRESSOR 0x01
@@ -92,6 +92,13 @@ namespace libdar
 	format = archive_format_supported_version;
     }
 
+    void database_header::set_version(unsigned char val)
+    {
+	if(val > database_version || val == 0)
+	    throw SRC_BUG;
+	version = val;
+    }
+
     void database_header::read(generic_file & f)
     {
 	unsigned char options;
@@ -220,6 +227,10 @@ namespace libdar
 	case crypto_algo::twofish256:
 	case crypto_algo::serpent256:
 	case crypto_algo::camellia256:
+	case crypto_algo::aes256_xts:
+	case crypto_algo::twofish256_xts:
+	case crypto_algo::serpent256_xts:
+	case crypto_algo::camellia256_xts:
 	    break;
 	default:
 	    throw SRC_BUG;
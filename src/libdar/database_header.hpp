@@ -63,6 +63,9 @@ namespace libdar
 	void set_crypto_block_size(U_32 val);
 	void set_kdf_salt(const std::string & val) const { salt = val; };
 
+	    /// set the format version to write, must not be greater than database_header_get_supported_version()
+	void set_version(unsigned char val);
+
 	U_I get_version() const { return version; };
 	compression get_compression() const { return algo; };
 	U_I get_compression_level() const { return compression_level; };
@@ -122,6 +125,11 @@ namespace libdar
 
     extern const unsigned char database_header_get_supported_version();
 
+	/// the last database format version storing the file tree as a nested structure
+
+	/// starting with the next version the file tree is written with data_dir::dump_streamed()
+    constexpr unsigned char database_header_last_nested_version = 7;
+
 	///@}
 
 } // end of namespace
@@ -78,6 +78,9 @@ namespace libdar
 	    /// \note if value is set to true, all restriction found for partial mode apply, and in addition, the database cannot be dumped (written back to file)
 	    /// \note partial_read_only implies partial, but partial does not imply partial_readonly (it can be dumped but modification
 	    /// can only take place in the archive header)
+	    /// \note with databases using the current format (version 8 and above), the queries (database::get_files(),
+	    /// database::get_version(), database::restore()...) stay available in partial_read_only mode, reading from file only
+	    /// the part of the file tree they need
 	void set_partial_read_only(bool value) { x_partial_read_only = value; if(value) x_partial = value; };
 
 
@@ -120,7 +123,7 @@ namespace libdar
 	database_dump_options & operator = (database_dump_options && ref) noexcept = default;
 	~database_dump_options() = default;
 
-	void clear() { x_overwrite = false; };
+	void clear() { x_overwrite = false; x_legacy_format = false; };
 
 	    // settings
 
@@ -130,11 +133,21 @@ namespace libdar
 	    ///
 	void set_overwrite(bool value) { x_overwrite = value; };
 
+	    /// legacy format option
+
+	    /// \param[in] value if set to true the database is written using the format
+	    /// of release 2.8.x (database format version 7), which can be read by older
+	    /// dar_manager but does not allow partial loading of the file tree
+	    /// \note this option is not available with partially extracted databases
+	void set_legacy_format(bool value) { x_legacy_format = value; };
+
 	    // gettings
 	bool get_overwrite() const { return x_overwrite; };
+	bool get_legacy_format() const { return x_legacy_format; };
 
     private:
 	bool x_overwrite;
+	bool x_legacy_format;
     };
 
 	/// options to add an archive to base
@@ -262,7 +275,7 @@ namespace libdar
 	database_restore_options & operator = (database_restore_options && ref) noexcept = default;
 	~database_restore_options() = default;
 
-	void clear() { x_early_release = x_info_details = x_ignore_dar_options_in_database = x_even_when_removed = false; x_date = datetime(0); x_extra_options_for_dar.clear(); };
+	void clear() { x_early_release = x_info_details = x_ignore_dar_options_in_database = x_even_when_removed = false; x_date = datetime(0); x_extra_options_for_dar.clear(); x_read_ahead = 0; };
 
 	    // settings
 
@@ -304,6 +317,18 @@ namespace libdar
 	    /// that will be restored will be the one it had just before being removed
 	void set_even_when_removed(bool value) { x_even_when_removed = value; };
 
+	    /// number of archives to open in advance
+
+	    /// when restoring without calling dar and if not zero, the files only one archive provides
+	    /// are first restored, up to this number plus one archives at the same time. Then the archives
+	    /// are restored one after the other for directories and the files needing several archives,
+	    /// the archives being opened (their catalogue read) by separated threads up to this number of
+	    /// archives in advance, while the files of the previous archive are restored.
+	    /// \note zero (the default) means the archives are restored one after the other, each being
+	    /// opened only once the previous one has been restored. This option has no effect if libdar
+	    /// has been built without libthreadar
+	void set_read_ahead(U_I num) { x_read_ahead = num; };
+
 
 	    // gettings
 	bool get_early_release() const { return x_early_release; };
@@ -312,6 +337,7 @@ namespace libdar
 	const datetime & get_date() const { return x_date; };
 	bool get_ignore_dar_options_in_database() const { return x_ignore_dar_options_in_database; };
 	bool get_even_when_removed() const { return x_even_when_removed; };
+	U_I get_read_ahead() const { return x_read_ahead; };
 
     private:
 	bool x_early_release;
@@ -320,6 +346,7 @@ namespace libdar
 	datetime x_date;
 	bool x_ignore_dar_options_in_database;
 	bool x_even_when_removed;
+	U_I x_read_ahead;
     };
 
 
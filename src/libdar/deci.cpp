@@ -34,7 +34,6 @@ namespace libdar
 
     using chiffre = unsigned char;
 
-    static const U_I PAS = 5;
     static inline chiffre get_left(unsigned char a) { return (a & 0xF0) >> 4; }
     static inline chiffre get_right(unsigned char a) { return a & 0x0F; }
     static inline void set_left(unsigned char & a, chiffre val) { val <<= 4; a &= 0x0F; a |= val; }
@@ -53,64 +52,17 @@ namespace libdar
         return '0' + c;
     }
 
-    template <class T> void decicoupe(storage * &decimales, T x)
-    {
-	NLS_SWAP_IN;
+	/// pairs of decimal digits from "00" to "99", used to produce two digits per division
+    static const char digit_pairs[] = "00010203040506070809101112131415161718192021222324252627282930313233343536373839404142434445464748495051525354555657585960616263646566676869707172737475767778798081828384858687888990919293949596979899";
 
-	decimales = nullptr;
-	try
-	{
-	    chiffre r;
-	    const T d_t = 10;
-	    T r_t;
-	    storage::iterator it;
-	    bool recule = false;
-	    unsigned char tmp = 0;
+	/// number of decimal digits of the largest power of ten an U_64 can hold
+    static const U_I u64_digits = 19;
 
-	    decimales = new (nothrow) storage(PAS);
-	    if(decimales == nullptr)
-		throw Ememory();
+	/// append the decimal representation of val to s, padded with leading zeros to width digits
+    static void deci_append(string & s, U_64 val, U_I width);
 
-	    decimales->clear(0xFF);
-	    it = decimales->rbegin();
-
-	    while(x > 0 || recule)
-	    {
-		if(x > 0)
-		{
-		    euclide(x,d_t,x,r_t);
-		    r = 0;
-		    r_t.unstack(r);
-		}
-		else
-		    r = 0xF; // not significative information
-		if(recule)
-		{
-		    set_left(tmp, chiffre(r));
-		    if(it == decimales->rend())
-		    {
-			decimales->insert_const_bytes_at_iterator(decimales->begin(), 0xFF, PAS);
-			it = decimales->begin() + PAS - 1;
-		    }
-		    *(it--) = tmp;
-		}
-		else
-		    set_right(tmp, chiffre(r));
-		recule = ! recule;
-	    }
-	}
-	catch(...)
-	{
-	    if(decimales != nullptr)
-	    {
-		delete decimales;
-		decimales = nullptr;
-	    }
-	    NLS_SWAP_OUT;
-	    throw;
-	}
-	NLS_SWAP_OUT;
-    }
+	/// append the decimal representation of x to s, padded with leading zeros to width digits
+    static void deci_append(string & s, const infinint & x, U_I width);
 
     deci::deci(string s)
     {
@@ -169,19 +121,8 @@ namespace libdar
 	NLS_SWAP_OUT;
     }
 
-    deci::deci(const infinint & x)
+    deci::deci(const infinint & x): deci(to_string(x))
     {
-	try
-	{
-	    decicoupe(decimales, x);
-	    reduce();
-	}
-	catch(...)
-	{
-	    if(decimales != nullptr)
-		delete decimales;
-	    throw;
-	}
     }
 
     void deci::copy_from(const deci & ref)
@@ -280,7 +221,7 @@ namespace libdar
                 c = get_left(*it);
 
             if(c != 0xF)
-                s = s + string(1, digit_ctoh(c));
+                s += digit_ctoh(c);
 
             avance = ! avance;
         }
@@ -317,12 +258,87 @@ namespace libdar
         return r;
     }
 
+    string deci::to_string(const infinint & x)
+    {
+	string ret;
+
+	deci_append(ret, x, 0);
+
+	return ret;
+    }
+
     ostream & operator << (ostream & ref, const infinint & arg)
     {
-        deci tmp = arg;
-        ref << tmp.human();
+        ref << deci::to_string(arg);
 
         return ref;
     }
 
+    static void deci_append(string & s, U_64 val, U_I width)
+    {
+	char buf[u64_digits + 1];
+	char *ptr = buf + sizeof(buf);
+	U_I len;
+
+	while(val >= 100)
+	{
+	    const char *pair = digit_pairs + (val % 100) * 2;
+
+	    val /= 100;
+	    *(--ptr) = pair[1];
+	    *(--ptr) = pair[0];
+	}
+
+	if(val >= 10)
+	{
+	    const char *pair = digit_pairs + val * 2;
+
+	    *(--ptr) = pair[1];
+	    *(--ptr) = pair[0];
+	}
+	else
+	    *(--ptr) = '0' + val;
+
+	len = buf + sizeof(buf) - ptr;
+	if(width > len)
+	    s.append(width - len, '0');
+	s.append(ptr, len);
+    }
+
+    static void deci_append(string & s, const infinint & x, U_I width)
+    {
+	infinint high = x;
+	U_64 low = 0;
+
+	high.unstack(low);
+	if(high.is_zero())
+	    deci_append(s, low, width);
+	else
+	{
+		// x does not fit in an U_64, we split it in two halves around
+		// the largest 10^(19*2^n) not greater than x and convert each
+		// half the same way, the lower half being padded with zeros
+
+	    infinint power = 1;
+	    infinint square;
+	    U_I power_digits = u64_digits;
+	    infinint quotient, remainder;
+
+	    for(U_I i = 0; i < u64_digits; ++i)
+		power *= infinint(10);
+	    square = power * power;
+
+	    while(square <= x)
+	    {
+		power = square;
+		square = power * power;
+		power_digits *= 2;
+	    }
+
+	    euclide(x, power, quotient, remainder);
+	    deci_append(s, quotient, width > power_digits ? width - power_digits : 0);
+	    deci_append(s, remainder, power_digits);
+	}
+    }
+
 } // end of namespace
@@ -80,6 +80,13 @@ namespace libdar
 	    /// this produce a string from the decimal stored in the current object
         std::string human() const;
 
+	    /// produce the decimal representation of an infinint
+
+	    /// \note this is equivalent to deci(x).human() but much faster, as no
+	    /// decimal object is built: the value is converted two digits at a time
+	    /// using 64 bits arithmetic, splitting it first if it does not fit in 64 bits
+	static std::string to_string(const infinint & x);
+
     private :
         storage *decimales;
 
@@ -134,6 +134,27 @@ namespace libdar
         }
     }
 
+    entree_stats & entree_stats::operator += (const entree_stats & ref)
+    {
+	num_x += ref.num_x;
+	num_d += ref.num_d;
+	num_f += ref.num_f;
+	num_c += ref.num_c;
+	num_b += ref.num_b;
+	num_p += ref.num_p;
+	num_s += ref.num_s;
+	num_l += ref.num_l;
+	num_D += ref.num_D;
+	num_hard_linked_inodes += ref.num_hard_linked_inodes;
+	num_hard_link_entries += ref.num_hard_link_entries;
+	saved += ref.saved;
+	patched += ref.patched;
+	inode_only += ref.inode_only;
+	total += ref.total;
+
+	return *this;
+    }
+
     void entree_stats::listing(user_interaction & dialog) const
     {
 	dialog.printf("");
@@ -67,6 +67,7 @@ namespace libdar
                 = num_s = num_l = num_D = num_hard_linked_inodes
                 = num_hard_link_entries = saved = patched = inode_only = total = 0; };
         void add(const cat_entree *ref);
+	entree_stats & operator += (const entree_stats & ref); ///< adds the counters of another set of entries
         void listing(user_interaction & dialog) const;
     };
 
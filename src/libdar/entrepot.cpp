@@ -89,12 +89,38 @@ namespace libdar
 				   bool erase,
 				   hash_algo algo,
 				   bool provide_a_plain_file) const
+    {
+	deque<hash_algo> algos;
+
+	if(algo != hash_algo::none)
+	    algos.push_back(algo);
+
+	return open(dialog,
+		    filename,
+		    mode,
+		    force_permission,
+		    permission,
+		    fail_if_exists,
+		    erase,
+		    algos,
+		    provide_a_plain_file);
+    }
+
+    fichier_global *entrepot::open(const shared_ptr<user_interaction> & dialog,
+				   const std::string & filename,
+				   gf_mode mode,
+				   bool force_permission,
+				   U_I permission,
+				   bool fail_if_exists,
+				   bool erase,
+				   const deque<hash_algo> & algos,
+				   bool provide_a_plain_file) const
     {
 	fichier_global *ret = nullptr;
 	tuyau_global *pipe_g = nullptr;
 
 	    // sanity check
-	if(algo != hash_algo::none && (mode != gf_write_only || (!erase && !fail_if_exists)))
+	if(!algos.empty() && (mode != gf_write_only || (!erase && !fail_if_exists)))
 	    throw SRC_BUG; // if hashing is asked, we cannot accept to open an existing file without erasing its contents
 
 	try
@@ -125,48 +151,58 @@ namespace libdar
 		pipe_g = nullptr;
 	    }
 
-	    if(algo != hash_algo::none)
+	    if(!algos.empty())
 	    {
 		fichier_global *hash_file = nullptr;
-		fichier_global *tmp = nullptr;
+		hash_fichier *hasher = nullptr;
 
-		    // creating the file to write hash to
+		    // creating the files to write hashes to, all
+		    // hashes being computed by the same hash_fichier
 
 		try
 		{
-		    hash_file = inherited_open(dialog,
-					       filename+"."+hash_algo_to_string(algo),
-					       gf_write_only,
-					       force_permission,
-					       permission,
-					       fail_if_exists,
-					       erase);
-
-		    if(hash_file == nullptr)
-			throw SRC_BUG;
-
 		    try
 		    {
-			tmp = new (nothrow) hash_fichier(dialog,
-							 ret,
-							 filename,
-							 hash_file,
-							 algo);
-			if(tmp == nullptr)
-			    throw Ememory();
-			else
+			for(deque<hash_algo>::const_iterator it = algos.begin(); it != algos.end(); ++it)
 			{
-			    ret = tmp;
-			    hash_file = nullptr;
+			    if(*it == hash_algo::none)
+				throw SRC_BUG;
+
+			    hash_file = inherited_open(dialog,
+						       filename+"."+hash_algo_to_string(*it),
+						       gf_write_only,
+						       force_permission,
+						       permission,
+						       fail_if_exists,
+						       erase);
+
+			    if(hash_file == nullptr)
+				throw SRC_BUG;
+
+			    if(hasher == nullptr)
+			    {
+				hasher = new (nothrow) hash_fichier(dialog,
+								    ret,
+								    filename,
+								    hash_file,
+								    *it);
+				if(hasher == nullptr)
+				    throw Ememory();
+				ret = hasher;
+			    }
+			    else
+				hasher->add_hash(hash_file, *it);
+			    hash_file = nullptr; // now managed by hasher
 			}
 		    }
 		    catch(...)
 		    {
 			if(hash_file != nullptr)
 			    delete hash_file;
+			if(hasher != nullptr)
+			    hasher->cancel_hash(); // hasher is deleted below as ret, it must not write the hash of no data
 			throw;
 		    }
-
 		}
 		catch(Egeneric & e)
 		{
@@ -37,6 +37,7 @@
 
 #include <string>
 #include <memory>
+#include <deque>
 #include "user_interaction.hpp"
 #include "path.hpp"
 #include "archive_aux.hpp"
@@ -126,6 +127,19 @@ namespace libdar
 			     hash_algo algo,
 			     bool provide_a_plain_file = true) const;
 
+	    /// same as above but computing several hashes at once, an empty list meaning no hash
+
+	    /// \note a hash file is created for each algorithm, they must thus all be different
+	fichier_global *open(const std::shared_ptr<user_interaction> & dialog,
+			     const std::string & filename,
+			     gf_mode mode,
+			     bool force_permission,
+			     U_I permission,
+			     bool fail_if_exists,
+			     bool erase,
+			     const std::deque<hash_algo> & algos,
+			     bool provide_a_plain_file = true) const;
+
 	    /// change user_interaction if the implementation recorded it (at construction time for example)
 
 	    /// \note method open() just above uses the specified user_interaction provided as its first argument
@@ -33,6 +33,7 @@ extern "C"
 }
 
 #include "tools.hpp"
+#include "sar_tools.hpp"
 #include "fichier_libssh.hpp"
 #include "nls_swap.hpp"
 #include "entrepot_libssh.hpp"
@@ -65,19 +66,20 @@ namespace libdar
 	set_user_ownership(""); // not used for this type of entrepot //// <<< A REVOIR
 	set_group_ownership(""); // not used for this type of entrepot /// <<<< A REVOIR
 
-	connect.reset(new (nothrow) libssh_connection(dialog,
-						      login,
-						      password,
-						      host,
-						      port,
-						      auth_from_file,
-						      sftp_pub_keyfile,
-						      sftp_prv_keyfile,
-						      sftp_known_hosts,
-						      waiting_time,
-						      verbose));
-	if(!connect)
+	pool.reset(new (nothrow) libssh_pool(dialog,
+					     login,
+					     password,
+					     host,
+					     port,
+					     auth_from_file,
+					     sftp_pub_keyfile,
+					     sftp_prv_keyfile,
+					     sftp_known_hosts,
+					     waiting_time,
+					     verbose));
+	if(!pool)
 	    throw Ememory();
+	connect = pool->get_main();
 
 	server_url = "sftp://" + login + "@" + host;
 	if(!port.empty())
@@ -93,6 +95,7 @@ namespace libdar
 	,
 	server_url(ref.server_url),
 	sdir(nullptr),
+	pool(ref.pool),
 	connect(ref.connect)
 #endif
     {
@@ -221,16 +224,29 @@ namespace libdar
 #if LIBSSH_AVAILABLE
 	U_I perm = force_permission ? permission : 0666;
 	string fullname = (get_full_path().append(filename)).display();
-	fichier_libssh* ptr = new (nothrow) fichier_libssh(dialog,
-							   connect,
-							   fullname,
-							   mode,
-							   perm,
-							   fail_if_exists,
-							   erase);
-
-	if(ptr == nullptr)
-	    throw Ememory();
+	fichier_libssh* ptr = nullptr;
+
+	if(!pool)
+	    throw SRC_BUG;
+
+	if(prefetched
+	   && mode == gf_read_only
+	   && prefetched_name == fullname
+	   && prefetched_dialog == dialog)
+	    ptr = prefetched.release();
+	else
+	{
+	    prefetched.reset();
+	    ptr = new (nothrow) fichier_libssh(dialog,
+					       pool->acquire(true),
+					       fullname,
+					       mode,
+					       perm,
+					       fail_if_exists,
+					       erase);
+	    if(ptr == nullptr)
+		throw Ememory();
+	}
 
 	try
 	{
@@ -262,6 +278,9 @@ namespace libdar
 	    throw;
 	}
 
+	if(mode == gf_read_only)
+	    prefetch_next(dialog, fullname);
+
 	return ptr;
 #else
 	throw Efeature("SFTP repository (requires libssh)");
@@ -299,5 +318,50 @@ namespace libdar
 #endif
     }
 
+#if LIBSSH_AVAILABLE
+
+    void entrepot_libssh::prefetch_next(const shared_ptr<user_interaction> & dialog, const string & fullname) const
+    {
+	string next;
+	shared_ptr<libssh_connection> sess;
+
+	prefetched.reset();
+
+	if(!sar_tools_next_slice_name(fullname, next))
+	    return;
+
+	sess = pool->acquire(false);
+	if(!sess)
+	    return; // no free session, the file just opened would compete with the prefetch
+
+	try
+	{
+	    prefetched.reset(new (nothrow) fichier_libssh(dialog,
+							  sess,
+							  next,
+							  gf_read_only,
+							  0,
+							  false,
+							  false));
+	    if(!prefetched)
+		throw Ememory();
+	    prefetched->read_ahead(prefetch_size);
+	    prefetched_name = next;
+	    prefetched_dialog = dialog;
+	}
+	catch(Ebug & e)
+	{
+	    throw;
+	}
+	catch(Egeneric & e)
+	{
+		// no next slice or not readable, the error will be
+		// reported if the next slice is requested
+	    prefetched.reset();
+	}
+    }
+
+#endif
+
 
 } // end of namespace
@@ -44,6 +44,8 @@ extern "C"
 #include "entrepot.hpp"
 #include "fichier_global.hpp"
 #include "libssh_connection.hpp"
+#include "libssh_pool.hpp"
+#include "fichier_libssh.hpp"
 
 namespace libdar
 {
@@ -53,6 +55,10 @@ namespace libdar
 	/// implementation for SFTP entrepot unsing libssh backend
 	///
 	/// entrepot_libssh generates objects of class "fichier_libssh" inherited class of fichier_global
+	///
+	/// each file is given its own ssh session when the server accepts it, and when a slice
+	/// is opened for reading the next one is opened on another session and its first bytes
+	/// requested ahead of time
 
     class entrepot_libssh : public entrepot, public mem_ui
     {
@@ -112,7 +118,18 @@ namespace libdar
 	mutable sftp_dir sdir;    // using for read_dir/read_next[_dirinfo]() paradygm
 
 	    // shared libssh structures
-	std::shared_ptr<libssh_connection> connect;
+	std::shared_ptr<libssh_pool> pool;
+	std::shared_ptr<libssh_connection> connect; ///< main session of the pool
+
+	    // next slice prefetching
+
+	static const U_I prefetch_size = 10*1024*1024;
+
+	mutable std::unique_ptr<fichier_libssh> prefetched; ///< next slice opened ahead of time
+	mutable std::string prefetched_name;                ///< full path of prefetched
+	mutable std::shared_ptr<user_interaction> prefetched_dialog; ///< user_interaction prefetched has been created with
+
+	void prefetch_next(const std::shared_ptr<user_interaction> & dialog, const std::string & fullname) const;
 #endif
 
     };
@@ -97,7 +97,7 @@ namespace libdar
 	    throw SRC_BUG;
 
 	me->detruit();
-	me->contents = new (nothrow) etage(aveugle, get_location().display().c_str(), datetime(0), datetime(0), false, furtive_mode);
+	me->contents = new (nothrow) etage(aveugle, get_location().display().c_str(), datetime(0), datetime(0), false, furtive_mode, false);
 	if(contents == nullptr)
 	    throw Ememory();
     }
@@ -70,6 +70,8 @@ extern "C"
 #endif
 } // end extern "C"
 
+#include <algorithm>
+
 #include "etage.hpp"
 #include "tools.hpp"
 #include "infinint.hpp"
@@ -100,7 +102,8 @@ namespace libdar
                  const datetime & x_last_acc,
                  const datetime & x_last_mod,
                  bool cache_directory_tagging,
-                 bool furtive_read_mode)
+                 bool furtive_read_mode,
+                 bool sorted)
     {
         struct dirent *ret;
         DIR *tmp = nullptr;
@@ -180,6 +183,9 @@ namespace libdar
                     // drop all the contents of the directory because it follows the Cache Directory Tagging Standard
             }
 
+	    if(sorted)
+		sort(fichier.begin(), fichier.end());
+
             last_mod = x_last_mod;
             last_acc = x_last_acc;
         }
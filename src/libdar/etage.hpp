@@ -46,6 +46,8 @@ namespace libdar
 	/// cannot be used recursively. Thus each etage structure is used
 	/// to cache the contents of a directory, and can then be stored
 	/// beside other etage structures corresponding to subdirectories
+	/// \note when asked, entries are returned sorted by name (byte-wise
+	/// comparison) rather than in the order the system provides them
 
     class etage
     {
@@ -56,7 +58,8 @@ namespace libdar
 	      const datetime & x_last_acc,
 	      const datetime & x_last_mod,
 	      bool cache_directory_tagging,
-	      bool furtive_read_mode);
+	      bool furtive_read_mode,
+	      bool sorted);
 	etage(const etage & ref) = default;
 	etage(etage && ref) = default;
 	etage & operator = (const etage & ref) = default;
@@ -77,6 +80,8 @@ namespace libdar
 
 	    cell(const std::string & filename,
 		 inode_type tp): name(filename), type(tp) {};
+
+	    bool operator < (const cell & ref) const { return name < ref.name; };
 	};
 
         std::deque<cell> fichier;     ///< holds the list of entry in the directory
@@ -47,7 +47,8 @@ namespace libdar
 				     U_I waiting,
 				     bool force_permission,
 				     U_I permission,
-				     bool erase): fichier_global(dialog, m),
+				     bool erase,
+				     const deque<shared_ptr<mycurl_easyhandle_node> > & readers): fichier_global(dialog, m),
 						  end_data_mode(false),
 						  sub_is_dying(false),
 						  sync_write_asked(false),
@@ -95,6 +96,17 @@ namespace libdar
 	    switch_to_metadata(true);
 	    if(append_write && m != gf_read_only)
 		current_offset = get_size();
+
+	    if(m == gf_read_only
+	       && !readers.empty()
+	       && x_proto != remote_entrepot_type::ftp)
+		    // range requests reset the control session of FTP
+		    // servers, see set_subthread()
+	    {
+		ranged.reset(new (nothrow) mycurl_ranged_reader(dialog, chemin, readers, waiting));
+		if(!ranged)
+		    throw Ememory();
+	    }
 	}
 	catch(...)
 	{
@@ -277,6 +289,12 @@ namespace libdar
 
     void fichier_libcurl::inherited_read_ahead(const infinint & amount)
     {
+	if(ranged)
+	{
+	    start_ranged();
+	    return;
+	}
+
 	if(!has_maxpos || current_offset < maxpos)
 	    relaunch_thread(amount);
 	    // we relaunch thread only if we are not at EOF
@@ -321,6 +339,8 @@ namespace libdar
 
     void fichier_libcurl::inherited_flush_read()
     {
+	if(ranged)
+	    ranged->stop();
 	switch_to_metadata(true);
 	interthread.reset();
     }
@@ -335,6 +355,7 @@ namespace libdar
 	    break;
 	case gf_read_only:
 	    switch_to_metadata(true);
+	    ranged.reset(); // stops the threads
 	    break;
 	case gf_read_write:
 	    throw SRC_BUG;
@@ -423,6 +444,14 @@ namespace libdar
 	    return true;
 	}
 
+	if(ranged)
+	{
+	    start_ranged();
+	    read = ranged->read(a, size);
+	    current_offset += read;
+	    return true;
+	}
+
 	set_subthread(size);
 	do
 	{
@@ -933,6 +962,25 @@ namespace libdar
 	}
     }
 
+    void fichier_libcurl::start_ranged()
+    {
+	U_64 offset;
+	U_64 size;
+
+	if(!ranged)
+	    throw SRC_BUG;
+
+	if(ranged->is_started())
+	    return;
+
+	(void)get_size();
+	if(!tools_infinint2U_64(current_offset, offset)
+	   || !tools_infinint2U_64(maxpos, size))
+	    throw Erange(gettext("Integer too large for libcurl, cannot skip at the requested offset in the remote repository"));
+
+	ranged->start(offset, size);
+    }
+
     bool fichier_libcurl::still_data_to_write()
     {
 	if(get_mode() == gf_write_only)
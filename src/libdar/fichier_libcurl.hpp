@@ -40,6 +40,8 @@ extern "C"
 } // end extern "C"
 
 #include <string>
+#include <deque>
+#include <memory>
 #ifdef LIBTHREADAR_AVAILABLE
 #include <libthreadar/libthreadar.hpp>
 #endif
@@ -48,6 +50,7 @@ extern "C"
 #include "fichier_global.hpp"
 #include "remote_entrepot_api.hpp"
 #include "mycurl_easyhandle_node.hpp"
+#include "mycurl_ranged_reader.hpp"
 
 namespace libdar
 {
@@ -72,7 +75,8 @@ namespace libdar
 			U_I waiting,                    ///< retry timeout in case of network error
 			bool force_permission,          ///< whether file permission should be modified
 			U_I permission,                 ///< file permission to enforce if force_permission is set
-			bool erase);                    ///< whether to erase the file before writing to it
+			bool erase,                     ///< whether to erase the file before writing to it
+			const std::deque<std::shared_ptr<mycurl_easyhandle_node> > & readers = std::deque<std::shared_ptr<mycurl_easyhandle_node> >()); ///< in read-only mode, if not empty, handles used to fetch data by several ranges at a time
 
 	    /// no copy constructor available
 
@@ -170,6 +174,7 @@ namespace libdar
 	libthreadar::fast_tampon<char> interthread; ///< data channel for reading or writing with subthread
 	libthreadar::barrier synchronize; ///< used to be sure subthread has been launched // also used for sync_write
 	remote_entrepot_type x_proto;     ///< used to workaround some libcurl strange behavoir for some protocols
+	std::unique_ptr<mycurl_ranged_reader> ranged; ///< if set, used instead of the subthread to read data
 
 	void set_range(const infinint & begin, const infinint & range_size); ///< set range in easyhandle
 	void unset_range();  ///< unset range in easyhandle
@@ -181,6 +186,7 @@ namespace libdar
 	void finalize_subthread();   ///< subthread routine to end itself
 	void set_subthread(U_I & needed_bytes); ///< set parameters and run subthtread if necessary
 	bool still_data_to_write(); /// return true when in write mode and there is data pending to writing in interthread
+	void start_ranged();        ///< start the ranged reader at current_offset if not already done
 
 	static size_t write_data_callback(char *buffer, size_t size, size_t nmemb, void *userp);
 	static size_t read_data_callback(char *bufptr, size_t size, size_t nitems, void *userp);
@@ -56,7 +56,8 @@ namespace libdar
 	rabuffer(nullptr),
 	rallocated(0),
 	rasize(0),
-	ralu(0)
+	ralu(0),
+	wareq_maxsize(0)
     {
 	int access_type = 0;
 
@@ -115,6 +116,10 @@ namespace libdar
 	    // only had one item in the queue. So we set rareq_maxsize
 	    // to at least rareq_minsize
 
+	wareq_maxsize = write_behind_window_size / connect->get_max_write();
+	if(wareq_maxsize < rareq_minsize)
+	    wareq_maxsize = rareq_minsize;
+
 	check_pos_from_libssh();
     }
 
@@ -147,6 +152,7 @@ namespace libdar
 	if(!connect)
 	    throw SRC_BUG;
 
+	flush_writes();
 	attr = sftp_stat(connect->get_sftp_session(),
 			 my_path.c_str());
 
@@ -178,6 +184,11 @@ namespace libdar
 	infinint q = pos;
 	int ret = 0;
 
+	if(pos == current_pos)
+	    return true;
+	    // keeping the read-ahead requests
+
+	flush_writes();
 	clear_readahead();
 	q.unstack(libpos);
 	if(!q.is_zero())
@@ -242,11 +253,26 @@ namespace libdar
 	clear_readahead();
 	do
 	{
-	    step = sftp_write(sfd,
-			      a + wrote,
-			      size - wrote);
+	    aioreq tmp;
+	    U_I microstep = size - wrote;
+
+	    if(microstep > connect->get_max_write())
+		microstep = connect->get_max_write();
+
+	    if(wareq.size() >= wareq_maxsize)
+		wait_oldest_write();
+		// we do not wait for the server acknowledgment before sending
+		// the next data, up to write_behind_window_size bytes
+
+	    step = sftp_aio_begin_write(sfd,
+					a + wrote,
+					microstep,
+					& tmp.handle);
 	    if(step > 0)
+	    {
 		wrote += step;
+		wareq.push_back(std::move(tmp));
+	    }
 	}
 	while(wrote < size && step > 0);
 	current_pos += wrote;
@@ -266,6 +292,7 @@ namespace libdar
 	if(!connect)
 	    throw SRC_BUG;
 
+	flush_writes();
 	while(loop && read < size)
 	{
 
@@ -348,6 +375,7 @@ namespace libdar
     void fichier_libssh::myclose()
     {
 	clear_readahead();
+	wareq.clear(); // abandonning the write requests not acknowledged, if any
 	if(rabuffer != nullptr)
 	{
 	    delete [] rabuffer;
@@ -368,7 +396,7 @@ namespace libdar
 
 	while((tora > 0 || step > 0) && rareq.size() < rareq_maxsize)
 	{
-	    rahead tmp;
+	    aioreq tmp;
 
 	    if(step < rallocated)
 		tora.unstack(step);
@@ -401,6 +429,23 @@ namespace libdar
 	    // the read-ahead window
     }
 
+    void fichier_libssh::wait_oldest_write() const
+    {
+	ssize_t ret;
+
+	if(wareq.empty())
+	    throw SRC_BUG;
+
+	ret = sftp_aio_wait_write(&(wareq.front().handle));
+	if(ret == SSH_AGAIN)
+	    throw SRC_BUG; // the sftp session is in blocking mode
+	if(ret == SSH_ERROR)
+	    throw Erange(tools_printf(gettext("Error while writing SFTP data: %s"),
+				      connect->get_sftp_error_msg()));
+
+	wareq.pop_front();
+    }
+
     void fichier_libssh::check_pos_from_libssh()
     {
 	if(infinint(sftp_tell(sfd)) != current_pos)
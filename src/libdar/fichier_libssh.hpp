@@ -112,9 +112,9 @@ namespace libdar
 	    // inherited from generic_file grand-parent class
 	virtual void inherited_truncate(const infinint & pos) override;
 	virtual void inherited_read_ahead(const infinint & amount) override;
-	virtual void inherited_sync_write() override {};
+	virtual void inherited_sync_write() override { flush_writes(); };
 	virtual void inherited_flush_read() override {};
-	virtual void inherited_terminate() override { myclose(); };
+	virtual void inherited_terminate() override { flush_writes(); myclose(); };
 
 	    // inherited from fichier_global parent class
 	virtual U_I fichier_global_inherited_write(const char *a, U_I size) override;
@@ -126,18 +126,18 @@ namespace libdar
 	sftp_file sfd;
 	infinint current_pos; ///< we cannot rely in libssh to provide the read offset as we also use Async I/O
 
-	    // read ahead structures
+	    // asynchronous I/O structures
 
-	struct rahead
+	struct aioreq
 	{
 	    sftp_aio handle;
 
-	    rahead(): handle(nullptr) {};
-	    rahead(const rahead & ref) = delete;
-	    rahead(rahead && ref) noexcept { handle = ref.handle; ref.handle = nullptr; };
-	    rahead & operator = (const rahead & ref) = delete;
-	    rahead & operator = (rahead && ref) noexcept { std::swap(handle, ref.handle); return *this; };
-	    ~rahead() { if(handle != nullptr) sftp_aio_free(handle); };
+	    aioreq(): handle(nullptr) {};
+	    aioreq(const aioreq & ref) = delete;
+	    aioreq(aioreq && ref) noexcept { handle = ref.handle; ref.handle = nullptr; };
+	    aioreq & operator = (const aioreq & ref) = delete;
+	    aioreq & operator = (aioreq && ref) noexcept { std::swap(handle, ref.handle); return *this; };
+	    ~aioreq() { if(handle != nullptr) sftp_aio_free(handle); };
 	};
 
 	static const U_I read_ahead_window_size = 100*1024*1024;
@@ -145,7 +145,7 @@ namespace libdar
 
 	infinint tora; ///< amount of data to read ahead and not yet pushed to libssh using rareq deque
 
-	std::deque<rahead> rareq; ///< background running requests not yet fetched
+	std::deque<aioreq> rareq; ///< background running requests not yet fetched
 	U_I rareq_maxsize;
 
 	char* rabuffer; ///< holds data retreived from the last sftp_aio_wait_read()
@@ -153,12 +153,26 @@ namespace libdar
 	U_I rasize;     ///< amount of bytes in rabuffer available for reading (rasize <= rallocated)
 	U_I ralu;       ///< bytes of rabuffer already allocaed
 
+	    // write behind structures
+
+	static const U_I write_behind_window_size = 16*1024*1024;
+	    /// data sent to the server and not yet acknowledged
+
+	mutable std::deque<aioreq> wareq; ///< write requests sent and not yet acknowledged
+	U_I wareq_maxsize;
+
 	    // private methods
 
 	void myclose();
 	void clear_readahead() { rareq.clear(); ralu = rasize = 0; };
 	void update_aio_reqs();
 
+	    /// wait for the server to acknowledge the oldest pending write
+	void wait_oldest_write() const;
+
+	    /// wait for all pending writes to be acknowledged
+	void flush_writes() const { while(!wareq.empty()) wait_oldest_write(); };
+
 	    /// checks libssh is in sync of our current_pos
 
 	    /// \note libssh is not expected to be in sync when we have
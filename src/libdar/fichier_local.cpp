@@ -254,6 +254,53 @@ namespace libdar
         return ret;
     }
 
+    U_I fichier_local::copy_range_to(fichier_local & dst, U_I size)
+    {
+	if(is_terminated() || dst.is_terminated())
+	    throw SRC_BUG;
+
+	if(get_mode() == gf_write_only || dst.get_mode() == gf_read_only)
+	    throw SRC_BUG;
+
+#if HAVE_COPY_FILE_RANGE
+	ssize_t ret;
+
+#ifdef MUTEX_WORKS
+	check_self_cancellation();
+#endif
+#ifdef SSIZE_MAX
+	if(size > SSIZE_MAX)
+	    size = SSIZE_MAX;
+#endif
+
+	do
+	{
+	    ret = copy_file_range(filedesc, nullptr, dst.filedesc, nullptr, size, 0);
+	}
+	while(ret < 0 && errno == EINTR);
+
+	if(ret < 0)
+	{
+	    switch(errno)
+	    {
+	    case ENOSYS:     // not supported by the kernel
+	    case EXDEV:      // not supported between these filesystems
+	    case EINVAL:     // not supported for these files
+	    case EOPNOTSUPP: // not supported by the filesystem
+	    case EBADF:      // destination open in append mode
+	    case ENOSPC:     // let the regular write path handle the user interaction
+		return 0;
+	    default:
+		throw Erange(string(gettext("Error while copying data between files: ")) + tools_strerror_r(errno));
+	    }
+	}
+
+	return (U_I)ret;
+#else
+	return 0;
+#endif
+    }
+
     void fichier_local::inherited_truncate(const infinint & pos)
     {
 	off_t offset = 0;
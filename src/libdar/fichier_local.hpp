@@ -111,6 +111,17 @@ namespace libdar
 	    /// \note this is the caller duty to close() the provided filedescriptor
 	S_I give_fd_and_terminate() { int ret = filedesc; filedesc = -1; terminate(); return ret; };
 
+	    /// copy data to another local file without passing it through user space
+
+	    /// \param[in,out] dst the file to copy data to, at its current position
+	    /// \param[in] size maximum amount of byte to copy from the current position
+	    /// \return the amount of byte copied, zero if the system cannot copy data
+	    /// this way between these two files, the caller has then to read and write it
+	    /// \note the current position of both files are moved forward by the amount
+	    /// of data copied. The filesystem may share the data between the two files
+	    /// instead of copying it (reflink) when it supports it.
+	U_I copy_range_to(fichier_local & dst, U_I size);
+
     protected :
 	    // inherited from generic_file grand-parent class
 	virtual void inherited_truncate(const infinint & pos) override;
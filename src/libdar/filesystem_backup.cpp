@@ -189,7 +189,9 @@ namespace libdar
 	{
 	    if(ref_dir != nullptr)
 	    {
-		pile.push_back(etage(get_ui(), tmp, ref_dir->get_last_access(), ref_dir->get_last_modif(), cache_directory_tagging, furtive_read_mode));
+		pile.push_back(etage(get_ui(), tmp, ref_dir->get_last_access(), ref_dir->get_last_modif(), cache_directory_tagging, furtive_read_mode, true));
+		    // entries are read in sorted order for the resulting catalogue
+		    // to be usable as streamed reference (see catalogue_stream class)
 		root_fs_device = ref_dir->get_device();
 	    }
 	    else
@@ -276,7 +278,8 @@ namespace libdar
 							     ref_dir->get_last_access(),
 							     ref_dir->get_last_modif(),
 							     cache_directory_tagging,
-							     furtive_read_mode));
+							     furtive_read_mode,
+							     true));
 				    }
 				    catch(Egeneric & e)
 				    {
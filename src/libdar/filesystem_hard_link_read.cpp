@@ -373,9 +373,9 @@ namespace libdar
 
 		if(buf.st_nlink > 1 && see_hard_link && dynamic_cast<cat_directory *>(ref) == nullptr)
 		{
-		    map<node, couple>::iterator it = corres_read.find(node(buf.st_ino, buf.st_dev));
+		    couple *it = corres_read.find(node(buf.st_ino, buf.st_dev));
 
-		    if(it == corres_read.end()) // inode not yet seen, creating the cat_etoile object
+		    if(it == nullptr) // inode not yet seen, creating the cat_etoile object
 		    {
 			cat_inode *ino_ref = dynamic_cast<cat_inode *>(ref);
 			cat_etoile *tmp_et = nullptr;
@@ -388,19 +388,14 @@ namespace libdar
 			try
 			{
 			    ref = nullptr; // the object pointed to by ref is now managed by tmp_et
-			    couple tmp = couple(tmp_et, buf.st_nlink - 1);
-			    pair <node, couple> p_tmp(node(buf.st_ino, buf.st_dev), tmp);
-			    corres_read.insert(p_tmp);
-			    it = corres_read.find(node(buf.st_ino,buf.st_dev));
-			    if(it == corres_read.end())
-				throw SRC_BUG; // the addition of the entry to the map failed !!!
-			    else
-				it->second.obj->get_inode()->change_name("");
+			    (void)corres_read.emplace(node(buf.st_ino, buf.st_dev), tmp_et, buf.st_nlink - 1);
+				// from here tmp_et is referenced by the new couple and will be released with it
+			    tmp_et->get_inode()->change_name("");
 				// name of inode attached to an cat_etoile is not used so we don't want to waste space in this field.
 			}
 			catch(...)
 			{
-			    if(tmp_et != nullptr)
+			    if(corres_read.find(node(buf.st_ino, buf.st_dev)) == nullptr && tmp_et != nullptr)
 				delete tmp_et;
 			    throw;
 			}
@@ -410,18 +405,18 @@ namespace libdar
 		    else // inode already seen creating a new cat_mirage on the given cat_etoile
 		    {
 			    // some sanity checks
-			if(it->second.obj == nullptr)
+			if(it->obj == nullptr)
 			    throw SRC_BUG;
 
 			if(ref != nullptr)
 			    delete ref;  // we don't need this just created inode as it is already attached to the cat_etoile object
-			ref = new (nothrow) cat_mirage(name, it->second.obj);
+			ref = new (nothrow) cat_mirage(name, it->obj);
 			if(ref != nullptr)
 			{
-			    it->second.count--;
-			    if(it->second.count == 0)
-				corres_read.erase(it);
-				// this deletes the couple entry, implying the release of memory used by the holder object, but the cat_etoile will only be destroyed once its internal counter drops to zero
+			    it->count--;
+			    if(it->count == 0)
+				(void)corres_read.erase(node(buf.st_ino, buf.st_dev));
+				// this deletes the couple entry, but the cat_etoile will only be destroyed once its internal counter drops to zero
 			}
 		    }
 		}
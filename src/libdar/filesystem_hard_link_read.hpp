@@ -39,11 +39,11 @@ extern "C"
 #endif
 } // end extern "C"
 
-#include <map>
 #include "infinint.hpp"
 #include "fsa_family.hpp"
 #include "cat_all_entrees.hpp"
 #include "mem_ui.hpp"
+#include "hard_link_table.hpp"
 
 #include <set>
 
@@ -112,26 +112,38 @@ namespace libdar
 
         struct couple
         {
-            nlink_t count;       ///< counts the number of hard link on that inode that have not yet been found in filesystem, once this count reaches zero, the "couple" structure can be dropped and the "holder" too (no more expected hard links to be found)
+            nlink_t count;       ///< counts the number of hard link on that inode that have not yet been found in filesystem, once this count reaches zero, the "couple" structure can be dropped (no more expected hard links to be found)
             cat_etoile *obj;     ///< the address of the corresponding cat_etoile object for that inode
-	    cat_mirage holder;   ///< it increments by one the obj internal counters, thus, while this object is alive, the obj will not be destroyed
 
-	    couple(cat_etoile *ptr, nlink_t ino_count) : holder("FAKE", ptr) { count = ino_count; obj = ptr; };
+		// the couple is referenced by obj, which increments by one the obj internal counters,
+		// thus, while this object is alive, the obj will not be destroyed. As the address
+		// of the couple is recorded by obj, it must not be copied nor moved, which
+		// hard_link_table guarantees
+	    couple(cat_etoile *ptr, nlink_t ino_count) { count = ino_count; obj = ptr; obj->add_ref(this); };
+	    couple(const couple & ref) = delete;
+	    couple(couple && ref) = delete;
+	    couple & operator = (const couple & ref) = delete;
+	    couple & operator = (couple && ref) = delete;
+	    ~couple() { obj->drop_ref(this); };
         };
 
 	struct node
 	{
 	    node(ino_t num, dev_t dev) { numnode = num; device = dev; };
 
-		// this operator is required to use the type node in a std::map
-	    bool operator < (const node & ref) const { return numnode < ref.numnode || (numnode == ref.numnode && device < ref.device); };
+	    bool operator == (const node & ref) const { return numnode == ref.numnode && device == ref.device; };
 	    ino_t numnode;
 	    dev_t device;
 	};
 
+	struct node_hash
+	{
+	    U_64 operator () (const node & ref) const { return (U_64)ref.numnode ^ ((U_64)ref.device << 32) ^ ((U_64)ref.device >> 32); };
+	};
+
 	    // private variable
 
-        std::map <node, couple> corres_read;
+        hard_link_table<node, couple, node_hash> corres_read;
 	infinint etiquette_counter;
 	bool furtive_read_mode;
 	fsa_scope sc;
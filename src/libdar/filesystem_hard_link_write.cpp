@@ -115,42 +115,47 @@ using namespace std;
 namespace libdar
 {
 
+    bool filesystem_hard_link_write::mark_ea_restored(const cat_nomme *e, const string & spot)
+    {
+        const cat_mirage *e_mir = dynamic_cast<const cat_mirage *>(e);
+
+	if(e == nullptr)
+	    throw SRC_BUG;
+
+	    // checking that we have not already restored the EA of this
+	    // inode through another hard link
+	if(e_mir != nullptr)
+	{
+	    U_64 key = hard_link_etiquette_key(e_mir->get_etiquette());
+	    corres_ino_ea *it = corres_write.find(key);
+
+	    if(it == nullptr)
+	    {
+		    // inode never restored; (no data saved just EA)
+		    // we must record it
+		(void)corres_write.emplace(key, spot, true);
+	    }
+	    else
+		if(it->ea_restored)
+		    return false; // inode already restored
+		else
+		    it->ea_restored = true;
+	}
+
+	return true;
+    }
+
     bool filesystem_hard_link_write::raw_set_ea(const cat_nomme *e,
 						const ea_attributs & list_ea,
 						const string & spot,
 						const mask & ea_mask)
     {
-        const cat_mirage *e_mir = dynamic_cast<const cat_mirage *>(e);
-
         bool ret = false;
 
         try
         {
-            if(e == nullptr)
-                throw SRC_BUG;
-
-                // checking that we have not already restored the EA of this
-                // inode through another hard link
-            if(e_mir != nullptr)
-            {
-                map<infinint, corres_ino_ea>::iterator it;
-
-                it = corres_write.find(e_mir->get_etiquette());
-                if(it == corres_write.end())
-                {
-                        // inode never restored; (no data saved just EA)
-                        // we must record it
-                    corres_ino_ea tmp;
-                    tmp.chemin = spot;
-                    tmp.ea_restored = true;
-                    corres_write[e_mir->get_etiquette()] = tmp;
-                }
-                else
-                    if(it->second.ea_restored)
-                        return false; // inode already restored
-                    else
-                        it->second.ea_restored = true;
-            }
+            if(!mark_ea_restored(e, spot))
+		return false; // inode already restored
 
                 // restoring Extended Attributes
                 //
@@ -180,20 +185,18 @@ namespace libdar
                 // inode through another hard link
             if(e_mir != nullptr)
             {
-                map<infinint, corres_ino_ea>::iterator it;
+                U_64 key = hard_link_etiquette_key(e_mir->get_etiquette());
+                corres_ino_ea *it = corres_write.find(key);
 
-                it = corres_write.find(e_mir->get_etiquette());
-                if(it == corres_write.end())
+                if(it == nullptr)
                 {
                         // inode never restored; (no data saved just EA)
                         // we must record it
-                    corres_ino_ea tmp;
-                    tmp.chemin = spot;
-                    tmp.ea_restored = false;   // clearing the EA does not mean we have restored them, setting here "false" let raw_set_ea() being call afterward
-                    corres_write[e_mir->get_etiquette()] = tmp;
+                    (void)corres_write.emplace(key, spot, false);
+			// clearing the EA does not mean we have restored them, setting here "false" let raw_set_ea() being call afterward
                 }
                 else // entry found
-                    if(it->second.ea_restored)
+                    if(it->ea_restored)
                         return false; // inode already restored
             }
 
@@ -215,17 +218,13 @@ namespace libdar
     void filesystem_hard_link_write::write_hard_linked_target_if_not_set(const cat_mirage *ref, const string & chemin)
     {
         if(!known_etiquette(ref->get_etiquette()))
-        {
-            corres_ino_ea tmp;
-            tmp.chemin = chemin;
-            tmp.ea_restored = false; // if EA have to be restored next
-            corres_write[ref->get_etiquette()] = tmp;
-        }
+            (void)corres_write.emplace(hard_link_etiquette_key(ref->get_etiquette()), chemin, false);
+		// false: if EA have to be restored next
     }
 
     bool filesystem_hard_link_write::known_etiquette(const infinint & eti)
     {
-        return corres_write.find(eti) != corres_write.end();
+        return corres_write.find(hard_link_etiquette_key(eti)) != nullptr;
     }
 
     void filesystem_hard_link_write::make_file(const cat_nomme * ref,
@@ -258,12 +257,12 @@ namespace libdar
 		{
 		    bool create_file = false;
 
-		    map<infinint, corres_ino_ea>::iterator it = corres_write.find(ref_mir->get_etiquette());
-		    if(it == corres_write.end()) // first time, we have to create the inode
+		    corres_ino_ea *it = corres_write.find(hard_link_etiquette_key(ref_mir->get_etiquette()));
+		    if(it == nullptr) // first time, we have to create the inode
 			create_file = true;
 		    else // the inode already exists, making hard link if possible
 		    {
-			const char *old = it->second.chemin.c_str();
+			const char *old = it->chemin.c_str();
 			ret = link(old, name);
 			if(ret < 0)
 			{
@@ -333,81 +332,24 @@ namespace libdar
 		}
 		else if(ref_fil != nullptr)
 		{
-		    generic_file *ou;
-		    infinint seek;
-
 		    fichier_local dest = fichier_local(get_pointer(), display, gf_write_only, 0700, false, true, false);
 			// the implicit destruction of dest (exiting the block)
 			// will close the 'ret' file descriptor (see ~fichier_local())
-		    ou = ref_fil->get_data(cat_file::normal,
-					   nullptr,
-					   rsync_sig_magic::none,
-					   0,
-					   nullptr);
+
+		    copy_data_to(*ref_fil, dest);
 
 		    try
 		    {
-			const crc *crc_ori = nullptr;
-			crc *crc_dyn = nullptr;
-			infinint crc_size;
-
-			try
-			{
-
-			    if(!ref_fil->get_crc_size(crc_size))
-				crc_size = tools_file_size_to_crc_size(ref_fil->get_size());
-
-			    ou->skip(0);
-			    ou->read_ahead(ref_fil->get_storage_size());
-			    ou->copy_to(dest, crc_size, crc_dyn);
-
-			    if(crc_dyn == nullptr)
-				throw SRC_BUG;
-
-			    if(ref_fil->get_crc(crc_ori))
-			    {
-				if(crc_ori == nullptr)
-				    throw SRC_BUG;
-				if(typeid(*crc_dyn) != typeid(*crc_ori))
-				    throw SRC_BUG;
-				if(*crc_dyn != *crc_ori)
-				    throw Erange(gettext("Bad CRC, data corruption occurred"));
-				    // else nothing to do, nor to signal
-			    }
-				// else this is a very old archive
-			}
-			catch(...)
-			{
-			    if(crc_dyn != nullptr)
-				delete crc_dyn;
-			    throw;
-			}
-			if(crc_dyn != nullptr)
-			    delete crc_dyn;
-
-			try
-			{
-				// nop we do not sync before, so maybe some pages
-				// will be kept in cache for Linux, maybe not for
-				// other systems that support fadvise(2)
-			    dest.fadvise(fichier_global::advise_dontneed);
-			}
-			catch(Erange & e)
-			{
-				// silently ignoring any fadvise error
-				// this is not crucial anyway
-			}
+			    // nop we do not sync before, so maybe some pages
+			    // will be kept in cache for Linux, maybe not for
+			    // other systems that support fadvise(2)
+			dest.fadvise(fichier_global::advise_dontneed);
 		    }
-		    catch(...)
+		    catch(Erange & e)
 		    {
-			if(ou != nullptr)
-			    delete ou;
-			ref_fil->clean_data();
-			throw;
+			    // silently ignoring any fadvise error
+			    // this is not crucial anyway
 		    }
-		    if(ou != nullptr)
-			delete ou;
-		    ref_fil->clean_data();
 		    ret = 0; // to report a successful operation at the end of the if/else if chain
 		}
 		else if(ref_lie != nullptr)
@@ -461,14 +403,9 @@ namespace libdar
 		else // inode successfully created
 		    if(ref_mir != nullptr)
 		    {
-			map<infinint, corres_ino_ea>::iterator it = corres_write.find(ref_mir->get_etiquette());
-			if(it == corres_write.end()) // we just created the first hard linked to that inode, so we must record its intial link to build subsequent ones
-			{
-			    corres_ino_ea tmp;
-			    tmp.chemin = string(name);
-			    tmp.ea_restored = false;
-			    corres_write[ref_mir->get_etiquette()] = tmp;
-			}
+			U_64 key = hard_link_etiquette_key(ref_mir->get_etiquette());
+			if(corres_write.find(key) == nullptr) // we just created the first hard linked to that inode, so we must record its intial link to build subsequent ones
+			    (void)corres_write.emplace(key, string(name), false);
 		    }
 	    }
 	    catch(Ethread_cancel & e)
@@ -483,13 +420,74 @@ namespace libdar
 	while(ret < 0 && errno == ENOSPC);
     }
 
+    void filesystem_hard_link_write::copy_data_to(const cat_file & ref_fil, generic_file & dest)
+    {
+	generic_file *ou = ref_fil.get_data(cat_file::normal,
+					    nullptr,
+					    rsync_sig_magic::none,
+					    0,
+					    nullptr);
+
+	try
+	{
+	    const crc *crc_ori = nullptr;
+	    crc *crc_dyn = nullptr;
+	    infinint crc_size;
+
+	    try
+	    {
+
+		if(!ref_fil.get_crc_size(crc_size))
+		    crc_size = tools_file_size_to_crc_size(ref_fil.get_size());
+
+		ou->skip(0);
+		ou->read_ahead(ref_fil.get_storage_size());
+		ou->copy_to(dest, crc_size, crc_dyn);
+
+		if(crc_dyn == nullptr)
+		    throw SRC_BUG;
+
+		if(ref_fil.get_crc(crc_ori))
+		{
+		    if(crc_ori == nullptr)
+			throw SRC_BUG;
+		    if(typeid(*crc_dyn) != typeid(*crc_ori))
+			throw SRC_BUG;
+		    if(*crc_dyn != *crc_ori)
+			throw Erange(gettext("Bad CRC, data corruption occurred"));
+			// else nothing to do, nor to signal
+		}
+		    // else this is a very old archive
+	    }
+	    catch(...)
+	    {
+		if(crc_dyn != nullptr)
+		    delete crc_dyn;
+		throw;
+	    }
+	    if(crc_dyn != nullptr)
+		delete crc_dyn;
+	}
+	catch(...)
+	{
+	    if(ou != nullptr)
+		delete ou;
+	    ref_fil.clean_data();
+	    throw;
+	}
+	if(ou != nullptr)
+	    delete ou;
+	ref_fil.clean_data();
+    }
+
     void filesystem_hard_link_write::clear_corres_if_pointing_to(const infinint & ligne, const string & path)
     {
-        map<infinint, corres_ino_ea>::iterator it = corres_write.find(ligne);
-        if(it != corres_write.end())
+        U_64 key = hard_link_etiquette_key(ligne);
+        corres_ino_ea *it = corres_write.find(key);
+        if(it != nullptr)
 	{
-	    if(it->second.chemin == path)
-		corres_write.erase(it);
+	    if(it->chemin == path)
+		(void)corres_write.erase(key);
 	}
     }
 
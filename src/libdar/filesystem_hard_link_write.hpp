@@ -39,11 +39,11 @@ extern "C"
 #endif
 } // end extern "C"
 
-#include <map>
 #include "catalogue.hpp"
 #include "infinint.hpp"
 #include "fsa_family.hpp"
 #include "cat_all_entrees.hpp"
+#include "hard_link_table.hpp"
 
 #include <set>
 
@@ -91,6 +91,14 @@ namespace libdar
         void make_file(const cat_nomme * ref,
 		       const path & ou);
 
+	    /// copy the data of a plain file from the archive to dest, checking the CRC
+	static void copy_data_to(const cat_file & ref_fil, generic_file & dest);
+
+	    /// record that EA of the inode "e" are about to be restored at spot
+
+	    /// \return false if "e" is a hard link to an inode that has its EA already restored previously
+	bool mark_ea_restored(const cat_nomme *e, const std::string & spot);
+
 	    /// add the given EA matching the given mask to the file pointed to by "e" and spot
 
 	    /// \param[in] e may be an inode or a hard link to an inode,
@@ -118,11 +126,14 @@ namespace libdar
     private:
         struct corres_ino_ea
         {
+	    corres_ino_ea(const std::string & x_chemin, bool x_ea_restored): chemin(x_chemin), ea_restored(x_ea_restored) {};
+
             std::string chemin;
             bool ea_restored;
         };
 
-        std::map <infinint, corres_ino_ea> corres_write;
+	    /// etiquette of the restored hard linked inodes (see hard_link_etiquette_key()) to their first restored path
+        hard_link_table<U_64, corres_ino_ea> corres_write;
     };
 
 	/// @}
@@ -51,6 +51,10 @@ extern "C"
 #include <sys/types.h>
 #endif
 
+#if HAVE_SYS_STAT_H
+#include <sys/stat.h>
+#endif
+
 #if HAVE_SYS_SOCKET_H
 #include <sys/socket.h>
 #endif
@@ -123,7 +127,9 @@ namespace libdar
 					   bool x_empty,
 					   const crit_action *x_overwrite,
 					   bool x_only_overwrite,
-					   const fsa_scope & scope):
+					   const fsa_scope & scope,
+					   U_I x_writers,
+					   const shared_ptr<restore_dir_journal> & x_dir_journal):
 	filesystem_hard_link_write(dialog),
 	filesystem_hard_link_read(dialog, compile_time::furtive_read(), scope)
     {
@@ -144,6 +150,10 @@ namespace libdar
 	    overwrite = x_overwrite->clone();
 	    if(overwrite == nullptr)
 		throw Ememory();
+#ifdef LIBTHREADAR_AVAILABLE
+	    if(x_writers > 1 && !x_empty)
+		writers = make_unique<restore_writer_pool>(dialog, x_writers, x_ea_mask, x_what_to_check, scope);
+#endif
 	}
 	catch(...)
 	{
@@ -156,12 +166,14 @@ namespace libdar
 	warn_remove_no_match = x_warn_remove_no_match;
 	empty = x_empty;
 	only_overwrite = x_only_overwrite;
+	dir_journal = x_dir_journal;
 	reset_write();
 	zeroing_negative_dates_without_asking(); // when reading existing inode to evaluate overwriting action
     }
 
     void filesystem_restore::reset_write()
     {
+	wait_writers(0);
         filesystem_hard_link_write::corres_reset();
         filesystem_hard_link_read::corres_reset();
         stack_dir.clear();
@@ -197,17 +209,41 @@ namespace libdar
 	    x_fil = dynamic_cast<const cat_file *>(x_ino);
 	}
 
+	flush_writers_messages();
+
 	if(x_eod != nullptr)
 	{
 	    string tmp;
+
+		// the entries of this directory must be completed before
+		// setting the directory's dates, ownership and permission
+	    wait_writers(stack_dir.size());
 	    current_dir->pop(tmp);
 	    if(!stack_dir.empty())
 	    {
 		try
 		{
-		    if(!empty && stack_dir.back().get_restore_date())
+		    bool restore_date = stack_dir.back().get_restore_date();
+		    string chem;
+
+		    if(restore_date || dir_journal)
+			chem = (current_dir->append(stack_dir.back().get_name())).display();
+
+		    if(dir_journal)
+		    {
+			if(dir_journal->recording())
+			{
+				// the directory will get its metadata from the second pass
+			    if(restore_date)
+				dir_journal->changed_in(chem);
+			    restore_date = false;
+			}
+			else
+			    restore_date = restore_date || dir_journal->was_changed_in(chem);
+		    }
+
+		    if(!empty && restore_date)
 		    {
-			string chem = (current_dir->append(stack_dir.back().get_name())).display();
 			filesystem_tools_make_date(stack_dir.back(), chem, what_to_check, get_fsa_scope());
 			filesystem_tools_make_owner_perm(get_ui(), stack_dir.back(), chem, what_to_check, get_fsa_scope());
 		    }
@@ -239,6 +275,15 @@ namespace libdar
 
 	    cat_nomme *exists = nullptr;
 
+	    if(x_mir != nullptr && dir_journal && dir_journal->recording())
+	    {
+		    // other links to this inode may have to be restored by the second pass
+		    // which is thus the one to restore them all
+		dir_journal->defer(relative_to_root(spot));
+		hard_link = false;
+		return;
+	    }
+
 	    if(ignore_over_restricts)
 		    // only used in sequential_read when a file has been saved several times due
 		    // to its contents being modified at backup time while dar was reading it.
@@ -246,6 +291,7 @@ namespace libdar
 		    // that file because a better copy has been found in the archive.
 	    {
 		ignore_over_restricts = false; // just one shot state ; exists == nullptr : we are ignoring existing entry
+		wait_writers(stack_dir.size()); // the previous copy may not be completed yet
 		filesystem_tools_supprime(get_ui(), spot_display);
 		if(x_det != nullptr)
 		{
@@ -285,7 +331,33 @@ namespace libdar
 		if(exists_ino == nullptr && exists != nullptr)
 		    throw SRC_BUG; // an object from filesystem should always be an cat_inode !?!
 
-		if(exists == nullptr)
+		bool created_as_path = false; // directory created by the first pass, see restore_dir_journal.hpp
+
+		if(x_dir != nullptr
+		   && exists_dir != nullptr
+		   && dir_journal
+		   && !dir_journal->recording()
+		   && dir_journal->take_created(spot_display))
+		{
+			// restoring the directory as if it had not been created by the first pass
+		    delete exists;
+		    exists = nullptr;
+		    exists_ino = nullptr;
+		    exists_dir = nullptr;
+		    created_as_path = true;
+		}
+
+		if(x_dir != nullptr
+		   && dir_journal
+		   && dir_journal->recording()
+		   && (exists == nullptr || exists_dir != nullptr))
+		{
+			// the directory is only used as path to the files restored
+			// under it, the second pass will restore it
+		    if(exists == nullptr && !empty && make_dir_as_path(spot_display))
+			dir_journal->created(spot_display);
+		}
+		else if(exists == nullptr)
 		{
 			// no conflict: there is not an already existing file present in filesystem
 
@@ -297,9 +369,22 @@ namespace libdar
 			if(info_details)
 			    get_ui().message(string(gettext("Restoring file's data: ")) + spot_display);
 
+#ifdef LIBTHREADAR_AVAILABLE
+			if(writers && x_dir == nullptr)
+			{
+				// steps 1 to 7 below are completed by the writer threads
+			    write_async(x_nom, x_ino, spot_display, has_ea_saved, has_fsa_saved, ea_restored, fsa_restored);
+			    data_created = true;
+			    data_restored = done_data_restored;
+			    if(!stack_dir.empty())
+				stack_dir.back().set_restore_date(true);
+			    return; // exists is nullptr here, nothing to release
+			}
+#endif
+
 			    // 1 - restoring data
 
-			if(!empty)
+			if(!empty && !created_as_path)
 			    make_file(x_nom, *current_dir);
 			data_created = true;
 			data_restored = done_data_restored;
@@ -641,6 +726,178 @@ namespace libdar
     }
 
 
+    string filesystem_restore::relative_to_root(const path & spot) const
+    {
+	path ret = spot;
+	string tmp;
+
+	for(U_I i = fs_root->degre(); i > 0; --i)
+	    if(!ret.pop_front(tmp))
+		throw SRC_BUG;
+
+	return ret.display();
+    }
+
+    bool filesystem_restore::make_dir_as_path(const string & spot)
+    {
+	struct stat buf;
+	S_I err;
+
+	if(mkdir(spot.c_str(), 0700) == 0)
+	    return true;
+
+	err = errno;
+	if(err == EEXIST && stat(spot.c_str(), &buf) == 0 && S_ISDIR(buf.st_mode))
+	    return false; // created meanwhile by another thread
+
+	throw Erange(string(gettext("Could not create inode: ")) + spot + " : " + tools_strerror_r(err));
+    }
+
+    void filesystem_restore::wait_writers(U_I depth)
+    {
+#ifdef LIBTHREADAR_AVAILABLE
+	if(writers)
+	{
+	    writers->wait_depth(depth);
+	    flush_writers_messages();
+	}
+#endif
+    }
+
+    void filesystem_restore::flush_writers_messages()
+    {
+#ifdef LIBTHREADAR_AVAILABLE
+	if(writers)
+	    writers->relay();
+#endif
+    }
+
+    void filesystem_restore::reap_writer_failure(bool wait_completion)
+    {
+#ifdef LIBTHREADAR_AVAILABLE
+	if(writers)
+	{
+	    string spot, msg;
+	    bool aborted;
+
+	    if(wait_completion)
+		wait_writers(0);
+	    else
+		flush_writers_messages();
+
+	    if(writers->pop_failure(spot, msg, aborted))
+	    {
+		if(aborted)
+		    throw Euser_abort(spot);
+		else
+		    throw Erange(spot + " : " + msg);
+	    }
+	}
+#endif
+    }
+
+#ifdef LIBTHREADAR_AVAILABLE
+    void filesystem_restore::write_async(const cat_nomme *x_nom,
+					 const cat_inode *x_ino,
+					 const string & spot,
+					 bool has_ea_saved,
+					 bool has_fsa_saved,
+					 bool & ea_restored,
+					 bool & fsa_restored)
+    {
+	const cat_mirage *x_mir = dynamic_cast<const cat_mirage *>(x_nom);
+	const cat_file *x_fil = dynamic_cast<const cat_file *>(x_ino);
+	unique_ptr<restore_task> task = make_unique<restore_task>();
+	cat_entree *clone = nullptr;
+
+	if(x_ino == nullptr || !writers)
+	    throw SRC_BUG;
+
+	task->spot = spot;
+	task->set_ea = false;
+	task->set_ea_again = x_mir == nullptr; // EA of a hard linked inode are only restored once
+	task->set_fsa = false;
+	task->depth = stack_dir.size();
+
+	    // 1 - restoring data, the archive can only be read from the current thread
+
+	if(x_mir == nullptr
+	   && x_fil != nullptr
+	   && x_fil->get_saved_status() == saved_status::saved
+	   && !x_fil->get_sparse_file_detection_read()
+	   && x_fil->get_size() <= infinint(restore_writer_pool::max_buffered_data))
+	{
+		// small plain file, a writer will create it from memory
+	    task->data = make_unique<memory_file>();
+	    copy_data_to(*x_fil, *(task->data));
+	}
+	else
+	    make_file(x_nom, *current_dir);
+
+	    // 2 - reading EA, they follow the data in the archive
+
+	if(has_ea_saved)
+	{
+	    if(info_details)
+		get_ui().message(string(gettext("Restoring file's EA: ")) + spot);
+
+	    try
+	    {
+		(void)x_ino->get_ea();
+		task->set_ea = mark_ea_restored(x_nom, spot);
+	    }
+	    catch(Erange & e)
+	    {
+		get_ui().message(tools_printf(gettext("Restoration of EA for %S aborted: "), &spot) + e.get_message());
+	    }
+	}
+
+	    // 3 - reading FSA, they follow the EA in the archive
+
+	if(has_fsa_saved)
+	{
+	    if(info_details)
+		get_ui().message(string(gettext("Restoring file's FSA: ")) + spot);
+
+	    try
+	    {
+		const filesystem_specific_attribute_list * fsa = x_ino->get_fsa();
+		if(fsa == nullptr)
+		    throw SRC_BUG;
+		task->set_fsa = true;
+		if(info_details && fsa->has_linux_immutable_set())
+		    get_ui().message(string(gettext("Restoring linux immutable FSA for ")) + spot);
+	    }
+	    catch(Erange & e)
+	    {
+		get_ui().message(tools_printf(gettext("Restoration of FSA for %S aborted: "), &spot) + e.get_message());
+	    }
+	}
+
+	    // the writer gets its own copy of the inode with EA and FSA loaded in memory,
+	    // so it never has to access the archive
+
+	clone = x_ino->clone();
+	if(clone == nullptr)
+	    throw Ememory();
+	task->ino.reset(dynamic_cast<cat_inode *>(clone));
+	if(!task->ino)
+	{
+	    delete clone;
+	    throw SRC_BUG;
+	}
+	if(has_fsa_saved && !task->set_fsa)
+	    task->ino->fsa_set_saved_status(fsa_saved_status::none);
+
+	ea_restored = task->set_ea;
+	fsa_restored = task->set_fsa;
+
+	    // 4 to 7 - dates, ownership, permission and immutable flag are set by the writer
+
+	writers->submit(std::move(task));
+    }
+#endif
+
     void filesystem_restore::action_over_remove(const cat_inode *in_place, const cat_detruit *to_be_added, const string & spot, over_action_data action)
     {
 	if(in_place == nullptr || to_be_added == nullptr)
@@ -1198,6 +1455,8 @@ namespace libdar
     {
 	string tmp;
 
+	wait_writers(0);
+
 	while(!stack_dir.empty() && current_dir->pop(tmp))
 	{
 	    string chem = (current_dir->append(stack_dir.back().get_name())).display();
@@ -45,8 +45,14 @@ extern "C"
 #include "cat_all_entrees.hpp"
 #include "filesystem_hard_link_read.hpp"
 #include "filesystem_hard_link_write.hpp"
+#include "restore_dir_journal.hpp"
+
+#ifdef LIBTHREADAR_AVAILABLE
+#include "filesystem_restore_async.hpp"
+#endif
 
 #include <set>
+#include <memory>
 
 namespace libdar
 {
@@ -59,6 +65,12 @@ namespace libdar
     {
     public:
 	    /// constructor
+
+	    /// \param[in] x_writers if greater than 1 and libthreadar is available, the number of threads
+	    /// used to complete the restoration of newly created inodes (small file data, EA, FSA, dates,
+	    /// ownership and permissions), the other arguments follow archive_options_extract
+	    /// \param[in] x_dir_journal if set, records or replays what is done to directories
+	    /// (see restore_dir_journal.hpp), may be empty
         filesystem_restore(const std::shared_ptr<user_interaction> & dialog,
 			   const path & root,
 			   bool x_warn_overwrite,
@@ -69,7 +81,9 @@ namespace libdar
 			   bool empty,
 			   const crit_action *x_overwrite,
 			   bool x_only_overwrite,
-			   const fsa_scope & scope);
+			   const fsa_scope & scope,
+			   U_I x_writers = 1,
+			   const std::shared_ptr<restore_dir_journal> & x_dir_journal = std::shared_ptr<restore_dir_journal>());
 
 	    /// copy constructor is forbidden
         filesystem_restore(const filesystem_restore & ref) = delete;
@@ -122,6 +136,14 @@ namespace libdar
 	    /// actions to take about overwriting... anoying for the user
 	void ignore_overwrite_restrictions_for_next_write() { ignore_over_restricts = true; };
 
+	    /// report the oldest inode the writer threads failed to complete the restoration of
+
+	    /// \param[in] wait_completion whether to first wait for all inodes handed to the writers to be completed
+	    /// \note this throws Erange, or Euser_abort if the failure comes from a negative answer of the user,
+	    /// and simply returns if no failure is pending. The inode concerned by a failure has already been
+	    /// reported as restored by write() when it was handed to the writers.
+	void reap_writer_failure(bool wait_completion);
+
 
     private:
 	class stack_dir_t : public cat_directory
@@ -148,14 +170,43 @@ namespace libdar
 	bool ignore_over_restricts;
 	const crit_action *overwrite;
 	bool only_overwrite;
+	std::shared_ptr<restore_dir_journal> dir_journal; ///< set when several archives are restored concurrently
+#ifdef LIBTHREADAR_AVAILABLE
+	std::unique_ptr<restore_writer_pool> writers; ///< completes the restoration of new inodes, if set
+#endif
 
         void detruire();
 	void restore_stack_dir_ownership();
 	user_interaction & get_ui() const { return filesystem_hard_link_read::get_ui(); };
 	std::shared_ptr<user_interaction> get_pointer() const { return filesystem_hard_link_read::get_pointer(); };
 
+	    /// wait for the inodes of the given directory depth and below to be completed by the writers
+	void wait_writers(U_I depth);
+
+	    /// display the messages recorded by the writers and ask their pending question
+	void flush_writers_messages();
+
+	    /// create a directory only used as path to the files restored under it
+
+	    /// \return false if the directory has been created meanwhile by another thread
+	bool make_dir_as_path(const std::string & spot);
+
+	    /// path of the entry relative to the root of the restoration, as the journal records it
+	std::string relative_to_root(const path & spot) const;
+
 	    // subroutines of write()
 
+#ifdef LIBTHREADAR_AVAILABLE
+	    /// create a new inode from the caller thread and let the writers complete its restoration
+	void write_async(const cat_nomme *x_nom,
+			 const cat_inode *x_ino,
+			 const std::string & spot,
+			 bool has_ea_saved,
+			 bool has_fsa_saved,
+			 bool & ea_restored,
+			 bool & fsa_restored);
+#endif
+
 	    /// perform action due to the overwriting policy when the "to be added" entry is a detruit object
 	void action_over_remove(const cat_inode *in_place,
 				const cat_detruit *to_be_added,
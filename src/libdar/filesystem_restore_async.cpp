@@ -0,0 +1,487 @@
+/*********************************************************************/
+// dar - disk archive - a backup/restoration program
+// Copyright (C) 2002-2026 Denis Corbin
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// to contact the author, see the AUTHOR file
+/*********************************************************************/
+
+#include "../my_config.h"
+
+extern "C"
+{
+}
+
+#include "filesystem_restore_async.hpp"
+#include "erreurs.hpp"
+#include "tools.hpp"
+#include "filesystem_tools.hpp"
+#include "ea_filesystem.hpp"
+#include "fichier_local.hpp"
+
+using namespace std;
+using namespace libthreadar;
+
+namespace libdar
+{
+
+	/////////////////////////////////////////////////////
+        //
+        // restore_writer_pool class implementation
+        //
+        //
+
+    restore_writer_pool::restore_writer_pool(const shared_ptr<user_interaction> & dialog,
+					     U_I num_workers,
+					     const mask & x_ea_mask,
+					     comparison_fields x_what_to_check,
+					     const fsa_scope & x_scope):
+	caller_ui(dialog),
+	what_to_check(x_what_to_check),
+	scope(x_scope),
+	max_pending(num_workers * 4),
+	cond(3),
+	stop(false),
+	asking(false),
+	answered(false),
+	answer(false)
+    {
+	if(num_workers == 0)
+	    throw SRC_BUG;
+	if(!caller_ui)
+	    throw SRC_BUG;
+
+	ea_mask.reset(x_ea_mask.clone());
+	if(!ea_mask)
+	    throw Ememory();
+
+	for(U_I i = 0; i < num_workers; ++i)
+	{
+	    workers.push_back(make_unique<restore_writer_worker>(*this));
+	    workers.back()->run();
+	}
+    }
+
+    restore_writer_pool::~restore_writer_pool()
+    {
+	cond.lock();
+	stop = true;
+	cond.broadcast(cond_worker);
+	cond.broadcast(cond_answer);
+	cond.unlock();
+
+	for(deque<unique_ptr<restore_writer_worker> >::iterator it = workers.begin();
+	    it != workers.end();
+	    ++it)
+	{
+	    try
+	    {
+		if(*it)
+		    (*it)->join();
+	    }
+	    catch(...)
+	    {
+		    // ignore all exceptions
+	    }
+	}
+    }
+
+    void restore_writer_pool::submit(unique_ptr<restore_task> && task)
+    {
+	if(!task || !task->ino)
+	    throw SRC_BUG;
+
+	cond.lock();
+	try
+	{
+	    while(pending.size() >= max_pending)
+	    {
+		if(asking && !answered)
+		    relay_locked();
+		else
+		    cond.wait(cond_caller);
+	    }
+	    if(in_flight.size() <= task->depth)
+		in_flight.resize(task->depth + 1, 0);
+	    ++in_flight[task->depth];
+	    pending.push_back(std::move(task));
+	    cond.signal(cond_worker);
+	}
+	catch(...)
+	{
+	    cond.unlock();
+	    throw;
+	}
+	cond.unlock();
+    }
+
+    void restore_writer_pool::wait_depth(U_I depth)
+    {
+	cond.lock();
+	try
+	{
+	    U_I d = depth;
+
+	    while(d < in_flight.size())
+	    {
+		if(asking && !answered)
+		    relay_locked();
+		else if(in_flight[d] > 0)
+		    cond.wait(cond_caller);
+		else
+		    ++d;
+	    }
+	}
+	catch(...)
+	{
+	    cond.unlock();
+	    throw;
+	}
+	cond.unlock();
+    }
+
+    void restore_writer_pool::relay()
+    {
+	cond.lock();
+	try
+	{
+	    relay_locked();
+	}
+	catch(...)
+	{
+	    cond.unlock();
+	    throw;
+	}
+	cond.unlock();
+    }
+
+    bool restore_writer_pool::pop_failure(string & spot, string & message, bool & aborted)
+    {
+	bool ret = false;
+
+	cond.lock();
+	if(!failures.empty())
+	{
+	    spot = failures.front().spot;
+	    message = failures.front().message;
+	    aborted = failures.front().aborted;
+	    failures.pop_front();
+	    ret = true;
+	}
+	cond.unlock();
+
+	return ret;
+    }
+
+    unique_ptr<restore_task> restore_writer_pool::next_task()
+    {
+	unique_ptr<restore_task> ret;
+
+	cond.lock();
+	try
+	{
+	    while(pending.empty() && !stop)
+		cond.wait(cond_worker);
+
+	    if(!pending.empty())
+	    {
+		ret = std::move(pending.front());
+		pending.pop_front();
+		cond.broadcast(cond_caller); // a slot is free for submit()
+	    }
+	}
+	catch(...)
+	{
+	    cond.unlock();
+	    throw;
+	}
+	cond.unlock();
+
+	return ret;
+    }
+
+    void restore_writer_pool::task_done(U_I depth)
+    {
+	cond.lock();
+	if(depth >= in_flight.size() || in_flight[depth] == 0)
+	{
+	    cond.unlock();
+	    throw SRC_BUG;
+	}
+	--in_flight[depth];
+	cond.broadcast(cond_caller);
+	cond.unlock();
+    }
+
+    void restore_writer_pool::record_message(const string & message)
+    {
+	cond.lock();
+	messages.push_back(message);
+	cond.unlock();
+    }
+
+    void restore_writer_pool::record_failure(const string & spot, const string & message, bool aborted)
+    {
+	cond.lock();
+	failures.push_back(failure{ spot, message, aborted });
+	cond.unlock();
+    }
+
+    bool restore_writer_pool::ask(const string & message)
+    {
+	bool ret = false;
+
+	cond.lock();
+	try
+	{
+		// waiting for the question of another worker to be answered
+	    while(asking && !stop)
+		cond.wait(cond_answer);
+
+	    if(!stop)
+	    {
+		asking = true;
+		answered = false;
+		question = message;
+		cond.broadcast(cond_caller);
+
+		while(!answered && !stop)
+		    cond.wait(cond_answer);
+
+		ret = answered && answer;
+		asking = false;
+		answered = false;
+		cond.broadcast(cond_answer);
+	    }
+		// else the caller thread does not relay questions anymore
+	}
+	catch(...)
+	{
+	    cond.unlock();
+	    throw;
+	}
+	cond.unlock();
+
+	return ret;
+    }
+
+    void restore_writer_pool::relay_locked()
+    {
+	    // cond is released while interacting with the user, for
+	    // the workers to be able to go on recording messages
+
+	while(!messages.empty() || (asking && !answered))
+	{
+	    if(!messages.empty())
+	    {
+		string msg = messages.front();
+
+		messages.pop_front();
+		cond.unlock();
+		try
+		{
+		    caller_ui->message(msg);
+		}
+		catch(...)
+		{
+		    cond.lock();
+		    throw;
+		}
+		cond.lock();
+	    }
+	    else
+	    {
+		string msg = question;
+		bool ret = false;
+
+		cond.unlock();
+		try
+		{
+		    caller_ui->pause(msg);
+		    ret = true;
+		}
+		catch(Euser_abort & e)
+		{
+			// negative answer
+		}
+		catch(...)
+		{
+		    cond.lock();
+		    answer = false;
+		    answered = true;
+		    cond.broadcast(cond_answer);
+		    throw;
+		}
+		cond.lock();
+		answer = ret;
+		answered = true;
+		cond.broadcast(cond_answer);
+	    }
+	}
+    }
+
+    void restore_writer_pool::execute(restore_task & task, const shared_ptr<user_interaction> & ui) const
+    {
+	const string & spot = task.spot;
+
+	    // 1 - creating the plain file from the data read by the caller thread
+
+	if(task.data)
+	{
+	    fichier_local dest = fichier_local(ui, spot, gf_write_only, 0700, false, true, false);
+
+	    task.data->skip(0);
+	    task.data->copy_to(dest);
+	    task.data.reset(); // releasing memory as soon as possible
+	    try
+	    {
+		dest.fadvise(fichier_global::advise_dontneed);
+	    }
+	    catch(Erange & e)
+	    {
+		// silently ignoring any fadvise error
+	    }
+	}
+
+	    // 2 - restoring EA
+
+	if(task.set_ea)
+	{
+	    try
+	    {
+		(void)ea_filesystem_write_ea(spot, *(task.ino->get_ea()), *ea_mask);
+	    }
+	    catch(Erange & e)
+	    {
+		ui->message(tools_printf(gettext("Restoration of EA for %S aborted: "), &spot) + e.get_message());
+	    }
+	}
+
+	    // 3 - restoring FSA, except the linux immutable flag
+
+	if(task.set_fsa)
+	{
+	    try
+	    {
+		(void)task.ino->get_fsa()->set_fsa_to_filesystem_for(spot, scope, *ui, false);
+	    }
+	    catch(Erange & e)
+	    {
+		ui->message(tools_printf(gettext("Restoration of FSA for %S aborted: "), &spot) + e.get_message());
+	    }
+	}
+
+	    // 4 - restoring dates
+
+	filesystem_tools_make_date(*(task.ino), spot, what_to_check, scope);
+
+	    // 5 - restoring permission and ownership
+
+	filesystem_tools_make_owner_perm(*ui, *(task.ino), spot, what_to_check, scope);
+
+	    // 6 - re-setting EA after ownership restoration to set back linux capabilities
+
+	if(task.set_ea && task.set_ea_again)
+	{
+	    try
+	    {
+		(void)ea_filesystem_write_ea(spot, *(task.ino->get_ea()), *ea_mask);
+	    }
+	    catch(Erange & e)
+	    {
+		// error probably due to permission context,
+		// EA have already been set at step 2
+	    }
+	}
+
+	    // 7 - setting the linux immutable flag if present
+
+	if(task.set_fsa)
+	{
+	    try
+	    {
+		(void)task.ino->get_fsa()->set_fsa_to_filesystem_for(spot, scope, *ui, true);
+	    }
+	    catch(Erange & e)
+	    {
+		ui->message(tools_printf(gettext("Restoration of linux immutable FSA for %S aborted: "), &spot) + e.get_message());
+	    }
+	}
+    }
+
+
+	/////////////////////////////////////////////////////
+        //
+        // restore_writer_ui class implementation
+        //
+        //
+
+    string restore_writer_ui::inherited_get_string(const string & message, bool echo)
+    {
+	throw Euser_abort(message);
+    }
+
+    secu_string restore_writer_ui::inherited_get_secu_string(const string & message, bool echo)
+    {
+	throw Euser_abort(message);
+    }
+
+
+	/////////////////////////////////////////////////////
+        //
+        // restore_writer_worker class implementation
+        //
+        //
+
+    restore_writer_worker::restore_writer_worker(restore_writer_pool & owner):
+	pool(owner)
+    {
+	ui.reset(new (nothrow) restore_writer_ui(owner));
+	if(!ui)
+	    throw Ememory();
+    }
+
+    void restore_writer_worker::inherited_run()
+    {
+	unique_ptr<restore_task> task;
+
+	while((task = pool.next_task()))
+	{
+	    U_I depth = task->depth;
+
+	    try
+	    {
+		pool.execute(*task, ui);
+	    }
+	    catch(Euser_abort & e)
+	    {
+		pool.record_failure(task->spot, e.get_message(), true);
+	    }
+	    catch(Egeneric & e)
+	    {
+		pool.record_failure(task->spot, e.get_message(), false);
+	    }
+	    catch(...)
+	    {
+		pool.record_failure(task->spot, gettext("Unexpected exception caught"), false);
+	    }
+
+	    task.reset();
+	    pool.task_done(depth);
+	}
+    }
+
+} // end of namespace
@@ -0,0 +1,210 @@
+/*********************************************************************/
+// dar - disk archive - a backup/restoration program
+// Copyright (C) 2002-2026 Denis Corbin
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// to contact the author, see the AUTHOR file
+/*********************************************************************/
+
+    /// \file filesystem_restore_async.hpp
+    /// \brief worker threads used by filesystem_restore to write inodes to filesystem
+    /// \ingroup Private
+    ///
+    /// filesystem_restore reads the archive (data, EA, FSA) from the caller thread, which
+    /// is the only one allowed to access the archive layers and to interact with the user.
+    /// What remains to be done for a newly created inode, that is to say creating small
+    /// plain files from their already read data, and setting EA, FSA, dates, ownership and
+    /// permissions, only involves system calls on the restored file and is handed to
+    /// a restore_writer_pool. Tasks are tagged with the depth of the directory they
+    /// reside in, which lets the caller wait for all the entries of a directory to be
+    /// completed before setting the directory's own metadata.
+    ///
+    /// Messages, questions and failures of the writers are relayed to the caller thread,
+    /// questions being asked to the user from there while the worker waits for the answer.
+
+#ifndef FILESYSTEM_RESTORE_ASYNC_HPP
+#define FILESYSTEM_RESTORE_ASYNC_HPP
+
+#include "../my_config.h"
+
+#include <string>
+#include <deque>
+#include <vector>
+#include <memory>
+#include "integers.hpp"
+#include "user_interaction.hpp"
+#include "cat_inode.hpp"
+#include "memory_file.hpp"
+#include "mask.hpp"
+#include "fsa_family.hpp"
+
+#include <libthreadar/libthreadar.hpp>
+
+namespace libdar
+{
+
+	/// \addtogroup Private
+	/// @{
+
+	/// what remains to be done on filesystem for a restored inode
+
+    struct restore_task
+    {
+	std::string spot;                   ///< full path of the inode on filesystem
+	std::unique_ptr<cat_inode> ino;     ///< metadata to restore, EA and FSA if any must be loaded in memory
+	std::unique_ptr<memory_file> data;  ///< if not null, the plain file has to be created with this content
+	bool set_ea;                        ///< whether EA of ino have to be restored
+	bool set_ea_again;                  ///< whether EA have to be set again once ownership restored (linux capabilities)
+	bool set_fsa;                       ///< whether FSA of ino have to be restored
+	U_I depth;                          ///< depth of the directory the inode resides in
+    };
+
+    class restore_writer_worker;
+
+	/// pool of threads completing the restoration of inodes
+
+    class restore_writer_pool
+    {
+    public:
+	    /// constructor
+
+	    /// \param[in] dialog user interaction of the caller thread, questions of the workers are relayed to it
+	    /// \param[in] num_workers number of threads to launch
+	    /// \param[in] x_ea_mask EA to consider when restoring EA
+	    /// \param[in] x_what_to_check which inode fields to restore
+	    /// \param[in] x_scope FSA families to consider
+	restore_writer_pool(const std::shared_ptr<user_interaction> & dialog,
+			    U_I num_workers,
+			    const mask & x_ea_mask,
+			    comparison_fields x_what_to_check,
+			    const fsa_scope & x_scope);
+	restore_writer_pool(const restore_writer_pool & ref) = delete;
+	restore_writer_pool(restore_writer_pool && ref) noexcept = delete;
+	restore_writer_pool & operator = (const restore_writer_pool & ref) = delete;
+	restore_writer_pool & operator = (restore_writer_pool && ref) noexcept = delete;
+
+	    /// destructor completes the submitted tasks and stops the threads
+
+	    /// \note questions asked by the workers from now on are answered negatively
+	~restore_writer_pool();
+
+	    /// hand a task to the worker threads, blocks while too many tasks are pending
+	void submit(std::unique_ptr<restore_task> && task);
+
+	    /// wait for the tasks of the given depth and of all greater depths to be completed
+	void wait_depth(U_I depth);
+
+	    /// wait for all submitted tasks to be completed
+	void wait_all() { wait_depth(0); };
+
+	    /// display the messages recorded by the worker threads and ask the pending question if any
+	void relay();
+
+	    /// fetch and remove the oldest task the worker threads failed to complete
+
+	    /// \param[out] spot path of the inode which restoration failed
+	    /// \param[out] message reason of the failure
+	    /// \param[out] aborted whether the failure comes from a negative answer of the user
+	    /// \return false if no failure is pending, in which case the arguments are not modified
+	bool pop_failure(std::string & spot, std::string & message, bool & aborted);
+
+	    /// size above which plain file data is not kept in memory for a worker to write it
+	static constexpr U_I max_buffered_data = 1048576;
+
+    private:
+	static constexpr unsigned int cond_worker = 0; ///< condition instance workers wait on for a new task
+	static constexpr unsigned int cond_caller = 1; ///< condition instance the caller waits on for a task completion or a question
+	static constexpr unsigned int cond_answer = 2; ///< condition instance workers wait on for the answer to a question
+
+	    /// a task a worker failed to complete
+	struct failure
+	{
+	    std::string spot;
+	    std::string message;
+	    bool aborted;
+	};
+
+	std::shared_ptr<user_interaction> caller_ui;
+	std::unique_ptr<mask> ea_mask;
+	comparison_fields what_to_check;
+	fsa_scope scope;
+
+	U_I max_pending;                                    ///< max number of tasks not yet started
+	libthreadar::condition cond;                        ///< protects the following fields
+	std::deque<std::unique_ptr<restore_task> > pending; ///< tasks not yet started
+	std::vector<U_I> in_flight;                         ///< number of tasks pending or running per depth
+	bool stop;                                          ///< whether workers have to end once no more task is pending
+	std::deque<std::string> messages;                   ///< messages recorded by the workers
+	std::deque<failure> failures;                       ///< tasks the workers failed to complete
+	bool asking;                                        ///< whether a worker is waiting for the answer to a question
+	bool answered;                                      ///< whether the pending question has been answered
+	bool answer;                                        ///< answer to the pending question
+	std::string question;                               ///< the pending question
+	std::deque<std::unique_ptr<restore_writer_worker> > workers; ///< the threads
+
+	std::unique_ptr<restore_task> next_task();  ///< called by workers, nullptr means the worker has to end
+	void task_done(U_I depth);
+	void record_message(const std::string & message);
+	void record_failure(const std::string & spot, const std::string & message, bool aborted);
+	bool ask(const std::string & message);      ///< called by workers, blocks until the caller thread got the answer from the user
+	void relay_locked();                        ///< same as relay() with cond already locked by the caller thread
+	void execute(restore_task & task, const std::shared_ptr<user_interaction> & ui) const;
+
+	friend class restore_writer_worker;
+	friend class restore_writer_ui;
+    };
+
+
+	/// user_interaction given to system calls run from a restore_writer_worker
+
+	/// messages are recorded in the pool for the caller thread to display them,
+	/// questions are asked from the caller thread too, strings are never asked
+    class restore_writer_ui: public user_interaction
+    {
+    public:
+	restore_writer_ui(restore_writer_pool & owner): pool(owner) {};
+
+    protected:
+	virtual void inherited_message(const std::string & message) override { pool.record_message(message); };
+	virtual bool inherited_pause(const std::string & message) override { return pool.ask(message); };
+	virtual std::string inherited_get_string(const std::string & message, bool echo) override;
+	virtual secu_string inherited_get_secu_string(const std::string & message, bool echo) override;
+
+    private:
+	restore_writer_pool & pool;
+    };
+
+
+	/// thread of a restore_writer_pool
+
+    class restore_writer_worker: public libthreadar::thread
+    {
+    public:
+	restore_writer_worker(restore_writer_pool & owner);
+
+    protected:
+	virtual void inherited_run() override;
+
+    private:
+	restore_writer_pool & pool;
+	std::shared_ptr<user_interaction> ui;
+    };
+
+	/// @}
+
+} // end of namespace
+
+#endif
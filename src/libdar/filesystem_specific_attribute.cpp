@@ -1276,7 +1276,7 @@ namespace libdar
 
     string fsa_infinint::show_val() const
     {
-	return deci(val).human();
+	return deci::to_string(val);
     }
 
     bool fsa_infinint::equal_value_to(const filesystem_specific_attribute & ref) const
@@ -156,7 +156,7 @@ namespace libdar
 
         if(S_ISDIR(buf.st_mode))
         {
-            etage fils = etage(ui, s, datetime(0), datetime(0), false, false); // we don't care the access and modification time because directory will be destroyed
+            etage fils = etage(ui, s, datetime(0), datetime(0), false, false, false); // we don't care the access and modification time because directory will be destroyed
             string tmp;
 	    inode_type tp;
 
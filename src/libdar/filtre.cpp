@@ -50,6 +50,8 @@ extern "C"
 #include "op_tools.hpp"
 #include "fichier_global.hpp"
 #include "capabilities.hpp"
+#include "hard_link_table.hpp"
+#include "catalogue_stream.hpp"
 
 using namespace std;
 
@@ -85,7 +87,8 @@ namespace libdar
 			   bool repair_mode,         ///< if set, try to fix CRC and size problem flagging such fixed files as dirty
 			   U_I signature_block_size, ///< block size of delta signatures
 			   rsync_sig_magic def_sig_magic, ///< hash to use to build binary delta signatures
-			   bool never_resave_uncompressed);
+			   bool never_resave_uncompressed,
+			   bool overlapped_read);    ///< whether file data may be read from a separated thread (it does not share any object with the written archive)
 
     static bool save_ea(const shared_ptr<user_interaction> & dialog,
 			const string & info_quoi,
@@ -96,6 +99,18 @@ namespace libdar
 
     static void restore_atime(const string & chemin, const cat_inode * & ptr);
 
+	// account as failed the inodes the writer threads of fs could not complete
+    static void restore_reap_writers(user_interaction & dialog, filesystem_restore & fs, statistics & st, bool wait_completion);
+
+	// whether the data of source can be copied with generic_file::copy_to_overlapped()
+    static bool overlapped_copy_possible(const generic_file *source);
+
+	/// start comparison with the reference, either the catalogue or the streamed catalogue when not nullptr
+    static void ref_reset_compare(const catalogue & ref, catalogue_stream *ref_stream, catalogue & cat);
+
+	/// compare target with the reference, either the catalogue or the streamed catalogue when not nullptr
+    static bool ref_compare(const catalogue & ref, catalogue_stream *ref_stream, const cat_entree *target, const cat_entree * & extracted);
+
     static bool save_fsa(const shared_ptr<user_interaction> & dialog,
 			 const string & info_quoi,
 			 cat_inode * & ino,
@@ -118,7 +133,7 @@ namespace libdar
 	/// \param[in] etiquette_offset is the offset to apply to etiquette (to not mix several hard-link sets using the same etiquette number in different archives)
 	/// \return a pointer to the new allocated clone object (to be deleted by the delete operator by the caller)
     static cat_entree *make_clone(const cat_nomme *ref,
-				  map<infinint, cat_etoile*> & hard_link_base,
+				  hard_link_table<U_64, cat_etoile *> & hard_link_base,
 				  const infinint & etiquette_offset);
 
 	/// remove an entry hardlink from a given hard_link database
@@ -128,11 +143,11 @@ namespace libdar
 	/// \note if the cat_mirage object is the last one pointing to a given "cat_etoile" object
 	/// deleting this cat_mirage will delete the "cat_etoile" object automatically (see destructor implementation of these classes).
 	/// However, one need to remove from the database the reference to this "cat_etoile *" that is about to me removed by the caller
-    static void clean_hard_link_base_from(const cat_mirage *mir, map<infinint, cat_etoile *> & hard_link_base);
+    static void clean_hard_link_base_from(const cat_mirage *mir, hard_link_table<U_64, cat_etoile *> & hard_link_base);
 
 
 	/// modify the hard_link_base to avoid hole in the numbering of etiquettes (map size == highest etiquette number)
-    static void normalize_link_base(map<infinint, cat_etoile *> & hard_link_base);
+    static void normalize_link_base(hard_link_table<U_64, cat_etoile *> & hard_link_base);
 
 	/// transfer EA from one cat_inode to another as defined by the given action
 
@@ -198,7 +213,9 @@ namespace libdar
 			bool only_deleted,
 			bool not_deleted,
 			const fsa_scope & scope,
-			bool ignore_unix_sockets)
+			bool ignore_unix_sockets,
+			U_I restore_writers,
+			const shared_ptr<restore_dir_journal> & dir_journal)
     {
 	defile juillet = fs_racine; // 'juillet' is in reference to 14th of July ;-) when takes place the "defile'" on the Champs-Elysees.
 	const cat_eod tmp_eod;
@@ -230,7 +247,9 @@ namespace libdar
 				  empty,
 				  &overwrite,
 				  only_deleted,
-				  scope);
+				  scope,
+				  restore_writers,
+				  dir_journal);
 		// if only_deleted, we set the filesystem to only overwrite mode (no creatation if not existing)
 		// we also filter to only restore directories and detruit objects.
 
@@ -508,6 +527,8 @@ namespace libdar
 				st.incr_errored();
 		    }
 
+		    restore_reap_writers(*dialog, fs, st, false);
+
 			// avoiding keeping in memory the delta signature
 			// is is loaded in any case when in sequential read mode
 			// it may be loaded when needed in direct access mode
@@ -531,6 +552,8 @@ namespace libdar
 		    }
 		}
 	    }
+
+	    restore_reap_writers(*dialog, fs, st, true);
 	}
 	catch(...)
 	{
@@ -587,7 +610,8 @@ namespace libdar
 			   const delta_sig_block_size & delta_sig_block_len,
 			   rsync_sig_magic sig_magic,
 			   bool never_resave_uncompressed,
-			   bool ref_read_in_seq_mode)
+			   bool ref_read_in_seq_mode,
+			   catalogue_stream *ref_stream)
     {
 	if(!dialog)
 	    throw SRC_BUG; // dialog points to nothing
@@ -632,7 +656,7 @@ namespace libdar
 
         st.clear();
         cat.reset_add();
-        ref.reset_compare();
+        ref_reset_compare(ref, ref_stream, cat);
 	fs.set_ignored_symlinks_list(ignored_symlinks);
 
 	try
@@ -713,7 +737,7 @@ namespace libdar
 
 				    if(fixed_date.is_zero())
 				    {
-					bool conflict = ref.compare(e, f);
+					bool conflict = ref_compare(ref, ref_stream, e, f);
 
 					if(!conflict)
 					{
@@ -963,7 +987,8 @@ namespace libdar
 						       false,
 						       sig_bl,
 						       sig_magic,
-						       never_resave_uncompressed))
+						       never_resave_uncompressed,
+						       false))   // overlapped_read
 					    st.incr_tooold(); // counting a new dirty file in archive
 
 					st.set_byte_amount(wasted_bytes);
@@ -1006,7 +1031,7 @@ namespace libdar
 				    catch(...)
 				    {
 					if(dir != nullptr && fixed_date.is_zero())
-					    ref.compare(&tmp_eod, f);
+					    ref_compare(ref, ref_stream, &tmp_eod, f);
 					throw;
 				    }
 				}
@@ -1045,7 +1070,7 @@ namespace libdar
 					bool known;
 
 					if(fixed_date.is_zero())
-					    known = ref.compare(dir, f);
+					    known = ref_compare(ref, ref_stream, dir, f);
 					else
 					    known = false;
 
@@ -1077,11 +1102,11 @@ namespace libdar
 					catch(...)
 					{
 					    if(fixed_date.is_zero())
-						ref.compare(&tmp_eod, f);
+						ref_compare(ref, ref_stream, &tmp_eod, f);
 					    throw;
 					}
 					if(fixed_date.is_zero())
-					    ref.compare(&tmp_eod, f);
+					    ref_compare(ref, ref_stream, &tmp_eod, f);
 				    }
 				    fs.skip_read_to_parent_dir();
 				    juillet.enfile(&tmp_eod);
@@ -1150,7 +1175,7 @@ namespace libdar
 			sem.raise(juillet.get_string(), e, true);
 			sem.lower();
 			if(fixed_date.is_zero())
-			    ref.compare(e, f); // makes the comparison in the reference catalogue go to parent directory
+			    ref_compare(ref, ref_stream, e, f); // makes the comparison in the reference catalogue go to parent directory
 			cat.pre_add(e); // adding a mark and dropping CAT_EOD entry in the archive if cat is an escape_catalogue object (else, does nothing)
 			if(display_finished)
 			{
@@ -1616,7 +1641,7 @@ namespace libdar
 				if(!empty)
 				{
 				    ea_attributs tmp = *(e_ino->get_ea());
-				    perimeter += "(" + deci(tmp.size()).human() +")";
+				    perimeter += "(" + deci::to_string(tmp.size()) +")";
 				    e_ino->ea_detach();
 				}
 			    }
@@ -1633,7 +1658,7 @@ namespace libdar
 				    const filesystem_specific_attribute_list *tmp = e_ino->get_fsa();
 				    if(tmp == nullptr)
 					throw SRC_BUG;
-				    perimeter += "(" + deci(tmp->size()).human() + ")";
+				    perimeter += "(" + deci::to_string(tmp->size()) + ")";
 				    e_ino->fsa_detach();
 				}
 			    }
@@ -1924,7 +1949,7 @@ namespace libdar
 	const cat_entree *e = nullptr;
 	U_I index = 0;
 	defile juillet = FAKE_ROOT;
-	map <infinint, cat_etoile *> corres_copy;
+	hard_link_table<U_64, cat_etoile *> corres_copy;
 	infinint etiquette_offset = 0;
 	const cat_eod tmp_eod;
 
@@ -2430,21 +2455,22 @@ namespace libdar
 							ut = tiquettes.begin();
 							while(ut != tiquettes.end())
 							{
-							    map<infinint, cat_etoile *>::iterator it = corres_copy.find(ut->first);
+							    U_64 key = hard_link_etiquette_key(ut->first);
+							    cat_etoile **it = corres_copy.find(key);
 
-							    if(it == corres_copy.end())
+							    if(it == nullptr)
 								throw SRC_BUG; // unknown etiquettes found in directory tree
 
-							    if(it->second->get_ref_count() < ut->second)
+							    if((*it)->get_ref_count() < ut->second)
 								throw SRC_BUG;
 								// more reference found in directory tree toward this cat_etoile than
 								// this cat_etoile is aware of !
 
-							    if(it->second->get_ref_count() == ut->second)
+							    if((*it)->get_ref_count() == ut->second)
 								    // this cat_etoile will disapear because all its reference are located
 								    // in the directory tree we are about to remove, we must clean this
 								    // entry from corres_copy
-								corres_copy.erase(it);
+								(void)corres_copy.erase(key);
 
 							    ++ut;
 							}
@@ -2917,7 +2943,8 @@ namespace libdar
 				   repair_mode,
 				   sig_bl,
 				   sig_magic,
-				   never_resave_uncompressed))
+				   never_resave_uncompressed,
+				   !repair_mode)) // overlapped_read, source archives are not read sequentially
 
 			throw SRC_BUG;
 		    else // succeeded saving
@@ -3112,7 +3139,8 @@ namespace libdar
 			   bool repair_mode,
 			   U_I signature_block_size,
 			   rsync_sig_magic def_sig_magic,
-			   bool never_resave_uncompressed)
+			   bool never_resave_uncompressed,
+			   bool overlapped_read)
     {
 	bool ret = true;
 	infinint current_repeat_count = 0;
@@ -3386,7 +3414,10 @@ namespace libdar
 						//////////////////////////////
 						// proceeding to file's data backup
 
-					    source->copy_to(*pdesc.stack, crc_size, val);
+					    if(overlapped_read && overlapped_copy_possible(source))
+						source->copy_to_overlapped(*pdesc.stack, crc_size, val);
+					    else
+						source->copy_to(*pdesc.stack, crc_size, val);
 					    if(val == nullptr)
 						throw SRC_BUG;
 
@@ -4026,6 +4057,49 @@ namespace libdar
         return ret;
     }
 
+    static void ref_reset_compare(const catalogue & ref, catalogue_stream *ref_stream, catalogue & cat)
+    {
+	if(ref_stream != nullptr)
+	    ref_stream->reset_compare(cat);
+	else
+	    ref.reset_compare();
+    }
+
+    static bool ref_compare(const catalogue & ref, catalogue_stream *ref_stream, const cat_entree *target, const cat_entree * & extracted)
+    {
+	if(ref_stream != nullptr)
+	    return ref_stream->compare(target, extracted);
+	else
+	    return ref.compare(target, extracted);
+    }
+
+    static void restore_reap_writers(user_interaction & dialog, filesystem_restore & fs, statistics & st, bool wait_completion)
+    {
+	bool loop = true;
+
+	while(loop)
+	{
+	    try
+	    {
+		fs.reap_writer_failure(wait_completion);
+		loop = false; // no more failure pending
+	    }
+	    catch(Euser_abort & e)
+	    {
+		dialog.message(e.get_message() + gettext(" not restored (user choice)"));
+		st.decr_treated();
+		st.incr_ignored();
+	    }
+	    catch(Erange & e)
+	    {
+		dialog.message(string(gettext("Error while restoring ")) + e.get_message());
+		st.decr_treated();
+		st.incr_errored();
+	    }
+	    wait_completion = false;
+	}
+    }
+
     static void restore_atime(const string & chemin, const cat_inode * & ptr)
     {
 	const cat_file * ptr_f = dynamic_cast<const cat_file *>(ptr);
@@ -4033,6 +4107,15 @@ namespace libdar
 	    tools_noexcept_make_date(chemin, false, ptr_f->get_last_access(), ptr_f->get_last_modif(), ptr_f->get_last_modif());
     }
 
+    static bool overlapped_copy_possible(const generic_file *source)
+    {
+	const pile *stack = dynamic_cast<const pile *>(source);
+	const generic_file *top = stack != nullptr ? stack->top() : source;
+
+	    // sparse_file has its own copy_to() implementation that must be used
+	return dynamic_cast<const sparse_file *>(top) == nullptr;
+    }
+
     static bool save_fsa(const shared_ptr<user_interaction> & dialog,
 			 const string & info_quoi,
 			 cat_inode * & ino,
@@ -4520,7 +4603,7 @@ namespace libdar
 
 
     static cat_entree *make_clone(const cat_nomme *ref,
-				  map<infinint, cat_etoile*> & hard_link_base,
+				  hard_link_table<U_64, cat_etoile *> & hard_link_base,
 				  const infinint & etiquette_offset)
     {
 	cat_entree *dolly = nullptr; // will be the address of the cloned object
@@ -4536,8 +4619,10 @@ namespace libdar
 	if(ref_mir != nullptr) // this is hard linked inode
 	{
 		// check whether this is the first time we see this file (in list of file covered by the file masks)
-	    map <infinint, cat_etoile *>::iterator it = hard_link_base.find(ref_mir->get_etiquette() + etiquette_offset);
-	    if(it == hard_link_base.end()) // this inode has not been yet recorded in the resulting archive
+	    infinint shift_etiquette = ref_mir->get_etiquette() + etiquette_offset;
+	    U_64 key = hard_link_etiquette_key(shift_etiquette);
+	    cat_etoile **it = hard_link_base.find(key);
+	    if(it == nullptr) // this inode has not been yet recorded in the resulting archive
 	    {
 		cat_etoile *filante = nullptr;
 		dolly = ref_mir->get_inode()->clone(); // we must clone the attached inode
@@ -4548,7 +4633,6 @@ namespace libdar
 		    if(dollinode == nullptr)
 			throw Ememory();
 
-		    infinint shift_etiquette = ref_mir->get_etiquette() + etiquette_offset;
 		    filante = new (nothrow) cat_etoile(dollinode, shift_etiquette);
 		    if(filante == nullptr)
 			throw Ememory();
@@ -4560,7 +4644,7 @@ namespace libdar
 			    throw Ememory();
 			try
 			{
-			    hard_link_base[shift_etiquette] = filante; // we now record this file_etiquette in the map of already enrolled hard_link sets
+			    (void)hard_link_base.emplace(key, filante); // we now record this file_etiquette in the map of already enrolled hard_link sets
 			}
 			catch(...)
 			{
@@ -4589,7 +4673,7 @@ namespace libdar
 		}
 	    }
 	    else // already added to archive
-		dolly = new (nothrow) cat_mirage(the_name, it->second); // we make a new cat_mirage pointing to the cat_etoile already involved in the catalogue under construction
+		dolly = new (nothrow) cat_mirage(the_name, *it); // we make a new cat_mirage pointing to the cat_etoile already involved in the catalogue under construction
 	}
 	else // not a hard_link file
 	    dolly = ref->clone();  // we just clone the entry
@@ -4601,45 +4685,43 @@ namespace libdar
     }
 
 
-    static void clean_hard_link_base_from(const cat_mirage *mir, map<infinint, cat_etoile *> & hard_link_base)
+    static void clean_hard_link_base_from(const cat_mirage *mir, hard_link_table<U_64, cat_etoile *> & hard_link_base)
     {
 	if(mir->get_etoile_ref_count().is_zero())
 	    throw SRC_BUG; // count should be >= 1
 
 	if(mir->get_etoile_ref_count() == 1)
 	{
-	    map<infinint, cat_etoile *>::iterator it = hard_link_base.find(mir->get_etiquette());
 	    const cat_inode *al_ptr_ino = mir->get_inode();
 	    if(al_ptr_ino == nullptr)
 		throw SRC_BUG;
-	    if(it == hard_link_base.end())
+	    if(!hard_link_base.erase(hard_link_etiquette_key(mir->get_etiquette())))
 		throw SRC_BUG; // the cat_etoile object pointed to by dolly_mir should be known by corres_copy
-	    hard_link_base.erase(it);
 	}
     }
 
-    static void normalize_link_base(map<infinint, cat_etoile *> & hard_link_base)
+    static void normalize_link_base(hard_link_table<U_64, cat_etoile *> & hard_link_base)
     {
-	infinint max_val = 0;
-	map<infinint, cat_etoile *>::iterator it, ut;
-	infinint num_etoile = hard_link_base.size();
-	infinint search = 0;
+	U_64 max_val = 0;
+	U_64 num_etoile = hard_link_base.size();
+	U_64 search = 0;
 
 	    // first pass, looking highest etiquette number
 
-	for(it = hard_link_base.begin(); it != hard_link_base.end(); ++it)
-	{
-	    if(it->first > max_val)
-		max_val = it->first;
-	}
+	hard_link_base.for_each([&max_val](const U_64 & key, cat_etoile *)
+				{
+				    if(key > max_val)
+					max_val = key;
+				});
 
 	    // second pass, looking for holes and moving highest value to fill the gap in
 
 	while(search < num_etoile)
 	{
-	    it = hard_link_base.find(search);
-	    if(it == hard_link_base.end())
+	    if(hard_link_base.find(search) == nullptr)
 	    {
+		cat_etoile **ut = nullptr;
+
 		    // unused etiquette value, looking for the higest value
 		do
 		{
@@ -4648,16 +4730,16 @@ namespace libdar
 		    ut = hard_link_base.find(max_val);
 		    --max_val;
 		}
-		while(ut == hard_link_base.end());
+		while(ut == nullptr);
 
 		    // we can now renumber cat_etoile tmp from max_val to search
 
-		cat_etoile *tmp = ut->second;
+		cat_etoile *tmp = *ut;
 		if(tmp == nullptr)
 		    throw SRC_BUG;
 		tmp->change_etiquette(search);
-		hard_link_base.erase(ut);
-		hard_link_base[search] = tmp;
+		(void)hard_link_base.erase(max_val + 1);
+		(void)hard_link_base.emplace(search, tmp);
 	    }
 	    ++search;
 	}
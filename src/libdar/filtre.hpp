@@ -30,6 +30,7 @@
 #include "mask.hpp"
 #include "pile.hpp"
 #include "catalogue.hpp"
+#include "catalogue_stream.hpp"
 #include "path.hpp"
 #include "statistics.hpp"
 #include "archive_options.hpp"
@@ -64,7 +65,9 @@ namespace libdar
 			       bool only_deleted,         ///< whether to only consider deleted files
 			       bool not_deleted,          ///< wether to consider deleted files
 			       const fsa_scope & scope,   ///< scope of FSA to take into account
-			       bool ignore_unix_sockets   ///< do not try to restore unix sockets
+			       bool ignore_unix_sockets,  ///< do not try to restore unix sockets
+			       U_I restore_writers,       ///< number of threads completing the restoration of new inodes
+			       const std::shared_ptr<restore_dir_journal> & dir_journal ///< what is done to directories when several archives are restored concurrently, may be empty
 	);
 
     extern void filtre_sauvegarde(const std::shared_ptr<user_interaction> & dialog,
@@ -112,7 +115,8 @@ namespace libdar
 				  const delta_sig_block_size & delta_sig_block_len,
 				  rsync_sig_magic sig_magic,
 				  bool never_resave_uncompressed,
-				  bool ref_read_in_seq_mode);
+				  bool ref_read_in_seq_mode,
+				  catalogue_stream *ref_stream); ///< when not nullptr, used instead of ref which is then only its skeleton
 
     extern void filtre_difference(const std::shared_ptr<user_interaction> & dialog,
 				  const mask &filtre,
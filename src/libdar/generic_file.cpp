@@ -68,6 +68,11 @@ extern "C"
 #include "cygwin_adapt.hpp"
 #include "int_tools.hpp"
 #include "crc.hpp"
+#include "probe_clock.hpp"
+
+#ifdef LIBTHREADAR_AVAILABLE
+#include "generic_file_prefetch.hpp"
+#endif
 
 #include <iostream>
 #include <sstream>
@@ -85,6 +90,21 @@ using namespace std;
 namespace libdar
 {
 
+    static bool diff_blocks(const char *a, U_I a_size, const char *b, U_I b_size, infinint & offset);
+
+#ifdef LIBTHREADAR_AVAILABLE
+    static U_I read_fully(generic_file & f, char *a, U_I size);
+    static bool diff_overlapped(generic_file & me,
+				generic_file & you,
+				char *buffer,
+				U_I buffer_size,
+				crc & value,
+				infinint & err_offset);
+    static void copy_overlapped(generic_file & me,
+				generic_file & ref,
+				U_I buffer_size);
+#endif
+
     void generic_file::terminate()
     {
 	try
@@ -148,8 +168,17 @@ namespace libdar
 
         if(rw == gf_write_only)
             throw Erange(gettext("Reading a write only generic_file"));
-        else
-            return (this->*active_read)(a, size);
+
+	if(probe == nullptr)
+	    return (this->*active_read)(a, size);
+	else
+	{
+	    probe_clock clock;
+	    U_I ret = (this->*active_read)(a, size);
+
+	    probe->read.add(ret, clock.lap());
+	    return ret;
+	}
     }
 
     void generic_file::write(const char *a, U_I size)
@@ -158,8 +187,16 @@ namespace libdar
 	    throw SRC_BUG;
         if(rw == gf_read_only)
             throw Erange(gettext("Writing to a read only generic_file"));
-        else
-            (this->*active_write)(a, size);
+
+	if(probe == nullptr)
+	    (this->*active_write)(a, size);
+	else
+	{
+	    probe_clock clock;
+
+	    (this->*active_write)(a, size);
+	    probe->write.add(size, clock.lap());
+	}
     }
 
     void generic_file::write(const string & arg)
@@ -242,6 +279,62 @@ namespace libdar
 	value = get_crc();
     }
 
+    void generic_file::copy_to_overlapped(generic_file & ref, const infinint & crc_size, crc * & value)
+    {
+        char buffer[BUFFER_SIZE];
+        U_I lu;
+
+	if(terminated)
+	    throw SRC_BUG;
+
+        reset_crc(crc_size);
+	try
+	{
+	    do
+	    {
+		try
+		{
+		    lu = read(buffer, BUFFER_SIZE);
+		}
+		catch(Egeneric & e)
+		{
+		    e.set_tag(ERROR_CONTEXT, CONTEXT_READ);
+		    throw;
+		}
+
+		if(lu > 0)
+		{
+		    try
+		    {
+			ref.write(buffer, lu);
+		    }
+		    catch(Egeneric & e)
+		    {
+			e.set_tag(ERROR_CONTEXT, CONTEXT_WRITE);
+			throw;
+		    }
+		}
+
+#ifdef LIBTHREADAR_AVAILABLE
+		if(lu == BUFFER_SIZE)
+		{
+			// more data is expected, worth reading
+			// from a separated thread for the remaining part
+		    copy_overlapped(*this, ref, BUFFER_SIZE);
+		    lu = 0; // copy completed
+		}
+#endif
+	    }
+	    while(lu > 0);
+	}
+	catch(...)
+	{
+	    value = get_crc();
+	    throw;
+	}
+	value = get_crc();
+    }
+
     U_32 generic_file::copy_to(generic_file & ref, U_32 size)
     {
         char buffer[BUFFER_SIZE];
@@ -327,7 +420,8 @@ namespace libdar
 			    const infinint & you_read_ahead,
 			    const infinint & crc_size,
 			    crc * & value,
-			    infinint & err_offset)
+			    infinint & err_offset,
+			    bool overlapped)
     {
         char buffer1[BUFFER_SIZE];
         char buffer2[BUFFER_SIZE];
@@ -353,29 +447,19 @@ namespace libdar
 	    {
 		lu1 = read(buffer1, BUFFER_SIZE);
 		lu2 = f.read(buffer2, BUFFER_SIZE);
-		if(lu1 == lu2)
-		{
-		    U_I i = 0;
-		    while(i < lu1 && buffer1[i] == buffer2[i])
-			++i;
-		    if(i < lu1)
-		    {
-			diff = true;
-			err_offset += i;
-		    }
-		    else
-		    {
-			err_offset += lu1;
-			value->compute(buffer1, lu1);
-		    }
-		}
-		else
-		{
-		    U_I min = lu1 > lu2 ? lu2 : lu1;
+		diff = diff_blocks(buffer1, lu1, buffer2, lu2, err_offset);
+		if(!diff)
+		    value->compute(buffer1, lu1);
 
-		    diff = true;
-		    err_offset += min;
+#ifdef LIBTHREADAR_AVAILABLE
+		if(!diff && overlapped && lu1 == BUFFER_SIZE)
+		{
+			// more data is expected, worth reading f from
+			// a separated thread for the remaining part
+		    diff = diff_overlapped(*this, f, buffer1, BUFFER_SIZE, *value, err_offset);
+		    lu1 = 0; // comparison completed
 		}
+#endif
 	    }
 	    while(!diff && lu1 > 0);
 	}
@@ -513,6 +597,7 @@ namespace libdar
 	    checksum = nullptr;
 	terminated = ref.terminated;
 	no_read_ahead = ref.no_read_ahead;
+	probe = nullptr; // a copy is a distinct layer, not accounted with the original one
 	active_read = ref.active_read;
 	active_write = ref.active_write;
     }
@@ -523,8 +608,117 @@ namespace libdar
 	swap(checksum, ref.checksum);
 	terminated = std::move(ref.terminated);
 	no_read_ahead = std::move(ref.no_read_ahead);
+	probe = std::move(ref.probe);
 	active_read = std::move(ref.active_read);
 	active_write = std::move(ref.active_write);
     }
 
+    static bool diff_blocks(const char *a, U_I a_size, const char *b, U_I b_size, infinint & offset)
+    {
+	U_I min = a_size > b_size ? b_size : a_size;
+
+	if(memcmp(a, b, min) != 0)
+	{
+	    U_I i = 0;
+
+	    while(a[i] == b[i])
+		++i;
+	    offset += i;
+	    return true;
+	}
+
+	offset += min;
+	return a_size != b_size;
+    }
+
+#ifdef LIBTHREADAR_AVAILABLE
+    static U_I read_fully(generic_file & f, char *a, U_I size)
+    {
+	U_I ret = 0;
+	U_I lu;
+
+	do
+	{
+	    lu = f.read(a + ret, size - ret);
+	    ret += lu;
+	}
+	while(lu > 0 && ret < size);
+
+	return ret;
+    }
+
+    static bool diff_overlapped(generic_file & me,
+				generic_file & you,
+				char *buffer,
+				U_I buffer_size,
+				crc & value,
+				infinint & err_offset)
+    {
+	generic_file_prefetch you_ahead(you, buffer_size, 4);
+	const char *you_data;
+	U_I you_lu;
+	U_I me_lu;
+	bool ret = false;
+
+	do
+	{
+		// "me" is read in the current thread while
+		// you_ahead fetches the next blocks of "you"
+	    you_lu = you_ahead.fetch(you_data);
+	    if(you_lu > 0)
+	    {
+		    // reading a full block from "me" even if "you" provided less,
+		    // for a shorter "you" to be detected on the same block as diff() does
+		me_lu = read_fully(me, buffer, buffer_size);
+		ret = diff_blocks(buffer, me_lu, you_data, you_lu, err_offset);
+		if(!ret)
+		    value.compute(buffer, me_lu);
+	    }
+	    else
+		ret = me.read(buffer, 1) > 0; // "me" is longer than "you"
+	}
+	while(!ret && you_lu > 0);
+
+	return ret;
+    }
+
+    static void copy_overlapped(generic_file & me,
+				generic_file & ref,
+				U_I buffer_size)
+    {
+	generic_file_prefetch me_ahead(me, buffer_size, 8);
+	const char *data;
+	U_I lu;
+
+	do
+	{
+		// "ref" is written in the current thread while
+		// me_ahead fetches the next blocks of "me"
+	    try
+	    {
+		lu = me_ahead.fetch(data);
+	    }
+	    catch(Egeneric & e)
+	    {
+		e.set_tag(generic_file::ERROR_CONTEXT, generic_file::CONTEXT_READ);
+		throw;
+	    }
+
+	    if(lu > 0)
+	    {
+		try
+		{
+		    ref.write(data, lu);
+		}
+		catch(Egeneric & e)
+		{
+		    e.set_tag(generic_file::ERROR_CONTEXT, generic_file::CONTEXT_WRITE);
+		    throw;
+		}
+	    }
+	}
+	while(lu > 0);
+    }
+#endif
+
 } // end of namespace
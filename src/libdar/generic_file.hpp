@@ -51,6 +51,7 @@ extern "C"
 #include "crc.hpp"
 #include "infinint.hpp"
 #include "gf_mode.hpp"
+#include "layer_statistics.hpp"
 
 #include <string>
 
@@ -86,7 +87,7 @@ namespace libdar
 
 
 	    /// main constructor
-        generic_file(gf_mode m) { rw = m; terminated = no_read_ahead = false; enable_crc(false); checksum = nullptr; };
+        generic_file(gf_mode m) { rw = m; terminated = no_read_ahead = false; enable_crc(false); checksum = nullptr; probe = nullptr; };
 
 	    /// copy constructor
 	generic_file(const generic_file &ref) { copy_from(ref); };
@@ -204,6 +205,18 @@ namespace libdar
 	    /// \note value has to be deleted by the caller when no more needed
         virtual void copy_to(generic_file &ref, const infinint & crc_size, crc * & value);
 
+	    /// same as copy_to() with CRC calculation but reading "this" from a separated thread
+
+	    /// \param[in] ref defines where to copy the data to
+	    /// \param[in] crc_size tell the width of the crc to compute on the copied data
+	    /// \param[out] value points to a newly allocated crc object containing the crc value
+	    /// \note if libthreadar is available, once a first block has been copied, "this" is read
+	    /// from a separated thread while ref is written by the current one. ref must then not share
+	    /// any underlying object with "this". Unlike copy_to(), the data is only fetched with read(),
+	    /// the copy_to() specific implementation of inherited classes is thus not used.
+	    /// \note value has to be deleted by the caller when no more needed
+	void copy_to_overlapped(generic_file &ref, const infinint & crc_size, crc * & value);
+
 	    /// small copy (up to 4GB) with CRC calculation
         U_32 copy_to(generic_file &ref, U_32 size); // returns the number of byte effectively copied
 
@@ -237,6 +250,9 @@ namespace libdar
 	    /// \param[out] err_offset in case of difference, holds the offset of the first difference met
 	    /// testing if this method returns false (no difference between files). The given checksum
 	    /// has to be set to the expected width by the caller.
+	    /// \param[in] overlapped if set and libthreadar is available, once the first block has been
+	    /// compared, f is read from a separated thread while "this" is read by the current one. f
+	    /// must then not share any underlying object with "this"
 	    /// \return true if arg differ from "this", else false is returned and err_offset is set
 	    /// \note value has to be deleted by the caller when no more needed
 	    /// \note the more simple operator == method may be prefered to diff() when no crc calculation is required
@@ -245,7 +261,8 @@ namespace libdar
 		  const infinint & you_read_ahead,
 		  const infinint & crc_size,
 		  crc * & value,
-		  infinint & err_offset);
+		  infinint & err_offset,
+		  bool overlapped = false);
 
             /// reset CRC on read or writen data
 
@@ -268,6 +285,15 @@ namespace libdar
 	    /// be ready to read at current position, reseting all pending data for reading, cached and in compression engine for example
 	void flush_read();
 
+	    /// record the calls to read() and write() and their duration into the given layer statistics
+
+	    /// \param[in] record where to account the calls, nullptr stops recording
+	    /// \note the record is not owned and must survive this object or be unset first
+	void set_probe(layer_statistics::layer *record) { probe = record; };
+
+	    /// the layer statistics given to set_probe() or nullptr
+	layer_statistics::layer *get_probe() const { return probe; };
+
 
     protected :
         void set_mode(gf_mode x) { rw = x; };
@@ -339,6 +365,7 @@ namespace libdar
         crc *checksum;
 	bool terminated;
 	bool no_read_ahead;
+	layer_statistics::layer *probe;
         U_I (generic_file::* active_read)(char *a, U_I size);
         void (generic_file::* active_write)(const char *a, U_I size);
 
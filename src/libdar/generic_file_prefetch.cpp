@@ -0,0 +1,125 @@
+/*********************************************************************/
+// dar - disk archive - a backup/restoration program
+// Copyright (C) 2002-2026 Denis Corbin
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// to contact the author, see the AUTHOR file
+/*********************************************************************/
+
+#include "../my_config.h"
+
+extern "C"
+{
+}
+
+#include "generic_file_prefetch.hpp"
+#include "erreurs.hpp"
+
+using namespace std;
+
+namespace libdar
+{
+
+    generic_file_prefetch::generic_file_prefetch(generic_file & source,
+						 U_I block_size,
+						 U_I num_blocks):
+	tampon_thread(num_blocks, block_size),
+	src(source),
+	stop(false),
+	current(nullptr),
+	eof(false)
+    {
+	run();
+    }
+
+    generic_file_prefetch::~generic_file_prefetch()
+    {
+	try
+	{
+	    const char *ptr;
+
+	    stop = true;
+		// draining the blocks up to the end of data marker,
+		// which the thread always sends before ending, fetch()
+		// then joins the thread
+	    while(!eof)
+		(void)fetch(ptr);
+	}
+	catch(...)
+	{
+		// ignore all exceptions
+	}
+    }
+
+    U_I generic_file_prefetch::fetch(const char * & ptr)
+    {
+	char *block;
+	unsigned int size;
+
+	if(current != nullptr)
+	{
+	    interthread.fetch_recycle(current);
+	    current = nullptr;
+	}
+
+	if(eof)
+	    size = 0;
+	else
+	{
+	    interthread.fetch(block, size);
+	    if(size == 0)
+	    {
+		interthread.fetch_recycle(block);
+		eof = true;
+		join(); // rethrows the exception met by the thread if any
+	    }
+	    else
+	    {
+		current = block;
+		ptr = block;
+	    }
+	}
+
+	return size;
+    }
+
+    void generic_file_prefetch::inherited_run()
+    {
+	char *ptr;
+	unsigned int size;
+	U_I lu;
+
+	do
+	{
+	    interthread.get_block_to_feed(ptr, size);
+	    try
+	    {
+		if(stop)
+		    lu = 0;
+		else
+		    lu = src.read(ptr, size);
+	    }
+	    catch(...)
+	    {
+		interthread.feed(ptr, 0); // end of data marker
+		throw;
+	    }
+	    interthread.feed(ptr, lu);
+	}
+	while(lu > 0);
+    }
+
+} // end of namespace
@@ -0,0 +1,88 @@
+/*********************************************************************/
+// dar - disk archive - a backup/restoration program
+// Copyright (C) 2002-2026 Denis Corbin
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// to contact the author, see the AUTHOR file
+/*********************************************************************/
+
+    /// \file generic_file_prefetch.hpp
+    /// \brief reads a generic_file ahead from a separated thread
+    /// \ingroup Private
+
+#ifndef GENERIC_FILE_PREFETCH_HPP
+#define GENERIC_FILE_PREFETCH_HPP
+
+#include "../my_config.h"
+
+#include <atomic>
+#include "generic_file.hpp"
+#include "tampon_thread.hpp"
+
+namespace libdar
+{
+
+	/// \addtogroup Private
+	/// @{
+
+	/// sequentially reads a generic_file from a separated thread
+
+	/// the source is read from its current position up to its end, the data
+	/// being handed to the caller thread block by block through a fast_tampon.
+	/// While the object exists, the source must not be accessed by any other
+	/// mean.
+    class generic_file_prefetch: public tampon_thread
+    {
+    public:
+	    /// constructor, starts the reading thread
+
+	    /// \param[in] source the object to read from
+	    /// \param[in] block_size size of the blocks handed to the caller
+	    /// \param[in] num_blocks number of blocks that can be read ahead
+	generic_file_prefetch(generic_file & source,
+			      U_I block_size,
+			      U_I num_blocks);
+	generic_file_prefetch(const generic_file_prefetch & ref) = delete;
+	generic_file_prefetch(generic_file_prefetch && ref) noexcept = delete;
+	generic_file_prefetch & operator = (const generic_file_prefetch & ref) = delete;
+	generic_file_prefetch & operator = (generic_file_prefetch && ref) noexcept = delete;
+
+	    /// destructor stops the thread if still running
+	~generic_file_prefetch();
+
+	    /// obtain the next block of data
+
+	    /// \param[out] ptr points to the data, which stays valid up to the next call
+	    /// or the object destruction
+	    /// \return the amount of bytes available at ptr, zero meaning end of file
+	    /// \note an exception met by the reading thread is rethrown here
+	U_I fetch(const char * & ptr);
+
+    protected:
+	virtual void inherited_run() override;
+
+    private:
+	generic_file & src;
+	std::atomic<bool> stop;    ///< asks the thread to end at the next block
+	char *current;             ///< block owned by the caller, not yet recycled
+	bool eof;                  ///< the end of data marker has been fetched
+    };
+
+	/// @}
+
+} // end of namespace
+
+#endif
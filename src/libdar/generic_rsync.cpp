@@ -48,6 +48,14 @@ extern "C"
 
 #define SMALL_BUF 10
 
+    // in sign mode, amount of data a read must provide for the remaining
+    // part of the file to be signed by a separated thread
+#define SIGNER_THRESHOLD 65536
+#define SIGNER_BLOCKS 8
+
+    // size of the window over the base file in patch mode
+#define BASE_CACHE_SIZE 4194304
+
 using namespace std;
 
 namespace libdar
@@ -87,6 +95,8 @@ namespace libdar
 	    initial = true;
 	    patching_completed = false; // not used in sign mode
 	    data_crc = nullptr;
+	    base_cache = nullptr;
+	    base_cache_data = 0;
 	    job = rs_sig_begin(signature_block_size, 0, rsync_sig_magic_to_librsync(sig_magic));
 	}
 	catch(...)
@@ -129,6 +139,8 @@ namespace libdar
 	initial = true;
 	patching_completed = false; // not used in delta mode
 	data_crc = nullptr;
+	base_cache = nullptr;
+	base_cache_data = 0;
 	working_buffer = new (nothrow) char[BUFFER_SIZE];
 	if(working_buffer == nullptr)
 	    throw Ememory();
@@ -255,15 +267,23 @@ namespace libdar
 	initial = true;
 	working_size = 0;
 	data_crc = nullptr;
+	base_cache = nullptr;
+	base_cache_data = 0;
 	working_buffer = new (nothrow) char[BUFFER_SIZE];
 	if(working_buffer == nullptr)
 	    throw Ememory();
 	try
 	{
+	    base_cache = new (nothrow) char[BASE_CACHE_SIZE];
+	    if(base_cache == nullptr)
+		throw Ememory();
+	    base_next = x_input->get_position();
 	    job = rs_patch_begin(generic_rsync::patch_callback, this);
 	}
 	catch(...)
 	{
+	    if(base_cache != nullptr)
+		delete [] base_cache;
 	    delete [] working_buffer;
 	    throw;
 	}
@@ -277,6 +297,8 @@ namespace libdar
     {
 	terminate();
 	delete [] working_buffer;
+	if(base_cache != nullptr)
+	    delete [] base_cache;
     }
 
     U_I generic_rsync::inherited_read(char *a, U_I size)
@@ -294,25 +316,27 @@ namespace libdar
 	{
 	case sign:
 	    lu = x_below->read(a, size);
-	    remain = lu;
-	    do
+#ifdef LIBTHREADAR_AVAILABLE
+	    if(worker)
 	    {
-		U_I tmp = BUFFER_SIZE - working_size;
-
-		(void)step_forward(a + lu - remain, remain,
-				   false,
-				   working_buffer+working_size, tmp);
-		working_size += tmp;
-
-		// we flush the working_buffer only when is it full because the
-		// memory_file class does not scale well with short writes
-		if(working_size > 0 && tmp == 0)
+		if(lu > 0)
+		    worker->feed(a, lu);
+	    }
+	    else
+	    {
+		sign_feed(a, lu);
+		if(lu == size && lu >= SIGNER_THRESHOLD)
 		{
-		    x_output->write(working_buffer, working_size);
-		    working_size = 0;
+			// more data is expected, worth signing
+			// it from a separated thread
+		    worker.reset(new (nothrow) signer(*this));
+		    if(!worker)
+			throw Ememory();
 		}
 	    }
-	    while(remain > 0);
+#else
+	    sign_feed(a, lu);
+#endif
 	    break;
 	case delta:
 	    do
@@ -404,7 +428,15 @@ namespace libdar
 	switch(status)
 	{
 	case sign:
-	    send_eof();
+#ifdef LIBTHREADAR_AVAILABLE
+	    if(worker)
+	    {
+		worker->finish(); // the thread has sent eof to librsync
+		worker.reset();
+	    }
+	    else
+#endif
+		send_eof();
 	    break;
 	case delta:
       	case patch:
@@ -431,7 +463,8 @@ namespace libdar
     {
 	rs_result ret;
 	generic_rsync *me = (generic_rsync *)(opaque);
-	U_I lu;
+	const char *ptr;
+	U_I avail;
 
 	if(me == nullptr)
 	    throw SRC_BUG;
@@ -440,13 +473,21 @@ namespace libdar
 
 	try
 	{
-	    me->x_input->skip(pos);
-	    lu = me->x_input->read((char *)*buf, *len);
-	    if(*len > 0 && lu == 0)
+	    avail = me->base_fetch(pos, ptr);
+	    if(*len > 0 && avail == 0)
+	    {
 		ret = RS_INPUT_ENDED;
+		*len = 0;
+	    }
 	    else
+	    {
+		    // librsync copies the data from the provided
+		    // buffer, which avoids an intermediate copy
+		if(*len > avail)
+		    *len = avail; // librsync asks again for the remaining part
+		*buf = const_cast<char *>(ptr);
 		ret = RS_DONE;
-	    *len = lu;
+	    }
 	}
 	catch(...)
 	{
@@ -540,6 +581,97 @@ namespace libdar
     }
 
 
+    U_I generic_rsync::base_fetch(const infinint & pos, const char * & ptr)
+    {
+	U_I offset = 0;
+	infinint delta;
+
+	if(base_cache == nullptr)
+	    throw SRC_BUG;
+
+	if(pos < base_cache_start || pos >= base_cache_start + base_cache_data)
+	{
+	    U_I lu;
+
+		// refilling the window from pos, the next copy
+		// commands being most of the time located after it
+
+	    base_cache_start = pos;
+	    base_cache_data = 0;
+	    if(pos != base_next)
+	    {
+		if(!x_input->skip(pos))
+		{
+		    base_next = x_input->get_position();
+		    return 0; // beyond end of file
+		}
+	    }
+
+	    do
+	    {
+		lu = x_input->read(base_cache + base_cache_data, BASE_CACHE_SIZE - base_cache_data);
+		base_cache_data += lu;
+	    }
+	    while(lu > 0 && base_cache_data < BASE_CACHE_SIZE);
+	    base_next = pos + base_cache_data;
+	}
+
+	delta = pos - base_cache_start;
+	delta.unstack(offset);
+	if(!delta.is_zero())
+	    throw SRC_BUG;
+
+	ptr = base_cache + offset;
+	return base_cache_data - offset;
+    }
+
+    void generic_rsync::sign_feed(const char *a, U_I size)
+    {
+	U_I remain = size;
+
+	do
+	{
+	    U_I tmp = BUFFER_SIZE - working_size;
+
+	    (void)step_forward(a + size - remain, remain,
+			       false,
+			       working_buffer+working_size, tmp);
+	    working_size += tmp;
+
+		// we flush the working_buffer only when is it full because the
+		// memory_file class does not scale well with short writes
+	    if(working_size > 0 && tmp == 0)
+	    {
+		x_output->write(working_buffer, working_size);
+		working_size = 0;
+	    }
+	}
+	while(remain > 0);
+    }
+
+#ifdef LIBTHREADAR_AVAILABLE
+
+    generic_rsync::signer::signer(generic_rsync & owner):
+	tampon_consumer(SIGNER_BLOCKS, BUFFER_SIZE),
+	me(owner)
+    {
+	run();
+    }
+
+    generic_rsync::signer::~signer()
+    {
+	try
+	{
+	    finish();
+	}
+	catch(...)
+	{
+		// ignore all exceptions
+	}
+    }
+
+#endif
+
 #if LIBRSYNC_AVAILABLE
 
     rs_magic_number generic_rsync::rsync_sig_magic_to_librsync(rsync_sig_magic algo)
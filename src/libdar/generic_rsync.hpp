@@ -36,10 +36,15 @@ extern "C"
 #endif
 }
 
+#include <memory>
 #include "generic_file.hpp"
 #include "erreurs.hpp"
 #include "archive_aux.hpp"
 
+#ifdef LIBTHREADAR_AVAILABLE
+#include "tampon_thread.hpp"
+#endif
+
 namespace libdar
 {
 
@@ -56,6 +61,9 @@ namespace libdar
 	    /// in this mode the generic_rsync object is read only, all data
 	    /// read from it is fetched unchanged from "below" while the signature is
 	    /// computed. The file signature is output to signature_storage
+	    /// \note if libthreadar is available, once a first full block has been
+	    /// read, the signature is computed by a separated thread, signature_storage
+	    /// must then not be accessed before this object has been terminated
 	    /// \param[in] signature_storage is write only mode generic_file
 	    /// \param[in] signature_block_size the block len to use to build the signature
 	    /// \param[in] sig_magic hashing algorithm used to build signature
@@ -120,6 +128,32 @@ namespace libdar
 	virtual void inherited_terminate() override;
 
     private:
+#ifdef LIBTHREADAR_AVAILABLE
+	    /// thread computing the signature of the data read in sign mode
+
+	    /// the data is handed to the thread through a fast_tampon, the thread
+	    /// feeds librsync and writes the signature to x_output in order
+	class signer: public tampon_consumer
+	{
+	public:
+	    signer(generic_rsync & owner);
+	    signer(const signer & ref) = delete;
+	    signer(signer && ref) noexcept = delete;
+	    signer & operator = (const signer & ref) = delete;
+	    signer & operator = (signer && ref) noexcept = delete;
+	    ~signer();
+
+	protected:
+	    virtual void consume(const char *a, U_I size) override { me.sign_feed(a, size); };
+	    virtual void end_of_data() override { me.send_eof(); };
+
+	private:
+	    generic_rsync & me;
+	};
+
+	std::unique_ptr<signer> worker; ///< signature computation thread (sign mode only)
+#endif
+
 	enum { sign, delta, patch } status;
 
 	generic_file *x_below;    ///< underlying layer to read from / write to
@@ -130,6 +164,10 @@ namespace libdar
 	U_I working_size;
 	bool patching_completed;
 	crc *data_crc;
+	char *base_cache;          ///< window over the base file data (patch mode only)
+	U_I base_cache_data;       ///< amount of valid bytes in base_cache
+	infinint base_cache_start; ///< offset in x_input of the first byte of base_cache
+	infinint base_next;        ///< offset in x_input where the next read occurs without skipping
 
 #if LIBRSYNC_AVAILABLE
 	rs_job_t *job;
@@ -160,6 +198,16 @@ namespace libdar
 			  U_I & avail_out);
 	void free_job();
 	void send_eof();
+	void sign_feed(const char *a, U_I size); ///< feed librsync with data to sign, writing the signature produced so far to x_output
+
+	    /// provides data of the base file in patch mode
+
+	    /// \param[in] pos offset in the base file of the requested data
+	    /// \param[out] ptr points to the data, which stays valid up to the next call
+	    /// \return the amount of bytes available at ptr, zero if pos is beyond the end of the base file
+	    /// \note data is read by large blocks, the copy commands of the patch being most of the
+	    /// time located in sequence, the next requested data is thus usually already available
+	U_I base_fetch(const infinint & pos, const char * & ptr);
 
 #if LIBRSYNC_AVAILABLE
 
@@ -76,6 +76,7 @@ extern "C"
 #include "tools.hpp"
 #include "thread_cancellation.hpp"
 #include "mycurl_easyhandle_node.hpp"
+#include "crypto.hpp"
 
 #ifdef LIBTHREADAR_AVAILABLE
 #include "parallel_tronconneuse.hpp"
@@ -310,6 +311,9 @@ namespace libdar
 	ssh_finalize();
 #endif
 
+	    // cached keys rely on libgcrypt secured memory too
+	clear_derived_key_cache();
+
 #ifdef CRYPTO_AVAILABLE
 	if(libdar_initialized_gcrypt)
 	    gcry_control(GCRYCTL_TERM_SECMEM, 0); // by precaution if not already done by libgcrypt itself
@@ -0,0 +1,322 @@
+/*********************************************************************/
+// dar - disk archive - a backup/restoration program
+// Copyright (C) 2002-2026 Denis Corbin
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// to contact the author, see the AUTHOR file
+/*********************************************************************/
+
+    /// \file hard_link_table.hpp
+    /// \brief hash table used to track hard linked inodes
+    /// \ingroup Private
+    ///
+    /// Hard link bookkeeping (inode seen when reading the filesystem, path of
+    /// the first restored link, cat_etoile already added to a merged catalogue)
+    /// may concern millions of entries, which are only looked up by key and never
+    /// need to be ordered. hard_link_table is a chained hash table with fixed-width
+    /// keys whose entries are allocated by chunks and recycled through a free list,
+    /// which avoids one memory allocation per entry and keeps entries at a stable
+    /// address for their whole life.
+
+#ifndef HARD_LINK_TABLE_HPP
+#define HARD_LINK_TABLE_HPP
+
+#include "../my_config.h"
+
+#include <vector>
+#include <memory>
+#include <new>
+#include <utility>
+#include <functional>
+#include <string>
+#include "integers.hpp"
+#include "infinint.hpp"
+#include "erreurs.hpp"
+
+namespace libdar
+{
+
+	/// \addtogroup Private
+	/// @{
+
+	/// convert an etiquette to the fixed-width key used in hard_link_table
+
+	/// \note throws Erange if the etiquette does not fit in 64 bits
+    inline U_64 hard_link_etiquette_key(const infinint & etiquette)
+    {
+	infinint tmp = etiquette;
+	U_64 ret = 0;
+
+	tmp.unstack(ret);
+	if(!tmp.is_zero())
+	    throw Erange(gettext("Too many hard linked inodes to be tracked"));
+
+	return ret;
+    }
+
+	/// hash table of hard linked inodes
+
+	/// \param K is the key type, it must be a fixed-width type comparable with operator ==
+	/// \param T is the type of the data associated to a key, it does not need to be copiable
+	/// nor movable as entries are constructed in place and never relocated
+	/// \param H is the hash function object applied to the keys
+    template <class K, class T, class H = std::hash<K> > class hard_link_table
+    {
+    public:
+	hard_link_table(): buckets(), num(0), free_slots(nullptr), next_chunk_size(min_chunk_size) {};
+	hard_link_table(const hard_link_table & ref) = delete;
+	hard_link_table(hard_link_table && ref) noexcept = delete;
+	hard_link_table & operator = (const hard_link_table & ref) = delete;
+	hard_link_table & operator = (hard_link_table && ref) noexcept = delete;
+	~hard_link_table() { clear(); };
+
+	    /// look for an entry
+
+	    /// \return the address of the data associated to key, or nullptr if key is not present
+	T *find(const K & key) const;
+
+	    /// add a new entry
+
+	    /// \param[in] key must not already be present in the table
+	    /// \param[in] args are given to the constructor of the T object
+	    /// \return the address of the newly created data, which stays valid until the entry is erased
+	template <class... Args> T & emplace(const K & key, Args && ... args);
+
+	    /// remove an entry
+
+	    /// \return false if key was not present
+	bool erase(const K & key);
+
+	    /// remove all entries and release the memory
+	void clear();
+
+	    /// number of entries
+	U_I size() const { return num; };
+
+	    /// whether the table is empty
+	bool empty() const { return num == 0; };
+
+	    /// call f(const K &, T &) for each entry, in no particular order
+
+	    /// \note the table must not be modified by f
+	template <class F> void for_each(F f) const;
+
+    private:
+	static constexpr U_I min_chunk_size = 64;
+	static constexpr U_I max_chunk_size = 65536;
+	static constexpr U_I min_buckets = 64;
+
+	struct entry
+	{
+	    template <class... Args> entry(const K & k, Args && ... args): key(k), val(std::forward<Args>(args)...), next(nullptr) {};
+
+	    K key;
+	    T val;
+	    entry *next;   ///< next entry of the same bucket
+	};
+
+	    /// raw memory for one entry, also used to chain unused slots
+	union slot
+	{
+	    slot *next_free;
+	    alignas(entry) unsigned char raw[sizeof(entry)];
+	};
+
+	std::vector<entry *> buckets;                  ///< size is always zero or a power of two
+	U_I num;                                       ///< number of entries
+	std::vector<std::unique_ptr<slot[]> > chunks;  ///< memory pool
+	slot *free_slots;                              ///< chained list of unused slots
+	U_I next_chunk_size;                           ///< number of slots of the next chunk to allocate
+
+	U_I bucket_of(const K & key) const;
+	void rehash(U_I new_size);
+	slot *get_slot();
+	void release_slot(entry *ent);
+    };
+
+    template <class K, class T, class H> T *hard_link_table<K, T, H>::find(const K & key) const
+    {
+	if(buckets.empty())
+	    return nullptr;
+
+	entry *ptr = buckets[bucket_of(key)];
+	while(ptr != nullptr && !(ptr->key == key))
+	    ptr = ptr->next;
+
+	return ptr != nullptr ? &(ptr->val) : nullptr;
+    }
+
+    template <class K, class T, class H>
+    template <class... Args> T & hard_link_table<K, T, H>::emplace(const K & key, Args && ... args)
+    {
+	if(find(key) != nullptr)
+	    throw SRC_BUG; // key already present
+
+	if(num >= buckets.size())
+	    rehash(buckets.empty() ? min_buckets : buckets.size() * 2);
+
+	slot *place = get_slot();
+	entry *ent = nullptr;
+
+	try
+	{
+	    ent = new (place->raw) entry(key, std::forward<Args>(args)...);
+	}
+	catch(...)
+	{
+	    place->next_free = free_slots;
+	    free_slots = place;
+	    throw;
+	}
+
+	entry * & head = buckets[bucket_of(key)];
+	ent->next = head;
+	head = ent;
+	++num;
+
+	return ent->val;
+    }
+
+    template <class K, class T, class H> bool hard_link_table<K, T, H>::erase(const K & key)
+    {
+	if(buckets.empty())
+	    return false;
+
+	entry **ptr = &(buckets[bucket_of(key)]);
+	while(*ptr != nullptr && !((*ptr)->key == key))
+	    ptr = &((*ptr)->next);
+
+	if(*ptr == nullptr)
+	    return false;
+
+	entry *found = *ptr;
+	*ptr = found->next;
+	--num;
+	release_slot(found);
+
+	return true;
+    }
+
+    template <class K, class T, class H> void hard_link_table<K, T, H>::clear()
+    {
+	for(typename std::vector<entry *>::iterator it = buckets.begin(); it != buckets.end(); ++it)
+	{
+	    while(*it != nullptr)
+	    {
+		entry *tmp = *it;
+		*it = tmp->next;
+		tmp->~entry();
+	    }
+	}
+
+	buckets.clear();
+	buckets.shrink_to_fit();
+	chunks.clear();
+	free_slots = nullptr;
+	num = 0;
+	next_chunk_size = min_chunk_size;
+    }
+
+    template <class K, class T, class H>
+    template <class F> void hard_link_table<K, T, H>::for_each(F f) const
+    {
+	for(typename std::vector<entry *>::const_iterator it = buckets.begin(); it != buckets.end(); ++it)
+	{
+	    for(entry *ptr = *it; ptr != nullptr; ptr = ptr->next)
+		f(ptr->key, ptr->val);
+	}
+    }
+
+    template <class K, class T, class H> U_I hard_link_table<K, T, H>::bucket_of(const K & key) const
+    {
+	U_64 h = H()(key);
+
+	    // mixing the bits as the hash of integers is often the identity
+	    // and only the lowest bits are used to select the bucket
+	h ^= h >> 33;
+	h *= 0xff51afd7ed558ccdULL;
+	h ^= h >> 33;
+
+	return (U_I)(h & (buckets.size() - 1));
+    }
+
+    template <class K, class T, class H> void hard_link_table<K, T, H>::rehash(U_I new_size)
+    {
+	std::vector<entry *> old;
+
+	old.swap(buckets);
+	try
+	{
+	    buckets.resize(new_size, nullptr);
+	}
+	catch(...)
+	{
+	    buckets.swap(old);
+	    throw;
+	}
+
+	for(typename std::vector<entry *>::iterator it = old.begin(); it != old.end(); ++it)
+	{
+	    while(*it != nullptr)
+	    {
+		entry *tmp = *it;
+		*it = tmp->next;
+
+		entry * & head = buckets[bucket_of(tmp->key)];
+		tmp->next = head;
+		head = tmp;
+	    }
+	}
+    }
+
+    template <class K, class T, class H> typename hard_link_table<K, T, H>::slot *hard_link_table<K, T, H>::get_slot()
+    {
+	if(free_slots == nullptr)
+	{
+	    std::unique_ptr<slot[]> chunk(new (std::nothrow) slot[next_chunk_size]);
+
+	    if(!chunk)
+		throw Ememory();
+
+	    for(U_I i = 0; i < next_chunk_size; ++i)
+		chunk[i].next_free = (i + 1 < next_chunk_size) ? &(chunk[i + 1]) : nullptr;
+	    chunks.push_back(std::move(chunk));
+	    free_slots = &(chunks.back()[0]);
+
+	    if(next_chunk_size < max_chunk_size)
+		next_chunk_size *= 2;
+	}
+
+	slot *ret = free_slots;
+	free_slots = ret->next_free;
+
+	return ret;
+    }
+
+    template <class K, class T, class H> void hard_link_table<K, T, H>::release_slot(entry *ent)
+    {
+	slot *place = reinterpret_cast<slot *>(ent);
+
+	ent->~entry();
+	place->next_free = free_slots;
+	free_slots = place;
+    }
+
+	/// @}
+
+} // end of namespace
+
+#endif
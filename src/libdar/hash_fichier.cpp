@@ -21,11 +21,24 @@
 
 #include "../my_config.h"
 
+extern "C"
+{
+#if HAVE_STRING_H
+#include <string.h>
+#endif
+}
+
 #include "hash_fichier.hpp"
 #include "erreurs.hpp"
 #include "tools.hpp"
 #include "path.hpp"
 
+    // number of blocks in transit between the writer and the hashing thread
+#define DIGESTER_BLOCKS 10
+
+    // size of the blocks handed to the hashing thread
+#define DIGESTER_BLOCK_SIZE 1048576
+
 using namespace std;
 
 namespace libdar
@@ -46,54 +59,33 @@ namespace libdar
 	if(hash_file->get_mode() != gf_write_only)
 	    throw SRC_BUG;
 	only_hash = false;
-	ref = under;
-	hash_ref = hash_file;
 	path tmp = under_filename;
 	ref_filename = tmp.basename();
 	eof = false;
 	hash_dumped = false;
-	algor = algo;
+	started = false;
 	aborting_write = false;
+	cancelled = false;
 
-	switch(algo)
-	{
-	case hash_algo::none:
-	    throw SRC_BUG;
-
-	case hash_algo::md5:
-	case hash_algo::sha1:
-	case hash_algo::sha512:
-	case hash_algo::whirlpool:
-	case hash_algo::sha3_512:
-	case hash_algo::blake2b_512:
 #if CRYPTO_AVAILABLE
-	    gcry_error_t err;
-
-	    hash_gcrypt = hash_algo_to_gcrypt_hash(algo);
-
-	    err = gcry_md_test_algo(hash_gcrypt);
-	    if(err != GPG_ERR_NO_ERROR)
-		throw Erange(tools_printf(gettext("Error while initializing hash: Hash algorithm not available in libgcrypt: %s/%s"),
-					  gcry_strsource(err),
-					  gcry_strerror(err)));
-
-	    err = gcry_md_open(&hash_handle, hash_gcrypt, 0); // no need of secure memory here
-	    if(err != GPG_ERR_NO_ERROR)
-		throw Erange(tools_printf(gettext("Error while creating hash handle: %s/%s"),
-					  gcry_strsource(err),
-					  gcry_strerror(err)));
+	gcry_error_t err;
+	U_I hash_gcrypt = get_gcrypt_algo(algo);
+
+	err = gcry_md_open(&hash_handle, hash_gcrypt, 0); // no need of secure memory here
+	if(err != GPG_ERR_NO_ERROR)
+	    throw Erange(tools_printf(gettext("Error while creating hash handle: %s/%s"),
+				      gcry_strsource(err),
+				      gcry_strerror(err)));
 #else
-	    throw Ecompilation(tools_printf(gettext("Missing %s hash algorithm support (provided with strong encryption support, using libgcrypt)"),
-					    hash_algo_to_string(algo).c_str()));
+	(void)get_gcrypt_algo(algo); // throws an exception
 #endif
-	    break;
 
-	case hash_algo::argon2:
-	    throw SRC_BUG;
+	    // no exception can occur past this point,
+	    // this object now owns under and hash_file
 
-	default:
-	    throw SRC_BUG;
-	}
+	ref = under;
+	hash_ref.push_back(hash_file);
+	algor.push_back(algo);
     }
 
     hash_fichier::~hash_fichier()
@@ -107,16 +99,76 @@ namespace libdar
 		// ignore all errors
 	}
 
+#ifdef LIBTHREADAR_AVAILABLE
+	worker.reset(); // in case terminate() failed before the thread completed
+#endif
+
 	if(ref != nullptr)
 	{
 	    delete ref;
 	    ref = nullptr;
 	}
 
-	if(hash_ref != nullptr)
+	for(deque<fichier_global *>::iterator it = hash_ref.begin(); it != hash_ref.end(); ++it)
+	{
+	    if(*it != nullptr)
+	    {
+		delete *it;
+		*it = nullptr;
+	    }
+	}
+    }
+
+    void hash_fichier::add_hash(fichier_global *hash_file, hash_algo algo)
+    {
+	if(hash_file == nullptr)
+	    throw SRC_BUG;
+	if(hash_file->get_mode() != gf_write_only)
+	    throw SRC_BUG;
+	if(started || eof)
+	    throw SRC_BUG;
+
+	for(deque<hash_algo>::iterator it = algor.begin(); it != algor.end(); ++it)
+	    if(*it == algo)
+		throw SRC_BUG; // algorithm already computed
+
+#if CRYPTO_AVAILABLE
+	gcry_error_t err = gcry_md_enable(hash_handle, get_gcrypt_algo(algo));
+	if(err != GPG_ERR_NO_ERROR)
+	    throw Erange(tools_printf(gettext("Error while creating hash handle: %s/%s"),
+				      gcry_strsource(err),
+				      gcry_strerror(err)));
+#else
+	throw SRC_BUG; // constructor should have failed
+#endif
+
+	hash_ref.push_back(hash_file);
+	algor.push_back(algo);
+    }
+
+    void hash_fichier::change_ownership(const std::string & user, const std::string & group)
+    {
+	if(ref == nullptr)
+	    throw SRC_BUG;
+	ref->change_ownership(user, group);
+	for(deque<fichier_global *>::iterator it = hash_ref.begin(); it != hash_ref.end(); ++it)
+	{
+	    if(*it == nullptr)
+		throw SRC_BUG;
+	    (*it)->change_ownership(user, group);
+	}
+    }
+
+    void hash_fichier::change_permission(U_I perm)
+    {
+	if(ref == nullptr)
+	    throw SRC_BUG;
+	ref->change_permission(perm);
+	for(deque<fichier_global *>::iterator it = hash_ref.begin(); it != hash_ref.end(); ++it)
 	{
-	    delete hash_ref;
-	    hash_ref = nullptr;
+	    if(*it == nullptr)
+		throw SRC_BUG;
+	    (*it)->change_permission(perm);
 	}
     }
 
@@ -135,28 +187,19 @@ namespace libdar
     {
 	if(eof)
 	    throw SRC_BUG;
-	switch(algor)
+
+	started = true;
+#ifdef LIBTHREADAR_AVAILABLE
+	if(!worker)
 	{
-	case hash_algo::none:
-	    throw SRC_BUG;
-	case hash_algo::md5:
-	case hash_algo::sha1:
-	case hash_algo::sha512:
-	case hash_algo::whirlpool:
-	case hash_algo::sha3_512:
-	case hash_algo::blake2b_512:
-#if CRYPTO_AVAILABLE
-	    gcry_md_write(hash_handle, (const void *)a, size);
+	    worker.reset(new (nothrow) digester(*this));
+	    if(!worker)
+		throw Ememory();
+	}
+	worker->feed(a, size);
 #else
-	    throw SRC_BUG;
+	hash_data(a, size);
 #endif
-	    break;
-	case hash_algo::argon2:
-	    throw SRC_BUG;
-
-	default:
-	    throw SRC_BUG;
-	}
 
 	if(!only_hash)
 	{
@@ -180,32 +223,9 @@ namespace libdar
 	    throw SRC_BUG;
 	read = ref->read(a, size);
 	message = "BUG! This should never show!";
+	started = true;
 	if(read > 0)
-	{
-	    switch(algor)
-	    {
-	    case hash_algo::none:
-		throw SRC_BUG;
-	    case hash_algo::md5:
-	    case hash_algo::sha1:
-	    case hash_algo::sha512:
-	    case hash_algo::whirlpool:
-	    case hash_algo::sha3_512:
-	    case hash_algo::blake2b_512:
-#if CRYPTO_AVAILABLE
-		gcry_md_write(hash_handle, (const void *)a, read);
-
-#else
-		throw SRC_BUG;
-#endif
-		break;
-	    case hash_algo::argon2:
-		throw SRC_BUG;
-
-	    default:
-		throw SRC_BUG;
-	    }
-	}
+	    hash_data(a, read);
 	return true;
     }
 
@@ -214,45 +234,40 @@ namespace libdar
 	ref->terminate();
 	if(!hash_dumped)
 	{
-	    unsigned char *digest = nullptr;
-	    U_I digest_size = 0;
-
 		// avoids subsequent writings (yeld a bug report if that occurs)
 	    eof = true;
 		// avoid a second run of dump_hash()
 	    hash_dumped = true;
 	    try
 	    {
-		switch(algor)
+#ifdef LIBTHREADAR_AVAILABLE
+		if(worker)
 		{
-		case hash_algo::none:
-		    throw SRC_BUG;
-
-		case hash_algo::md5:
-		case hash_algo::sha1:
-		case hash_algo::sha512:
-		case hash_algo::whirlpool:
-		case hash_algo::sha3_512:
-		case hash_algo::blake2b_512:
-#if CRYPTO_AVAILABLE
-			// first we obtain the hash result;
-		    digest = gcry_md_read(hash_handle, hash_gcrypt);
-		    digest_size = gcry_md_get_algo_dlen(hash_gcrypt);
-#else
-		    throw SRC_BUG;
-#endif
-		    break;
-		case hash_algo::argon2:
-		    throw SRC_BUG;
-		default:
-		    throw SRC_BUG;
+		    worker->finish(); // rethrows exception met by the thread if any
+		    worker.reset();
 		}
-
+#endif
 
 		if(aborting_write)
 		    get_ui().printf(gettext("No data will be written to the hash file for %S due to the interruption of the write operation (disk full)"), &ref_filename);
-		else
-		    write_hash_in_hexa(digest, digest_size);
+		else if(!cancelled)
+		{
+		    if(algor.size() != hash_ref.size())
+			throw SRC_BUG;
+
+		    for(U_I i = 0; i < algor.size(); ++i)
+		    {
+#if CRYPTO_AVAILABLE
+			U_I hash_gcrypt = hash_algo_to_gcrypt_hash(algor[i]);
+
+			write_hash_in_hexa(hash_ref[i],
+					   gcry_md_read(hash_handle, hash_gcrypt),
+					   gcry_md_get_algo_dlen(hash_gcrypt));
+#else
+			throw SRC_BUG;
+#endif
+		    }
+		}
 
 		    // no #else clause (routine used from constructor, if binary lack support
 		    // for strong encryption this has already been returned to the user
@@ -260,63 +275,39 @@ namespace libdar
 	    }
 	    catch(...)
 	    {
-		switch(algor)
-		{
-		case hash_algo::none:
-		    break;
-		case hash_algo::md5:
-		case hash_algo::sha1:
-		case hash_algo::sha512:
-		case hash_algo::whirlpool:
-		case hash_algo::sha3_512:
-		case hash_algo::blake2b_512:
 #if CRYPTO_AVAILABLE
-		    gcry_md_close(hash_handle);
+		gcry_md_close(hash_handle);
 #endif
-		    break;
-		case hash_algo::argon2:
-		    break;
-		default:
-		    break;
-		}
-
 		throw;
 	    }
-	    switch(algor)
-	    {
-	    case hash_algo::none:
-		break;
-	    case hash_algo::md5:
-	    case hash_algo::sha1:
-	    case hash_algo::sha512:
-	    case hash_algo::whirlpool:
-	    case hash_algo::sha3_512:
-	    case hash_algo::blake2b_512:
 #if CRYPTO_AVAILABLE
-		gcry_md_close(hash_handle);
+	    gcry_md_close(hash_handle);
 #endif
-		break;
-	    case hash_algo::argon2:
-		break;
-	    default:
-		break;
-	    }
 	}
     }
 
-    void hash_fichier::write_hash_in_hexa(void const* digest, U_I digest_size)
+    void hash_fichier::hash_data(const char *a, U_I size)
+    {
+#if CRYPTO_AVAILABLE
+	gcry_md_write(hash_handle, (const void *)a, size);
+#else
+	throw SRC_BUG;
+#endif
+    }
+
+    void hash_fichier::write_hash_in_hexa(fichier_global *hash_file, void const* digest, U_I digest_size)
     {
 	try
 	{
 	    string hexa = tools_string_to_hexa(string((char *)digest, digest_size));
 
-	    if(hash_ref == nullptr)
+	    if(hash_file == nullptr)
 		throw SRC_BUG;
-	    hash_ref->write((const char *)hexa.c_str(), hexa.size());
-	    hash_ref->write("  ", 2); // two spaces sperator used by md5sum and sha1sum
-	    hash_ref->write(ref_filename.c_str(), ref_filename.size());
-	    hash_ref->write("\n", 1); // we finish by a new-line character
-	    hash_ref->terminate();
+	    hash_file->write((const char *)hexa.c_str(), hexa.size());
+	    hash_file->write("  ", 2); // two spaces sperator used by md5sum and sha1sum
+	    hash_file->write(ref_filename.c_str(), ref_filename.size());
+	    hash_file->write("\n", 1); // we finish by a new-line character
+	    hash_file->terminate();
 	}
 	catch(Egeneric & e)
 	{
@@ -324,5 +315,65 @@ namespace libdar
 	}
     }
 
+    U_I hash_fichier::get_gcrypt_algo(hash_algo algo)
+    {
+	switch(algo)
+	{
+	case hash_algo::none:
+	    throw SRC_BUG;
+
+	case hash_algo::md5:
+	case hash_algo::sha1:
+	case hash_algo::sha512:
+	case hash_algo::whirlpool:
+	case hash_algo::sha3_512:
+	case hash_algo::blake2b_512:
+#if CRYPTO_AVAILABLE
+	    {
+		gcry_error_t err;
+		U_I hash_gcrypt = hash_algo_to_gcrypt_hash(algo);
+
+		err = gcry_md_test_algo(hash_gcrypt);
+		if(err != GPG_ERR_NO_ERROR)
+		    throw Erange(tools_printf(gettext("Error while initializing hash: Hash algorithm not available in libgcrypt: %s/%s"),
+					      gcry_strsource(err),
+					      gcry_strerror(err)));
+		return hash_gcrypt;
+	    }
+#else
+	    throw Ecompilation(tools_printf(gettext("Missing %s hash algorithm support (provided with strong encryption support, using libgcrypt)"),
+					    hash_algo_to_string(algo).c_str()));
+#endif
+
+	case hash_algo::argon2:
+	    throw SRC_BUG;
+
+	default:
+	    throw SRC_BUG;
+	}
+    }
+
+#ifdef LIBTHREADAR_AVAILABLE
+
+    hash_fichier::digester::digester(hash_fichier & owner):
+	tampon_consumer(DIGESTER_BLOCKS, DIGESTER_BLOCK_SIZE),
+	me(owner)
+    {
+	run();
+    }
+
+    hash_fichier::digester::~digester()
+    {
+	try
+	{
+	    finish();
+	}
+	catch(...)
+	{
+		// ignore all exceptions
+	}
+    }
+
+#endif
 
 } // end of namespace
@@ -26,6 +26,10 @@
     /// This is an inherited class from class fichier
     /// Objects of that class are write-only objects that provide a hash of the written data
     /// other hash algorithm may be added in the future
+    ///
+    /// Several hash algorithms can be computed at once, each result being dropped to its
+    /// own hash file. When libthreadar is available, the hashes of the written data are
+    /// computed by a separated thread while the data is written to the underlying file.
 
 #ifndef HASH_FICHIER_HPP
 #define HASH_FICHIER_HPP
@@ -43,11 +47,17 @@ extern "C"
 }
 
 #include <string>
+#include <deque>
+#include <memory>
 
 #include "fichier_global.hpp"
 #include "integers.hpp"
 #include "archive_aux.hpp"
 
+#ifdef LIBTHREADAR_AVAILABLE
+#include "tampon_thread.hpp"
+#endif
+
 namespace libdar
 {
 
@@ -90,9 +100,17 @@ namespace libdar
 	    /// destructor
 	~hash_fichier();
 
+	    /// compute an additional hash in the same pass over the data
+
+	    /// \param[in] hash_file points to an object where to drop the additional hash file once writings are finished
+	    /// \param[in] algo hash algorithm to use. hash_none is not an acceptable value
+	    /// \note must be called before any data is read or written. If the call succeed the object
+	    /// pointed to by hash_file is owned and deleted by this hash_file object
+	void add_hash(fichier_global *hash_file, hash_algo algo);
+
 	    // inherited from fichier_global
-	virtual void change_ownership(const std::string & user, const std::string & group) override { if(ref == nullptr || hash_ref == nullptr) throw SRC_BUG; ref->change_ownership(user, group); hash_ref->change_ownership(user, group); };
-	virtual void change_permission(U_I perm) override { if(ref == nullptr || hash_ref == nullptr) throw SRC_BUG; ref->change_permission(perm); hash_ref->change_permission(perm); };
+	virtual void change_ownership(const std::string & user, const std::string & group) override;
+	virtual void change_permission(U_I perm) override;
 	virtual infinint get_size() const override { if(ref == nullptr) throw SRC_BUG; return ref->get_size(); };
 	virtual void fadvise(advise adv) const override { if(ref == nullptr) throw SRC_BUG; ref->fadvise(adv); };
 
@@ -104,6 +122,11 @@ namespace libdar
 	virtual bool truncatable(const infinint & pos) const override { return false; };
 	virtual infinint get_position() const override { if(ref == nullptr) throw SRC_BUG; return ref->get_position(); };
 
+	    /// no hash file is written when the object is terminated
+
+	    /// \note to be used when the object is destroyed because of an error met while it was being set up
+	void cancel_hash() { cancelled = true; };
+
 	    /// for debugging purposes only
 	void set_only_hash() { only_hash = true; };
 
@@ -120,20 +143,48 @@ namespace libdar
 	virtual void inherited_terminate() override;
 
     private:
+#ifdef LIBTHREADAR_AVAILABLE
+	    /// thread computing the hashes of the written data
+
+	class digester: public tampon_consumer
+	{
+	public:
+	    digester(hash_fichier & owner);
+	    digester(const digester & ref) = delete;
+	    digester(digester && ref) noexcept = delete;
+	    digester & operator = (const digester & ref) = delete;
+	    digester & operator = (digester && ref) noexcept = delete;
+	    ~digester();
+
+	protected:
+	    virtual void consume(const char *a, U_I size) override { me.hash_data(a, size); };
+
+	private:
+	    hash_fichier & me;
+	};
+
+	std::unique_ptr<digester> worker; ///< hash computation thread (write mode only)
+#endif
+
 	fichier_global *ref;
-	fichier_global *hash_ref;
+	std::deque<fichier_global *> hash_ref; ///< where to drop each hash, same order as algor
 	bool only_hash; ///< if set, avoids copying data to file, only compute hash (debugging purpose)
 #if CRYPTO_AVAILABLE
-	gcry_md_hd_t hash_handle;
+	gcry_md_hd_t hash_handle; ///< a single handle computes all the hash algorithms at once
 #endif
 	std::string ref_filename;
-	U_I hash_gcrypt;
 	bool eof;
 	bool hash_dumped;
-	hash_algo algor;
+	bool started;   ///< whether data has already been hashed
+	std::deque<hash_algo> algor;
 	bool aborting_write;
+	bool cancelled; ///< set by cancel_hash()
+
+	void hash_data(const char *a, U_I size);
+	void write_hash_in_hexa(fichier_global *hash_file, void const* digest, U_I digest_size);
 
-	void write_hash_in_hexa(void const* digest, U_I digest_size);
+	    /// return the libgcrypt value of the algo or throw an exception if not available
+	static U_I get_gcrypt_algo(hash_algo algo);
     };
 
 	/// @}
@@ -132,7 +132,7 @@ namespace libdar
 	string sym_str = get_sym_crypto_name();
 	string asym = get_asym_crypto_name();
 	string xsigned = is_signed() ? gettext("yes") : gettext("no");
-	string kdf_iter = deci(iteration_count).human();
+	string kdf_iter = deci::to_string(iteration_count);
 	string hashing = hash_algo_to_string(kdf_hash);
 
 	dialog.printf(gettext("Archive version format               : %s"), get_edition().display().c_str());
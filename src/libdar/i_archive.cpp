@@ -70,7 +70,7 @@ namespace libdar
     static bool local_check_dirty_seq(escape *ptr);
 
     static void check_libgcrypt_hash_bug(user_interaction & dialog,
-					 hash_algo hash,
+					 const deque<hash_algo> & hash,
 					 const infinint & first_file_size,
 					 const infinint & file_size);
 
@@ -89,6 +89,7 @@ namespace libdar
 	    throw Ememory();
 
 	cat = nullptr;
+	streamed_catalogue = false;
 	live_crypto_bs = options.get_crypto_size();
 	live_pass = options.get_crypto_pass();
 
@@ -107,6 +108,10 @@ namespace libdar
 	    sequential_read = options.get_sequential_read(); // updating the archive object's field
 	    where->set_location(chem);
 
+	    if(options.get_streaming_catalogue()
+	       && (options.get_sequential_read() || options.is_external_catalogue_set()))
+		throw Erange(gettext("Streaming the catalogue of an archive of reference is not possible in sequential read mode nor with an isolated catalogue"));
+
 	    try
 	    {
 
@@ -257,6 +262,9 @@ namespace libdar
 		    throw Erange(gettext("header only mode asked"));
 		}
 
+		if(options.get_layer_statistics())
+		    stack.set_statistics(options.get_layer_statistics());
+
 		pdesc = pile_descriptor(&stack);
 
 		if(options.is_external_catalogue_set())
@@ -281,7 +289,8 @@ namespace libdar
 								   local_cat_size,
 								   ref_second_terminateur_offset,
 								   tmp2_signatories,
-								   false); // never relaxed checking for external catalogue
+								   false, // never relaxed checking for external catalogue
+								   options.get_multi_threaded_compress());
 		    if(!same_signatories(tmp1_signatories, tmp2_signatories))
 			dialog->pause(gettext("Archive of reference is not signed properly (not the same signatories for the archive and the internal catalogue), do we continue?"));
 		    if(cat == nullptr)
@@ -319,7 +328,9 @@ namespace libdar
 			if(!options.get_sequential_read())
 			{
 			    if(info_details)
-				dialog->message(gettext("Loading catalogue into memory..."));
+				dialog->message(options.get_streaming_catalogue()
+						? gettext("Loading catalogue skeleton into memory...")
+						: gettext("Loading catalogue into memory..."));
 			    cat = macro_tools_get_catalogue_from(dialog,
 								 stack,
 								 ver,
@@ -327,7 +338,14 @@ namespace libdar
 								 local_cat_size,
 								 second_term_offset,
 								 tmp1_signatories,
-								 options.get_lax());
+								 options.get_lax(),
+								 options.get_multi_threaded_compress(),
+								 options.get_streaming_catalogue());
+			    if(options.get_streaming_catalogue())
+			    {
+				streamed_cat_start = macro_tools_get_catalogue_start(stack, ver);
+				streamed_catalogue = true;
+			    }
 			    if(!same_signatories(tmp1_signatories, gnupg_signed))
 			    {
 				string msg = gettext("Archive internal catalogue is not identically signed as the archive itself, this might be the sign the archive has been compromised");
@@ -360,7 +378,8 @@ namespace libdar
 								     tmp1_signatories,
 								     options.get_lax(),
 								     lab,
-								     false); // only_detruits
+								     false, // only_detruits
+								     options.get_multi_threaded_compress());
 
 				    if(!same_signatories(tmp1_signatories, gnupg_signed))
 				    {
@@ -492,6 +511,7 @@ namespace libdar
         try
         {
 	    cat = nullptr;
+	    streamed_catalogue = false;
 
 	    shared_ptr<entrepot> sauv_path_t = options.get_entrepot();
 	    if(!sauv_path_t)
@@ -510,6 +530,19 @@ namespace libdar
 	       && options.get_reference().get()->pimpl->cat->get_early_memory_release())
 		throw Erange(gettext("Early memory release is not possible for a backup of reference"));
 
+	    layer_stats = options.get_layer_statistics();
+
+	    spill_dir = options.get_spill_directory();
+	    if(!spill_dir.empty())
+	    {
+		if(options.get_reference()
+		   && options.get_reference()->pimpl != nullptr
+		   && !options.get_reference()->pimpl->streamed_catalogue)
+		    throw Erange(gettext("Spilling the catalogue to disk requires the catalogue of the archive of reference to be streamed"));
+		if(options.get_delta_signature())
+		    throw Erange(gettext("Spilling the catalogue to disk is not possible when delta signature is requested"));
+	    }
+
 	    try
 	    {
 		sequential_read = false; // updating the archive field
@@ -537,6 +570,7 @@ namespace libdar
 				   options.get_first_slice_size(),
 				   options.get_ea_mask(),
 				   options.get_execute(),
+				   options.get_async_execute(),
 				   options.get_crypto_algo(),
 				   options.get_crypto_pass(),
 				   options.get_crypto_size(),
@@ -562,7 +596,7 @@ namespace libdar
 				   options.get_security_check(),
 				   options.get_sparse_file_min_size(),
 				   options.get_user_comment(),
-				   options.get_hash_algo(),
+				   options.get_hash_algos(),
 				   options.get_slice_min_digits(),
 				   options.get_backup_hook_file_execute(),
 				   options.get_backup_hook_file_mask(),
@@ -623,6 +657,7 @@ namespace libdar
 	shared_ptr<entrepot> sauv_path_t = options.get_entrepot();
 
 	cat = nullptr;
+	streamed_catalogue = false;
 
 	try
 	{
@@ -645,7 +680,7 @@ namespace libdar
 		if(options.get_crypto_size() < 10 && options.get_crypto_algo() != crypto_algo::none)
 		    throw Elibcall(gettext("Crypto block size must be greater than 10 bytes"));
 
-		check_libgcrypt_hash_bug(get_ui(), options.get_hash_algo(), options.get_first_slice_size(), options.get_slice_size());
+		check_libgcrypt_hash_bug(get_ui(), options.get_hash_algos(), options.get_first_slice_size(), options.get_slice_size());
 
 		if(ref_arch1)
 		    if(ref_arch1->pimpl->only_contains_an_isolated_catalogue())
@@ -669,6 +704,10 @@ namespace libdar
 						    options.get_warn_over(),
 						    options.get_empty());
 
+		if((ref_arch1 != nullptr && ref_arch1->pimpl->streamed_catalogue)
+		   || (ref_arch2 && ref_arch2->pimpl->streamed_catalogue))
+		    throw Erange(gettext("The catalogue of this archive is streamed, the archive can only be used as reference for a differential backup"));
+
 		if(ref_arch1 == nullptr)
 		    if(!ref_arch2)
 			throw Elibcall(string(gettext("Both reference archive are nullptr, cannot merge archive from nothing")));
@@ -754,6 +793,7 @@ namespace libdar
 				 sauv_path_t,
 				 ref_cat1,
 				 ref_cat2,
+				 nullptr, // ref_stream
 				 false,  // initial_pause
 				 options.get_selection(),
 				 options.get_subtree(),
@@ -776,6 +816,7 @@ namespace libdar
 				 options.get_first_slice_size(),
 				 options.get_ea_mask(),
 				 options.get_execute(),
+				 options.get_async_execute(),
 				 options.get_crypto_algo(),
 				 options.get_crypto_pass(),
 				 options.get_crypto_size(),
@@ -803,7 +844,7 @@ namespace libdar
 				 false,   // security_check
 				 options.get_sparse_file_min_size(),
 				 options.get_user_comment(),
-				 options.get_hash_algo(),
+				 options.get_hash_algos(),
 				 options.get_slice_min_digits(),
 				 "",      // backup_hook_file_execute
 				 bool_mask(false),         // backup_hook_file_mask
@@ -869,6 +910,7 @@ namespace libdar
 	    // stack will be set by op_create_in_sub()
 	    // ver will be set by op_create_in_sub()
 	cat = nullptr; // will be set by op_create_in_sub()
+	streamed_catalogue = false;
 	exploitable = false;
 	lax_read_mode = false;
 	sequential_read = false;
@@ -923,6 +965,7 @@ namespace libdar
 			     sauv_path_t,
 			     src.pimpl->cat,      // ref1
 			     nullptr,             // ref2
+			     nullptr,             // ref_stream
 			     initial_pause,
 			     bool_mask(true),     // selection
 			     bool_mask(true),     // subtree
@@ -945,6 +988,7 @@ namespace libdar
 			     options_repair.get_first_slice_size(),
 			     bool_mask(true),     // ea_mask
 			     options_repair.get_execute(),
+			     options_repair.get_async_execute(),
 			     options_repair.get_crypto_algo(),
 			     options_repair.get_crypto_pass(),
 			     options_repair.get_crypto_size(),
@@ -972,7 +1016,7 @@ namespace libdar
 			     false,               // security_check
 			     0,                   // sparse_file_min_size (disabling hole detection)
 			     options_repair.get_user_comment(),
-			     options_repair.get_hash_algo(),
+			     options_repair.get_hash_algos(),
 			     options_repair.get_slice_min_digits(),
 			     "",                  // backup_hook_file_execute
 			     bool_mask(true),     // backup_hook_file_mask
@@ -1086,7 +1130,9 @@ namespace libdar
 			       options.get_only_deleted(),
 			       options.get_ignore_deleted(),
 			       options.get_fsa_scope(),
-			       options.get_ignore_unix_sockets());
+			       options.get_ignore_unix_sockets(),
+			       options.get_restore_writers(),
+			       options.get_dir_journal());
 	    }
 	    catch(Euser_abort & e)
 	    {
@@ -1735,6 +1781,7 @@ namespace libdar
 				      options.get_slice_size(),
 				      options.get_first_slice_size(),
 				      options.get_execute(),
+				      options.get_async_execute(),
 				      options.get_crypto_algo(),
 				      options.get_crypto_pass(),
 				      options.get_crypto_size(),
@@ -1744,7 +1791,7 @@ namespace libdar
 				      options.get_slice_permission(),
 				      options.get_sequential_marks(),
 				      options.get_user_comment(),
-				      options.get_hash_algo(),
+				      options.get_hash_algos(),
 				      options.get_slice_min_digits(),
 				      internal_name,
 				      isol_data_name,
@@ -1962,6 +2009,51 @@ namespace libdar
 	return ret;
     }
 
+    U_I archive::i_archive::get_children_in_columns(const string & dir,
+						    list_columns & batch,
+						    U_I start,
+						    U_I max_entries) const
+    {
+	i_archive* me = const_cast<i_archive *>(this);
+	U_I ret = 0;
+
+	if(me == nullptr)
+	    throw SRC_BUG;
+
+	if(cat != nullptr && cat->get_early_memory_release())
+	    throw Erange(gettext("get_children_in_columns is not possible on a catalogue set with early memory release"));
+
+	me->load_catalogue(false);
+
+	const cat_directory* parent = get_dir_object(dir);
+	U_I num = 0;
+
+	if(parent == nullptr)
+	    throw SRC_BUG;
+
+	batch.clear();
+	parent->get_dir_size().unstack(num);
+	    // if the directory has more entries than U_I can hold, the
+	    // remaining ones cannot be reached with a U_I start index anyway
+	if(start >= num)
+	    return 0;
+	num -= start;
+	if(max_entries > 0 && max_entries < num)
+	    num = max_entries;
+	batch.reserve(num);
+
+	ret = parent->for_each_children(start,
+					num,
+					[&batch](const cat_nomme *child)
+					{
+					    if(child == nullptr)
+						throw SRC_BUG;
+					    batch.add(*child);
+					});
+
+	return ret;
+    }
+
     bool archive::i_archive::has_subdirectory(const string & dir) const
     {
 	bool ret = false;
@@ -2012,14 +2104,34 @@ namespace libdar
 	if(cat == nullptr)
 	    throw SRC_BUG;
 
+	if(streamed_catalogue)
+	    throw Erange(gettext("The catalogue of this archive is streamed, the archive can only be used as reference for a differential backup"));
+
+	if(cat->has_spilled_entries())
+	    throw Erange(gettext("Part of the catalogue of this archive has been spilled to disk while it was created, the archive has to be opened again to read its content"));
+
 	if(cat->get_memory_released())
 	    throw Erange(gettext("cannot get catalogue which memory has been (early) released"));
 
 	return *cat;
     }
 
+    const catalogue & archive::i_archive::get_cat() const
+    {
+	if(cat == nullptr)
+	    throw SRC_BUG;
+	if(streamed_catalogue)
+	    throw Erange(gettext("The catalogue of this archive is streamed, the archive can only be used as reference for a differential backup"));
+	if(cat->has_spilled_entries())
+	    throw Erange(gettext("Part of the catalogue of this archive has been spilled to disk while it was created, the archive has to be opened again to read its content"));
+	return *cat;
+    }
+
     void archive::i_archive::drop_all_filedescriptors(bool repairing)
     {
+	if(streamed_catalogue)
+	    throw Erange(gettext("Cannot drop the file descriptors of an archive which catalogue is streamed, they are needed to read it"));
+
 	if(exploitable && sequential_read)
 	{
 	    if(only_contains_an_isolated_catalogue())
@@ -2135,6 +2247,7 @@ namespace libdar
 						const infinint & first_file_size,
 						const mask & ea_mask,
 						const string & execute,
+						U_I async_execute,
 						crypto_algo crypto,
 						const secu_string & pass,
 						U_32 crypto_size,
@@ -2160,7 +2273,7 @@ namespace libdar
 						bool security_check,
 						const infinint & sparse_file_min_size,
 						const string & user_comment,
-						hash_algo hash,
+						const deque<hash_algo> & hash,
 						const infinint & slice_min_digits,
 						const string & backup_hook_file_execute,
 						const mask & backup_hook_file_mask,
@@ -2205,6 +2318,7 @@ namespace libdar
             // end of sanity checks
 
 	catalogue *ref_cat = nullptr;
+	unique_ptr<catalogue_stream> ref_stream;
 	bool initial_pause = false;
 	path sauv_path_abs = sauv_path_t->get_location();
 	path fs_root_abs = fs_root.is_relative() ? tools_relative2absolute_path(fs_root, tools_getcwd()) : fs_root;
@@ -2268,7 +2382,31 @@ namespace libdar
 	    const shared_ptr<entrepot> ref_where = ref_arch->pimpl->get_entrepot();
 	    if(ref_where)
 		initial_pause = (*ref_where == *sauv_path_t);
-	    ref_cat = const_cast<catalogue *>(& ref_arch->pimpl->get_catalogue());
+	    if(ref_arch->pimpl->streamed_catalogue)
+	    {
+		if(op != oper_create)
+		    throw SRC_BUG;
+		if(delta_signature)
+		    throw Erange(gettext("Cannot stream the catalogue of the archive of reference when delta signature is requested"));
+		delta_diff = false; // delta signatures of the archive of reference are not available
+		if(!fixed_date.is_zero())
+		    throw Erange(gettext("Cannot stream the catalogue of the archive of reference when a fixed date is given"));
+		if(ref_arch->pimpl->cat == nullptr)
+		    throw SRC_BUG;
+		ref_cat = ref_arch->pimpl->cat;
+		ref_stream.reset(new (nothrow) catalogue_stream(get_pointer(),
+								*ref_cat,
+								ref_arch->pimpl->stack,
+								ref_arch->pimpl->streamed_cat_start,
+								ref_arch->pimpl->ver.get_edition(),
+								ref_arch->pimpl->ver.get_compression_algo(),
+								fs_root,
+								display_treated));
+		if(!ref_stream)
+		    throw Ememory();
+	    }
+	    else
+		ref_cat = const_cast<catalogue *>(& ref_arch->pimpl->get_catalogue());
 	}
 
 	op_create_in_sub(op,
@@ -2276,6 +2414,7 @@ namespace libdar
 			 sauv_path_t,
 			 ref_cat,
 			 nullptr,
+			 ref_stream.get(),
 			 initial_pause,
 			 selection,
 			 subtree,
@@ -2298,6 +2437,7 @@ namespace libdar
 			 first_file_size,
 			 ea_mask,
 			 execute,
+			 async_execute,
 			 crypto,
 			 pass,
 			 crypto_size,
@@ -2356,6 +2496,7 @@ namespace libdar
 					      const shared_ptr<entrepot> & sauv_path_t,
 					      catalogue *ref_cat1,
 					      const catalogue *ref_cat2,
+					      catalogue_stream *ref_stream,
 					      bool initial_pause,
 					      const mask & selection,
 					      const mask & subtree,
@@ -2378,6 +2519,7 @@ namespace libdar
 					      const infinint & first_file_size,
 					      const mask & ea_mask,
 					      const string & execute,
+					      U_I async_execute,
 					      crypto_algo crypto,
 					      const secu_string & pass,
 					      U_32 crypto_size,
@@ -2405,7 +2547,7 @@ namespace libdar
 					      bool security_check,
 					      const infinint & sparse_file_min_size,
 					      const string & user_comment,
-					      hash_algo hash,
+					      const deque<hash_algo> & hash,
 					      const infinint & slice_min_digits,
 					      const string & backup_hook_file_execute,
 					      const mask & backup_hook_file_mask,
@@ -2472,6 +2614,7 @@ namespace libdar
 					  file_size,
 					  first_file_size,
 					  execute,
+					  async_execute,
 					  crypto,
 					  pass,
 					  crypto_size,
@@ -2494,6 +2637,9 @@ namespace libdar
 					  sl_header // this object field is set!
 		    );
 
+		if(layer_stats)
+		    stack.set_statistics(layer_stats);
+
 		    // ********** building the catalogue (empty for now) ************************* //
 		datetime root_mtime;
 		pile_descriptor pdesc(&stack);
@@ -2547,6 +2693,9 @@ namespace libdar
 		if(cat == nullptr)
 		    throw Ememory();
 
+		if(op == oper_create && !spill_dir.empty())
+		    cat->set_spill_directory(spill_dir);
+
 
 		    // *********** now we can perform the data filtering operation (adding data to the archive) *************** //
 
@@ -2644,7 +2793,8 @@ namespace libdar
 					      sig_block_len,
 					      sig_magic,
 					      never_resave_uncompressed,
-					      sequential_read);
+					      sequential_read,
+					      ref_stream);
 				// build_delta_sig is not used for archive creation it is always implied when delta_signature is set
 			}
 			catch(...)
@@ -2806,7 +2956,18 @@ namespace libdar
 		    }
 		}
 
-		if(ref_cat1 != nullptr && op == oper_create)
+		if(ref_stream != nullptr)
+		{
+			// files destroyed since the reference backup have been recorded while the filesystem was walked
+			// only the end of the root directory remains to be compared. When aborting, the entries of the
+			// archive of reference not yet read are not known, they cannot be added to the catalogue
+		    if(!aborting)
+		    {
+			ref_stream->finish();
+			st_ptr->add_to_deleted(ref_stream->get_destroyed());
+		    }
+		}
+		else if(ref_cat1 != nullptr && op == oper_create)
 		{
 		    if(info_details)
 			get_ui().message(gettext("Adding reference to files that have been destroyed since reference backup..."));
@@ -3088,12 +3249,12 @@ namespace libdar
     }
 
     static void check_libgcrypt_hash_bug(user_interaction & dialog,
-					 hash_algo hash,
+					 const deque<hash_algo> & hash,
 					 const infinint & first_file_size,
 					 const infinint & file_size)
     {
 #if CRYPTO_AVAILABLE
-	if(hash != hash_algo::none && !crypto_min_ver_libgcrypt_no_bug())
+	if(!hash.empty() && !crypto_min_ver_libgcrypt_no_bug())
 	{
 	    const infinint limit = tools_get_extended_size("256G", 1024);
 	    if(file_size >= limit || first_file_size >= limit)
@@ -29,6 +29,7 @@
 
 #include "../my_config.h"
 #include <vector>
+#include <deque>
 #include <string>
 #include <memory>
 
@@ -44,6 +45,7 @@
 #include "archive_summary.hpp"
 #include "archive_listing_callback.hpp"
 #include "catalogue.hpp"
+#include "catalogue_stream.hpp"
 #include "archive.hpp"
 #include "header_version.hpp"
 
@@ -166,6 +168,7 @@ namespace libdar
 	    /// getting information about the given directory (alternative to get_children_of)
 
 	const std::vector<list_entry> get_children_in_table(const std::string & dir, bool fetch_ea = false) const;
+	U_I get_children_in_columns(const std::string & dir, list_columns & batch, U_I start, U_I max_entries) const;
 
 	    /// returns true if the pointed directory has one or more subdirectories
 	bool has_subdirectory(const std::string & dir) const;
@@ -228,17 +231,21 @@ namespace libdar
 	bool exploitable;        ///< is false if only the catalogue is available (for reference backup or isolation).
 	bool lax_read_mode;      ///< whether the archive has been openned in lax mode (unused for creation/merging/isolation)
 	bool sequential_read;    ///< whether the archive is read in sequential mode
+	bool streamed_catalogue; ///< whether only the skeleton of the catalogue is in memory (the archive can only be used as reference for a backup)
+	infinint streamed_cat_start; ///< offset of the catalogue in stack (meaningful if streamed_catalogue is set)
 	std::list<signator> gnupg_signed; ///< list of signature found in the archive (reading an existing archive)
 	slice_header sl_header;  ///< slice header of the "level1" of the archive (sar, trivial_sar, zapette...)
 	infinint second_term_offset; ///< offset of the data never ciphered at end of achive (zero if not yet known)
 
 	U_32 live_crypto_bs;     ///< this fields is never written to file but left available to feed a dar_manager database when needed
 	secu_string live_pass;   ///< this fields is never written to file but left available to feed a dar_manager database when needed
+	std::shared_ptr<layer_statistics> layer_stats; ///< where to record the activity of the layers of an archive being created (nullptr if not recorded)
+	std::string spill_dir;   ///< where to spill the catalogue under construction (empty string to keep it in memory)
 
 	void free_mem();
 	void check_gnupg_signed() const;
 
-	const catalogue & get_cat() const { if(cat == nullptr) throw SRC_BUG; else return *cat; };
+	const catalogue & get_cat() const;
 	const header_version & get_header() const { return ver; };
 
 	bool get_sar_param(infinint & sub_file_size,
@@ -273,6 +280,7 @@ namespace libdar
 				const infinint & first_file_size,
 				const mask & ea_mask,
 				const std::string & execute,
+				U_I async_execute,
 				crypto_algo crypto,
 				const secu_string & pass,
 				U_32 crypto_size,
@@ -298,7 +306,7 @@ namespace libdar
 				bool security_check,
 				const infinint & sparse_file_min_size,
 				const std::string & user_comment,
-				hash_algo hash,
+				const std::deque<hash_algo> & hash,
 				const infinint & slice_min_digits,
 				const std::string & backup_hook_file_execute,
 				const mask & backup_hook_file_mask,
@@ -326,6 +334,7 @@ namespace libdar
 			      const std::shared_ptr<entrepot> & sauv_path_t,     ///< where to create the archive
 			      catalogue * ref_cat1,             ///< catalogue of the archive of reference, (cannot be nullptr if ref_cat2 is not nullptr)
 			      const catalogue * ref_cat2,       ///< secondary catalogue used for merging, can be nullptr if not used
+			      catalogue_stream * ref_stream,    ///< when not nullptr, the streamed catalogue of reference (ref_cat1 being its skeleton)
 			      bool initial_pause,               ///< whether we shall pause before starting the archive creation
 			      const mask & selection,           ///< filter on filenames
 			      const mask & subtree,             ///< filter on directory tree and filenames
@@ -348,6 +357,7 @@ namespace libdar
 			      const infinint & first_file_size, ///< first slice size
 			      const mask & ea_mask,             ///< Extended Attribute to consider
 			      const std::string & execute,      ///< Command line to execute between slices
+			      U_I async_execute,                ///< max number of commands between slices to run in background (0 for synchronous execution)
 			      crypto_algo crypto,               ///< crypt algorithm
 			      const secu_string & pass,         ///< password ("" for onfly request of password)
 			      U_32 crypto_size,                 ///< size of crypto blocks
@@ -375,7 +385,7 @@ namespace libdar
 			      bool security_check,                       ///< whether to check for ctime change with no reason (rootkit ?)
 			      const infinint & sparse_file_min_size,     ///< starting which size to consider looking for holes in sparse files (0 for no detection)
 			      const std::string & user_comment,          ///< user comment to put in the archive
-			      hash_algo hash,                            ///< whether to produce hash file, and which algo to use
+			      const std::deque<hash_algo> & hash,        ///< hash algorithms to produce hash files with, none if empty
 			      const infinint & slice_min_digits,         ///< minimum digit for slice number
 			      const std::string & backup_hook_file_execute, ///< command to execute before and after files to backup
 			      const mask & backup_hook_file_mask,         ///< files elected to have a command executed before and after their backup
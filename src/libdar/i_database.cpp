@@ -44,6 +44,10 @@ extern "C"
 #include "archive.hpp"
 #include "mask_database.hpp"
 
+#ifdef LIBTHREADAR_AVAILABLE
+#include "archive_loader.hpp"
+#endif
+
 using namespace libdar;
 using namespace std;
 
@@ -67,6 +71,7 @@ namespace libdar
 	data_files = nullptr;
 	check_order_asked = true;
 	head.clear();
+	tree_in_file = false;
     }
 
     database::i_database::i_database(const shared_ptr<user_interaction> & dialog,
@@ -83,14 +88,23 @@ namespace libdar
 	try
 	{
 	    check_order_asked = opt.get_warn_order();
+	    base_filename = base;
 	    build(*f, opt.get_partial(), opt.get_partial_read_only());
+	    if(tree_in_file)
+	    {
+		    // the file tree will be read when needed
+		pending_tree.reset(f);
+		f = nullptr;
+	    }
 	}
 	catch(...)
 	{
-	    delete f;
+	    if(f != nullptr)
+		delete f;
 	    throw;
 	}
-	delete f;
+	if(f != nullptr)
+	    delete f;
     }
 
     void database::i_database::build(generic_file & f,
@@ -100,81 +114,20 @@ namespace libdar
 	NLS_SWAP_IN;
 	try
 	{
-	    struct archive_data dat;
-	    char a;
-
 	    if(head.get_version() > database_header_get_supported_version())
 		throw SRC_BUG; // we should not get there if the database is more recent than what that software can handle. this is necessary if we do not want to destroy the database or loose data.
 
-	    coordinate.clear();
-	    infinint tmp = infinint(f); // number of archive to read
-	    while(!tmp.is_zero())
-	    {
-		    // reading a new archive entry of the database:
-
-		tools_read_string(f, dat.chemin);
-		tools_read_string(f, dat.basename);
-		if(head.get_version() >= 3)
-		    dat.root_last_mod.read(f, db2archive_version(head.get_version()));
-		else
-		    dat.root_last_mod = datetime(0);
-
-		if(head.get_version() >= 7)
-		{
-		    f.read(&a, 1);
-		    dat.crypto = char_2_crypto_algo(a);
-		}
-		else
-		{
-		    dat.crypto = crypto_algo::none;
-		    dat.pass.clear();
-		    dat.crypto_size = 0; // we will use the default value archive_options
-		}
-
-		if(dat.crypto != crypto_algo::none)
-		{
-		    infinint keysize;
-		    U_I i_keysize = 0;
-
-		    keysize.read(f);
-		    keysize.unstack(i_keysize);
-		    if(!keysize.is_zero())
-			throw Erange(gettext("integer type unable to handle such too large value for archive key size in database, data corruption may have occured on disk"));
-
-		    dat.pass.clear();
-		    if(i_keysize > 0)
-		    {
-			dat.pass.resize(i_keysize + 1); // alocate data
-			dat.pass.set_size(i_keysize); // size of the key
-			f.read(dat.pass.get_array(), i_keysize);
-		    }
-
-		    keysize.read(f); // recycling keysize temporary variable to fetch crypto_size as an infinint
-		    dat.crypto_size = 0;
-		    keysize.unstack(dat.crypto_size);
-		    if(!keysize.is_zero())
-			throw Erange(gettext("integer type unable to handle such too large value for archive key size in database, data corruption may have occured on disk"));
-		}
-		else
-		{
-		    dat.crypto = crypto_algo::none;
-		    dat.pass.clear();
-		    dat.crypto_size = 0; // we will use the default value archive_options
-		}
-
-		coordinate.push_back(dat);
-		--tmp;
-	    }
-	    if(coordinate.empty())
-		throw Erange(gettext("Badly formatted database"));
-	    tools_read_vector(f, options_to_dar);
-	    tools_read_string(f, dar_path);
+	    read_front(f, coordinate, options_to_dar, dar_path);
 	    if(head.get_version() < database_header_get_supported_version())
 		partial = false;
 
+	    tree_in_file = false;
 	    if(!partial)
 	    {
-		files = data_dir::data_tree_read(f, head.get_version());
+		if(head.get_version() > database_header_last_nested_version)
+		    files = data_dir::data_tree_read_streamed(f, head.get_version(), nullptr);
+		else
+		    files = data_dir::data_tree_read(f, head.get_version());
 		if(files == nullptr)
 		    throw Ememory();
 		if(files->get_name() != PSEUDO_ROOT)
@@ -192,6 +145,7 @@ namespace libdar
 		{
 		    files = nullptr;
 		    data_files = nullptr;
+		    tree_in_file = true;
 		}
 	    }
 	}
@@ -203,6 +157,151 @@ namespace libdar
 	NLS_SWAP_OUT;
     }
 
+    void database::i_database::read_front(generic_file & f,
+					  deque<struct archive_data> & coord,
+					  vector<string> & opt,
+					  string & chemin) const
+    {
+	struct archive_data dat;
+	char a;
+
+	coord.clear();
+	infinint tmp = infinint(f); // number of archive to read
+	while(!tmp.is_zero())
+	{
+		// reading a new archive entry of the database:
+
+	    tools_read_string(f, dat.chemin);
+	    tools_read_string(f, dat.basename);
+	    if(head.get_version() >= 3)
+		dat.root_last_mod.read(f, db2archive_version(head.get_version()));
+	    else
+		dat.root_last_mod = datetime(0);
+
+	    if(head.get_version() >= 7)
+	    {
+		f.read(&a, 1);
+		dat.crypto = char_2_crypto_algo(a);
+	    }
+	    else
+	    {
+		dat.crypto = crypto_algo::none;
+		dat.pass.clear();
+		dat.crypto_size = 0; // we will use the default value archive_options
+	    }
+
+	    if(dat.crypto != crypto_algo::none)
+	    {
+		infinint keysize;
+		U_I i_keysize = 0;
+
+		keysize.read(f);
+		keysize.unstack(i_keysize);
+		if(!keysize.is_zero())
+		    throw Erange(gettext("integer type unable to handle such too large value for archive key size in database, data corruption may have occured on disk"));
+
+		dat.pass.clear();
+		if(i_keysize > 0)
+		{
+		    dat.pass.resize(i_keysize + 1); // alocate data
+		    dat.pass.set_size(i_keysize); // size of the key
+		    f.read(dat.pass.get_array(), i_keysize);
+		}
+
+		keysize.read(f); // recycling keysize temporary variable to fetch crypto_size as an infinint
+		dat.crypto_size = 0;
+		keysize.unstack(dat.crypto_size);
+		if(!keysize.is_zero())
+		    throw Erange(gettext("integer type unable to handle such too large value for archive key size in database, data corruption may have occured on disk"));
+	    }
+	    else
+	    {
+		dat.crypto = crypto_algo::none;
+		dat.pass.clear();
+		dat.crypto_size = 0; // we will use the default value archive_options
+	    }
+
+	    coord.push_back(dat);
+	    --tmp;
+	}
+	if(coord.empty())
+	    throw Erange(gettext("Badly formatted database"));
+	tools_read_vector(f, opt);
+	tools_read_string(f, chemin);
+    }
+
+    generic_file *database::i_database::open_tree() const
+    {
+	generic_file *ret = pending_tree.release();
+
+	if(!tree_in_file)
+	    throw SRC_BUG;
+
+	if(ret == nullptr)
+	{
+		// the tree has already been read once, reopening the database
+	    database_header tmp_head;
+	    deque<struct archive_data> tmp_coord;
+	    vector<string> tmp_opt;
+	    string tmp_path;
+
+	    ret = database_header_open(get_pointer(),
+				       base_filename,
+				       head.get_pass(),
+				       tmp_head,
+				       false);
+	    if(ret == nullptr)
+		throw Ememory();
+
+	    try
+	    {
+		if(tmp_head.get_version() != head.get_version())
+		    throw Erange(gettext("Database file has changed since it was opened"));
+		read_front(*ret, tmp_coord, tmp_opt, tmp_path);
+	    }
+	    catch(...)
+	    {
+		delete ret;
+		throw;
+	    }
+	}
+
+	return ret;
+    }
+
+    const data_dir *database::i_database::get_tree(const deque<path> *wanted, unique_ptr<data_dir> & holder) const
+    {
+	if(files != nullptr)
+	    return files;
+
+	if(!tree_in_file)
+	    throw SRC_BUG;
+
+	unique_ptr<generic_file> f(open_tree());
+
+	holder.reset(data_dir::data_tree_read_streamed(*f, head.get_version(), wanted));
+	if(!holder)
+	    throw Ememory();
+	holder->set_name(PSEUDO_ROOT);
+
+	return holder.get();
+    }
+
+    bool database::i_database::check_order() const
+    {
+	bool initial_warn = true;
+
+	if(check_order_asked)
+	{
+	    unique_ptr<data_dir> holder;
+	    const data_dir *root = get_tree(nullptr, holder);
+
+	    return root->check_order(get_ui(), path("."), initial_warn) && initial_warn;
+	}
+	else
+	    return true;
+    }
+
     database::i_database::~i_database()
     {
 	if(files != nullptr)
@@ -217,10 +316,18 @@ namespace libdar
 	if(files == nullptr && data_files == nullptr)
 	    throw Erange(gettext("Cannot write down a read-only database"));
 
+	database_header params = head;
+
+	if(files != nullptr)
+	    params.set_version(opt.get_legacy_format() ? database_header_last_nested_version : database_header_get_supported_version());
+	else // data_files is copied as is, partial mode is only possible with the current format
+	    if(opt.get_legacy_format())
+		throw Erange(gettext("Cannot change the format of a partially loaded database"));
+
 	generic_file *f = database_header_create(get_pointer(),
 						 filename,
 						 opt.get_overwrite(),
-						 head,
+						 params,
 						 true);
 
 	if(f == nullptr)
@@ -265,7 +372,12 @@ namespace libdar
 	    tools_write_vector(*f, options_to_dar);
 	    tools_write_string(*f, dar_path);
 	    if(files != nullptr)
-		files->dump(*f);
+	    {
+		if(opt.get_legacy_format())
+		    files->dump(*f);
+		else
+		    files->dump_streamed(*f);
+	    }
 	    else
 		if(data_files != nullptr)
 		    memory2file(*data_files, *f);
@@ -539,11 +651,19 @@ namespace libdar
 	{
 	    if(num != 0)
 		num = get_real_archive_num(num, opt.get_revert_archive_numbering());
-	    if(files == nullptr)
+	    if(files == nullptr && !tree_in_file)
 		throw SRC_BUG;
 
 	    if(num < coordinate.size())
-		files->show(callback, context, num);
+	    {
+		if(files != nullptr)
+		    files->show(callback, context, num);
+		else
+		{
+		    unique_ptr<generic_file> f(open_tree());
+		    data_dir::show_streamed(*f, head.get_version(), callback, context, num);
+		}
+	    }
 	    else
 		throw Erange(gettext("Non existent archive in database"));
 	}
@@ -564,15 +684,16 @@ namespace libdar
 	try
 	{
 	    const data_tree *ptr = nullptr;
-	    const data_dir *ptr_dir = files;
+	    const data_dir *ptr_dir = nullptr;
 	    string tmp;
-
-	    if(files == nullptr)
-		throw SRC_BUG;
+	    unique_ptr<data_dir> holder;
 
 	    if(!chemin.is_relative())
 		throw Erange(gettext("Invalid path, path must be relative"));
 
+	    deque<path> wanted(1, chemin);
+	    ptr_dir = get_tree(&wanted, holder);
+
 	    while(chemin.pop_front(tmp) && ptr_dir != nullptr)
 	    {
 		ptr = ptr_dir->read_child(tmp);
@@ -609,13 +730,12 @@ namespace libdar
 	    deque<infinint> total_data(coordinate.size(), 0);
 	    deque<infinint> total_ea(coordinate.size(), 0);
 
-	    if(files == nullptr)
-		throw SRC_BUG;
+	    unique_ptr<data_dir> holder;
 
 	    if(callback == nullptr)
 		throw Erange("nullptr provided as user callback function");
 
-	    files->compute_most_recent_stats(stats_data, stats_ea, total_data, total_ea, datetime(0));
+	    get_tree(nullptr, holder)->compute_most_recent_stats(stats_data, stats_ea, total_data, total_ea, datetime(0));
 	    try
 	    {
 		for(archive_num i = 1; i < coordinate.size(); ++i)
@@ -644,21 +764,39 @@ namespace libdar
 	    map<archive_num, vector<string> > command_line;
 	    deque<string> anneau;
 	    const data_tree *ptr;
+	    unique_ptr<data_dir> holder;
+	    const data_dir *root;
+
+	    for(vector<string>::const_iterator it = filename.begin(); it != filename.end(); ++it)
+		if(!path(*it).is_relative())
+		    throw Erange(gettext("Invalid path, path must be relative"));
 
 	    anneau.assign(filename.begin(), filename.end());
-	    if(files == nullptr)
-		throw SRC_BUG;
+	    if(files != nullptr)
+		root = files;
+	    else
+	    {
+		deque<path> wanted;
+
+		for(vector<string>::const_iterator it = filename.begin(); it != filename.end(); ++it)
+		    wanted.push_back(path(*it));
+		root = get_tree(&wanted, holder);
+	    }
 
 	    if(opt.get_info_details())
 		get_ui().message(gettext("Checking chronological ordering of files between the archives..."));
-	    check_order();
+	    if(check_order_asked)
+	    {
+		bool initial_warn = true;
+		(void)root->check_order(get_ui(), path("."), initial_warn);
+	    }
 
 		// determination of the archives to restore and files to restore for each selected file
 	    while(!anneau.empty())
 	    {
-		if(files == nullptr)
+		if(root == nullptr)
 		    throw SRC_BUG;
-		if(files->data_tree_find(anneau.front(), ptr))
+		if(root->data_tree_find(anneau.front(), ptr))
 		{
 		    const data_dir *ptr_dir = dynamic_cast<const data_dir *>(ptr);
 		    set<archive_num> num_data;
@@ -778,6 +916,8 @@ namespace libdar
 		    delete files;
 		    files = nullptr;
 		}
+		holder.reset();
+		root = nullptr;
 	    }
 
 		// calling dar for each archive
@@ -875,12 +1015,12 @@ namespace libdar
 	if(opt.get_info_details())
 	    get_ui().message(gettext("Identifying the set of archive to use from the dar_manager database..."));
 
-	if(files == nullptr)
-	    throw SRC_BUG;
+	unique_ptr<data_dir> holder;
+	const data_dir *root = get_tree(nullptr, holder);
 
 	    //*** ANDING the subdir mask of extract_option with a mask_database from us
 
-	mask_database mask_building = mask_database(files, fs_root, opt.get_date());
+	mask_database mask_building = mask_database(root, fs_root, opt.get_date());
 
 	mask_building.compose_with(extract_options.get_subtree());
 	extract_options.set_subtree(mask_building);
@@ -898,44 +1038,97 @@ namespace libdar
 
 	    //*** for each archive_num
 
-	for(set<archive_num>::iterator it = to_consider.begin(); it != to_consider.end(); ++it)
+	    // the archives are restored one after the other in the increasing
+	    // order of their number, as a file may have to be restored from several
+	    // archives (delta patches, EA saved apart from data, directories...)
+	    // but the next archives can be opened (their catalogue read) meanwhile
+
+	vector<archive_num> ordered(to_consider.begin(), to_consider.end());
+	map<archive_num, shared_ptr<restore_dir_journal> > journals; // set if the files have been restored by a first pass
+	map<archive_num, unique_ptr<archive> > kept;                   // archives of the first pass still opened
+#ifdef LIBTHREADAR_AVAILABLE
+	deque<unique_ptr<archive_loader> > ahead; // archives being opened, ahead.front() is the one of the next archive not in kept
+	U_I next_ahead = 1;                        // index in ordered of the next archive to open in advance
+
+	if(opt.get_read_ahead() > 0 && ordered.size() > 1)
 	{
+		// the files only found in one archive do not depend on the
+		// restoration order, they are restored first, concurrently,
+		// what remains being restored in order by the loop below
+
+	    restore_files_concurrently(read_options,
+				       fs_root,
+				       extract_options,
+				       ordered,
+				       opt.get_read_ahead() + 1,
+				       journals,
+				       kept);
+	    next_ahead = kept.size() > 0 ? kept.size() : 1;
+	}
+#endif
+
+	for(U_I index = 0; index < ordered.size(); ++index)
+	{
+	    archive_num num = ordered[index];
 	    unique_ptr<archive> arch;
-	    archive_options_read tmp_read = read_options;
+	    map<archive_num, unique_ptr<archive> >::iterator kit = kept.find(num);
 
 		// - open the archive with the provided read options
 
-	    if(*it >= coordinate.size())
+	    if(num >= coordinate.size())
 		throw SRC_BUG;
 
-	    path chem(coordinate[*it].chemin);
-	    string basename = coordinate[*it].basename;
-	    if(coordinate[*it].crypto != crypto_algo::none)
-	    {
-		tmp_read.set_crypto_algo(coordinate[*it].crypto);
-		tmp_read.set_crypto_pass(coordinate[*it].pass);
-		    // note that the user may specify crypto options
-		    // to read all archive of referred byt the database,
-		    // these will be used unless the database defines
-		    // specific crypto params for a given archive, in
-		    // which case, those parameter will override the
-		    // global crypto params when reading such archive.
-		if(coordinate[*it].crypto_size != 0)
-		    tmp_read.set_crypto_size(coordinate[*it].crypto_size);
-		    // same thing here, crypto_size can be defined
-		    // globally when restoring from a database, but this
-		    // parameter will be overriden for each archive that
-		    // are stored with a non-null crypto_size value
+	    path chem(coordinate[num].chemin);
+	    string basename = coordinate[num].basename;
+
+	    if(kit != kept.end())
+	    {
+		arch = std::move(kit->second);
+		kept.erase(kit);
 	    }
 
-	    arch.reset(new (nothrow) archive(get_pointer(),
-					     chem,
-					     basename,
-					     dar_extension,
-					     tmp_read));
+#ifdef LIBTHREADAR_AVAILABLE
+	    if(!arch && !ahead.empty())
+	    {
+		if(!ahead.front())
+		    throw SRC_BUG;
+		arch = ahead.front()->release();
+		ahead.pop_front();
+	    }
+
+	    while(ahead.size() + kept.size() < opt.get_read_ahead() && next_ahead < ordered.size())
+	    {
+		archive_num anum = ordered[next_ahead];
+		archive_options_read tmp_read = read_options;
+
+		if(anum >= coordinate.size())
+		    throw SRC_BUG;
+		set_archive_read_options(anum, tmp_read);
+		ahead.push_back(make_unique<archive_loader>(get_pointer(),
+							    path(coordinate[anum].chemin),
+							    coordinate[anum].basename,
+							    dar_extension,
+							    tmp_read));
+		++next_ahead;
+	    }
+#endif
 
 	    if(!arch)
-		throw Ememory();
+	    {
+		archive_options_read tmp_read = read_options;
+
+		    // either no read ahead is used or the archive could not
+		    // be opened from a separated thread, which may need some
+		    // interaction with the user we only do from here
+		set_archive_read_options(num, tmp_read);
+		arch.reset(new (nothrow) archive(get_pointer(),
+						 chem,
+						 basename,
+						 dar_extension,
+						 tmp_read));
+		if(!arch)
+		    throw Ememory();
+	    }
 
 	    if(opt.get_info_details())
 	    {
@@ -950,11 +1143,22 @@ namespace libdar
 	    if(mask_base == nullptr)
 		throw SRC_BUG;
 
-	    mask_base->set_focus(*it);
+	    mask_base->set_focus(num);
 		// note: mask_base points to the first member of the wrapper_mask
 		// passed as set_subtree() of the arhive_option_extract object used
 		// below:
 
+	    if(!journals.empty())
+	    {
+		map<archive_num, shared_ptr<restore_dir_journal> >::iterator jit = journals.find(num);
+
+		if(jit == journals.end() || !jit->second)
+		    throw SRC_BUG;
+		jit->second->set_replay();
+		mask_base->set_pass(mask_database::pass::second, jit->second);
+		extract_options.set_dir_journal(jit->second);
+	    }
+
 		// - extract the archive with the provided/modified extraction options
 
 	    (void)arch->op_extract(fs_root,
@@ -967,6 +1171,139 @@ namespace libdar
 	}
     }
 
+#ifdef LIBTHREADAR_AVAILABLE
+    void database::i_database::restore_files_concurrently(const archive_options_read & read_options,
+							  const path & fs_root,
+							  const archive_options_extract & extract_options,
+							  const vector<archive_num> & ordered,
+							  U_I concurrency,
+							  map<archive_num, shared_ptr<restore_dir_journal> > & journals,
+							  map<archive_num, unique_ptr<archive> > & kept) const
+    {
+	shared_ptr<restore_dir_journal::created_dirs> created = make_shared<restore_dir_journal::created_dirs>();
+	shared_ptr<libthreadar::mutex> ui_lock = make_shared<libthreadar::mutex>();
+	map<archive_num, archive_options_extract> first_pass;  // the extraction options of each archive
+	deque<archive_num> running_num;                         // archives being extracted
+	deque<unique_ptr<archive_loader> > running;             // and the threads extracting them
+	deque<archive_num> left;                                // archives the threads could not open
+	bool keeping = true;                                    // whether the archives extracted so far are all kept
+
+	if(concurrency < 2)
+	    throw SRC_BUG;
+
+	for(vector<archive_num>::const_iterator it = ordered.begin(); it != ordered.end(); ++it)
+	{
+	    shared_ptr<restore_dir_journal> journal = make_shared<restore_dir_journal>(created);
+	    archive_options_extract & tmp_extract = first_pass[*it];
+	    const mask_database *tmp_mask = nullptr;
+
+	    tmp_extract = extract_options; // each archive has its own copy of the mask_database
+	    tmp_mask = dynamic_cast<const mask_database*>(& tmp_extract.get_subtree());
+	    if(tmp_mask == nullptr)
+		throw SRC_BUG;
+	    tmp_mask->set_focus(*it);
+	    tmp_mask->set_pass(mask_database::pass::first, journal);
+	    tmp_extract.set_dir_journal(journal);
+	    journals[*it] = journal;
+	}
+
+	    // user interaction is done by the threads only, which take ui_lock
+	    // for that, the current thread just starts them and waits for them
+
+	for(U_I index = 0; index <= ordered.size(); ++index)
+	{
+	    while(!running.empty() && (running.size() >= concurrency || index == ordered.size()))
+	    {
+		unique_ptr<archive> arch;
+
+		if(!running.front())
+		    throw SRC_BUG;
+		arch = running.front()->release(); // rethrows the exception met by the extraction if any
+
+		if(!running.front()->extracted())
+		{
+		    left.push_back(running_num.front());
+		    keeping = false;
+		}
+		else
+		{
+			// the second pass starts with the first archives, which we keep opened
+		    if(kept.size() + 1 >= concurrency)
+			keeping = false;
+		    if(keeping)
+			kept[running_num.front()] = std::move(arch);
+		}
+
+		running.pop_front();
+		running_num.pop_front();
+	    }
+
+	    if(index < ordered.size())
+	    {
+		archive_num num = ordered[index];
+		archive_options_read tmp_read = read_options;
+
+		if(num >= coordinate.size())
+		    throw SRC_BUG;
+		set_archive_read_options(num, tmp_read);
+		running.push_back(make_unique<archive_loader>(get_pointer(),
+							      path(coordinate[num].chemin),
+							      coordinate[num].basename,
+							      dar_extension,
+							      tmp_read,
+							      fs_root,
+							      first_pass[num],
+							      ui_lock));
+		running_num.push_back(num);
+	    }
+	}
+
+	    // the archives that could not be opened from a separated
+	    // thread may need some interaction with the user, which
+	    // is now possible from here
+
+	for(deque<archive_num>::iterator it = left.begin(); it != left.end(); ++it)
+	{
+	    archive_options_read tmp_read = read_options;
+	    unique_ptr<archive> arch;
+
+	    set_archive_read_options(*it, tmp_read);
+	    arch.reset(new (nothrow) archive(get_pointer(),
+					     path(coordinate[*it].chemin),
+					     coordinate[*it].basename,
+					     dar_extension,
+					     tmp_read));
+	    if(!arch)
+		throw Ememory();
+	    (void)arch->op_extract(fs_root, first_pass[*it], nullptr);
+	}
+    }
+#endif
+
+    void database::i_database::set_archive_read_options(archive_num num, archive_options_read & read_options) const
+    {
+	if(num >= coordinate.size())
+	    throw SRC_BUG;
+
+	if(coordinate[num].crypto != crypto_algo::none)
+	{
+	    read_options.set_crypto_algo(coordinate[num].crypto);
+	    read_options.set_crypto_pass(coordinate[num].pass);
+		// note that the user may specify crypto options
+		// to read all archive of referred byt the database,
+		// these will be used unless the database defines
+		// specific crypto params for a given archive, in
+		// which case, those parameter will override the
+		// global crypto params when reading such archive.
+	    if(coordinate[num].crypto_size != 0)
+		read_options.set_crypto_size(coordinate[num].crypto_size);
+		// same thing here, crypto_size can be defined
+		// globally when restoring from a database, but this
+		// parameter will be overriden for each archive that
+		// are stored with a non-null crypto_size value
+	}
+    }
+
 
     archive_num database::i_database::get_real_archive_num(archive_num num, bool revert) const
     {
@@ -30,6 +30,7 @@
 #include "../my_config.h"
 
 #include <list>
+#include <map>
 
 #include "archive.hpp"
 #include "generic_file.hpp"
@@ -45,6 +46,7 @@
 #include "crypto.hpp"
 #include "secu_string.hpp"
 #include "database_header.hpp"
+#include "restore_dir_journal.hpp"
 
 namespace libdar
 {
@@ -207,17 +209,7 @@ namespace libdar
 		     statistics* progressive_report);
 
             /// check that all files's Data and EA are more recent when archive number grows within the database, only warn the user
-        bool check_order() const
-        {
-            bool initial_warn = true;
-
-            if(files == nullptr)
-                throw SRC_BUG;
-            if(check_order_asked)
-                return files->check_order(get_ui(), path("."), initial_warn) && initial_warn;
-            else
-                return true;
-        }
+        bool check_order() const;
 
 
     private:
@@ -241,10 +233,51 @@ namespace libdar
 	storage *data_files;                         ///< when reading archive in partial mode, this is where is located the "not readed" part of the archive (is set to nullptr in partial-read-only mode)
 	bool check_order_asked;                      ///< whether order check has been asked
 	database_header head;                        ///< database header releated parameters
+	bool tree_in_file;                           ///< partial read-only mode of a streamed database: queries read the file tree from file
+	std::string base_filename;                   ///< database file name, used when tree_in_file is set
+	mutable std::unique_ptr<generic_file> pending_tree; ///< when tree_in_file is set, database file left open at the file tree position by the constructor
 
 	void build(generic_file & f, bool partial, bool read_only);  ///< used by constructors
+
+	    /// read the part of the database located before the file tree
+	void read_front(generic_file & f,
+			std::deque<struct archive_data> & coord,
+			std::vector<std::string> & opt,
+			std::string & chemin) const;
+
+	    /// provide the database file positionned at the beginning of the file tree (tree_in_file mode only)
+	generic_file *open_tree() const;
+
+	    /// get the file tree, either the loaded one or reading it from file
+
+	    /// \param[in] wanted if not nullptr and the tree has to be read from file, only these paths
+	    /// and what they lead to are loaded
+	    /// \param[out] holder receives the tree if it had to be read from file
+	    /// \return the file tree to use, which is either "files" or held by "holder"
+	const data_dir *get_tree(const std::deque<path> *wanted, std::unique_ptr<data_dir> & holder) const;
+
 	archive_num get_real_archive_num(archive_num num, bool revert) const;
 
+	    /// adapt the options to read archive num with the crypto parameters recorded for it in the database
+	void set_archive_read_options(archive_num num, archive_options_read & read_options) const;
+
+#ifdef LIBTHREADAR_AVAILABLE
+	    /// first pass of restore(): restores concurrently the files each archive is the only one to provide
+
+	    /// \param[in] read_options, fs_root, extract_options as given to restore(), extract_options's subtree being the mask_database
+	    /// \param[in] ordered the archives to restore from
+	    /// \param[in] concurrency the maximum number of archives extracted at the same time
+	    /// \param[out] journals receives the journal of each archive, for the second pass
+	    /// \param[out] kept receives some archives, still opened, the second pass can start with
+	void restore_files_concurrently(const archive_options_read & read_options,
+					const path & fs_root,
+					const archive_options_extract & extract_options,
+					const std::vector<archive_num> & ordered,
+					U_I concurrency,
+					std::map<archive_num, std::shared_ptr<restore_dir_journal> > & journals,
+					std::map<archive_num, std::unique_ptr<archive> > & kept) const;
+#endif
+
 	const datetime & get_root_last_mod(const archive_num & num) const;
     };
 
@@ -29,6 +29,7 @@ extern "C"
 #include "i_entrepot_libcurl.hpp"
 #include "fichier_libcurl.hpp"
 #include "cache_global.hpp"
+#include "sar_tools.hpp"
 
 using namespace std;
 
@@ -95,6 +96,23 @@ namespace libdar
 	}
     }
 
+    entrepot_libcurl::i_entrepot_libcurl::i_entrepot_libcurl(const i_entrepot_libcurl & ref):
+	entrepot(ref),
+	mem_ui(ref),
+	x_proto(ref.x_proto),
+	base_URL(ref.base_URL),
+	easyh(ref.easyh),
+	wait_delay(ref.wait_delay),
+	verbosity(ref.verbosity),
+	withdirinfo(false)
+    {
+	    // directory listing in progress and prefetched slice are not shared
+	current_dir.clear();
+	reading_dir_tmp.clear();
+	temporary_list.clear();
+	cur_dir_cursor = current_dir.begin();
+    }
+
     bool entrepot_libcurl::i_entrepot_libcurl::read_dir_next(string & filename) const
     {
 	inode_type tp;
@@ -181,8 +199,6 @@ namespace libdar
 						       bool erase) const
     {
 	fichier_global *ret = nullptr;
-	cache_global *rw = nullptr;
-	gf_mode hidden_mode = mode;
 
 	if(fail_if_exists)
 	{
@@ -194,6 +210,45 @@ namespace libdar
 		    throw Esystem("File exists on remote repository" , Esystem::io_exist);
 	}
 
+	if(prefetched
+	   && mode == gf_read_only
+	   && prefetched_name == filename
+	   && prefetched_dialog == dialog)
+	    ret = prefetched.release();
+	else
+	{
+	    prefetched.reset();
+	    ret = open_file(dialog, filename, mode, force_permission, permission, erase);
+	}
+
+	if(mode == gf_read_only)
+	{
+	    try
+	    {
+		prefetch_next(dialog, filename);
+	    }
+	    catch(...)
+	    {
+		delete ret;
+		throw;
+	    }
+	}
+
+	return ret;
+    }
+
+    fichier_global *entrepot_libcurl::i_entrepot_libcurl::open_file(const shared_ptr<user_interaction> & dialog,
+								    const string & filename,
+								    gf_mode mode,
+								    bool force_permission,
+								    U_I permission,
+								    bool erase) const
+    {
+	fichier_global *ret = nullptr;
+	cache_global *rw = nullptr;
+	gf_mode hidden_mode = mode;
+	deque<shared_ptr<mycurl_easyhandle_node> > readers;
+
 	string chemin = (path(get_url(), true).append(filename)).display();
 
 	if(verbosity)
@@ -202,6 +257,10 @@ namespace libdar
 	if(hidden_mode == gf_read_write)
 	    hidden_mode = gf_write_only;
 
+	if(hidden_mode == gf_read_only && x_proto != remote_entrepot_type::ftp)
+	    for(U_I i = 0; i < parallel_readers; ++i)
+		readers.push_back(easyh.alloc_instance());
+
 	try
 	{
 	    ret = new (nothrow) fichier_libcurl(dialog,
@@ -212,7 +271,8 @@ namespace libdar
 						wait_delay,
 						force_permission,
 						permission,
-						erase);
+						erase,
+						readers);
 
 	    if(ret == nullptr)
 		throw Ememory();
@@ -272,6 +332,36 @@ namespace libdar
 	return ret;
     }
 
+    void entrepot_libcurl::i_entrepot_libcurl::prefetch_next(const shared_ptr<user_interaction> & dialog, const string & filename) const
+    {
+	string next;
+
+	prefetched.reset();
+
+	if(!sar_tools_next_slice_name(filename, next))
+	    return;
+
+	try
+	{
+	    prefetched.reset(open_file(dialog, next, gf_read_only, false, 0, false));
+	    if(!prefetched)
+		throw SRC_BUG;
+	    prefetched->read_ahead(prefetch_size);
+	    prefetched_name = next;
+	    prefetched_dialog = dialog;
+	}
+	catch(Ebug & e)
+	{
+	    throw;
+	}
+	catch(Egeneric & e)
+	{
+		// no next slice or not readable, the error will be
+		// reported if the next slice is requested
+	    prefetched.reset();
+	}
+    }
+
     void entrepot_libcurl::i_entrepot_libcurl::inherited_unlink(const string & filename) const
     {
 	mycurl_slist headers;
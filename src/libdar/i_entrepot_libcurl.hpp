@@ -40,6 +40,7 @@ extern "C"
 #include <string>
 #include <deque>
 #include <map>
+#include <memory>
 #include "entrepot_libcurl.hpp"
 #include "secu_string.hpp"
 #include "mem_ui.hpp"
@@ -71,7 +72,7 @@ namespace libdar
 			   U_I waiting_time,                       ///< time in second to wait before retrying in case of network error
 			   bool verbose                           ///< whether to have verbose messages from libcurl
 	    );
-	i_entrepot_libcurl(const i_entrepot_libcurl & ref) = default;
+	i_entrepot_libcurl(const i_entrepot_libcurl & ref);
 	i_entrepot_libcurl(i_entrepot_libcurl && ref) = default;
 	i_entrepot_libcurl & operator = (const i_entrepot_libcurl & ref) = delete;
 	i_entrepot_libcurl & operator = (i_entrepot_libcurl && ref) noexcept = delete;
@@ -120,6 +121,12 @@ namespace libdar
 	U_I wait_delay;
 	bool verbosity;
 	mutable bool withdirinfo; ///< used by callback function while reading directory content, to know whether to expect only a filename per line or whole entry information
+	mutable std::unique_ptr<fichier_global> prefetched;  ///< next slice opened ahead of time
+	mutable std::string prefetched_name;                 ///< filename of prefetched
+	mutable std::shared_ptr<user_interaction> prefetched_dialog; ///< user_interaction prefetched has been created with
+
+	static constexpr U_I parallel_readers = 4; ///< number of range requests in flight when reading a file (not for FTP)
+	static constexpr U_I prefetch_size = 10485760; ///< amount of the next slice to read ahead
 
 	std::string get_libcurl_URL() const;
 	void set_libcurl_authentication(user_interaction & dialog,         ///< for user interaction
@@ -135,6 +142,13 @@ namespace libdar
 	void fill_temporary_list() const;   ///< extract list files and subdir from current_dir to temporary_list std::deque
 	void update_current_dir_with_line(const std::string & line) const; ///< run from callback to fill current_dir with a detailed line from the 'dir/ls' output
 	void set_current_dir(bool details) const;  ///< fill current_dir with the content of the directory pointed to by get_location()
+	fichier_global *open_file(const std::shared_ptr<user_interaction> & dialog,
+				  const std::string & filename,
+				  gf_mode mode,
+				  bool force_permission,
+				  U_I permission,
+				  bool erase) const; ///< inherited_open() without the file existence check nor the prefetching
+	void prefetch_next(const std::shared_ptr<user_interaction> & dialog, const std::string & filename) const; ///< open ahead the slice following filename
 
 
 	static std::string mycurl_protocol2string(remote_entrepot_type proto);
@@ -115,6 +115,10 @@ namespace libdar
         unique_ptr<generic_file> destination;
 	bool force_perm = slice_perm != "";
 	U_I perm = force_perm ? tools_octal2int(slice_perm) : 0;
+	deque<hash_algo> hashes;
+
+	if(hash != hash_algo::none)
+	    hashes.push_back(hash);
 
 	if(!dst_path)
 	    throw Ememory();
@@ -150,7 +154,7 @@ namespace libdar
 								warn_over,
 								force_perm,
 								perm,
-								hash,
+								hashes,
 								min_digits,
 								source->get_slice_info().get_format_07_compatibility()));
 	}
@@ -170,7 +174,7 @@ namespace libdar
 							source->get_slice_info().get_data_name(),
 							force_perm,
 							perm,
-							hash,
+							hashes,
 							min_digits,
 							source->get_slice_info().get_format_07_compatibility(),
 							execute));
@@ -221,6 +225,9 @@ namespace libdar
 	    generic_file* src = dynamic_cast<generic_file*>(source.get());
 	    if(src == nullptr)
 		throw SRC_BUG; // the source should not only inherit from contextual but also from generic_file
+	    sar *src_sar = dynamic_cast<sar *>(src);
+	    if(src_sar != nullptr)
+		direct_copy(*src_sar, *dst);
 	    src->copy_to(*dst);
 	}
 	catch(Escript & e)
@@ -246,4 +253,70 @@ namespace libdar
 	}
     }
 
+    void libdar_xform::i_libdar_xform::direct_copy(sar & src, generic_file & dst)
+    {
+	static const U_I max_step = 64*1024*1024; // checking for thread cancellation between each step
+	char buffer[BUFFER_SIZE];
+	sar *dst_sar = dynamic_cast<sar *>(&dst);
+	trivial_sar *dst_triv = dynamic_cast<trivial_sar *>(&dst);
+	thread_cancellation thr;
+
+	if(dst_sar == nullptr && dst_triv == nullptr)
+	    return;
+
+	while(true)
+	{
+	    infinint avail, room;
+	    fichier_local *in = src.direct_read_access(avail);
+	    fichier_local *out = nullptr;
+	    U_I step = max_step;
+	    U_I copied;
+
+	    if(dst_sar != nullptr)
+		out = dst_sar->direct_write_access(room);
+	    else
+	    {
+		out = dst_triv->direct_write_access();
+		room = avail;
+	    }
+
+	    if(in == nullptr || out == nullptr)
+		return;
+
+	    thr.check_self_cancellation();
+
+	    if(avail.is_zero() || room.is_zero())
+	    {
+		    // crossing a slice boundary the usual way, the sar
+		    // objects take care of slice trailers and headers
+
+		copied = src.read(buffer, BUFFER_SIZE);
+		if(copied == 0)
+		    return; // end of archive
+		dst.write(buffer, copied);
+		continue;
+	    }
+
+	    if(avail < step)
+	    {
+		step = 0;
+		avail.unstack(step);
+	    }
+	    if(room < step)
+	    {
+		step = 0;
+		room.unstack(step);
+	    }
+
+	    copied = in->copy_range_to(*out, step);
+	    if(copied == 0)
+		return; // not supported by the system or filesystem
+	    src.direct_read_done(copied);
+	    if(dst_sar != nullptr)
+		dst_sar->direct_write_done(copied);
+	    else
+		dst_triv->direct_write_done(copied);
+	}
+    }
+
 } // end of namespace
@@ -33,6 +33,7 @@
 #include "label.hpp"
 #include "libdar_xform.hpp"
 #include "contextual.hpp"
+#include "sar.hpp"
 
 namespace libdar
 {
@@ -149,6 +150,11 @@ namespace libdar
 
 	void init_entrep();
 	void xform_to(generic_file *dst);
+
+	    /// copy data between local slices without reading it in memory as long as possible
+
+	    /// \note the caller has to copy what remains (if any) the usual way
+	void direct_copy(sar & src, generic_file & dst);
     };
 
 	/// @}
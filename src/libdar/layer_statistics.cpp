@@ -0,0 +1,133 @@
+/*********************************************************************/
+// dar - disk archive - a backup/restoration program
+// Copyright (C) 2002-2026 Denis Corbin
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// to contact the author, see the AUTHOR file
+/*********************************************************************/
+
+#include "../my_config.h"
+
+extern "C"
+{
+} // end extern "C"
+
+#include "layer_statistics.hpp"
+#include "user_interaction.hpp"
+#include "infinint.hpp"
+#include "erreurs.hpp"
+
+#include <algorithm>
+
+using namespace std;
+
+namespace libdar
+{
+
+	/// human readable form of a duration given in nanoseconds, in milliseconds with microsecond precision
+    static string duration_to_string(U_64 ns);
+
+	/// sorting order of layers for listing(), top layer first
+    static bool higher_level(const layer_statistics::layer *a, const layer_statistics::layer *b) { return a->level > b->level; };
+
+	/// display one counter if it has been used
+    static void counter_listing(user_interaction & dialog, const char *op, const layer_statistics::counter & val);
+
+
+    void layer_statistics::counter::add(U_64 amount, U_64 duration_ns)
+    {
+	++calls;
+	bytes += amount;
+	total_ns += duration_ns;
+	if(duration_ns > max_ns)
+	    max_ns = duration_ns;
+    }
+
+    const layer_statistics::layer & layer_statistics::get_layer(U_I index) const
+    {
+	if(index >= layers.size())
+	    throw Erange(gettext("Layer index out of range"));
+
+	return layers[index];
+    }
+
+    void layer_statistics::listing(user_interaction & dialog) const
+    {
+	dialog.printf("");
+	dialog.printf(gettext("LAYER STATISTICS (top layer first, the time of a layer includes the time of the layers below it):"));
+	dialog.printf("");
+
+	deque<const layer *> ordered;
+
+	for(deque<layer>::const_iterator it = layers.begin(); it != layers.end(); ++it)
+	    ordered.push_back(&(*it));
+	stable_sort(ordered.begin(), ordered.end(), higher_level);
+
+	for(deque<const layer *>::iterator it = ordered.begin(); it != ordered.end(); ++it)
+	{
+	    dialog.printf(" %S", &((*it)->name));
+	    counter_listing(dialog, gettext("read "), (*it)->read);
+	    counter_listing(dialog, gettext("write"), (*it)->write);
+	    counter_listing(dialog, gettext("skip "), (*it)->skip);
+
+	    for(deque<worker>::const_iterator wt = (*it)->workers.begin(); wt != (*it)->workers.end(); ++wt)
+	    {
+		string busy = duration_to_string(wt->busy_ns);
+		string idle = duration_to_string(wt->idle_ns);
+
+		dialog.printf(gettext("   thread %S: busy %S, idle %S"), &(wt->name), &busy, &idle);
+	    }
+	}
+	dialog.printf("");
+    }
+
+    layer_statistics::layer & layer_statistics::get_record(U_I level, const string & name)
+    {
+	for(deque<layer>::iterator it = layers.begin(); it != layers.end(); ++it)
+	    if(it->level == level && it->name == name)
+		return *it;
+
+	layers.push_back(layer());
+	layers.back().name = name;
+	layers.back().level = level;
+
+	return layers.back();
+    }
+
+    static string duration_to_string(U_64 ns)
+    {
+	string frac = to_string((ns / 1000) % 1000);
+
+	while(frac.size() < 3)
+	    frac = "0" + frac;
+
+	return to_string(ns / 1000000) + "." + frac + " ms";
+    }
+
+    static void counter_listing(user_interaction & dialog, const char *op, const layer_statistics::counter & val)
+    {
+	if(val.calls > 0)
+	{
+	    infinint calls = val.calls;
+	    infinint bytes = val.bytes;
+	    string total = duration_to_string(val.total_ns);
+	    string max = duration_to_string(val.max_ns);
+
+	    dialog.printf(gettext("   %s: %i call(s), %i byte(s), %S total, %S max"), op, &calls, &bytes, &total, &max);
+	}
+    }
+
+} // end of namespace
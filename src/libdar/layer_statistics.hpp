@@ -0,0 +1,133 @@
+/*********************************************************************/
+// dar - disk archive - a backup/restoration program
+// Copyright (C) 2002-2026 Denis Corbin
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// to contact the author, see the AUTHOR file
+/*********************************************************************/
+
+    /// \file layer_statistics.hpp
+    /// \brief time and amount of data spent in each layer of an archive
+    /// \ingroup API
+
+#ifndef LAYER_STATISTICS_HPP
+#define LAYER_STATISTICS_HPP
+
+#include "../my_config.h"
+
+extern "C"
+{
+} // end extern "C"
+
+#include "integers.hpp"
+
+#include <string>
+#include <deque>
+
+namespace libdar
+{
+    class user_interaction;
+
+	/// \addtogroup API
+	/// @{
+
+	/// per layer breakdown of the work done on an archive
+
+	/// an archive is read or written through a stack of layers (slicing, encryption,
+	/// compression, escape sequences...). Giving an object of this class to
+	/// archive_options_read::set_layer_statistics() or archive_options_create::set_layer_statistics()
+	/// has libdar record here the calls made to each layer and the time they took, as well
+	/// as how much the threads of the multi-threaded layers have been busy or idle.
+	/// \note times are measured from the caller side, so the time of a layer includes
+	/// the time spent in the layers below it.
+	/// \note skip operations are measured where libdar asks the whole stack to seek,
+	/// they are thus reported on the top layer only.
+    class layer_statistics
+    {
+    public:
+
+	    /// counters for one kind of operation
+	struct counter
+	{
+	    U_64 calls = 0;    ///< number of calls
+	    U_64 bytes = 0;    ///< number of bytes read or written
+	    U_64 total_ns = 0; ///< cumulated duration of the calls (nanoseconds)
+	    U_64 max_ns = 0;   ///< duration of the longest call (nanoseconds)
+
+		/// record a new call
+	    void add(U_64 amount, U_64 duration_ns);
+	};
+
+	    /// time spent by a thread of a layer
+	struct worker
+	{
+	    std::string name;  ///< role of the thread
+	    U_64 busy_ns = 0;  ///< time spent working (nanoseconds)
+	    U_64 idle_ns = 0;  ///< time spent waiting for data to work on or for room to send its result (nanoseconds)
+	};
+
+	    /// statistics of a layer
+	struct layer
+	{
+	    std::string name;            ///< class name of the layer
+	    U_I level = 0;               ///< position in the stack of layers, zero for the bottom layer
+	    counter read;                ///< read operations
+	    counter write;               ///< write operations
+	    counter skip;                ///< skip operations, only recorded for the top layer
+	    std::deque<worker> workers;  ///< threads of this layer, if any, known once the layer has been closed
+	};
+
+	layer_statistics() = default;
+	layer_statistics(const layer_statistics & ref) = default;
+	layer_statistics(layer_statistics && ref) noexcept = default;
+	layer_statistics & operator = (const layer_statistics & ref) = default;
+	layer_statistics & operator = (layer_statistics && ref) noexcept = default;
+	~layer_statistics() = default;
+
+	    /// number of layers recorded so far
+	U_I size() const { return layers.size(); };
+
+	    /// access to the recorded layers
+
+	    /// \param[in] index ranges from zero to size()-1, layers are recorded in the order
+	    /// they have been added to the stack, the first being the bottom layer (close to the filesystem)
+	const layer & get_layer(U_I index) const;
+
+	    /// forget all recorded layers
+
+	    /// \note must not be called while an archive using this object is still open
+	void clear() { layers.clear(); };
+
+	    /// display the recorded statistics, top layer first
+	void listing(user_interaction & dialog) const;
+
+	    /// obtain the record of a layer, adding it if not already present
+
+	    /// \param[in] level position of the layer in the stack
+	    /// \param[in] name class name of the layer
+	    /// \note this is used by libdar, the returned reference stays valid until clear() is called.
+	    /// Layers temporarily added to the stack (one per saved file for example) share the same record.
+	layer & get_record(U_I level, const std::string & name);
+
+    private:
+	std::deque<layer> layers;
+    };
+
+	/// @}
+
+} // end of namespace
+
+#endif
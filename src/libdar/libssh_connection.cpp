@@ -57,7 +57,8 @@ namespace libdar
 					 const string & sftp_prv_keyfile,
 					 const string & sftp_known_hosts,
 					 U_I waiting_time,
-					 bool verbose):
+					 bool verbose,
+					 bool retry):
 	sess(nullptr),
 	sftp_sess(nullptr),
 	waiting(waiting_time)
@@ -104,8 +105,9 @@ namespace libdar
 		Erange* e_r = dynamic_cast<Erange*>(&e);
 		Ememory* e_m = dynamic_cast<Ememory*>(&e);
 
-		if(e_r != nullptr
-		   || e_m != nullptr)
+		if(retry
+		   && (e_r != nullptr
+		       || e_m != nullptr))
 		{
 		    dialog->message(tools_printf(gettext("Waiting %d seconds and retring connection due to: %s"),
 						 waiting_time,
@@ -313,6 +315,7 @@ namespace libdar
 	    if(code != SSH_OK)
 		throw Enet_auth(tools_printf(gettext("Authentication failure: %s"),
 					     ssh_get_error(sess)));
+	    credential = real_pass;
 	}
 	else // public/private key pair authentication (password field if not empty is used as key passphrase)
 	{
@@ -373,6 +376,7 @@ namespace libdar
 		    throw;
 		}
 		ssh_key_free(prvkey);
+		credential = real_pass;
 	    }
 	    catch(...)
 	    {
@@ -70,7 +70,8 @@ namespace libdar
 			  const std::string & sftp_prv_keyfile,
 			  const std::string & sftp_known_hosts,
 			  U_I waiting_time,
-			  bool verbose = false);
+			  bool verbose = false,
+			  bool retry = true);
 
 	libssh_connection(const libssh_connection & ref) = delete;
 	libssh_connection(libssh_connection && ref) = delete;
@@ -84,6 +85,9 @@ namespace libdar
 	U_I get_max_read() const { return max_read; };
 	U_I get_max_write() const { return max_write; };
 
+	    /// password or key passphrase that succeeded, to open further sessions without asking the user again
+	const secu_string & get_credential() const { return credential; };
+
 	const char* get_sftp_error_msg() const;
 
     private:
@@ -92,6 +96,7 @@ namespace libdar
 	U_I waiting;
 	uint64_t max_read;
 	uint64_t max_write;
+	secu_string credential;
 
 
 	void create_session(const std::string & host,
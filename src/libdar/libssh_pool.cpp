@@ -0,0 +1,137 @@
+/*********************************************************************/
+// dar - disk archive - a backup/restoration program
+// Copyright (C) 2002-2026 Denis Corbin
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// to contact the author, see the AUTHOR file
+/*********************************************************************/
+
+#include "../my_config.h"
+
+#include "libssh_pool.hpp"
+#include "erreurs.hpp"
+
+using namespace std;
+
+namespace libdar
+{
+#if LIBSSH_AVAILABLE
+
+    libssh_pool::libssh_pool(const shared_ptr<user_interaction> & x_dialog,
+			     const string & x_login,
+			     const secu_string & password,
+			     const string & x_host,
+			     const string & x_port,
+			     bool x_auth_from_file,
+			     const string & x_sftp_pub_keyfile,
+			     const string & x_sftp_prv_keyfile,
+			     const string & x_sftp_known_hosts,
+			     U_I x_waiting_time,
+			     bool x_verbose):
+	dialog(x_dialog),
+	login(x_login),
+	host(x_host),
+	port(x_port),
+	auth_from_file(x_auth_from_file),
+	sftp_pub_keyfile(x_sftp_pub_keyfile),
+	sftp_prv_keyfile(x_sftp_prv_keyfile),
+	sftp_known_hosts(x_sftp_known_hosts),
+	waiting_time(x_waiting_time),
+	verbose(x_verbose),
+	can_grow(true)
+    {
+	shared_ptr<libssh_connection> tmp(new (nothrow) libssh_connection(dialog,
+									  login,
+									  password,
+									  host,
+									  port,
+									  auth_from_file,
+									  sftp_pub_keyfile,
+									  sftp_prv_keyfile,
+									  sftp_known_hosts,
+									  waiting_time,
+									  verbose));
+	if(!tmp)
+	    throw Ememory();
+
+	sessions.push_back(tmp);
+    }
+
+    shared_ptr<libssh_connection> libssh_pool::acquire(bool fallback_to_main)
+    {
+	deque<shared_ptr<libssh_connection> >::iterator it = sessions.begin();
+
+	if(it == sessions.end())
+	    throw SRC_BUG;
+
+	++it; // the main session is never considered free, entrepot_libssh objects use it
+	while(it != sessions.end() && it->use_count() > 1)
+	    ++it;
+
+	if(it != sessions.end())
+	    return *it;
+
+	if(can_grow && sessions.size() < max_sessions)
+	{
+	    try
+	    {
+		shared_ptr<libssh_connection> tmp(new (nothrow) libssh_connection(dialog,
+										  login,
+										  sessions.front()->get_credential(),
+										  host,
+										  port,
+										  auth_from_file,
+										  sftp_pub_keyfile,
+										  sftp_prv_keyfile,
+										  sftp_known_hosts,
+										  waiting_time,
+										  verbose,
+										  false));
+		if(!tmp)
+		    throw Ememory();
+
+		sessions.push_back(tmp);
+		return tmp;
+	    }
+	    catch(Ebug & e)
+	    {
+		throw;
+	    }
+	    catch(Euser_abort & e)
+	    {
+		throw;
+	    }
+	    catch(Ethread_cancel & e)
+	    {
+		throw;
+	    }
+	    catch(Egeneric & e)
+	    {
+		    // server limits the number of sessions per user or per host,
+		    // we will do with the sessions we already have
+		can_grow = false;
+	    }
+	}
+
+	if(fallback_to_main)
+	    return sessions.front();
+	else
+	    return shared_ptr<libssh_connection>();
+    }
+
+#endif
+
+} // end of namespace
@@ -0,0 +1,111 @@
+/*********************************************************************/
+// dar - disk archive - a backup/restoration program
+// Copyright (C) 2002-2026 Denis Corbin
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// to contact the author, see the AUTHOR file
+/*********************************************************************/
+
+    /// \file libssh_pool.hpp
+    /// \brief set of ssh/sftp sessions to a given server shared by the clones of an entrepot_libssh
+    /// \ingroup Private
+    ///
+    /// libssh sessions process their requests in order, so a file being read or written
+    /// would delay every other operation made through the same session. The pool opens
+    /// additional sessions on demand so each file gets its own.
+
+#ifndef LIBSSH_POOL_HPP
+#define LIBSSH_POOL_HPP
+
+
+#include "../my_config.h"
+
+#include <string>
+#include <deque>
+#include <memory>
+
+#include "integers.hpp"
+#include "user_interaction.hpp"
+#include "secu_string.hpp"
+#include "libssh_connection.hpp"
+
+namespace libdar
+{
+
+	/// \addtogroup Private
+	/// @{
+
+#if LIBSSH_AVAILABLE
+
+    class libssh_pool
+    {
+    public:
+
+	    /// constructor opens the first session, the arguments are those of libssh_connection
+
+	libssh_pool(const std::shared_ptr<user_interaction> & dialog,
+		    const std::string & login,
+		    const secu_string & password,
+		    const std::string & host,
+		    const std::string & port,
+		    bool auth_from_file,
+		    const std::string & sftp_pub_keyfile,
+		    const std::string & sftp_prv_keyfile,
+		    const std::string & sftp_known_hosts,
+		    U_I waiting_time,
+		    bool verbose);
+
+	libssh_pool(const libssh_pool & ref) = delete;
+	libssh_pool(libssh_pool && ref) = delete;
+	libssh_pool & operator = (const libssh_pool & ref) = delete;
+	libssh_pool & operator = (libssh_pool && ref) = delete;
+	~libssh_pool() = default;
+
+	    /// the session used for directory operations, always available
+	const std::shared_ptr<libssh_connection> & get_main() const { return sessions.front(); };
+
+	    /// provides a session not used by any other file
+
+	    /// \param[in] fallback_to_main if no session is free and no more can be opened,
+	    /// return the main session when true, nullptr when false
+	    /// \note a session is considered free as soon as the pool holds the only reference on it
+	std::shared_ptr<libssh_connection> acquire(bool fallback_to_main);
+
+    private:
+	static constexpr U_I max_sessions = 4; ///< main session included
+
+	std::shared_ptr<user_interaction> dialog;
+	std::string login;
+	std::string host;
+	std::string port;
+	bool auth_from_file;
+	std::string sftp_pub_keyfile;
+	std::string sftp_prv_keyfile;
+	std::string sftp_known_hosts;
+	U_I waiting_time;
+	bool verbose;
+	bool can_grow; ///< false once the server refused an additional session
+
+	std::deque<std::shared_ptr<libssh_connection> > sessions; ///< first is the main session
+    };
+
+#endif
+
+	/// @}
+
+} // end of namespace
+
+#endif
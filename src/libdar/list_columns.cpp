@@ -0,0 +1,253 @@
+/*********************************************************************/
+// dar - disk archive - a backup/restoration program
+// Copyright (C) 2002-2026 Denis Corbin
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// to contact the author, see the AUTHOR file
+/*********************************************************************/
+
+#include "../my_config.h"
+
+#include <limits>
+
+#include "list_columns.hpp"
+#include "cat_all_entrees.hpp"
+#include "tools.hpp"
+#include "erreurs.hpp"
+
+using namespace std;
+
+namespace libdar
+{
+
+	/// converts val to U_64, setting the overflow flag if it does not fit
+    static U_64 col_u64(const infinint & val, U_32 & fl);
+
+	/// converts a date to nanoseconds, setting the overflow flag if it does not fit
+    static S_64 col_date(const datetime & val, U_32 & fl);
+
+    string list_columns::get_name(U_I index) const
+    {
+	if(index >= size())
+	    throw Erange(gettext("Index out of range"));
+
+	return names.substr(name_offset[index], name_offset[index + 1] - name_offset[index]);
+    }
+
+    void list_columns::clear()
+    {
+	names.clear();
+	name_offset.clear();
+	name_offset.push_back(0);
+	type.clear();
+	removed_type.clear();
+	flags.clear();
+	perm.clear();
+	uid.clear();
+	gid.clear();
+	file_size.clear();
+	storage_size.clear();
+	data_offset.clear();
+	last_access.clear();
+	last_modif.clear();
+	last_change.clear();
+    }
+
+    void list_columns::reserve(U_I num)
+    {
+	try
+	{
+	    name_offset.reserve(num + 1);
+	    type.reserve(num);
+	    removed_type.reserve(num);
+	    flags.reserve(num);
+	    perm.reserve(num);
+	    uid.reserve(num);
+	    gid.reserve(num);
+	    file_size.reserve(num);
+	    storage_size.reserve(num);
+	    data_offset.reserve(num);
+	    last_access.reserve(num);
+	    last_modif.reserve(num);
+	    last_change.reserve(num);
+	}
+	catch(std::bad_alloc &)
+	{
+	    throw Ememory();
+	}
+    }
+
+    void list_columns::add(const cat_nomme & entry)
+    {
+	const cat_mirage *tmp_mir = dynamic_cast<const cat_mirage *>(&entry);
+	const cat_inode *tmp_inode = dynamic_cast<const cat_inode *>(&entry);
+	const cat_detruit *tmp_det = dynamic_cast<const cat_detruit *>(&entry);
+	const cat_file *tmp_file = nullptr;
+	const cat_directory *tmp_dir = nullptr;
+	U_32 fl = 0;
+	unsigned char sig = entry.signature();
+	unsigned char rem_sig = 0;
+	U_32 x_perm = 0;
+	U_64 x_uid = 0;
+	U_64 x_gid = 0;
+	U_64 x_size = 0;
+	U_64 x_storage = 0;
+	U_64 x_offset = 0;
+	S_64 x_atime = 0;
+	S_64 x_mtime = 0;
+	S_64 x_ctime = 0;
+
+	if(tmp_mir != nullptr)
+	{
+	    fl |= flag_hard_linked;
+	    tmp_inode = tmp_mir->get_inode();
+	    if(tmp_inode == nullptr)
+		throw SRC_BUG;
+	    sig = tmp_inode->signature();
+	}
+
+	tmp_file = dynamic_cast<const cat_file *>(tmp_inode);
+	tmp_dir = dynamic_cast<const cat_directory *>(tmp_inode);
+
+	if(tmp_det != nullptr)
+	{
+	    rem_sig = tmp_det->get_signature();
+	    x_mtime = col_date(tmp_det->get_date(), fl);
+	}
+
+	if(tmp_inode != nullptr)
+	{
+	    x_perm = tmp_inode->get_perm();
+	    x_uid = col_u64(tmp_inode->get_uid(), fl);
+	    x_gid = col_u64(tmp_inode->get_gid(), fl);
+	    x_atime = col_date(tmp_inode->get_last_access(), fl);
+	    x_mtime = col_date(tmp_inode->get_last_modif(), fl);
+	    if(tmp_inode->has_last_change())
+		x_ctime = col_date(tmp_inode->get_last_change(), fl);
+	    if(tmp_inode->get_saved_status() == saved_status::saved
+	       || tmp_inode->get_saved_status() == saved_status::delta)
+		fl |= flag_data_saved;
+
+	    switch(tmp_inode->ea_get_saved_status())
+	    {
+	    case ea_saved_status::full:
+		fl |= flag_ea_saved;
+		    /* no break ! */
+	    case ea_saved_status::partial:
+	    case ea_saved_status::fake:
+		fl |= flag_ea;
+		break;
+	    case ea_saved_status::none:
+	    case ea_saved_status::removed:
+		break;
+	    default:
+		throw SRC_BUG;
+	    }
+
+	    switch(tmp_inode->fsa_get_saved_status())
+	    {
+	    case fsa_saved_status::full:
+		fl |= flag_fsa_saved;
+		    /* no break ! */
+	    case fsa_saved_status::partial:
+		fl |= flag_fsa;
+		break;
+	    case fsa_saved_status::none:
+		break;
+	    default:
+		throw SRC_BUG;
+	    }
+	}
+
+	if(tmp_file != nullptr)
+	{
+	    x_size = col_u64(tmp_file->get_size(), fl);
+	    if(tmp_file->get_sparse_file_detection_read())
+		fl |= flag_sparse;
+	    if(tmp_file->is_dirty())
+		fl |= flag_dirty;
+	    if(tmp_file->get_saved_status() == saved_status::saved
+	       || tmp_file->get_saved_status() == saved_status::delta)
+	    {
+		x_offset = col_u64(tmp_file->get_offset(), fl);
+		x_storage = col_u64(tmp_file->get_storage_size(), fl);
+	    }
+	    if(tmp_file->has_delta_signature_structure())
+		fl |= flag_delta_sig;
+	}
+
+	if(tmp_dir != nullptr)
+	{
+	    x_size = col_u64(tmp_dir->get_size(), fl);
+	    x_storage = col_u64(tmp_dir->get_storage_size(), fl);
+	    if(tmp_dir->is_empty())
+		fl |= flag_empty_dir;
+	}
+
+	try
+	{
+	    names += entry.get_name();
+	    name_offset.push_back(names.size());
+	    type.push_back(sig);
+	    removed_type.push_back(rem_sig);
+	    flags.push_back(fl);
+	    perm.push_back(x_perm);
+	    uid.push_back(x_uid);
+	    gid.push_back(x_gid);
+	    file_size.push_back(x_size);
+	    storage_size.push_back(x_storage);
+	    data_offset.push_back(x_offset);
+	    last_access.push_back(x_atime);
+	    last_modif.push_back(x_mtime);
+	    last_change.push_back(x_ctime);
+	}
+	catch(std::bad_alloc &)
+	{
+	    throw Ememory();
+	}
+    }
+
+    static U_64 col_u64(const infinint & val, U_32 & fl)
+    {
+	U_64 ret;
+
+	if(!tools_infinint2U_64(val, ret))
+	{
+	    fl |= list_columns::flag_overflow;
+	    ret = numeric_limits<U_64>::max();
+	}
+
+	return ret;
+    }
+
+    static S_64 col_date(const datetime & val, U_32 & fl)
+    {
+	static const S_64 ns_per_s = 1000000000;
+	time_t sec = 0;
+	time_t sub = 0;
+
+	if(!val.get_value(sec, sub, datetime::tu_nanosecond)
+	   || sec > (numeric_limits<S_64>::max() - sub) / ns_per_s
+	   || sec < 0)
+	{
+	    fl |= list_columns::flag_overflow;
+	    return numeric_limits<S_64>::max();
+	}
+
+	return (S_64)(sec) * ns_per_s + sub;
+    }
+
+} // end of namespace
@@ -0,0 +1,156 @@
+/*********************************************************************/
+// dar - disk archive - a backup/restoration program
+// Copyright (C) 2002-2026 Denis Corbin
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// to contact the author, see the AUTHOR file
+/*********************************************************************/
+
+
+    /// \file list_columns.hpp
+    /// \brief batch of archive entries stored field by field, used by archive::get_children_in_columns
+    /// \ingroup API
+
+
+#ifndef LIST_COLUMNS_HPP
+#define LIST_COLUMNS_HPP
+
+#include <string>
+#include <vector>
+
+#include "../my_config.h"
+#include "integers.hpp"
+
+namespace libdar
+{
+
+        /// \addtogroup API
+        /// @{
+
+    class cat_nomme;
+
+	/// the list_columns class holds the description of a batch of entries of a directory
+
+	/// at the difference of list_entry, which holds all the information about a single
+	/// entry, list_columns holds one table per field, the Nth element of each table describing
+	/// the Nth entry of the batch. Names are stored one after the other in a single string,
+	/// numerical fields are stored as fixed width integers. This avoids creating an object
+	/// and converting every field to a string for each entry, and lets the tables be handed
+	/// as is to a program that processes many entries at once.
+    class list_columns
+    {
+    public:
+	    /// bits of the flag field
+	static constexpr U_32 flag_hard_linked = 0x0001;   ///< entry is a hard link
+	static constexpr U_32 flag_data_saved = 0x0002;    ///< data (or a delta patch) is present in the archive
+	static constexpr U_32 flag_ea = 0x0004;            ///< entry has Extended Attributes
+	static constexpr U_32 flag_ea_saved = 0x0008;      ///< Extended Attributes are present in the archive
+	static constexpr U_32 flag_fsa = 0x0010;           ///< entry has Filesystem Specific Attributes
+	static constexpr U_32 flag_fsa_saved = 0x0020;     ///< Filesystem Specific Attributes are present in the archive
+	static constexpr U_32 flag_dirty = 0x0040;         ///< file changed while it was read for backup
+	static constexpr U_32 flag_sparse = 0x0080;        ///< file was stored with sparse file detection
+	static constexpr U_32 flag_empty_dir = 0x0100;     ///< directory has no children
+	static constexpr U_32 flag_delta_sig = 0x0200;     ///< file has a delta signature
+	static constexpr U_32 flag_overflow = 0x8000;      ///< at least one field was too large for its table and has been set to its maximum value
+
+	list_columns() { clear(); };
+	list_columns(const list_columns & ref) = default;
+	list_columns(list_columns && ref) noexcept = default;
+	list_columns & operator = (const list_columns & ref) = default;
+	list_columns & operator = (list_columns && ref) noexcept = default;
+	~list_columns() = default;
+
+	    /// number of entries in the batch
+	U_I size() const { return type.size(); };
+
+	    /// name of the entry at the given index
+	std::string get_name(U_I index) const;
+
+	    /// names of all entries, one after the other without separator
+
+	    /// \note the name of entry N starts at offset get_name_offsets()[N] and ends
+	    /// at offset get_name_offsets()[N+1]
+	const std::string & get_name_arena() const { return names; };
+
+	    /// offsets of names in the name arena, this table has size()+1 elements
+	const std::vector<U_64> & get_name_offsets() const { return name_offset; };
+
+	    /// inode type using the same letters as list_entry::get_type()
+
+	    /// \note for hard links the type of the linked inode is given and flag_hard_linked is set,
+	    /// for removed entries (type 'x') the type of the removed inode is given by get_removed_types()
+	const std::vector<unsigned char> & get_types() const { return type; };
+
+	    /// type of the removed inode for removed entries, zero for other entries
+	const std::vector<unsigned char> & get_removed_types() const { return removed_type; };
+
+	    /// combination of the flag_* bits
+	const std::vector<U_32> & get_flags() const { return flags; };
+
+	    /// permission bits, zero for removed entries
+	const std::vector<U_32> & get_perms() const { return perm; };
+
+	const std::vector<U_64> & get_uids() const { return uid; };
+	const std::vector<U_64> & get_gids() const { return gid; };
+
+	    /// file size for plain files, size of the whole subtree for directories, zero otherwise
+	const std::vector<U_64> & get_file_sizes() const { return file_size; };
+
+	    /// amount of byte used in the archive to store the data, zero if no data is saved
+	const std::vector<U_64> & get_storage_sizes() const { return storage_size; };
+
+	    /// offset of the data in the archive (see list_entry::get_archive_offset_for_data()), zero if no data is saved
+	const std::vector<U_64> & get_data_offsets() const { return data_offset; };
+
+	    /// dates in nanoseconds since the end of 1969
+
+	    /// \note for removed entries, last modification holds the removal date
+	const std::vector<S_64> & get_last_access() const { return last_access; };
+	const std::vector<S_64> & get_last_modif() const { return last_modif; };
+	const std::vector<S_64> & get_last_change() const { return last_change; };
+
+	    /// remove all entries from the batch
+	void clear();
+
+	    /// reserve room for the given number of entries
+	void reserve(U_I num);
+
+	    // method for libdar to fill the object
+
+	void add(const cat_nomme & entry);
+
+    private:
+	std::string names;
+	std::vector<U_64> name_offset;
+	std::vector<unsigned char> type;
+	std::vector<unsigned char> removed_type;
+	std::vector<U_32> flags;
+	std::vector<U_32> perm;
+	std::vector<U_64> uid;
+	std::vector<U_64> gid;
+	std::vector<U_64> file_size;
+	std::vector<U_64> storage_size;
+	std::vector<U_64> data_offset;
+	std::vector<S_64> last_access;
+	std::vector<S_64> last_modif;
+	std::vector<S_64> last_change;
+    };
+
+	/// @}
+
+} // end of namespace
+
+#endif
@@ -106,7 +106,7 @@ namespace libdar
 	if(try_resolving_name)
 	    return tools_name_of_uid(uid);
 	else
-	    return deci(uid).human();
+	    return deci::to_string(uid);
     }
 
     string list_entry::get_gid(bool try_resolving_name) const
@@ -114,7 +114,7 @@ namespace libdar
 	if(try_resolving_name)
 	    return tools_name_of_gid(gid);
 	else
-	    return deci(gid).human();
+	    return deci::to_string(gid);
     }
 
     string list_entry::get_perm() const
@@ -167,7 +167,7 @@ namespace libdar
     string list_entry::get_file_size(bool size_in_bytes) const
     {
 	if(size_in_bytes)
-	    return deci(file_size).human();
+	    return deci::to_string(file_size);
 	else
 	    return tools_display_integer_in_metric_system(file_size , "o", true);
     }
@@ -264,7 +264,7 @@ namespace libdar
     string list_entry::get_storage_size_for_data(bool size_in_bytes) const
     {
 	if(size_in_bytes)
-	    return deci(storage_size_for_data).human();
+	    return deci::to_string(storage_size_for_data);
 	else
 	    return tools_display_integer_in_metric_system(storage_size_for_data, "o", true);
     }
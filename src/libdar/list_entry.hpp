@@ -174,7 +174,7 @@ namespace libdar
 	    /// version of this method
 	bool get_archive_offset_for_data(infinint & val) const { val = offset_for_data; return !val.is_zero(); };
 	bool get_archive_offset_for_data(U_64 & val) const;
-	std::string get_archive_offset_for_data() const { return offset_for_data.is_zero() ? "" : deci(offset_for_data).human(); };
+	std::string get_archive_offset_for_data() const { return offset_for_data.is_zero() ? "" : deci::to_string(offset_for_data); };
 
 	    /// amount of byte used to store the file's data
 
@@ -191,12 +191,12 @@ namespace libdar
 	    /// std::string version of this method
 	bool get_archive_offset_for_EA(infinint & val) const { val = offset_for_EA; return !val.is_zero(); };
 	bool get_archive_offset_for_EA(U_64 & val) const;
-	std::string get_archive_offset_for_EA() const { return offset_for_EA.is_zero() ? "" : deci(offset_for_EA).human(); };
+	std::string get_archive_offset_for_EA() const { return offset_for_EA.is_zero() ? "" : deci::to_string(offset_for_EA); };
 
 	    /// amount of byte used to store the file's EA
 	bool get_storage_size_for_EA(infinint & val) const { val = storage_size_for_EA; return !val.is_zero(); };
 	bool get_storage_size_for_EA(U_64 & val) const;
-	std::string get_storage_size_for_EA() const { return storage_size_for_EA.is_zero() ? "" : deci(storage_size_for_EA).human(); };
+	std::string get_storage_size_for_EA() const { return storage_size_for_EA.is_zero() ? "" : deci::to_string(storage_size_for_EA); };
 
 	    /// offset in byte where to find the first byte of Filesystem Specific Attributes
 
@@ -205,12 +205,12 @@ namespace libdar
 	    /// infinint of std::string version of this method
 	bool get_archive_offset_for_FSA(infinint & val) const { val = offset_for_FSA; return !val.is_zero(); };
 	bool get_archive_offset_for_FSA(U_64 & val) const;
-	std::string get_archive_offset_for_FSA() const { return offset_for_FSA.is_zero() ? "" : deci(offset_for_FSA).human(); };
+	std::string get_archive_offset_for_FSA() const { return offset_for_FSA.is_zero() ? "" : deci::to_string(offset_for_FSA); };
 
 	    /// amount of byte used to store the file's FSA
 	bool get_storage_size_for_FSA(infinint & val) const { val = storage_size_for_FSA; return !val.is_zero(); };
 	bool get_storage_size_for_FSA(U_64 & val) const;
-	std::string get_storage_size_for_FSA() const { return storage_size_for_FSA.is_zero() ? "" : deci(storage_size_for_FSA).human(); };
+	std::string get_storage_size_for_FSA() const { return storage_size_for_FSA.is_zero() ? "" : deci::to_string(storage_size_for_FSA); };
 
 	    /// reset the reading of Extended Attributes names
 
@@ -226,7 +226,7 @@ namespace libdar
 	    /// in archive::get_children_of() and in archive_get_children_in_table()
 	bool get_ea_read_next(std::string & key) const;
 
-	std::string get_etiquette() const { return deci(etiquette).human(); }; ///< this is the hard-link ID, only valid for hard linked entries
+	std::string get_etiquette() const { return deci::to_string(etiquette); }; ///< this is the hard-link ID, only valid for hard linked entries
 
 	fsa_scope get_fsa_scope() const { return fsa_sc; };
 
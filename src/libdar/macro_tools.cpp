@@ -93,6 +93,7 @@ namespace libdar
 
 	/// create a compress_module based on the provided arguments
     static unique_ptr<compress_module> make_compress_module_ptr(compression algo, U_I compression_level = 9);
+    static void read_terminateur(pile & stack, generic_file *crypto, const header_version & ver, terminateur & term);
 
     catalogue *macro_tools_get_catalogue_from(const shared_ptr<user_interaction> & dialog,
 					      pile & stack,
@@ -101,7 +102,9 @@ namespace libdar
 					      infinint &cat_size,
 					      const infinint & second_terminateur_offset,
 					      list<signator> & signatories,
-					      bool lax_mode)
+					      bool lax_mode,
+					      U_I decoding_threads,
+					      bool skeleton_only)
     {
 	return macro_tools_get_derivated_catalogue_from(dialog,
 							stack,
@@ -111,7 +114,19 @@ namespace libdar
 							cat_size,
 							second_terminateur_offset,
 							signatories,
-							lax_mode);
+							lax_mode,
+							decoding_threads,
+							skeleton_only);
+    }
+
+    infinint macro_tools_get_catalogue_start(pile & stack,
+					     const header_version & ver)
+    {
+	terminateur term;
+	generic_file *crypto = stack.get_by_label(LIBDAR_STACK_LABEL_UNCYPHERED);
+
+	read_terminateur(stack, crypto, ver, term);
+	return term.get_catalogue_start();
     }
 
     catalogue *macro_tools_get_derivated_catalogue_from(const shared_ptr<user_interaction> & dialog,
@@ -122,7 +137,9 @@ namespace libdar
 							infinint &cat_size,
 							const infinint & second_terminateur_offset,
 							list<signator> & signatories,
-							bool lax_mode)
+							bool lax_mode,
+							U_I decoding_threads,
+							bool skeleton_only)
     {
         terminateur term;
         catalogue *ret = nullptr;
@@ -151,14 +168,7 @@ namespace libdar
         if(info_details)
             dialog->message(gettext("Locating archive contents..."));
 
-	if(ver.get_edition() > 3)
-	    term.read_catalogue(*crypto, ver.is_ciphered(), ver.get_edition(), 0);
-	    // terminator is encrypted since format "04"
-	    // elastic buffer present when encryption is used
-	else
-	    term.read_catalogue(*crypto, false, ver.get_edition());
-	    // elastic buffer did not exist before format "04"
-	cata_stack.flush_read_above(crypto);
+	read_terminateur(cata_stack, crypto, ver, term);
 
         if(info_details)
             dialog->message(gettext("Reading archive contents..."));
@@ -176,7 +186,9 @@ namespace libdar
 					     signatories,
 					     lax_mode,
 					     label_zero,
-					     false); // only_detruit
+					     false, // only_detruit
+					     decoding_threads,
+					     skeleton_only);
 
 	    if(ret == nullptr)
 		throw Ememory();
@@ -257,7 +269,9 @@ namespace libdar
 					  list<signator> & signatories,
 					  bool lax_mode,
 					  const label & lax_layer1_data_name,
-					  bool only_detruits)
+					  bool only_detruits,
+					  U_I decoding_threads,
+					  bool skeleton_only)
     {
         catalogue *ret = nullptr;
 	memory_file hash_to_compare;
@@ -315,7 +329,9 @@ namespace libdar
 					      ver.get_compression_algo(),
 					      lax_mode,
 					      lax_layer1_data_name,
-					      only_detruits);
+					      only_detruits,
+					      decoding_threads,
+					      skeleton_only);
 		if(ret == nullptr)
 		    throw Ememory();
 		try
@@ -754,6 +770,10 @@ namespace libdar
 	    case crypto_algo::twofish256:
 	    case crypto_algo::serpent256:
 	    case crypto_algo::camellia256:
+	    case crypto_algo::aes256_xts:
+	    case crypto_algo::twofish256_xts:
+	    case crypto_algo::serpent256_xts:
+	    case crypto_algo::camellia256_xts:
 		if(info_details)
 		    dialog->message(gettext("Opening cyphering layer..."));
 #ifdef LIBDAR_NO_OPTIMIZATION
@@ -1162,6 +1182,7 @@ namespace libdar
 				   const infinint & file_size,
 				   const infinint & first_file_size,
 				   const string & execute,
+				   U_I async_execute,
 				   crypto_algo crypto,
 				   const secu_string & pass,
 				   U_32 crypto_size,
@@ -1171,7 +1192,7 @@ namespace libdar
 				   const string & slice_permission,
 				   bool add_marks_for_sequential_reading,
 				   const string & user_comment,
-				   hash_algo hash,
+				   const deque<hash_algo> & hash,
 				   const infinint & slice_min_digits,
 				   const label & internal_name,
 				   const label & data_name,
@@ -1203,7 +1224,7 @@ namespace libdar
 
 	    secu_string real_pass = pass;
 
-	    if(hash != hash_algo::none || crypto != crypto_algo::none)
+	    if(!hash.empty() || crypto != crypto_algo::none)
 		open_mode = gf_write_only;
 
 	    try
@@ -1280,7 +1301,8 @@ namespace libdar
 						hash,
 						slice_min_digits,
 						false,
-						execute);
+						execute,
+						async_execute);
 		    }
 
 		    tmp_ctxt = dynamic_cast<contextual*>(tmp);
@@ -1361,6 +1383,10 @@ namespace libdar
 			case crypto_algo::twofish256:
 			case crypto_algo::serpent256:
 			case crypto_algo::camellia256:
+			case crypto_algo::aes256_xts:
+			case crypto_algo::twofish256_xts:
+			case crypto_algo::serpent256_xts:
+			case crypto_algo::camellia256_xts:
 			    gnupg_key_size = tools_max(crypto_sym::max_key_len(crypto),
 						       crypto_sym::max_key_len_libdar(crypto));
 			    break;
@@ -1389,6 +1415,10 @@ namespace libdar
 			case crypto_algo::twofish256:
 			case crypto_algo::serpent256:
 			case crypto_algo::camellia256:
+			case crypto_algo::aes256_xts:
+			case crypto_algo::twofish256_xts:
+			case crypto_algo::serpent256_xts:
+			case crypto_algo::camellia256_xts:
 			    while(!crypto_sym::is_a_strong_password(crypto, clear.get_contents()))
 			    {
 				clear.randomize(gnupg_key_size);
@@ -1484,6 +1514,10 @@ namespace libdar
 		case crypto_algo::twofish256:
 		case crypto_algo::serpent256:
 		case crypto_algo::camellia256:
+		case crypto_algo::aes256_xts:
+		case crypto_algo::twofish256_xts:
+		case crypto_algo::serpent256_xts:
+		case crypto_algo::camellia256_xts:
 		    if(info_details)
 			dialog->message(gettext("Adding a new layer on top: Strong encryption object..."));
 
@@ -2233,6 +2267,21 @@ namespace libdar
             dialog.pause(gettext("The format version of the archive is too high for that software version, try reading anyway?"));
     }
 
+    static void read_terminateur(pile & stack, generic_file *crypto, const header_version & ver, terminateur & term)
+    {
+	if(crypto == nullptr)
+	    throw SRC_BUG;
+
+	if(ver.get_edition() > 3)
+	    term.read_catalogue(*crypto, ver.is_ciphered(), ver.get_edition(), 0);
+	    // terminator is encrypted since format "04"
+	    // elastic buffer present when encryption is used
+	else
+	    term.read_catalogue(*crypto, false, ver.get_edition());
+	    // elastic buffer did not exist before format "04"
+	stack.flush_read_above(crypto);
+    }
+
     static unique_ptr<compress_module> make_compress_module_ptr(compression algo, U_I compression_level)
     {
 	unique_ptr<compress_module> ret;
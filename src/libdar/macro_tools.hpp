@@ -36,6 +36,7 @@ extern "C"
 }
 #include <string>
 #include <vector>
+#include <deque>
 
 #include "catalogue.hpp"
 #include "compression.hpp"
@@ -142,7 +143,9 @@ namespace libdar
 							       infinint &cat_size, // return size of archive in file (not in memory !)
 							       const infinint & second_terminateur_offset, // location of the second terminateur (zero if none exist)
 							       std::list<signator> & signatories, // returns the list of signatories (empty if archive is was not signed)
-							       bool lax_mode);         // whether to do relaxed checkings
+							       bool lax_mode,          // whether to do relaxed checkings
+							       U_I decoding_threads = 1, // number of threads to build the catalogue with
+							       bool skeleton_only = false); // only read the catalogue entries stored out of catalogue chunks
 
 	/// uses terminator to skip to the position where to find the catalogue and read it
     extern catalogue *macro_tools_get_catalogue_from(const std::shared_ptr<user_interaction> & dialog,
@@ -152,7 +155,15 @@ namespace libdar
                                                      infinint &cat_size, // return size of archive in file (not in memory !)
 						     const infinint & second_terminateur_offset,
 						     std::list<signator> & signatories, // returns the list of signatories (empty if archive is was not signed)
-						     bool lax_mode);
+						     bool lax_mode,
+						     U_I decoding_threads = 1, // number of threads to build the catalogue with
+						     bool skeleton_only = false); // only read the catalogue entries stored out of catalogue chunks
+
+	/// uses terminator to provide the position where to find the catalogue
+
+	/// \note the returned offset is to be given to the skip() method of the stack
+    extern infinint macro_tools_get_catalogue_start(pile & stack,
+						    const header_version & ver);
 
 	/// read the catalogue from cata_stack assuming the cata_stack is positionned at the beginning of the area containing archive's dumped data
     extern catalogue *macro_tools_read_catalogue(const std::shared_ptr<user_interaction> & dialog,
@@ -162,7 +173,9 @@ namespace libdar
 						 std::list<signator> & signatories,
 						 bool lax_mode,
 						 const label & lax_layer1_data_name,
-						 bool only_detruits);
+						 bool only_detruits,
+						 U_I decoding_threads = 1,
+						 bool skeleton_only = false);
 
     extern catalogue *macro_tools_lax_search_catalogue(const std::shared_ptr<user_interaction> & dialog,
 						       pile & stack,
@@ -194,6 +207,7 @@ namespace libdar
 	/// \param[in]  file_size size of the slices
 	/// \param[in]  first_file_size size of the first slice
 	/// \param[in]  execute command to execute after each slice creation
+	/// \param[in]  async_execute max number of commands given by execute to run in background (zero for synchronous execution)
 	/// \param[in]  crypto cipher algorithm to use
 	/// \param[in]  pass password/passphrase to use for encryption
 	/// \param[in]  crypto_size size of crypto blocks
@@ -203,7 +217,7 @@ namespace libdar
 	/// \param[in]  slice_permission permission to set the slices to
 	/// \param[in]  add_marks_for_sequential_reading whether to add an escape layer in the stack
 	/// \param[in]  user_comment user comment to add into the slice header/trailer
-	/// \param[in]  hash algorithm to use for slices hashing
+	/// \param[in]  hash algorithms to use for slices hashing, none if empty
 	/// \param[in]  slice_min_digits minimum number of digits slice number must have
 	/// \param[in]  internal_name common label to all slices
 	/// \param[in]  data_name to use in slice header
@@ -254,6 +268,7 @@ namespace libdar
 					  const infinint & file_size,
 					  const infinint & first_file_size,
 					  const std::string & execute,
+					  U_I async_execute,
 					  crypto_algo crypto,
 					  const secu_string & pass,
 					  U_32 crypto_size,
@@ -263,7 +278,7 @@ namespace libdar
 					  const std::string & slice_permission,
 					  bool add_marks_for_sequential_reading,
 					  const std::string & user_comment,
-					  hash_algo hash,
+					  const std::deque<hash_algo> & hash,
 					  const infinint & slice_min_digits,
 					  const label & internal_name,
 					  const label & data_name,
@@ -36,7 +36,8 @@ namespace libdar
 				 const path & fs_root,
 				 const datetime & ignore_older_than_that):
 	fs_racine(fs_root),
-	zoom(0)
+	zoom(0),
+	selection(pass::all)
     {
 	tree.reset(new (nothrow) restore_tree(racine, ignore_older_than_that));
 
@@ -60,6 +61,15 @@ namespace libdar
 	}
     }
 
+    void mask_database::set_pass(pass val, const shared_ptr<restore_dir_journal> & journal) const
+    {
+	if(val == pass::second && !journal)
+	    throw SRC_BUG;
+
+	selection = val;
+	deferred = journal;
+    }
+
     bool mask_database::is_covered(const std::string & expression) const
     {
 	throw SRC_BUG;
@@ -128,7 +138,24 @@ namespace libdar
 	if(zoom == 0)
 	    throw SRC_BUG;
 
-	return tree->restore_from(relative_part, zoom);
+	bool is_dir, single;
+
+	if(!tree->restore_from(relative_part, zoom, is_dir, single))
+	    return false;
+
+	switch(selection)
+	{
+	case pass::all:
+	    return true;
+	case pass::first:
+	    return is_dir || single;
+	case pass::second:
+	    if(!deferred)
+		throw SRC_BUG;
+	    return is_dir || !single || deferred->is_deferred(relative_part.display());
+	default:
+	    throw SRC_BUG;
+	}
     }
 
 } // end of namespace
@@ -52,6 +52,7 @@ extern "C"
 #include "data_dir.hpp"
 #include "datetime.hpp"
 #include "restore_tree.hpp"
+#include "restore_dir_journal.hpp"
 
 
     /// class mask_database
@@ -97,6 +98,20 @@ namespace libdar
 	    /// condition the mask to return is_covered for this provided archive num
 	void set_focus(archive_num focus) const { zoom = focus; };
 
+	    /// the part of the entries to select when the archives are restored concurrently
+	enum class pass
+	{
+	    all,    ///< no restriction, the archives are restored one after the other
+	    first,  ///< entries only restored from the focused archive, and the directories leading to them
+	    second  ///< directories and entries restored from several archives, plus those the first pass deferred
+	};
+
+	    /// restrict the selection to one pass of a concurrent restoration (see restore_dir_journal.hpp)
+
+	    /// \param[in] val the pass to select the entries of
+	    /// \param[in] journal the journal of the focused archive, required for the second pass
+	void set_pass(pass val, const std::shared_ptr<restore_dir_journal> & journal) const;
+
 
 	    /// inherited from class mask
 	virtual bool is_covered(const std::string & expression) const;
@@ -118,6 +133,8 @@ namespace libdar
 
 	path fs_racine;                     ///< prefix to reach the root where restoration will take place
 	mutable archive_num zoom;           ///< the archive to focus on
+	mutable pass selection;             ///< the part of the entries to select
+	mutable std::shared_ptr<restore_dir_journal> deferred; ///< entries the first pass left to the second one
 	std::shared_ptr<restore_tree> tree; ///< contains all info to define archive set to use to restore a given path/file
 	std::shared_ptr<mask> composition;  ///< the mask defining what to restore, while "this" defines *from where* to restore
 
@@ -0,0 +1,393 @@
+/*********************************************************************/
+// dar - disk archive - a backup/restoration program
+// Copyright (C) 2002-2026 Denis Corbin
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// to contact the author, see the AUTHOR file
+/*********************************************************************/
+
+#include "../my_config.h"
+
+extern "C"
+{
+#if HAVE_STRING_H
+#include <string.h>
+#endif
+
+#if HAVE_STRINGS_H
+#include <strings.h>
+#endif
+}
+
+#include "mycurl_ranged_reader.hpp"
+#include "erreurs.hpp"
+#include "tools.hpp"
+
+using namespace std;
+
+namespace libdar
+{
+
+#if defined ( LIBCURL_AVAILABLE ) && defined ( LIBTHREADAR_AVAILABLE )
+
+	/////////////////////////////////////////////////////
+        //
+        // mycurl_ranged_reader class implementation
+        //
+        //
+
+    mycurl_ranged_reader::block::block(U_64 x_offset, U_I x_size):
+	offset(x_offset),
+	size(x_size),
+	filled(0),
+	status(block_status::queued)
+    {
+	data.reset(new (nothrow) char[x_size]);
+	if(!data)
+	    throw Ememory();
+    }
+
+    mycurl_ranged_reader::mycurl_ranged_reader(const shared_ptr<user_interaction> & dialog,
+					       const string & url,
+					       const deque<shared_ptr<mycurl_easyhandle_node> > & handles,
+					       U_I wait_delay):
+	cond(2),
+	next_request(0),
+	file_end(0),
+	stop_workers(false),
+	started(false),
+	offset(0),
+	head_used(0)
+    {
+	if(handles.empty())
+	    throw SRC_BUG;
+
+	try
+	{
+	    for(deque<shared_ptr<mycurl_easyhandle_node> >::const_iterator it = handles.begin();
+		it != handles.end();
+		++it)
+	    {
+		workers.push_back(make_unique<mycurl_ranged_reader_worker>(*this, dialog, url, *it, wait_delay));
+		workers.back()->run();
+	    }
+	}
+	catch(...)
+	{
+	    end_workers();
+	    throw;
+	}
+    }
+
+    mycurl_ranged_reader::~mycurl_ranged_reader()
+    {
+	end_workers();
+    }
+
+    void mycurl_ranged_reader::start(U_64 x_offset, U_64 file_size)
+    {
+	cond.lock();
+	try
+	{
+	    window.clear(); // running blocks are still referred by their worker
+	    next_request = x_offset;
+	    file_end = file_size;
+	    fill_window();
+	}
+	catch(...)
+	{
+	    cond.unlock();
+	    throw;
+	}
+	cond.unlock();
+
+	offset = x_offset;
+	head_used = 0;
+	started = true;
+    }
+
+    void mycurl_ranged_reader::stop()
+    {
+	cond.lock();
+	window.clear();
+	cond.unlock();
+	started = false;
+    }
+
+    U_I mycurl_ranged_reader::read(char *a, U_I size)
+    {
+	U_I ret = 0;
+
+	if(!started)
+	    throw SRC_BUG;
+
+	while(ret < size)
+	{
+	    shared_ptr<block> head;
+
+	    cond.lock();
+	    try
+	    {
+		fill_window();
+		if(!window.empty())
+		{
+		    head = window.front();
+		    while(head->status == block_status::queued
+			  || head->status == block_status::running)
+			cond.wait(cond_caller);
+		}
+	    }
+	    catch(...)
+	    {
+		cond.unlock();
+		throw;
+	    }
+	    cond.unlock();
+
+	    if(!head)
+		break; // end of file
+
+	    if(head->status == block_status::failed)
+		throw Erange(head->error);
+
+		// the block is done, its worker does no more access it
+
+	    U_I avail = head->filled - head_used;
+	    U_I min = size - ret < avail ? size - ret : avail;
+
+	    (void)memcpy(a + ret, head->data.get() + head_used, min);
+	    ret += min;
+	    head_used += min;
+	    offset += min;
+
+	    if(head_used == head->filled)
+	    {
+		cond.lock();
+		if(head->filled < head->size)
+		{
+			// the file is shorter than expected
+		    file_end = offset;
+		    window.clear();
+		}
+		else
+		    window.pop_front();
+		cond.unlock();
+		head_used = 0;
+	    }
+	}
+
+	return ret;
+    }
+
+    void mycurl_ranged_reader::end_workers()
+    {
+	cond.lock();
+	window.clear();
+	stop_workers = true;
+	cond.broadcast(cond_worker);
+	cond.unlock();
+
+	for(deque<unique_ptr<mycurl_ranged_reader_worker> >::iterator it = workers.begin();
+	    it != workers.end();
+	    ++it)
+	{
+	    try
+	    {
+		if(*it)
+		    (*it)->join();
+	    }
+	    catch(...)
+	    {
+		    // ignore all exceptions
+	    }
+	}
+    }
+
+    void mycurl_ranged_reader::fill_window()
+    {
+	while(window.size() < workers.size() * blocks_per_worker
+	      && next_request < file_end)
+	{
+	    U_64 remains = file_end - next_request;
+	    U_I step = remains < block_size ? (U_I)remains : block_size;
+
+	    window.push_back(make_shared<block>(next_request, step));
+	    next_request += step;
+	    cond.signal(cond_worker);
+	}
+    }
+
+    shared_ptr<mycurl_ranged_reader::block> mycurl_ranged_reader::next_block()
+    {
+	shared_ptr<block> ret;
+
+	cond.lock();
+	try
+	{
+	    while(!ret && !stop_workers)
+	    {
+		deque<shared_ptr<block> >::iterator it = window.begin();
+
+		while(it != window.end() && (*it)->status != block_status::queued)
+		    ++it;
+
+		if(it != window.end())
+		{
+		    ret = *it;
+		    ret->status = block_status::running;
+		}
+		else
+		    cond.wait(cond_worker);
+	    }
+	}
+	catch(...)
+	{
+	    cond.unlock();
+	    throw;
+	}
+	cond.unlock();
+
+	return ret;
+    }
+
+    void mycurl_ranged_reader::block_done(const shared_ptr<block> & blk, bool ok, const string & error)
+    {
+	cond.lock();
+	if(ok)
+	    blk->status = block_status::done;
+	else
+	{
+	    blk->error = error;
+	    blk->status = block_status::failed;
+	}
+	cond.broadcast(cond_caller);
+	cond.unlock();
+    }
+
+
+	/////////////////////////////////////////////////////
+        //
+        // mycurl_ranged_reader_worker class implementation
+        //
+        //
+
+    mycurl_ranged_reader_worker::mycurl_ranged_reader_worker(mycurl_ranged_reader & owner,
+							     const shared_ptr<user_interaction> & dialog,
+							     const string & url,
+							     const shared_ptr<mycurl_easyhandle_node> & handle,
+							     U_I wait_delay):
+	pool(owner),
+	ui(dialog),
+	ehandle(handle),
+	wait(wait_delay),
+	overflow(false),
+	http(strncasecmp(url.c_str(), "http", 4) == 0)
+    {
+	if(!ehandle || !ui)
+	    throw SRC_BUG;
+
+	ehandle->setopt(CURLOPT_URL, url);
+	ehandle->setopt(CURLOPT_WRITEFUNCTION, (void*)write_data_callback);
+	ehandle->setopt(CURLOPT_WRITEDATA, (void*)this);
+    }
+
+    void mycurl_ranged_reader_worker::inherited_run()
+    {
+	while((current = pool.next_block()) != nullptr)
+	{
+	    bool ok = false;
+	    string error;
+
+	    try
+	    {
+		string range = to_string(current->offset) + "-" + to_string(current->offset + current->size - 1);
+		U_I restarts = 0;
+
+		ehandle->setopt(CURLOPT_RANGE, range);
+		do
+		{
+		    current->filled = 0;
+		    overflow = false;
+		    try
+		    {
+			ehandle->apply(ui, wait);
+		    }
+		    catch(Erange & e)
+		    {
+			long code = 0;
+
+			if(!overflow)
+			    throw;
+
+			    // a server ignoring the range answers with the whole file
+			    // (HTTP code 200), fetching it again would not help
+			if(http)
+			{
+			    ehandle->getinfo(CURLINFO_RESPONSE_CODE, &code);
+			    if(code != 206)
+				throw Erange(tools_printf(gettext("The server ignored the byte range requested (response code %d), data cannot be fetched by blocks from it"), (S_I)code));
+			}
+
+			    // else libcurl retried the request after a network error
+			    // and provided the data from the beginning of the range
+			    // again, we restart the block from scratch
+			if(++restarts > max_restarts)
+			    throw Erange(gettext("More data than requested received several times for the same byte range, giving up"));
+		    }
+		}
+		while(overflow);
+		ehandle->setopt_default(CURLOPT_RANGE);
+		ok = true;
+	    }
+	    catch(Egeneric & e)
+	    {
+		error = e.get_message();
+	    }
+	    catch(...)
+	    {
+		error = gettext("Unexpected exception caught while fetching data from the remote repository");
+	    }
+
+	    pool.block_done(current, ok, error);
+	    current.reset();
+	}
+    }
+
+    size_t mycurl_ranged_reader_worker::write_data_callback(char *buffer, size_t size, size_t nmemb, void *userp)
+    {
+	mycurl_ranged_reader_worker *me = (mycurl_ranged_reader_worker *)(userp);
+	size_t amount = size * nmemb;
+	size_t room;
+
+	if(me == nullptr || !me->current)
+	    throw SRC_BUG;
+
+	room = me->current->size - me->current->filled;
+	if(amount > room)
+	{
+	    me->overflow = true;
+	    return 0; // more data than requested, this makes libcurl report an error
+	}
+
+	(void)memcpy(me->current->data.get() + me->current->filled, buffer, amount);
+	me->current->filled += amount;
+
+	return amount;
+    }
+
+#endif
+
+} // end of namespace
@@ -0,0 +1,181 @@
+/*********************************************************************/
+// dar - disk archive - a backup/restoration program
+// Copyright (C) 2002-2026 Denis Corbin
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// to contact the author, see the AUTHOR file
+/*********************************************************************/
+
+    /// \file mycurl_ranged_reader.hpp
+    /// \brief several threads fetching consecutive ranges of a remote file at the same time
+    /// \ingroup Private
+    ///
+    /// Each thread uses its own libcurl easy handle and fetches one block of the file at a
+    /// time by mean of a range request. Blocks may complete in any order, they are handed
+    /// back to the caller in file order. This hides the network latency that a single
+    /// sequence of range requests pays at each block.
+
+#ifndef MYCURL_RANGED_READER_HPP
+#define MYCURL_RANGED_READER_HPP
+
+#include "../my_config.h"
+
+extern "C"
+{
+#if LIBCURL_AVAILABLE
+#if HAVE_CURL_CURL_H
+#include <curl/curl.h>
+#endif
+#endif
+} // end extern "C"
+
+#include <string>
+#include <deque>
+#include <memory>
+#ifdef LIBTHREADAR_AVAILABLE
+#include <libthreadar/libthreadar.hpp>
+#endif
+#include "integers.hpp"
+#include "user_interaction.hpp"
+#include "mycurl_easyhandle_node.hpp"
+
+namespace libdar
+{
+
+	/// \addtogroup Private
+	/// @{
+
+#if defined ( LIBCURL_AVAILABLE ) && defined ( LIBTHREADAR_AVAILABLE )
+
+    class mycurl_ranged_reader_worker;
+
+	/// reads a remote file with several range requests in flight
+
+    class mycurl_ranged_reader
+    {
+    public:
+	    /// constructor
+
+	    /// \param[in] dialog for user interaction from the worker threads
+	    /// \param[in] url the file to read
+	    /// \param[in] handles one easy handle per worker thread, carrying the authentication options
+	    /// \param[in] wait_delay retry timeout in case of network error
+	mycurl_ranged_reader(const std::shared_ptr<user_interaction> & dialog,
+			     const std::string & url,
+			     const std::deque<std::shared_ptr<mycurl_easyhandle_node> > & handles,
+			     U_I wait_delay);
+	mycurl_ranged_reader(const mycurl_ranged_reader & ref) = delete;
+	mycurl_ranged_reader(mycurl_ranged_reader && ref) noexcept = delete;
+	mycurl_ranged_reader & operator = (const mycurl_ranged_reader & ref) = delete;
+	mycurl_ranged_reader & operator = (mycurl_ranged_reader && ref) noexcept = delete;
+
+	    /// destructor waits for the running requests to complete and stops the threads
+	~mycurl_ranged_reader();
+
+	    /// drop the pending blocks and start fetching from the given offset
+
+	    /// \param[in] offset where the next read() will start
+	    /// \param[in] file_size size of the file, no data is requested past it
+	void start(U_64 offset, U_64 file_size);
+
+	    /// whether start() has been called since the object creation or the last stop()
+	bool is_started() const { return started; };
+
+	    /// drop the pending blocks, start() must be called before the next read()
+	void stop();
+
+	    /// copy the data found at the current offset and move the offset forward
+
+	    /// \return the amount of byte copied, less than size only at end of file
+	U_I read(char *a, U_I size);
+
+    private:
+	static constexpr unsigned int cond_worker = 0; ///< condition instance workers wait on for a block to fetch
+	static constexpr unsigned int cond_caller = 1; ///< condition instance the caller waits on for a block completion
+	static constexpr U_I block_size = 1048576;     ///< amount of data fetched by a range request
+	static constexpr U_I blocks_per_worker = 2;    ///< size of the window in block per thread
+
+	enum class block_status { queued, running, done, failed };
+
+	struct block
+	{
+	    U_64 offset;          ///< offset of the first byte in the file
+	    U_I size;             ///< amount of byte requested
+	    U_I filled;           ///< amount of byte received
+	    block_status status;
+	    std::unique_ptr<char[]> data;
+	    std::string error;    ///< reason of the failure
+
+	    block(U_64 x_offset, U_I x_size);
+	};
+
+	libthreadar::condition cond;                  ///< protects the following fields
+	std::deque<std::shared_ptr<block> > window;   ///< requested blocks in file order
+	U_64 next_request;                            ///< offset of the next block to request
+	U_64 file_end;                                ///< offset at which to stop requesting
+	bool stop_workers;                            ///< whether workers have to end
+	std::deque<std::unique_ptr<mycurl_ranged_reader_worker> > workers;
+
+	    // fields only used by the caller thread
+
+	bool started;
+	U_64 offset;       ///< offset of the next byte to provide to the caller
+	U_I head_used;     ///< amount of byte of window.front() already provided
+
+	void fill_window(); ///< to be called with cond locked
+	void end_workers(); ///< ask the threads to end and wait for them
+	std::shared_ptr<block> next_block(); ///< called by workers, nullptr means the worker has to end
+	void block_done(const std::shared_ptr<block> & blk, bool ok, const std::string & error); ///< called by workers
+
+	friend class mycurl_ranged_reader_worker;
+    };
+
+
+	/// thread of a mycurl_ranged_reader
+
+    class mycurl_ranged_reader_worker: public libthreadar::thread
+    {
+    public:
+	mycurl_ranged_reader_worker(mycurl_ranged_reader & owner,
+				    const std::shared_ptr<user_interaction> & dialog,
+				    const std::string & url,
+				    const std::shared_ptr<mycurl_easyhandle_node> & handle,
+				    U_I wait_delay);
+
+    protected:
+	virtual void inherited_run() override;
+
+    private:
+	mycurl_ranged_reader & pool;
+	std::shared_ptr<user_interaction> ui;
+	std::shared_ptr<mycurl_easyhandle_node> ehandle;
+	U_I wait;
+	std::shared_ptr<mycurl_ranged_reader::block> current; ///< the block being fetched
+	bool overflow;   ///< set by the callback when more data than requested has been received
+	bool http;       ///< whether the URL uses HTTP(S), for which ranges are answered by a 206 code
+
+	static constexpr const U_I max_restarts = 3; ///< times a block is fetched again after receiving too much data
+
+	static size_t write_data_callback(char *buffer, size_t size, size_t nmemb, void *userp);
+    };
+
+#endif
+
+	/// @}
+
+} // end of namespace
+
+#endif
@@ -398,6 +398,7 @@ namespace libdar
         }
 
         stop_threads();
+	report_workers();
     }
 
     void parallel_block_compressor::send_flag_to_workers(compressor_block_flags flag)
@@ -563,6 +564,27 @@ namespace libdar
         }
     }
 
+    void parallel_block_compressor::report_workers()
+    {
+	layer_statistics::layer *probe = get_probe();
+
+	if(probe == nullptr)
+	    return;
+
+	for(deque<unique_ptr<zip_worker> >::iterator it = travailleurs.begin(); it != travailleurs.end(); ++it)
+	{
+	    layer_statistics::worker rec;
+
+	    if((*it) == nullptr)
+		throw SRC_BUG;
+
+	    rec.name = get_mode() == gf_write_only ? "compression" : "decompression";
+	    rec.busy_ns = (*it)->get_clock().get_busy_ns();
+	    rec.idle_ns = (*it)->get_clock().get_idle_ns();
+	    probe->workers.push_back(rec);
+	}
+    }
+
     compressor_block_flags parallel_block_compressor::purge_ratelier_up_to_non_data()
     {
         S_I expected = num_w;
@@ -947,6 +969,8 @@ namespace libdar
 
     void zip_worker::inherited_run()
     {
+	clock.restart();
+
 	try
 	{
 	    work();
@@ -998,6 +1022,7 @@ namespace libdar
 
 	    if(!transit)
 		transit = reader->worker_get_one(transit_slot, flag);
+	    clock.lap_idle(); // waiting for a block or for room to send the previous one
 
 	    switch(static_cast<compressor_block_flags>(flag))
 	    {
@@ -1020,7 +1045,7 @@ namespace libdar
 										 transit->clear_data.get_max_size()));
 			transit->clear_data.rewind_read();
 		    }
-
+		    clock.lap_busy();
 		}
 		writer->worker_push_one(transit_slot, transit, flag);
 		break;
@@ -106,6 +106,7 @@
 #include "heap.hpp"
 #include "compress_module.hpp"
 #include "proto_compressor.hpp"
+#include "probe_clock.hpp"
 
 #include <libthreadar/libthreadar.hpp>
 
@@ -221,6 +222,7 @@ namespace libdar
 	void run_read_threads();
 	void run_write_threads();
 	compressor_block_flags purge_ratelier_up_to_non_data();
+	void report_workers(); ///< add the busy and idle time of the workers to the layer_statistics of this object, if any
 
 
 	    // static methods
@@ -339,6 +341,9 @@ namespace libdar
 
 	~zip_worker() { cancel(); join(); };
 
+	    /// time spent working and waiting, to be read only once the thread has been joined
+	const probe_clock & get_clock() const { return clock; };
+
     protected:
 	virtual void inherited_run() override;
 
@@ -350,6 +355,7 @@ namespace libdar
 	bool error;
 	std::unique_ptr<crypto_segment> transit;
 	unsigned int transit_slot;
+	probe_clock clock;
 
 	void work();
     };
@@ -644,6 +644,8 @@ namespace libdar
 	    throw SRC_BUG;
 	}
 
+	report_workers();
+
 	    // sanity checks
 
 	if(tas->get_size() != get_heap_size(num_workers))
@@ -1275,6 +1277,27 @@ namespace libdar
 	t_status = thread_status::dead;
     }
 
+    void parallel_tronconneuse::report_workers()
+    {
+	layer_statistics::layer *probe = get_probe();
+
+	if(probe == nullptr)
+	    return;
+
+	for(deque<unique_ptr<crypto_worker> >::iterator it = travailleur.begin(); it != travailleur.end(); ++it)
+	{
+	    layer_statistics::worker rec;
+
+	    if((*it) == nullptr)
+		throw SRC_BUG;
+
+	    rec.name = get_mode() == gf_write_only ? "encryption" : "decryption";
+	    rec.busy_ns = (*it)->get_clock().get_busy_ns();
+	    rec.idle_ns = (*it)->get_clock().get_idle_ns();
+	    probe->workers.push_back(rec);
+	}
+    }
+
     U_I parallel_tronconneuse::get_heap_size(U_I num_workers)
     {
 	U_I ratelier_size = get_ratelier_size(num_workers);
@@ -1716,6 +1739,8 @@ namespace libdar
 
     void crypto_worker::inherited_run()
     {
+	clock.restart();
+
 	try
 	{
 	    waiting->wait(); // initial sync before starting working
@@ -1747,6 +1772,7 @@ namespace libdar
 	    cancellation_checkpoint();
 
 	    ptr = reader->worker_get_one(slot, flag);
+	    clock.lap_idle(); // waiting for a block or for room to send the previous one
 
 	    switch(static_cast<tronco_flags>(flag))
 	    {
@@ -1784,6 +1810,7 @@ namespace libdar
 			flag = static_cast<int>(tronco_flags::data_error);
 			    // we will push the block with this flag data_error
 		    }
+		    clock.lap_busy();
 		    break;
 		case status::inform:
 		    flag = static_cast<int>(tronco_flags::exception_worker);
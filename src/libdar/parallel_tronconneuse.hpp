@@ -44,6 +44,7 @@
 #include "heap.hpp"
 #include "crypto_module.hpp"
 #include "proto_tronco.hpp"
+#include "probe_clock.hpp"
 
 #include <libthreadar/libthreadar.hpp>
 
@@ -304,6 +305,9 @@ namespace libdar
             /// wait for threads to finish and eventually rethrow their exceptions in current thread
         void join_threads();
 
+	    /// add the busy and idle time of the workers to the layer_statistics of this object, if any
+	void report_workers();
+
 
         static U_I get_ratelier_size(U_I num_worker) { return num_worker + num_worker/2; };
         static U_I get_heap_size(U_I num_worker);
@@ -488,6 +492,9 @@ namespace libdar
 
 	virtual ~crypto_worker() { cancel(); join(); };
 
+	    /// time spent working and waiting, to be read only once the thread has been joined
+	const probe_clock & get_clock() const { return clock; };
+
     protected:
 	virtual void inherited_run() override;
 
@@ -502,6 +509,7 @@ namespace libdar
 	std::unique_ptr<crypto_segment> ptr;
 	unsigned int slot;
 	status abort;
+	probe_clock clock;
 
 	void work();
     };
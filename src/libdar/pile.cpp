@@ -22,14 +22,23 @@
 #include "../my_config.h"
 
 #include "pile.hpp"
+#include "probe_clock.hpp"
 
 #include <algorithm>
+#include <typeinfo>
+#ifdef __GNUG__
+#include <cxxabi.h>
+#include <cstdlib>
+#endif
 
 using namespace std;
 
 namespace libdar
 {
 
+	/// name of the class of the given object, used to identify the layers in layer_statistics
+    static string class_name(const generic_file *ptr);
+
 
     void pile::push(generic_file *f, const string & label, bool extend_mode)
     {
@@ -54,6 +63,8 @@ namespace libdar
 	if(label != "")
 	    to_add.labels.push_back(label);
 	stack.push_back(to_add);
+	if(layer_stats)
+	    add_probe(f, stack.size() - 1);
     }
 
     generic_file *pile::pop()
@@ -181,7 +192,19 @@ namespace libdar
 	{
 	    if(stack.back().ptr == nullptr)
 		throw SRC_BUG;
-	    return stack.back().ptr->skip(pos);
+
+	    layer_statistics::layer *probe = stack.back().ptr->get_probe();
+
+	    if(probe == nullptr)
+		return stack.back().ptr->skip(pos);
+	    else
+	    {
+		probe_clock clock;
+		bool ret = stack.back().ptr->skip(pos);
+
+		probe->skip.add(0, clock.lap());
+		return ret;
+	    }
 	}
 	else
 	    throw Erange("Error: skip() on empty stack");
@@ -196,7 +219,19 @@ namespace libdar
 	{
 	    if(stack.back().ptr == nullptr)
 		throw SRC_BUG;
-	    return stack.back().ptr->skip_to_eof();
+
+	    layer_statistics::layer *probe = stack.back().ptr->get_probe();
+
+	    if(probe == nullptr)
+		return stack.back().ptr->skip_to_eof();
+	    else
+	    {
+		probe_clock clock;
+		bool ret = stack.back().ptr->skip_to_eof();
+
+		probe->skip.add(0, clock.lap());
+		return ret;
+	    }
 	}
 	else
 	    throw Erange("Error: skip_to_eof() on empty stack");
@@ -211,7 +246,19 @@ namespace libdar
 	{
 	    if(stack.back().ptr == nullptr)
 		throw SRC_BUG;
-	    return stack.back().ptr->skip_relative(x);
+
+	    layer_statistics::layer *probe = stack.back().ptr->get_probe();
+
+	    if(probe == nullptr)
+		return stack.back().ptr->skip_relative(x);
+	    else
+	    {
+		probe_clock clock;
+		bool ret = stack.back().ptr->skip_relative(x);
+
+		probe->skip.add(0, clock.lap());
+		return ret;
+	    }
 	}
 	else
 	    throw Erange("Error: skip_relative() on empty stack");
@@ -385,6 +432,16 @@ namespace libdar
     }
 
 
+    void pile::set_statistics(const shared_ptr<layer_statistics> & stats)
+    {
+	if(!stats)
+	    throw SRC_BUG;
+
+	layer_stats = stats;
+	for(U_I i = 0; i < stack.size(); ++i)
+	    add_probe(stack[i].ptr, i);
+    }
+
     void pile::detruit()
     {
 	for(deque<face>::reverse_iterator it = stack.rbegin() ; it != stack.rend() ; ++it)
@@ -415,4 +472,37 @@ namespace libdar
 	return it;
     }
 
+    void pile::add_probe(generic_file *ptr, U_I level)
+    {
+	if(ptr == nullptr)
+	    throw SRC_BUG;
+	if(!layer_stats)
+	    throw SRC_BUG;
+
+	ptr->set_probe(&(layer_stats->get_record(level, class_name(ptr))));
+    }
+
+    static string class_name(const generic_file *ptr)
+    {
+	string ret = typeid(*ptr).name();
+	const string prefix = "libdar::";
+
+#ifdef __GNUG__
+	int status = 0;
+	char *demangled = abi::__cxa_demangle(ret.c_str(), nullptr, nullptr, &status);
+
+	if(demangled != nullptr)
+	{
+	    if(status == 0)
+		ret = demangled;
+	    free(demangled);
+	}
+#endif
+
+	if(ret.compare(0, prefix.size(), prefix) == 0)
+	    ret = ret.substr(prefix.size());
+
+	return ret;
+    }
+
 } // end of namespace
@@ -31,7 +31,9 @@
 
 #include <list>
 #include <deque>
+#include <memory>
 #include "generic_file.hpp"
+#include "layer_statistics.hpp"
 
 namespace libdar
 {
@@ -142,6 +144,14 @@ namespace libdar
 	    /// call the generic_file::flush_read() method of all objects found above ptr in the stack
 	void flush_read_above(generic_file *ptr);
 
+	    /// record the activity of each object of the stack into the given statistics
+
+	    /// \param[in] stats where to add a record for each object of the stack, objects pushed
+	    /// later on get their own record too
+	    /// \note skip operations are only recorded when made on the pile itself and are accounted
+	    /// to the object at the top of the stack
+	void set_statistics(const std::shared_ptr<layer_statistics> & stats);
+
 	    // inherited methods from generic_file
 	    // they all apply to the top generic_file object, they fail by Erange() exception if the stack is empty
 
@@ -174,8 +184,10 @@ namespace libdar
 	    // because often a face is design there and the expression "tirer `a pile ou face" (meaning "to toss up") is very common.
 
 	std::deque<face> stack;
+	std::shared_ptr<layer_statistics> layer_stats; ///< where to record the activity of the layers (nullptr if not recorded)
 
 	void detruit();
+	void add_probe(generic_file *ptr, U_I level);
 	std::deque<face>::iterator look_for_label(const std::string & label);
     };
 
@@ -0,0 +1,81 @@
+/*********************************************************************/
+// dar - disk archive - a backup/restoration program
+// Copyright (C) 2002-2026 Denis Corbin
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// to contact the author, see the AUTHOR file
+/*********************************************************************/
+
+    /// \file probe_clock.hpp
+    /// \brief measures durations for layer_statistics
+    /// \ingroup Private
+
+#ifndef PROBE_CLOCK_HPP
+#define PROBE_CLOCK_HPP
+
+#include "../my_config.h"
+
+#include <chrono>
+#include "integers.hpp"
+
+namespace libdar
+{
+
+	/// \addtogroup Private
+	/// @{
+
+	/// measures the time elapsed between successive laps and splits it in busy and idle time
+
+	/// \note an object of this class is not thread-safe, it must be used by a single thread
+	/// and its counters read once that thread has ended
+    class probe_clock
+    {
+    public:
+	probe_clock() { restart(); };
+
+	    /// the time elapsed so far is not accounted
+	void restart() { last = std::chrono::steady_clock::now(); };
+
+	    /// time elapsed since the last lap or restart, in nanoseconds
+	U_64 lap()
+	{
+	    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+	    U_64 ret = std::chrono::duration_cast<std::chrono::nanoseconds>(now - last).count();
+
+	    last = now;
+	    return ret;
+	};
+
+	    /// account the time elapsed since the last lap as busy time
+	void lap_busy() { busy_ns += lap(); };
+
+	    /// account the time elapsed since the last lap as idle time
+	void lap_idle() { idle_ns += lap(); };
+
+	U_64 get_busy_ns() const { return busy_ns; };
+	U_64 get_idle_ns() const { return idle_ns; };
+
+    private:
+	std::chrono::steady_clock::time_point last;
+	U_64 busy_ns = 0;
+	U_64 idle_ns = 0;
+    };
+
+	/// @}
+
+} // end of namespace
+
+#endif
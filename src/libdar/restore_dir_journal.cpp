@@ -0,0 +1,86 @@
+/*********************************************************************/
+// dar - disk archive - a backup/restoration program
+// Copyright (C) 2002-2026 Denis Corbin
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// to contact the author, see the AUTHOR file
+/*********************************************************************/
+
+#include "../my_config.h"
+
+#include "restore_dir_journal.hpp"
+#include "erreurs.hpp"
+
+using namespace std;
+
+namespace libdar
+{
+
+    void restore_dir_journal::created_dirs::add(const string & dir)
+    {
+#ifdef LIBTHREADAR_AVAILABLE
+	access.lock();
+	try
+	{
+#endif
+
+	    dirs.insert(dir);
+
+#ifdef LIBTHREADAR_AVAILABLE
+	}
+	catch(...)
+	{
+	    access.unlock();
+	    throw;
+	}
+	access.unlock();
+#endif
+    }
+
+    bool restore_dir_journal::created_dirs::take(const string & dir)
+    {
+	bool ret;
+
+#ifdef LIBTHREADAR_AVAILABLE
+	access.lock();
+	try
+	{
+#endif
+
+	    ret = dirs.erase(dir) > 0;
+
+#ifdef LIBTHREADAR_AVAILABLE
+	}
+	catch(...)
+	{
+	    access.unlock();
+	    throw;
+	}
+	access.unlock();
+#endif
+
+	return ret;
+    }
+
+    restore_dir_journal::restore_dir_journal(const shared_ptr<created_dirs> & created):
+	first_pass(true),
+	shared(created)
+    {
+	if(!shared)
+	    throw SRC_BUG;
+    }
+
+} // end of namespace
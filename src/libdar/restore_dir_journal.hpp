@@ -0,0 +1,138 @@
+/*********************************************************************/
+// dar - disk archive - a backup/restoration program
+// Copyright (C) 2002-2026 Denis Corbin
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// to contact the author, see the AUTHOR file
+/*********************************************************************/
+
+    /// \file restore_dir_journal.hpp
+    /// \brief records what the concurrent extractions did to directories
+    /// \ingroup Private
+    ///
+    /// When database::restore() extracts several archives concurrently, each
+    /// archive first restores the files only it provides, directories being
+    /// only used as path to reach them (their metadata is not restored). Then
+    /// the archives are extracted a second time, one after the other in date
+    /// order, for directories and for the files needing several archives.
+    /// The journal lets this second pass restore directories as if the
+    /// first pass had not taken place: a directory created by the first pass
+    /// is considered as created by the second pass of the oldest archive
+    /// having it, and a directory into which an archive restored something
+    /// gets the metadata this archive has for it.
+
+#ifndef RESTORE_DIR_JOURNAL_HPP
+#define RESTORE_DIR_JOURNAL_HPP
+
+#include "../my_config.h"
+
+#include <string>
+#include <set>
+#include <memory>
+
+#if HAVE_LIBTHREADAR_LIBTHREADAR_HPP
+#include <libthreadar/libthreadar.hpp>
+#endif
+
+namespace libdar
+{
+
+	/// \addtogroup Private
+	/// @{
+
+	/// what the extraction of an archive did to directories while only restoring files
+
+	/// there is one journal per archive, the journals of a same restoration share the set
+	/// of directories created by the first pass, which may be modified concurrently
+    class restore_dir_journal
+    {
+    public:
+	    /// set of directories created by the first pass of a restoration
+	class created_dirs
+	{
+	public:
+	    created_dirs() = default;
+	    created_dirs(const created_dirs & ref) = delete;
+	    created_dirs(created_dirs && ref) noexcept = delete;
+	    created_dirs & operator = (const created_dirs & ref) = delete;
+	    created_dirs & operator = (created_dirs && ref) noexcept = delete;
+	    ~created_dirs() = default;
+
+	    void add(const std::string & dir);
+
+		/// remove the directory from the set
+		/// \return whether the directory was part of the set
+	    bool take(const std::string & dir);
+
+	private:
+	    std::set<std::string> dirs;
+#ifdef LIBTHREADAR_AVAILABLE
+	    libthreadar::mutex access;
+#endif
+	};
+
+	    /// constructor
+	    /// \param[in] created set of directories shared by the journals of a same restoration
+	restore_dir_journal(const std::shared_ptr<created_dirs> & created);
+	restore_dir_journal(const restore_dir_journal & ref) = delete;
+	restore_dir_journal(restore_dir_journal && ref) noexcept = delete;
+	restore_dir_journal & operator = (const restore_dir_journal & ref) = delete;
+	restore_dir_journal & operator = (restore_dir_journal && ref) noexcept = delete;
+	~restore_dir_journal() = default;
+
+	    /// whether the first pass is running, the journal is replayed by the second pass else
+	bool recording() const { return first_pass; };
+
+	    /// end of the first pass for the archive this journal is for
+	void set_replay() { first_pass = false; };
+
+
+	    // used by the first pass
+
+	    /// the directory has been created, only to restore files under it
+	void created(const std::string & dir) { shared->add(dir); };
+
+	    /// something has been restored in the directory
+	void changed_in(const std::string & dir) { changed.insert(dir); };
+
+	    /// the hard linked inode is left to the second pass
+	void defer(const std::string & entry) { deferred.insert(entry); };
+
+
+	    // used by the second pass
+
+	    /// whether the directory has been created by the first pass and not yet considered by the second
+	    /// \note the directory is considered by the second pass from now on
+	bool take_created(const std::string & dir) { return shared->take(dir); };
+
+	    /// whether the first pass of the archive restored something in that directory
+	bool was_changed_in(const std::string & dir) const { return changed.find(dir) != changed.end(); };
+
+	    /// whether the entry has been left to the second pass
+	bool is_deferred(const std::string & entry) const { return deferred.find(entry) != deferred.end(); };
+
+    private:
+	bool first_pass;
+	std::shared_ptr<created_dirs> shared;
+	std::set<std::string> changed;
+	std::set<std::string> deferred;
+    };
+
+	/// @}
+
+} // end of namespace
+
+#endif
@@ -45,6 +45,8 @@ namespace libdar
 	if(source == nullptr)
 	    throw SRC_BUG;
 
+	directory = source_dir != nullptr;
+
 	    //*** setting up locations
 
 	data_ret = source->get_data(data_set, max_date, false);
@@ -127,6 +129,13 @@ namespace libdar
     }
 
     bool restore_tree::restore_from(const path & chem, archive_num num) const
+    {
+	bool is_dir, single;
+
+	return restore_from(chem, num, is_dir, single);
+    }
+
+    bool restore_tree::restore_from(const path & chem, archive_num num, bool & is_dir, bool & single) const
     {
 	const restore_tree* found = nullptr;
 
@@ -139,6 +148,9 @@ namespace libdar
 	if(found == nullptr)
 	    throw SRC_BUG;
 
+	is_dir = found->directory;
+	single = found->locations.size() == 1;
+
 	return found->result_for(num);
     }
 
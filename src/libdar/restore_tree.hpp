@@ -83,7 +83,16 @@ namespace libdar
 	    /// but also because more recent archive have better version to be restored instread.
 	bool restore_from(const path & chem, archive_num num) const;
 
+	    /// same as restore_from() above, also telling the kind of entry
+
+	    /// \param[in] chem path to the inode to be restored (should always be a relative path)
+	    /// \param[in] num the archive num to be restored from
+	    /// \param[out] is_dir whether the entry is a directory in the database
+	    /// \param[out] single whether num is the only archive the entry is restored from
+	bool restore_from(const path & chem, archive_num num, bool & is_dir, bool & single) const;
+
     private:
+	bool directory;
 	std::set<archive_num> locations;
 	std::map<std::string, std::unique_ptr<restore_tree> > children;
 
@@ -112,6 +112,7 @@ extern "C"
 #include "entrepot.hpp"
 #include "sar_tools.hpp"
 #include "fichier_global.hpp"
+#include "entrepot_local.hpp"
 
 using namespace std;
 
@@ -137,13 +138,14 @@ namespace libdar
         initial = true;
         hook = execute;
         set_info_status(CONTEXT_INIT);
-	hash = hash_algo::none;
+	hash.clear();
 	lax = x_lax;
 	min_digits = x_min_digits;
 	seq_read = sequential_read;
 	entr = where;
 	force_perm = false;
 	to_read_ahead = 0;
+	pre_create = false;
 
         open_file_init();
 
@@ -179,10 +181,11 @@ namespace libdar
 	     const label & data_name,
 	     bool force_permission,
 	     U_I permission,
-	     hash_algo x_hash,
+	     const deque<hash_algo> & x_hash,
 	     const infinint & x_min_digits,
 	     bool format_07_compatible,
-	     const string & execute) : generic_file(open_mode), mem_ui(dialog)
+	     const string & execute,
+	     U_I async_hooks) : generic_file(open_mode), mem_ui(dialog)
     {
 	if(open_mode == gf_read_only)
 	    throw SRC_BUG;
@@ -226,6 +229,24 @@ namespace libdar
 	    if(!entr)
 		throw SRC_BUG;
 
+	    pre_create = async_hooks > 0
+		&& pause.is_zero()
+		&& hash.empty()
+		&& dynamic_cast<entrepot_local *>(entr.get()) != nullptr;
+		// other entrepot types are not expected to support
+		// concurrent operations from different threads
+
+	    if(async_hooks > 0 && hook != "")
+	    {
+#ifdef LIBTHREADAR_AVAILABLE
+		hooks.reset(new (nothrow) sar_hook_pool(async_hooks));
+		if(!hooks)
+		    throw Ememory();
+#else
+		throw Ecompilation(gettext("libthreadar is required at compilation time in order to execute user commands in background"));
+#endif
+	    }
+
 	    open_file(1);
 	}
 	catch(...)
@@ -249,8 +270,12 @@ namespace libdar
     void sar::inherited_terminate()
     {
         close_file(true);
+#ifdef LIBTHREADAR_AVAILABLE
+	next_slice.reset(); // removes the slice created ahead of time if not used
+#endif
         if(get_mode() != gf_read_only && natural_destruction)
 	{
+	    hook_wait_all();
 	    set_info_status(CONTEXT_LAST_SLICE);
             hook_execute(of_current);
 	}
@@ -270,7 +295,7 @@ namespace libdar
 
     bool sar::skippable(skippability direction, const infinint & amount)
     {
-	if(hash != hash_algo::none)
+	if(!hash.empty())
 	    return false;
 
 	if(of_current.is_zero() && initial)
@@ -605,6 +630,60 @@ namespace libdar
             return file_offset - slicing.get_first_slice_header_size();
     }
 
+    fichier_local *sar::direct_read_access(infinint & avail)
+    {
+	fichier_local *ret = nullptr;
+	infinint trailer = slicing.get_format_07_compatibility() ? 0 : 1;
+
+	if(is_terminated() || get_mode() != gf_read_only)
+	    throw SRC_BUG;
+
+	avail = 0;
+	if(of_current.is_zero())
+	    skip(0);
+	    // this will trigger the fetch of the slice
+	    // header from the first slice
+
+	if(of_fd == nullptr || size_of_current.is_zero() || lax)
+	    return nullptr;
+
+	ret = dynamic_cast<fichier_local *>(of_fd);
+	if(ret == nullptr)
+	    return nullptr;
+
+	if(size_of_current < file_offset + trailer || ret->get_position() != file_offset)
+	    return nullptr;
+
+	avail = size_of_current - file_offset - trailer;
+	return ret;
+    }
+
+    fichier_local *sar::direct_write_access(infinint & room)
+    {
+	fichier_local *ret = nullptr;
+	infinint trailer = slicing.get_format_07_compatibility() ? 0 : 1;
+	infinint size;
+
+	if(is_terminated() || get_mode() == gf_read_only)
+	    throw SRC_BUG;
+
+	room = 0;
+	if(of_current.is_zero())
+	    skip(0);
+
+	size = of_current == 1 ? slicing.get_first_slice_size() : slicing.get_slice_size();
+
+	ret = dynamic_cast<fichier_local *>(of_fd);
+	if(ret == nullptr)
+	    return nullptr; // hash_fichier objects are not fichier_local
+
+	if(size < file_offset + trailer || ret->get_position() != file_offset)
+	    return nullptr;
+
+	room = size - file_offset - trailer;
+	return ret;
+    }
+
     void sar::inherited_read_ahead(const infinint & amount)
     {
 	infinint avail_in_slice;
@@ -1121,7 +1200,7 @@ namespace libdar
 	    {
 		of_fd = entr->open(get_pointer(),
 				   fic,
-				   hash == hash_algo::none ? gf_read_write : gf_write_only,
+				   hash.empty() ? gf_read_write : gf_write_only,
 				       // yes, no anymore always writeonly as stated in the name of this method
 				   force_perm,
 				   perm,
@@ -1241,7 +1320,7 @@ namespace libdar
 			    // open with overwriting
 			of_fd = entr->open(get_pointer(),
 					   fic,
-					   hash == hash_algo::none ? gf_read_write : gf_write_only, // yes, no more write only as stated in the name of this method
+					   hash.empty() ? gf_read_write : gf_write_only, // yes, no more write only as stated in the name of this method
 					   force_perm,
 					   perm,
 					   false,    //< fail if exists
@@ -1249,10 +1328,10 @@ namespace libdar
 					   hash);
 		    }
 		    else // open without overwriting
-			if(hash == hash_algo::none)
+			if(hash.empty())
 			    of_fd = entr->open(get_pointer(),
 					       fic,
-					       hash == hash_algo::none ? gf_read_write : gf_write_only, // yes, no more write only as stated in the name of this method
+					       hash.empty() ? gf_read_write : gf_write_only, // yes, no more write only as stated in the name of this method
 					       force_perm,
 					       perm,
 					       false, //< fail if exists
@@ -1403,7 +1482,9 @@ namespace libdar
 		else
 		    initial = false;
 
-		open_writeonly(display, num);
+		if(!use_next_slice(display, num))
+		    open_writeonly(display, num);
+		prepare_next_slice(num + 1);
 		break;
 	    default :
 		close_file(false);
@@ -1644,15 +1725,30 @@ namespace libdar
 		if(!entr)
 		    throw SRC_BUG;
 
-		tools_hook_substitute_and_execute(get_ui(),
-						  hook,
-						  entr->get_full_path().display(),
-						  base,
-						  num_str,
-						  sar_tools_make_padded_number(num_str, min_digits),
-						  ext,
-						  get_info_status(),
-						  entr->get_url());
+#ifdef LIBTHREADAR_AVAILABLE
+		if(hooks && get_info_status() == CONTEXT_OP)
+		{
+		    hook_report_failures();
+		    hooks->submit(tools_hook_substitute(hook,
+							entr->get_full_path().display(),
+							base,
+							num_str,
+							sar_tools_make_padded_number(num_str, min_digits),
+							ext,
+							get_info_status(),
+							entr->get_url()));
+		}
+		else
+#endif
+		    tools_hook_substitute_and_execute(get_ui(),
+						      hook,
+						      entr->get_full_path().display(),
+						      base,
+						      num_str,
+						      sar_tools_make_padded_number(num_str, min_digits),
+						      ext,
+						      get_info_status(),
+						      entr->get_url());
 	    }
 	    catch(Escript & g)
 	    {
@@ -1662,6 +1758,119 @@ namespace libdar
 	}
     }
 
+    void sar::hook_wait_all()
+    {
+#ifdef LIBTHREADAR_AVAILABLE
+	if(hooks)
+	{
+	    hooks->wait_all();
+	    hook_report_failures();
+	}
+#endif
+    }
+
+    void sar::hook_report_failures()
+    {
+#ifdef LIBTHREADAR_AVAILABLE
+	string cmd_line;
+	string message;
+
+	if(!hooks)
+	    throw SRC_BUG;
+
+	while(hooks->pop_failure(cmd_line, message))
+	{
+	    bool retry;
+
+	    try
+	    {
+		get_ui().pause(tools_printf(gettext("Error during background execution of user command line [ %S ]: %S . Retry command-line ?"), &cmd_line, &message));
+		retry = true;
+	    }
+	    catch(Euser_abort & e)
+	    {
+		retry = false;
+	    }
+
+	    try
+	    {
+		if(retry)
+		    tools_hook_execute(get_ui(), cmd_line);
+		else
+		    get_ui().pause(gettext("Ignore previous error on user command line and continue ?"));
+	    }
+	    catch(Euser_abort & g)
+	    {
+		natural_destruction = false;
+		throw Escript(string(gettext("Fatal error on user command line: ")) + g.get_message());
+	    }
+	}
+#endif
+    }
+
+    void sar::prepare_next_slice(const infinint & num)
+    {
+#ifdef LIBTHREADAR_AVAILABLE
+	if(pre_create)
+	{
+	    next_slice.reset(); // removes a previously created slice that has not been used
+	    next_slice.reset(new (nothrow) sar_slice_opener(get_pointer(),
+							    entr,
+							    sar_tools_make_filename(base, num, min_digits, ext),
+							    gf_read_write,
+							    force_perm,
+							    perm));
+	    if(!next_slice)
+		throw Ememory();
+	}
+#endif
+    }
+
+    bool sar::use_next_slice(const string & fic, const infinint & num)
+    {
+#ifdef LIBTHREADAR_AVAILABLE
+	if(!next_slice)
+	    return false;
+
+	if(next_slice->get_filename() != fic)
+	{
+	    next_slice.reset();
+	    return false;
+	}
+
+	if(of_fd != nullptr)
+	    throw SRC_BUG;
+
+	of_fd = next_slice->release();
+	next_slice.reset();
+
+	if(of_fd == nullptr)
+	    return false; // slice could not be created in advance
+
+	try
+	{
+	    slicing.set_flag(flag_type_located_at_end_of_slice);
+	    slicing.write(get_ui(), *of_fd, num == 1, false);
+
+	    if(num == 1)
+		size_of_current = slicing.get_first_slice_size();
+	    else
+		size_of_current = slicing.get_slice_size();
+	}
+	catch(...)
+	{
+	    delete of_fd;
+	    of_fd = nullptr;
+	    entr->unlink(fic);
+	    throw;
+	}
+
+	return true;
+#else
+	return false;
+#endif
+    }
+
     bool sar::is_current_eof_a_normal_end_of_slice() const
     {
 	infinint delta = slicing.get_format_07_compatibility() ? 0 : 1; // one byte less per slice with archive format >= 8
@@ -29,6 +29,7 @@
 #include "../my_config.h"
 
 #include <string>
+#include <deque>
 #include "infinint.hpp"
 #include "generic_file.hpp"
 #include "slice_header.hpp"
@@ -38,6 +39,10 @@
 #include "contextual.hpp"
 #include "mem_ui.hpp"
 #include "thread_cancellation.hpp"
+#include "fichier_local.hpp"
+#ifdef LIBTHREADAR_AVAILABLE
+#include "sar_async.hpp"
+#endif
 
 namespace libdar
 {
@@ -109,6 +114,9 @@ namespace libdar
 	    /// \param[in] x_min_digits is the minimum number of digits the slices number is stored with in the filename
 	    /// \param[in] format_07_compatible when set to true, creates a slice header in the archive format of version 7 instead of the highest version known
 	    /// \param[in] execute is the command to execute after each slice creation (once it is completed)
+	    /// \param[in] async_hooks when not zero, the command given by execute is run in background for all
+	    /// slices but the last one, with at most async_hooks commands in flight at any time. The next slice is
+	    /// then also created ahead of time when slices are stored in a local directory and no pause nor hash is required
 	    /// \note data_name should be equal to internal_name except when reslicing an archive as dar_xform does in which
 	    /// case internal_name is randomly, and data_name is kept from the source archive
         sar(const std::shared_ptr<user_interaction> & dialog,
@@ -125,10 +133,11 @@ namespace libdar
 	    const label & data_name,
 	    bool force_permission,
 	    U_I permission,
-	    hash_algo x_hash,
+	    const std::deque<hash_algo> & x_hash,
 	    const infinint & x_min_digits,
 	    bool format_07_compatible,
-	    const std::string & execute = "");
+	    const std::string & execute = "",
+	    U_I async_hooks = 0);
 
 	    /// the copy constructor
    	sar(const sar & ref) = delete;
@@ -169,6 +178,30 @@ namespace libdar
 	    /// get a reference to the slice header (inherited from contextual class)
 	const slice_header & get_slice_info() const override { fetch_slicing(); return slicing; };
 
+	    /// direct access to the slice being read (read mode only)
+
+	    /// \param[out] avail amount of data that can be read from the returned object before
+	    /// reaching the end of the current slice
+	    /// \return the slice file positionned at the current reading offset, or nullptr if the
+	    /// slice is not a local file or its size is not known (sequential read mode)
+	    /// \note direct_read_done() must be called once data has been read from the returned object
+	fichier_local *direct_read_access(infinint & avail);
+
+	    /// inform the sar object that the given amount of data has been read from direct_read_access() returned object
+	void direct_read_done(U_I amount) { file_offset += amount; };
+
+	    /// direct access to the slice being written (write mode only)
+
+	    /// \param[out] room amount of data that can be written to the returned object
+	    /// before the current slice is full
+	    /// \return the slice file positionned at the current writing offset, or nullptr
+	    /// if the slice is not a local file or if it is hashed while written
+	    /// \note direct_write_done() must be called once data has been written to the returned object
+	fichier_local *direct_write_access(infinint & room);
+
+	    /// inform the sar object that the given amount of data has been written to direct_write_access() returned object
+	void direct_write_done(U_I amount) { file_offset += amount; };
+
     protected :
 	virtual void inherited_read_ahead(const infinint & amount) override;
         virtual U_I inherited_read(char *a, U_I size) override;
@@ -185,7 +218,7 @@ namespace libdar
         std::string hook;            ///< command line to execute between slices
 	slice_header slicing;        ///< slice layout
         infinint file_offset;        ///< current reading/writing position in the current slice (relative to the whole slice file, including headers)
-	hash_algo hash;              ///< whether to build a hashing when creating slices, and if so, which algorithm to use
+	std::deque<hash_algo> hash; ///< hash algorithms to use when creating slices, none if empty
 	infinint min_digits;         ///< minimum number of digits the slices number is stored with in the filename
         bool natural_destruction;    ///< whether to execute commands between slices on object destruction
             // these following variables are modified by open_file / open_file_init
@@ -209,6 +242,11 @@ namespace libdar
 	infinint to_read_ahead;      ///< amount of data to read ahead for next slices
 	bool seq_read;               ///< whether sequential read has been requested
 	thread_cancellation thr;     ///< used to know whether to ask the user or assume negative answer to allow proper archive terminatio
+	bool pre_create;             ///< whether to create the next slice ahead of time (write mode only)
+#ifdef LIBTHREADAR_AVAILABLE
+	std::unique_ptr<sar_hook_pool> hooks;        ///< background execution of hook between slices (write mode only)
+	std::unique_ptr<sar_slice_opener> next_slice; ///< slice being created ahead of time (write mode only)
+#endif
 
 	bool skip_forward(U_I x);                    ///< skip forward in sar global contents
 	bool skip_backward(U_I x);                   ///< skip backward in sar global contents
@@ -232,6 +270,10 @@ namespace libdar
 			  const infinint & slice_num);///< the slice number where from the header has ebeen taken
             // function to lauch the eventually existing command to execute after/before each slice
         void hook_execute(const infinint &num);
+	void hook_wait_all();                         ///< wait for background commands to complete and report their failures
+	void hook_report_failures();                  ///< ask the user about background commands that failed
+	void prepare_next_slice(const infinint & num); ///< launch the creation of slice num ahead of time if possible
+	bool use_next_slice(const std::string & fic, const infinint & num); ///< open slice num from the one created ahead of time, return false if not possible
     };
 
 	/// @}
@@ -0,0 +1,305 @@
+/*********************************************************************/
+// dar - disk archive - a backup/restoration program
+// Copyright (C) 2002-2026 Denis Corbin
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// to contact the author, see the AUTHOR file
+/*********************************************************************/
+
+#include "../my_config.h"
+
+extern "C"
+{
+}
+
+#include "sar_async.hpp"
+#include "erreurs.hpp"
+#include "tools.hpp"
+
+using namespace std;
+using namespace libthreadar;
+
+namespace libdar
+{
+
+	/////////////////////////////////////////////////////
+        //
+        // sar_hook_pool class implementation
+        //
+        //
+
+    sar_hook_pool::sar_hook_pool(U_I max_in_flight):
+	max_flight(max_in_flight),
+	cond(2),
+	running(0),
+	stop(false)
+    {
+	if(max_flight == 0)
+	    throw SRC_BUG;
+
+	for(U_I i = 0; i < max_flight; ++i)
+	{
+	    workers.push_back(make_unique<sar_hook_worker>(*this));
+	    workers.back()->run();
+	}
+    }
+
+    sar_hook_pool::~sar_hook_pool()
+    {
+	cond.lock();
+	pending.clear(); // commands not yet started are dropped
+	stop = true;
+	cond.broadcast(cond_worker);
+	cond.unlock();
+
+	for(deque<unique_ptr<sar_hook_worker> >::iterator it = workers.begin();
+	    it != workers.end();
+	    ++it)
+	{
+	    try
+	    {
+		if(*it)
+		    (*it)->join();
+	    }
+	    catch(...)
+	    {
+		    // ignore all exceptions
+	    }
+	}
+    }
+
+    void sar_hook_pool::submit(const string & cmd_line)
+    {
+	cond.lock();
+	try
+	{
+	    while(pending.size() + running >= max_flight)
+		cond.wait(cond_caller);
+	    pending.push_back(cmd_line);
+	    cond.signal(cond_worker);
+	}
+	catch(...)
+	{
+	    cond.unlock();
+	    throw;
+	}
+	cond.unlock();
+    }
+
+    void sar_hook_pool::wait_all()
+    {
+	cond.lock();
+	try
+	{
+	    while(!pending.empty() || running > 0)
+		cond.wait(cond_caller);
+	}
+	catch(...)
+	{
+	    cond.unlock();
+	    throw;
+	}
+	cond.unlock();
+    }
+
+    bool sar_hook_pool::pop_failure(string & cmd_line, string & message)
+    {
+	bool ret = false;
+
+	cond.lock();
+	if(!failures.empty())
+	{
+	    cmd_line = failures.front().first;
+	    message = failures.front().second;
+	    failures.pop_front();
+	    ret = true;
+	}
+	cond.unlock();
+
+	return ret;
+    }
+
+    bool sar_hook_pool::next_command(string & cmd_line)
+    {
+	bool ret;
+
+	cond.lock();
+	try
+	{
+	    while(pending.empty() && !stop)
+		cond.wait(cond_worker);
+
+	    ret = !pending.empty();
+	    if(ret)
+	    {
+		cmd_line = pending.front();
+		pending.pop_front();
+		++running;
+	    }
+	}
+	catch(...)
+	{
+	    cond.unlock();
+	    throw;
+	}
+	cond.unlock();
+
+	return ret;
+    }
+
+    void sar_hook_pool::command_done(const string & cmd_line, const string & failure)
+    {
+	cond.lock();
+	if(running == 0)
+	{
+	    cond.unlock();
+	    throw SRC_BUG;
+	}
+	--running;
+	if(!failure.empty())
+	    failures.push_back(make_pair(cmd_line, failure));
+	cond.broadcast(cond_caller);
+	cond.unlock();
+    }
+
+
+	/////////////////////////////////////////////////////
+        //
+        // sar_hook_worker class implementation
+        //
+        //
+
+    void sar_hook_worker::inherited_run()
+    {
+	string cmd_line;
+
+	while(pool.next_command(cmd_line))
+	{
+	    string failure = "";
+
+	    try
+	    {
+		tools_hook_execute_once(cmd_line);
+	    }
+	    catch(Egeneric & e)
+	    {
+		failure = e.get_message();
+		if(failure.empty())
+		    failure = "?";
+	    }
+	    catch(...)
+	    {
+		failure = "unknown exception caught while executing user command";
+	    }
+
+	    pool.command_done(cmd_line, failure);
+	}
+    }
+
+
+	/////////////////////////////////////////////////////
+        //
+        // sar_slice_opener class implementation
+        //
+        //
+
+    sar_slice_opener::sar_slice_opener(const shared_ptr<user_interaction> & dialog,
+				       const shared_ptr<entrepot> & where,
+				       const string & filename,
+				       gf_mode mode,
+				       bool force_permission,
+				       U_I permission):
+	ui(dialog),
+	entr(where),
+	fic(filename),
+	open_mode(mode),
+	force_perm(force_permission),
+	perm(permission),
+	created(nullptr)
+    {
+	if(!entr)
+	    throw SRC_BUG;
+	run();
+    }
+
+    sar_slice_opener::~sar_slice_opener()
+    {
+	try
+	{
+	    wait_for_thread();
+	    if(created != nullptr)
+	    {
+		    // the file has not been used, we remove it
+		delete created;
+		created = nullptr;
+		entr->unlink(fic);
+	    }
+	}
+	catch(...)
+	{
+		// ignore all exceptions
+	}
+    }
+
+    fichier_global *sar_slice_opener::release()
+    {
+	fichier_global *ret;
+
+	wait_for_thread();
+	ret = created;
+	created = nullptr;
+
+	return ret;
+    }
+
+    void sar_slice_opener::inherited_run()
+    {
+	try
+	{
+	    created = entr->open(ui,
+				 fic,
+				 open_mode,
+				 force_perm,
+				 perm,
+				 true,  //< fail_if_exists
+				 false, //< erase
+				 hash_algo::none);
+	}
+	catch(...)
+	{
+	    created = nullptr;
+		// the caller will create the slice the usual way
+	}
+    }
+
+    void sar_slice_opener::wait_for_thread()
+    {
+	try
+	{
+	    join();
+	}
+	catch(...)
+	{
+	    if(created != nullptr)
+	    {
+		delete created;
+		created = nullptr;
+	    }
+		// the caller will create the slice the usual way
+	}
+    }
+
+} // end of namespace
@@ -0,0 +1,177 @@
+/*********************************************************************/
+// dar - disk archive - a backup/restoration program
+// Copyright (C) 2002-2026 Denis Corbin
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// to contact the author, see the AUTHOR file
+/*********************************************************************/
+
+    /// \file sar_async.hpp
+    /// \brief helper threads used by sar to take slice boundary work out of the data path
+    /// \ingroup Private
+    ///
+    /// Two classes are defined here:
+    /// - class sar_hook_pool, which runs the user command given to sar (-E option) in
+    ///   background threads, at most a given number of them being in flight at any time.
+    ///   When this maximum is reached, submitting a new command blocks the caller until
+    ///   a previous one has completed (back-pressure). Commands are not executed through
+    ///   user interaction, failures are recorded and reported later by the caller thread
+    ///   which is the only one allowed to interact with the user.
+    /// - class sar_slice_opener, which creates the next slice file in a separated thread
+    ///   while the current slice is being filled.
+    /// .
+
+#ifndef SAR_ASYNC_HPP
+#define SAR_ASYNC_HPP
+
+#include "../my_config.h"
+
+#include <string>
+#include <deque>
+#include <memory>
+#include "integers.hpp"
+#include "entrepot.hpp"
+#include "fichier_global.hpp"
+
+#include <libthreadar/libthreadar.hpp>
+
+namespace libdar
+{
+
+	/// \addtogroup Private
+	/// @{
+
+    class sar_hook_worker;
+
+	/// pool of threads running user commands between slices
+
+    class sar_hook_pool
+    {
+    public:
+	    /// constructor
+
+	    /// \param[in] max_in_flight maximum number of commands running or waiting to run at any given time
+	sar_hook_pool(U_I max_in_flight);
+	sar_hook_pool(const sar_hook_pool & ref) = delete;
+	sar_hook_pool(sar_hook_pool && ref) noexcept = delete;
+	sar_hook_pool & operator = (const sar_hook_pool & ref) = delete;
+	sar_hook_pool & operator = (sar_hook_pool && ref) noexcept = delete;
+
+	    /// destructor drops commands not yet started and waits for the running ones to complete
+	~sar_hook_pool();
+
+	    /// add a command to execute, blocks while the maximum number of commands are in flight
+	void submit(const std::string & cmd_line);
+
+	    /// wait for all submitted commands to be completed
+	void wait_all();
+
+	    /// fetch and remove the oldest recorded failure
+
+	    /// \param[out] cmd_line the command line that failed
+	    /// \param[out] message the reason of the failure
+	    /// \return false if no failure is pending, in which case the arguments are not modified
+	bool pop_failure(std::string & cmd_line, std::string & message);
+
+	    /// the maximum number of commands in flight
+	U_I get_max_in_flight() const { return max_flight; };
+
+    private:
+	static constexpr unsigned int cond_worker = 0; ///< condition instance workers wait on for a new command
+	static constexpr unsigned int cond_caller = 1; ///< condition instance the caller waits on for a command completion
+
+	U_I max_flight;                       ///< max number of commands pending or running
+	libthreadar::condition cond;          ///< protects the following fields
+	std::deque<std::string> pending;      ///< commands not yet started
+	U_I running;                          ///< number of commands being executed
+	bool stop;                            ///< whether workers have to end once no more command is pending
+	std::deque<std::pair<std::string, std::string> > failures; ///< failed commands and their error message
+	std::deque<std::unique_ptr<sar_hook_worker> > workers;     ///< the threads
+
+	bool next_command(std::string & cmd_line); ///< called by workers, false means the worker has to end
+	void command_done(const std::string & cmd_line, const std::string & failure);
+
+	friend class sar_hook_worker;
+    };
+
+
+	/// thread of a sar_hook_pool
+
+    class sar_hook_worker: public libthreadar::thread
+    {
+    public:
+	sar_hook_worker(sar_hook_pool & owner): pool(owner) {};
+
+    protected:
+	virtual void inherited_run() override;
+
+    private:
+	sar_hook_pool & pool;
+    };
+
+
+	/// creates a new file in an entrepot from a separated thread
+
+	/// the file is created with fail_if_exists set, if it already exists or
+	/// cannot be created for any other reason, the failure is silently recorded
+	/// and the caller is expected to fall back to its regular (and interactive)
+	/// way of creating the slice.
+    class sar_slice_opener: public libthreadar::thread
+    {
+    public:
+	sar_slice_opener(const std::shared_ptr<user_interaction> & dialog,
+			 const std::shared_ptr<entrepot> & where,
+			 const std::string & filename,
+			 gf_mode mode,
+			 bool force_permission,
+			 U_I permission);
+	sar_slice_opener(const sar_slice_opener & ref) = delete;
+	sar_slice_opener(sar_slice_opener && ref) noexcept = delete;
+	sar_slice_opener & operator = (const sar_slice_opener & ref) = delete;
+	sar_slice_opener & operator = (sar_slice_opener && ref) noexcept = delete;
+
+	    /// destructor removes the created file if it has not been released
+	~sar_slice_opener();
+
+	    /// name of the file created
+	const std::string & get_filename() const { return fic; };
+
+	    /// wait for the file creation to complete and get the resulting object
+
+	    /// \return the created file object which becomes owned by the caller, or
+	    /// nullptr if the file could not be created
+	fichier_global *release();
+
+    protected:
+	virtual void inherited_run() override;
+
+    private:
+	std::shared_ptr<user_interaction> ui;
+	std::shared_ptr<entrepot> entr;
+	std::string fic;
+	gf_mode open_mode;
+	bool force_perm;
+	U_I perm;
+	fichier_global *created; ///< set by the thread upon success
+
+	void wait_for_thread();
+    };
+
+	/// @}
+
+} // end of namespace
+
+#endif
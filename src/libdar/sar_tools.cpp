@@ -189,4 +189,41 @@ namespace libdar
 	return ret;
     }
 
+    bool sar_tools_next_slice_name(const string & filename, string & next)
+    {
+	string::size_type ext = filename.rfind('.');
+	string::size_type num;
+	string::size_type it;
+
+	if(ext == string::npos || ext == 0)
+	    return false;
+	num = filename.rfind('.', ext - 1);
+	if(num == string::npos || num + 1 == ext)
+	    return false;
+
+	for(it = num + 1; it < ext; ++it)
+	    if(filename[it] < '0' || filename[it] > '9')
+		return false;
+
+	    // incrementing the slice number keeping its padding
+
+	next = filename;
+	it = ext;
+	do
+	{
+	    --it;
+	    if(next[it] == '9')
+		next[it] = '0';
+	    else
+	    {
+		++next[it];
+		return true;
+	    }
+	}
+	while(it > num + 1);
+
+	next.insert(num + 1, 1, '1');
+	return true;
+    }
+
 } // end of namespace
@@ -67,6 +67,13 @@ namespace libdar
     extern std::string sar_tools_make_padded_number(const std::string & num,
 						    const infinint & min_digits);
 
+	/// guess the name of the slice following the given one, for remote repositories to fetch it ahead
+
+	/// \param[in] filename a slice name (or path) of the form <base>.<number>.<extension>
+	/// \param[out] next the same name with the slice number incremented, keeping its padding
+	/// \return false if filename does not look like a slice name
+    extern bool sar_tools_next_slice_name(const std::string & filename, std::string & next);
+
 
 	/// @}
 
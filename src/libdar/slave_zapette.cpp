@@ -94,7 +94,8 @@ namespace libdar
         request req;
         answer ans;
         char *buffer = nullptr;
-        U_16 buf_size = 1024;
+        U_32 buf_size = 1024;
+	U_I protocol = ZAPETTE_PROTOCOL_V1;
 
 	buffer = new (nothrow) char[buf_size];
 	if(buffer == nullptr)
@@ -104,7 +105,7 @@ namespace libdar
         {
             do
             {
-                req.read(in);
+                req.read(in, protocol);
                 ans.serial_num = req.serial_num;
 
                 if(req.size != REQUEST_SIZE_SPECIAL_ORDER)
@@ -112,26 +113,28 @@ namespace libdar
                     ans.type = ANSWER_TYPE_DATA;
                     if(src->skip(req.offset))
                     {
+			U_32 to_read = req.size > max_answer_size ? max_answer_size : req.size;
+
                             // enlarge buffer if necessary
-                        if(req.size > buf_size)
+                        if(to_read > buf_size)
                         {
                             if(buffer != nullptr)
 				delete [] buffer;
 
-			    buffer = new (nothrow) char [req.size];
+			    buffer = new (nothrow) char [to_read];
                             if(buffer == nullptr)
                                 throw Ememory();
                             else
-                                buf_size = req.size;
+                                buf_size = to_read;
                         }
 
-                        ans.size = src->read(buffer, req.size);
-                        ans.write(out, buffer);
+                        ans.size = src->read(buffer, to_read);
+                        ans.write(out, buffer, protocol);
                     }
                     else // bad position
                     {
                         ans.size = 0;
-                        ans.write(out, nullptr);
+                        ans.write(out, nullptr, protocol);
                     }
                 }
                 else // special orders
@@ -140,7 +143,7 @@ namespace libdar
                     {
                         ans.type = ANSWER_TYPE_DATA;
                         ans.size = 0;
-                        ans.write(out, nullptr);
+                        ans.write(out, nullptr, protocol);
                     }
                     else if(req.offset == REQUEST_OFFSET_GET_FILESIZE) // return file size
                     {
@@ -148,27 +151,37 @@ namespace libdar
                         if(!src->skip_to_eof())
                             throw Erange(gettext("Cannot skip at end of file"));
                         ans.arg = src->get_position();
-                        ans.write(out, nullptr);
+                        ans.write(out, nullptr, protocol);
                     }
 		    else if(req.offset == REQUEST_OFFSET_CHANGE_CONTEXT_STATUS) // contextual status change requested
 		    {
 			ans.type = ANSWER_TYPE_INFININT;
-			ans.arg = 1;
- 			src_ctxt->set_info_status(req.info);
-			ans.write(out, nullptr);
+			if(req.info == ZAPETTE_PROTOCOL_PROBE && protocol == ZAPETTE_PROTOCOL_V1)
+			{
+				// not a status change but the zapette probing for protocol version 2
+			    ans.arg = ZAPETTE_PROTOCOL_V2;
+			    ans.write(out, nullptr, protocol);
+			    protocol = ZAPETTE_PROTOCOL_V2;
+			}
+			else
+			{
+			    ans.arg = 1;
+			    src_ctxt->set_info_status(req.info);
+			    ans.write(out, nullptr, protocol);
+			}
 		    }
                     else if(req.offset == REQUEST_IS_OLD_START_END_ARCHIVE) // return whether the underlying archive has an old slice header or not
 		    {
 			ans.type = ANSWER_TYPE_INFININT;
 			ans.arg = src_ctxt->get_slice_info().get_format_07_compatibility() ? 1 : 0;
-			ans.write(out, nullptr);
+			ans.write(out, nullptr, protocol);
 		    }
 		    else if(req.offset == REQUEST_GET_DATA_NAME) // return the data_name of the underlying sar
 		    {
 			ans.type = ANSWER_TYPE_DATA;
 			ans.arg = 0;
 			ans.size = src_ctxt->get_slice_info().get_data_name().size();
-			ans.write(out, (char *)(src_ctxt->get_slice_info().get_data_name().data()));
+			ans.write(out, (char *)(src_ctxt->get_slice_info().get_data_name().data()), protocol);
 		    }
 		    else if(req.offset == REQUEST_FIRST_SLICE_HEADER_SIZE)
 		    {
@@ -182,7 +195,7 @@ namespace libdar
 			    ans.arg = src_sar->get_slice_info().get_first_slice_header_size();
 			else
 			    ans.arg = 0; // means unknown
-			ans.write(out, nullptr);
+			ans.write(out, nullptr, protocol);
 		    }
 		    else if(req.offset == REQUEST_OTHER_SLICE_HEADER_SIZE)
 		    {
@@ -196,7 +209,7 @@ namespace libdar
 			    ans.arg = src_sar->get_slice_info().get_common_slice_header_size();
 			else
 			    ans.arg = 0; // means unknown
-			ans.write(out, nullptr);
+			ans.write(out, nullptr, protocol);
 		    }
 		    else if(req.offset == REQUEST_SLICE_INFO_SIZE)
 		    {
@@ -207,7 +220,7 @@ namespace libdar
 
 			ans.type = ANSWER_TYPE_INFININT;
 			ans.arg = serialzd.size();
-			ans.write(out, nullptr);
+			ans.write(out, nullptr, protocol);
 		    }
 		    else if(req.offset == REQUEST_SLICE_INFO_DATA)
 		    {
@@ -219,7 +232,8 @@ namespace libdar
 
 			ans.size = 0;
 			data_size.unstack(ans.size);
-			if(! data_size.is_zero())
+			if(! data_size.is_zero()
+			   || (protocol == ZAPETTE_PROTOCOL_V1 && ans.size > (U_16)(~0)))
 			    throw Erange(gettext("too large slice header information for zapette protocol"));
 
 			tmp_data = new (nothrow) char[ans.size];
@@ -230,7 +244,7 @@ namespace libdar
 			{
 			    serialzd.dump_to((unsigned char*)(tmp_data), infinint(ans.size));
 			    ans.type = ANSWER_TYPE_DATA;
-			    ans.write(out, tmp_data);
+			    ans.write(out, tmp_data, protocol);
 			}
 			catch(...)
 			{
@@ -79,6 +79,8 @@ namespace libdar
         void action();
 
     private:
+	static constexpr U_32 max_answer_size = 16777216; ///< larger data requests get a shorter answer
+
         generic_file *in;     ///< where to read orders from
 	generic_file *out;    ///< where to send requested info or data to
 	generic_file *src;    ///< where to read data from
@@ -135,6 +135,12 @@ namespace libdar
 	swap(lock_mutex, ref.lock_mutex);
 #endif
 	swap(locking, ref.locking);
+	swap(increment, ref.increment);
+	swap(add_to, ref.add_to);
+	swap(returned, ref.returned);
+	swap(decrement, ref.decrement);
+	swap(set_to, ref.set_to);
+	swap(sub_from, ref.sub_from);
 	treated = std::move(ref.treated);
 	hard_links = std::move(ref.hard_links);
 	skipped = std::move(ref.skipped);
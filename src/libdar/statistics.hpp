@@ -193,37 +193,37 @@ namespace libdar
 	    // now the _str() variant returning std::string
 
 	    /// returns the current value of the treated counter as a std::string
-	std::string get_treated_str() const { return deci(get_treated()).human(); };
+	std::string get_treated_str() const { return deci::to_string(get_treated()); };
 
 	    /// returns the current value of the hard_links counter as a std::string;
-	std::string get_hard_links_str() const { return deci(get_hard_links()).human(); };
+	std::string get_hard_links_str() const { return deci::to_string(get_hard_links()); };
 
 	    /// returns the current value of the skipped counter as a std::string
-	std::string get_skipped_str() const { return deci(get_skipped()).human(); };
+	std::string get_skipped_str() const { return deci::to_string(get_skipped()); };
 
 	    /// returns the current value of the inode_only counter as a std::string
-	std::string get_inode_only_str() const { return deci(get_inode_only()).human(); };
+	std::string get_inode_only_str() const { return deci::to_string(get_inode_only()); };
 
 	    /// returns the current value of the ignored counter as a std::string
-	std::string get_ignored_str() const { return deci(get_ignored()).human();};
+	std::string get_ignored_str() const { return deci::to_string(get_ignored());};
 
 	    /// returns the current value of the tooold counter as a std::string
-	std::string get_tooold_str() const { return deci(get_tooold()).human(); };
+	std::string get_tooold_str() const { return deci::to_string(get_tooold()); };
 
 	    /// returns the current value of the errored counter as a std::string
-	std::string get_errored_str() const { return deci(get_errored()).human(); };
+	std::string get_errored_str() const { return deci::to_string(get_errored()); };
 
 	    /// returns the current value of the deleted counter as a std::string
-	std::string get_deleted_str() const { return deci(get_deleted()).human(); };
+	std::string get_deleted_str() const { return deci::to_string(get_deleted()); };
 
 	    /// returns the current value of the ea_treated counter as a std::string
-	std::string get_ea_treated_str() const { return deci(get_ea_treated()).human(); };
+	std::string get_ea_treated_str() const { return deci::to_string(get_ea_treated()); };
 
 	    /// returns the current value of the byte_amount counter as a std::string
-	std::string get_byte_amount_str() const { return deci(get_byte_amount()).human(); };
+	std::string get_byte_amount_str() const { return deci::to_string(get_byte_amount()); };
 
 	    /// returns the current value of the fsa_treated counter as a std::string
-	std::string get_fsa_treated_str() const { return deci(get_fsa_treated()).human(); };
+	std::string get_fsa_treated_str() const { return deci::to_string(get_fsa_treated()); };
 
 
 	    /// decrement by one the treated counter
@@ -0,0 +1,162 @@
+/*********************************************************************/
+// dar - disk archive - a backup/restoration program
+// Copyright (C) 2002-2026 Denis Corbin
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// to contact the author, see the AUTHOR file
+/*********************************************************************/
+
+#include "../my_config.h"
+
+extern "C"
+{
+#if HAVE_STRING_H
+#include <string.h>
+#endif
+}
+
+#include "tampon_thread.hpp"
+#include "erreurs.hpp"
+
+using namespace std;
+
+namespace libdar
+{
+
+    tampon_thread::tampon_thread(U_I num_blocks, U_I block_size):
+	interthread(num_blocks, block_size)
+    {
+	if(block_size == 0 || num_blocks < 2)
+	    throw SRC_BUG;
+    }
+
+    void tampon_thread::send_end_of_data()
+    {
+	char *ptr;
+	unsigned int room;
+
+	interthread.get_block_to_feed(ptr, room);
+	interthread.feed(ptr, 0);
+    }
+
+    void tampon_thread::drain_up_to_end_of_data(unsigned int size)
+    {
+	char *block;
+
+	while(size > 0)
+	{
+	    interthread.fetch(block, size);
+	    interthread.fetch_recycle(block);
+	}
+    }
+
+
+    tampon_consumer::tampon_consumer(U_I num_blocks, U_I block_size):
+	tampon_thread(num_blocks, block_size),
+	current(nullptr),
+	filled(0),
+	room(0),
+	finished(false)
+    {
+    }
+
+    void tampon_consumer::feed(const char *a, U_I size)
+    {
+	U_I step;
+
+	if(finished)
+	    throw SRC_BUG;
+
+	    // small amounts are gathered in the same block
+	    // before being handed to the thread
+
+	while(size > 0)
+	{
+	    if(current == nullptr)
+	    {
+		interthread.get_block_to_feed(current, room);
+		filled = 0;
+	    }
+
+	    step = room - filled;
+	    if(step > size)
+		step = size;
+	    (void)memcpy(current + filled, a, step);
+	    filled += step;
+	    a += step;
+	    size -= step;
+
+	    if(filled == room)
+	    {
+		interthread.feed(current, filled);
+		current = nullptr;
+	    }
+	}
+    }
+
+    void tampon_consumer::finish()
+    {
+	if(finished)
+	    return;
+
+	finished = true;
+	if(current != nullptr)
+	{
+	    if(filled > 0)
+		interthread.feed(current, filled);
+	    else
+		interthread.feed_cancel_get_block(current);
+	    current = nullptr;
+	}
+	send_end_of_data();
+	join(); // rethrows the exception met by the thread if any
+    }
+
+    void tampon_consumer::inherited_run()
+    {
+	char *block = nullptr;
+	unsigned int size = 1;
+
+	try
+	{
+	    do
+	    {
+		interthread.fetch(block, size);
+		try
+		{
+		    if(size > 0)
+			consume(block, size);
+		}
+		catch(...)
+		{
+		    interthread.fetch_recycle(block);
+		    throw;
+		}
+		interthread.fetch_recycle(block);
+	    }
+	    while(size > 0);
+
+	    end_of_data();
+	}
+	catch(...)
+	{
+		// the feeding thread must not stay blocked
+	    drain_up_to_end_of_data(size);
+	    throw;
+	}
+    }
+
+} // end of namespace
@@ -0,0 +1,120 @@
+/*********************************************************************/
+// dar - disk archive - a backup/restoration program
+// Copyright (C) 2002-2026 Denis Corbin
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// to contact the author, see the AUTHOR file
+/*********************************************************************/
+
+    /// \file tampon_thread.hpp
+    /// \brief threads exchanging blocks of data with their caller through a fast_tampon
+    /// \ingroup Private
+
+#ifndef TAMPON_THREAD_HPP
+#define TAMPON_THREAD_HPP
+
+#include "../my_config.h"
+
+#include "integers.hpp"
+
+#include <libthreadar/libthreadar.hpp>
+
+namespace libdar
+{
+
+	/// \addtogroup Private
+	/// @{
+
+	/// thread exchanging blocks of data with the caller thread through a fast_tampon
+
+	/// the end of the data is signaled by a block of zero byte, the end of data marker,
+	/// which the producing side always sends, even when it fails. The consuming side
+	/// joins the thread once it has fetched that marker, which rethrows the exception
+	/// the thread may have met.
+	/// \note the inherited class constructor is expected to call run() once it is
+	/// fully constructed, and its destructor to stop the thread before its own fields
+	/// are released
+    class tampon_thread: public libthreadar::thread
+    {
+    public:
+	tampon_thread(U_I num_blocks, U_I block_size);
+	tampon_thread(const tampon_thread & ref) = delete;
+	tampon_thread(tampon_thread && ref) noexcept = delete;
+	tampon_thread & operator = (const tampon_thread & ref) = delete;
+	tampon_thread & operator = (tampon_thread && ref) noexcept = delete;
+	~tampon_thread() = default;
+
+    protected:
+	libthreadar::fast_tampon<char> interthread;
+
+	    /// hand the end of data marker to the consuming side
+	void send_end_of_data();
+
+	    /// fetch and recycle the blocks up to the end of data marker included
+
+	    /// \param[in] size is the size of the last block fetched, nothing is done if zero
+	    /// \note used by the consuming side when it stops early, for the producing
+	    /// side not to stay blocked waiting for a free block
+	void drain_up_to_end_of_data(unsigned int size);
+    };
+
+
+	/// thread consuming the data the caller thread hands to it
+
+	/// data given to feed() is copied to blocks of the fast_tampon, small amounts
+	/// being gathered in the same block, then consume() is called from the thread
+	/// for each block, in order
+    class tampon_consumer: public tampon_thread
+    {
+    public:
+	tampon_consumer(U_I num_blocks, U_I block_size);
+	tampon_consumer(const tampon_consumer & ref) = delete;
+	tampon_consumer(tampon_consumer && ref) noexcept = delete;
+	tampon_consumer & operator = (const tampon_consumer & ref) = delete;
+	tampon_consumer & operator = (tampon_consumer && ref) noexcept = delete;
+	~tampon_consumer() = default;
+
+	    /// hand a copy of the data to the thread
+	void feed(const char *a, U_I size);
+
+	    /// send the end of data marker and wait for the thread to complete
+
+	    /// \note an exception met by the thread is rethrown here
+	    /// \note the inherited class destructor must call it (ignoring exceptions)
+	    /// as consume() cannot be called anymore once the inherited class is destroyed
+	void finish();
+
+    protected:
+	    /// processes a block of data, called from the thread
+	virtual void consume(const char *a, U_I size) = 0;
+
+	    /// called from the thread once all the data has been consumed
+	virtual void end_of_data() {};
+
+	virtual void inherited_run() override;
+
+    private:
+	char *current;       ///< block being filled, not yet handed to the thread
+	unsigned int filled; ///< amount of data in current
+	unsigned int room;   ///< allocated size of current
+	bool finished;
+    };
+
+	/// @}
+
+} // end of namespace
+
+#endif
@@ -265,7 +265,7 @@ namespace libdar
             number /= multiple;
         }
 
-        ret = deci(number).human();
+        ret = deci::to_string(number);
 
         switch(power)
         {
@@ -354,8 +354,7 @@ namespace libdar
 
         if(name.empty()) // uid not associated with a name
         {
-            deci d = uid;
-            return d.human();
+            return deci::to_string(uid);
         }
         else
             return name;
@@ -375,8 +374,7 @@ namespace libdar
 
         if(name.empty()) // uid not associated with a name
         {
-            deci d = gid;
-            return d.human();
+            return deci::to_string(gid);
         }
         else
             return name;
@@ -424,7 +422,7 @@ namespace libdar
 	datetime::time_unit tu = fully_detailed ? date.get_unit() : datetime::tu_second;
 
         if(!date.get_value(pas, frac, tu)) // conversion to system type failed. Using a replacement string
-	    return deci(date.get_second_value()).human() + " " + datetime::unit_symbol(datetime::tu_second);
+	    return deci::to_string(date.get_second_value()) + " " + datetime::unit_symbol(datetime::tu_second);
 	else
         {
 	    static const U_I str_size = 50; ///< minimum required is 26 bytes for ctime_r
@@ -1098,7 +1096,7 @@ namespace libdar
                         break;
                     case 'u':
                         test = va_arg(ap, U_I);
-                        output += deci(test).human();
+                        output += deci::to_string(test);
                         break;
                     case 'x':
                         test = va_arg(ap, U_I);
@@ -1115,7 +1113,7 @@ namespace libdar
                         output += static_cast<char>(va_arg(ap, S_I));
                         break;
                     case 'i':
-                        output += deci(*(va_arg(ap, infinint *))).human();
+                        output += deci::to_string(*(va_arg(ap, infinint *)));
                         break;
                     case 'S':
                         output += *(va_arg(ap, string *));
@@ -1505,31 +1503,38 @@ namespace libdar
     }
 
 
+    void tools_hook_execute_once(const string & cmd_line)
+    {
+	    // dar_gettext() is used here rather than NLS_SWAP_IN/OUT
+	    // as this routine may be called from a sub-thread
+
+        S_I code = system(cmd_line.c_str());
+        switch(code)
+        {
+        case 0:
+            break; // All is fine, script did not report error
+        case 127:
+            throw Erange(dar_gettext("execve() failed. (process table is full ?)"));
+        case -1:
+            throw Erange(string(dar_gettext("system() call failed: ")) + tools_strerror_r(errno));
+        default:
+            throw Erange(tools_printf(dar_gettext("execution of [ %S ] returned error code: %d"), &cmd_line, code));
+        }
+    }
+
     void tools_hook_execute(user_interaction & ui,
                             const string & cmd_line)
     {
         NLS_SWAP_IN;
         try
         {
-            const char *ptr = cmd_line.c_str();
             bool loop = false;
             do
             {
                 try
                 {
-                    S_I code = system(ptr);
-                    switch(code)
-                    {
-                    case 0:
-                        loop = false;
-                        break; // All is fine, script did not report error
-                    case 127:
-                        throw Erange(gettext("execve() failed. (process table is full ?)"));
-                    case -1:
-                        throw Erange(string(gettext("system() call failed: ")) + tools_strerror_r(errno));
-                    default:
-                        throw Erange(tools_printf(gettext("execution of [ %S ] returned error code: %d"), &cmd_line, code));
-                    }
+                    tools_hook_execute_once(cmd_line);
+                    loop = false;
                 }
                 catch(Erange & e)
                 {
@@ -2167,7 +2172,7 @@ namespace libdar
         else
             if(file_size >= storage_size)
 		if(!file_size.is_zero())
-		    return tools_addspacebefore(deci(((file_size - storage_size)*100)/file_size).human(), 4) +"%";
+		    return tools_addspacebefore(deci::to_string(((file_size - storage_size)*100)/file_size), 4) +"%";
 		else
 		    return not_compressed;
             else
@@ -455,6 +455,13 @@ namespace libdar
 					     const std::string & base_url);
 
 
+	/// execute once a given command line without user interaction
+
+	/// \param[in] cmd_line the command line to execute
+	/// \note an Erange exception is thrown if the command could not be run or returned a non zero exit status
+    extern void tools_hook_execute_once(const std::string & cmd_line);
+
+
 	/// execute and retries at user will a given command line
 
 	/// \param[in] ui which way to ask the user whether to continue upon command line error
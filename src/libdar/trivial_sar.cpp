@@ -122,7 +122,7 @@ namespace libdar
 			     bool warn_over,
 			     bool force_permission,
 			     U_I permission,
-			     hash_algo x_hash,
+			     const deque<hash_algo> & x_hash,
 			     const infinint & x_min_digits,
 			     bool format_07_compatible) : generic_file(open_mode), mem_ui(dialog)
     {
@@ -568,6 +568,19 @@ namespace libdar
 	}
     }
 
+    fichier_local *trivial_sar::direct_write_access()
+    {
+	fichier_local *ret = dynamic_cast<fichier_local *>(reference);
+
+	if(is_terminated() || get_mode() == gf_read_only)
+	    throw SRC_BUG;
+
+	if(ret != nullptr && ret->get_position() != offset + cur_pos)
+	    ret = nullptr;
+
+	return ret;
+    }
+
     void trivial_sar::where_am_i()
     {
 	cur_pos = reference->get_position();
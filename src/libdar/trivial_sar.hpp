@@ -29,12 +29,14 @@
 #include "../my_config.h"
 
 #include <string>
+#include <deque>
 #include "infinint.hpp"
 #include "generic_file.hpp"
 #include "integers.hpp"
 #include "entrepot.hpp"
 #include "contextual.hpp"
 #include "mem_ui.hpp"
+#include "fichier_local.hpp"
 
 namespace libdar
 {
@@ -66,7 +68,7 @@ namespace libdar
 		    bool warn_over,                    ///< whether to warn before overwriting
 		    bool force_permission,             ///< whether to enforce slice permission or not
 		    U_I permission,                    ///< value of permission to use if permission enforcement is used
-		    hash_algo x_hash,                  ///< whether to build a hash of the slice, and which algo to use for that
+		    const std::deque<hash_algo> & x_hash, ///< hash algorithms to compute on the slice, none if empty
 	    	    const infinint & min_digits,       ///< is the minimum number of digits the slices number is stored with in the filename
 		    bool format_07_compatible          ///< build a slice header backward compatible with 2.3.x
 	    );
@@ -127,6 +129,16 @@ namespace libdar
 	    /// enable back execution of user command when destroying the current object
 	void enable_natural_destruction() { natural_destruction = true; };
 
+	    /// direct access to the underlying file being written (write mode only)
+
+	    /// \return the slice file positionned at the current writing offset, or nullptr
+	    /// if the slice is not a local file or if it is hashed while written
+	    /// \note direct_write_done() must be called once data has been written to the returned object
+	fichier_local *direct_write_access();
+
+	    /// inform the trivial_sar object that the given amount of data has been written to direct_write_access() returned object
+	void direct_write_done(U_I amount) { cur_pos += amount; };
+
     protected:
 	virtual void inherited_read_ahead(const infinint & amount) override { reference->read_ahead(amount); };
         virtual U_I inherited_read(char *a, U_I size) override;
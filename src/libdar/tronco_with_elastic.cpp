@@ -130,6 +130,14 @@ namespace libdar
 	    throw SRC_BUG;
     }
 
+    tronco_with_elastic::~tronco_with_elastic() noexcept
+    {
+	    // if not yet terminated, the object behind gets terminated by its own destructor
+	    // and must still report its threads with this layer
+	if(behind)
+	    behind->set_probe(get_probe());
+    }
+
     void tronco_with_elastic::get_ready_for_writing(const infinint & initial_shift)
     {
 	if(status != init)
@@ -458,6 +466,8 @@ namespace libdar
 	if(beh == nullptr)
 	    throw SRC_BUG;
 
+	    // the threads of the underlying object, if any, get reported with this layer
+	beh->set_probe(get_probe());
 	beh->terminate();
 	status = closed;
     }
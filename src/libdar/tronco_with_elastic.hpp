@@ -98,7 +98,7 @@ namespace libdar
 	tronco_with_elastic & operator = (tronco_with_elastic && ref) noexcept = default;
 
 	    /// destructor
-	virtual ~tronco_with_elastic() noexcept = default;
+	virtual ~tronco_with_elastic() noexcept;
 
 	    /// obtain the salt
 	const std::string & get_salt() const { return sel; };
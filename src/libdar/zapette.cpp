@@ -36,6 +36,10 @@ extern "C"
 #if HAVE_ARPA_INET_H
 #include <arpa/inet.h>
 #endif
+
+#if HAVE_STRING_H
+#include <string.h>
+#endif
 } // end extern "C"
 
 #include <string>
@@ -71,12 +75,28 @@ namespace libdar
 	out = output;
 	position = 0;
 	serial_counter = 0;
+	protocol = ZAPETTE_PROTOCOL_V1;
+	sent_end = 0;
+	ahead_end = 0;
+	last_read_end = 0;
+	cache_offset = 0;
+	cache_data = 0;
 	contextual::set_info_status(CONTEXT_INIT);
 
 	    //////////////////////////////
-	    // retreiving the file size
+	    // negotiating the protocol version
 	    //
+	infinint peer_version;
 	S_I tmp = 0;
+	make_transfert(REQUEST_SIZE_SPECIAL_ORDER, REQUEST_OFFSET_CHANGE_CONTEXT_STATUS, nullptr, ZAPETTE_PROTOCOL_PROBE, tmp, peer_version);
+	if(peer_version == ZAPETTE_PROTOCOL_V2)
+	    protocol = ZAPETTE_PROTOCOL_V2;
+	else // the peer only knows version 1 and took the probe as its new contextual status
+	    make_transfert(REQUEST_SIZE_SPECIAL_ORDER, REQUEST_OFFSET_CHANGE_CONTEXT_STATUS, nullptr, CONTEXT_INIT, tmp, peer_version);
+
+	    //////////////////////////////
+	    // retreiving the file size
+	    //
 	make_transfert(REQUEST_SIZE_SPECIAL_ORDER, REQUEST_OFFSET_GET_FILESIZE, nullptr, "", tmp, file_size);
 
 	    //////////////////////////////
@@ -134,6 +154,7 @@ namespace libdar
 	if(is_terminated())
 	    throw SRC_BUG;
 
+	ahead_end = 0;
         if(pos >= file_size)
         {
             position = file_size;
@@ -151,6 +172,7 @@ namespace libdar
 	if(is_terminated())
 	    throw SRC_BUG;
 
+	ahead_end = 0;
         if(x >= 0)
         {
             position += x;
@@ -272,11 +294,22 @@ namespace libdar
     }
 
 
+    void zapette::inherited_read_ahead(const infinint & amount)
+    {
+	if(amount.is_zero())
+	    ahead_end = file_size;
+	else
+	    ahead_end = position + amount;
+    }
+
     U_I zapette::inherited_read(char *a, U_I size)
     {
         static const U_16 max_short = ~0;
         U_I lu = 0;
 
+	if(protocol == ZAPETTE_PROTOCOL_V2)
+	    return pipelined_read(a, size);
+
         if(size > 0)
         {
             infinint not_used;
@@ -304,17 +337,151 @@ namespace libdar
         throw SRC_BUG; // zapette is read-only
     }
 
-    void zapette::make_transfert(U_16 size, const infinint &offset, char *data, const string & info, S_I & lu, infinint & arg) const
+    U_I zapette::pipelined_read(char *a, U_I size)
+    {
+	U_I lu = 0;
+
+	    // consecutive reads are taken as a hint the caller reads sequentially
+	if(position == last_read_end && ahead_end < position + infinint(V2_BLOCK_SIZE * V2_WINDOW))
+	    ahead_end = position + infinint(V2_BLOCK_SIZE * V2_WINDOW);
+
+	while(lu < size)
+	{
+	    if(cache_offset <= position && position < cache_offset + cache_data)
+	    {
+		    // serving data from the cache
+
+		infinint tmp = position - cache_offset;
+		U_I shift = 0;
+		U_I step;
+
+		tmp.unstack(shift);
+		if(!tmp.is_zero())
+		    throw SRC_BUG; // cache_data is an U_32
+		step = cache_data - shift;
+		if(step > size - lu)
+		    step = size - lu;
+		(void)memcpy(a + lu, &(cache[shift]), step);
+		lu += step;
+		position += step;
+		continue;
+	    }
+
+	    if(position >= file_size)
+		break; // end of file reached
+
+	    if(!pending.empty() && (position < pending.front().offset || position >= sent_end))
+		drain_pending(); // the pending requests do not cover the position we have skipped to
+	    if(pending.empty())
+	    {
+		    // requests are aligned on blocks for small reads around
+		    // the same location to be served by the same answer
+		sent_end = position - position % infinint(V2_BLOCK_SIZE);
+	    }
+
+		// keeping up to V2_WINDOW requests outstanding up to the end of what is
+		// to be read, or further if reading ahead is expected
+
+	    infinint target = position + infinint(size - lu);
+	    if(target < ahead_end)
+		target = ahead_end;
+	    if(target > file_size)
+		target = file_size;
+
+	    while(pending.size() < V2_WINDOW && sent_end < target)
+	    {
+		infinint remain = file_size - sent_end;
+		U_32 step = V2_BLOCK_SIZE;
+
+		if(remain < infinint(V2_BLOCK_SIZE))
+		{
+		    step = 0;
+		    remain.unstack(step);
+		}
+		send_data_request(sent_end, step);
+		sent_end += step;
+	    }
+
+	    if(pending.empty())
+		break; // end of file reached
+
+	    if(!receive_data_answer() && position >= cache_offset + cache_data)
+	    {
+		    // peer provided less data than requested, and not up to the position we read at
+		drain_pending();
+		break;
+	    }
+	}
+
+	last_read_end = position;
+
+	return lu;
+    }
+
+    void zapette::send_data_request(const infinint & offset, U_32 size)
+    {
+	request req;
+
+	req.serial_num = serial_counter++; // may loopback to 0
+	req.offset = offset;
+	req.size = size;
+	req.info = "";
+	req.write(out, protocol);
+	pending.push_back(pending_read{ req.serial_num, offset, size });
+    }
+
+    bool zapette::receive_data_answer()
+    {
+	bool ret;
+
+	answer ans;
+
+	if(pending.empty())
+	    throw SRC_BUG;
+
+	if(cache.size() < pending.front().size)
+	    cache.resize(pending.front().size);
+
+	cache_data = 0; // cache content is overwritten below
+	ans.read(in, cache.data(), pending.front().size, protocol);
+	if(ans.serial_num != pending.front().serial_num || ans.type != ANSWER_TYPE_DATA)
+	    throw Erange(gettext("Incoherent answer from peer"));
+
+	cache_offset = pending.front().offset;
+	cache_data = ans.size > pending.front().size ? pending.front().size : ans.size;
+	ret = cache_data == pending.front().size;
+	pending.pop_front();
+
+	return ret;
+    }
+
+    void zapette::drain_pending() const
+    {
+	answer ans;
+
+	while(!pending.empty())
+	{
+	    ans.read(in, nullptr, 0, protocol);
+	    if(ans.serial_num != pending.front().serial_num || ans.type != ANSWER_TYPE_DATA)
+		throw Erange(gettext("Incoherent answer from peer"));
+	    pending.pop_front();
+	}
+    }
+
+    void zapette::make_transfert(U_32 size, const infinint &offset, char *data, const string & info, S_I & lu, infinint & arg) const
     {
         request req;
         answer ans;
 
+	    // answers to pending data requests come first
+	drain_pending();
+
             // building the request
         req.serial_num = const_cast<char &>(serial_counter)++; // may loopback to 0
         req.offset = offset;
         req.size = size;
 	req.info = info;
-        req.write(out);
+        req.write(out, protocol);
 
 	if(req.size == REQUEST_SIZE_SPECIAL_ORDER)
 	    size = lu;
@@ -322,7 +489,7 @@ namespace libdar
             // reading the answer
         do
         {
-            ans.read(in, data, size);
+            ans.read(in, data, size, protocol);
             if(ans.serial_num != req.serial_num)
                 get_ui().pause(gettext("Communication problem with peer, retry ?"));
 	}
@@ -361,7 +528,7 @@ namespace libdar
             }
 	    else if(req.offset == REQUEST_OFFSET_CHANGE_CONTEXT_STATUS)
 	    {
-		if(ans.arg != 1)
+		if(ans.arg != 1 && (info != ZAPETTE_PROTOCOL_PROBE || ans.arg != ZAPETTE_PROTOCOL_V2))
 		    throw Erange(gettext("Unexpected answer from slave, communication problem or bug may hang the operation"));
 	    }
             else if(req.offset == REQUEST_IS_OLD_START_END_ARCHIVE)
@@ -34,6 +34,9 @@
 #define ZAPETTE_HPP
 
 #include "../my_config.h"
+
+#include <deque>
+#include <vector>
 #include "infinint.hpp"
 #include "generic_file.hpp"
 #include "integers.hpp"
@@ -74,7 +77,7 @@ namespace libdar
             // inherited methods from generic_file
 	virtual bool skippable(skippability direction, const infinint & amount) override { return true; };
         virtual bool skip(const infinint &pos) override;
-        virtual bool skip_to_eof() override { if(is_terminated()) throw SRC_BUG; position = file_size; return true; };
+        virtual bool skip_to_eof() override { if(is_terminated()) throw SRC_BUG; position = file_size; ahead_end = 0; return true; };
         virtual bool skip_relative(S_I x) override;
 	virtual bool truncatable(const infinint & pos) const override { return false; };
         virtual infinint get_position() const override { if(is_terminated()) throw SRC_BUG; return position; };
@@ -94,7 +97,7 @@ namespace libdar
 	infinint get_non_first_slice_header_size() const;
 
     protected:
-	virtual void inherited_read_ahead(const infinint & amount) override {}; // optimization will be done when zapette will use the messaging_encode/decode exchange format
+	virtual void inherited_read_ahead(const infinint & amount) override;
         virtual U_I inherited_read(char *a, U_I size) override;
         virtual void inherited_write(const char *a, U_I size) override;
 	virtual void inherited_truncate(const infinint & pos) override { throw SRC_BUG; }; // read only object
@@ -104,12 +107,44 @@ namespace libdar
 
     private:
 	static constexpr const U_I MEMBUF_INCR = 1024;
+	static constexpr const U_32 V2_BLOCK_SIZE = 262144; ///< amount of data asked by each request with protocol version 2
+	static constexpr const U_I V2_WINDOW = 8;            ///< max number of outstanding data requests with protocol version 2
+
+	    /// a data request sent with protocol version 2 which answer has not yet been read
+	struct pending_read
+	{
+	    char serial_num;
+	    infinint offset;
+	    U_32 size;
+	};
 
         generic_file *in, *out;
         infinint position, file_size;
         char serial_counter;
 	mutable slice_header slice_info;
 	mutable memory_file slice_info_xfer;
+	U_I protocol;                              ///< protocol version used with the peer
+	mutable std::deque<pending_read> pending;  ///< outstanding data requests in the order they have been sent
+	infinint sent_end;                         ///< offset following the data asked by the last pending request
+	infinint ahead_end;                        ///< offset up to which data has to be asked ahead of reading
+	infinint last_read_end;                    ///< position at the end of the last read, to detect sequential reading
+	std::vector<char> cache;                   ///< data of the last answer read
+	infinint cache_offset;                     ///< offset of the data in cache
+	U_32 cache_data;                           ///< amount of data in cache
+
+	    /// reading data with protocol version 2, several requests being sent before reading their answers
+	U_I pipelined_read(char *a, U_I size);
+
+	    /// send a data request and record it as pending
+	void send_data_request(const infinint & offset, U_32 size);
+
+	    /// read the answer of the oldest pending request into the cache
+
+	    /// \return false if the peer provided less data than requested
+	bool receive_data_answer();
+
+	    /// read and drop the answers of all pending requests
+	void drain_pending() const;
 
 	    /// wrapped formatted method to communicate with the slave_zapette located behind the pair of pipes (= tuyau)
 
@@ -129,7 +164,7 @@ namespace libdar
 	    /// allocated space for the reply must be given through 'lu' which at return gives the effective length of the returned
 	    /// string
 
-	void make_transfert(U_16 size, const infinint &offset, char *data, const std::string & info, S_I & lu, infinint & arg) const;
+	void make_transfert(U_32 size, const infinint &offset, char *data, const std::string & info, S_I & lu, infinint & arg) const;
     };
 
 	/// @}
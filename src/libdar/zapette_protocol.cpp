@@ -50,47 +50,43 @@ using namespace std;
 namespace libdar
 {
 
-    void request::write(generic_file *f)
-    {
-        U_16 tmp = htons(size);
+	/// write a data size using the width of the given protocol version
+    static void write_size(generic_file *f, U_32 size, U_I version);
+
+	/// read a data size using the width of the given protocol version
+    static U_32 read_size(generic_file *f, U_I version);
 
+    void request::write(generic_file *f, U_I version)
+    {
         f->write(&serial_num, 1);
         offset.dump(*f);
-        f->write((char *)&tmp, sizeof(tmp));
+	write_size(f, size, version);
 	if(size == REQUEST_SIZE_SPECIAL_ORDER && offset == REQUEST_OFFSET_CHANGE_CONTEXT_STATUS)
 	    tools_write_string(*f, info);
     }
 
-    void request::read(generic_file *f)
+    void request::read(generic_file *f, U_I version)
     {
-        U_16 tmp;
-        U_16 pas;
-
-        if(f->read(&serial_num, 1) == 0)
-            throw Erange(gettext("Partial request received, aborting\n"));
 	if(f == nullptr)
 	    throw SRC_BUG;
+        if(f->read(&serial_num, 1) == 0)
+            throw Erange(gettext("Partial request received, aborting\n"));
         offset = infinint(*f);
-        pas = 0;
-        while(pas < sizeof(tmp))
-            pas += f->read((char *)&tmp+pas, sizeof(tmp)-pas);
-        size = ntohs(tmp);
+	size = read_size(f, version);
 	if(size == REQUEST_SIZE_SPECIAL_ORDER && offset == REQUEST_OFFSET_CHANGE_CONTEXT_STATUS)
 	    tools_read_string(*f, info);
 	else
 	    info = "";
     }
 
-    void answer::write(generic_file *f, char *data)
+    void answer::write(generic_file *f, char *data, U_I version)
     {
-        U_16 tmp = htons(size);
-
         f->write(&serial_num, 1);
         f->write(&type, 1);
         switch(type)
         {
         case ANSWER_TYPE_DATA:
-            f->write((char *)&tmp, sizeof(tmp));
+	    write_size(f, size, version);
             if(data != nullptr)
                 f->write(data, size);
             else
@@ -105,26 +101,21 @@ namespace libdar
         }
     }
 
-    void answer::read(generic_file *f, char *data, U_16 max)
+    void answer::read(generic_file *f, char *data, U_32 max, U_I version)
     {
-        U_16 tmp;
-        U_16 pas;
+        U_32 tmp;
 
         f->read(&serial_num, 1);
         f->read(&type, 1);
         switch(type)
         {
         case ANSWER_TYPE_DATA:
-            pas = 0;
-            while(pas < sizeof(tmp))
-                pas += f->read((char *)&tmp+pas, sizeof(tmp)-pas);
-            size = ntohs(tmp);
+	    size = read_size(f, version);
 
-		// recycling tmp to carry the max data to store in the data arg of this method
+		// tmp carries the max data to store in the data arg of this method
 	    tmp = size > max ? max : size;
-
-		// recycling pas to follow the steps of data fullfilment
-	    f->read(data, tmp);
+	    if(tmp > 0)
+		f->read(data, tmp);
 
 		// need to drop the remaining data
             if(size > max)
@@ -146,4 +137,66 @@ namespace libdar
         }
     }
 
+    static void write_size(generic_file *f, U_32 size, U_I version)
+    {
+	switch(version)
+	{
+	case ZAPETTE_PROTOCOL_V1:
+	    {
+		U_16 tmp = htons(size);
+
+		if(size > (U_16)(~0))
+		    throw SRC_BUG;
+		f->write((char *)&tmp, sizeof(tmp));
+	    }
+	    break;
+	case ZAPETTE_PROTOCOL_V2:
+	    {
+		U_32 tmp = htonl(size);
+
+		f->write((char *)&tmp, sizeof(tmp));
+	    }
+	    break;
+	default:
+	    throw SRC_BUG;
+	}
+    }
+
+    static U_32 read_size(generic_file *f, U_I version)
+    {
+	U_16 tmp16;
+	U_32 tmp32;
+	char *ptr = nullptr;
+	U_I width = 0;
+	U_I pas = 0;
+
+	switch(version)
+	{
+	case ZAPETTE_PROTOCOL_V1:
+	    ptr = (char *)&tmp16;
+	    width = sizeof(tmp16);
+	    break;
+	case ZAPETTE_PROTOCOL_V2:
+	    ptr = (char *)&tmp32;
+	    width = sizeof(tmp32);
+	    break;
+	default:
+	    throw SRC_BUG;
+	}
+
+	while(pas < width)
+	{
+	    U_I lu = f->read(ptr + pas, width - pas);
+
+	    if(lu == 0)
+		throw Erange(gettext("Corrupted data read on pipe"));
+	    pas += lu;
+	}
+
+	if(version == ZAPETTE_PROTOCOL_V1)
+	    return ntohs(tmp16);
+	else
+	    return ntohl(tmp32);
+    }
+
 } // end of namespace
@@ -59,26 +59,43 @@ namespace libdar
     constexpr U_I REQUEST_SLICE_INFO_SIZE = 7;
     constexpr U_I REQUEST_SLICE_INFO_DATA = 8;
 
+	/// protocol versions
+
+	/// version 1 sends a request and waits for its answer before sending the next one,
+	/// data sizes are coded on 16 bits. Version 2 lets the zapette send several requests
+	/// before reading their answers, which the slave_zapette sends in the same order,
+	/// data sizes are coded on 32 bits.
+    constexpr U_I ZAPETTE_PROTOCOL_V1 = 1;
+    constexpr U_I ZAPETTE_PROTOCOL_V2 = 2;
+
+	/// contextual status sent by the zapette with version 1 to probe the peer
+
+	/// a slave_zapette only knowing version 1 takes it as its new contextual status and
+	/// answers 1, the zapette then restores the contextual status and keeps using version 1.
+	/// A slave_zapette knowing version 2 leaves its contextual status unchanged and answers 2,
+	/// both sides using version 2 for the messages that follow.
+    constexpr const char *ZAPETTE_PROTOCOL_PROBE = "zapette protocol v2";
+
     struct request
     {
         char serial_num;
-        U_16 size; // size or REQUEST_SIZE_SPECIAL_ORDER
+        U_32 size; // size or REQUEST_SIZE_SPECIAL_ORDER, must fit in 16 bits with protocol version 1
         infinint offset; // offset or REQUEST_OFFSET_END_TRANSMIT or REQUEST_OFFSET_GET_FILESIZE, REQUEST_OFFSET_* ...
 	std::string info; // new contextual_status
 
-        void write(generic_file *f); // master side
-        void read(generic_file *f);  // slave side
+        void write(generic_file *f, U_I version); // master side
+        void read(generic_file *f, U_I version);  // slave side
     };
 
     struct answer
     {
         char serial_num;
         char type;
-        U_16 size;
+        U_32 size; // must fit in 16 bits with protocol version 1
         infinint arg;
 
-        void write(generic_file *f, char *data); // slave side
-        void read(generic_file *f, char *data, U_16 max);  // master side
+        void write(generic_file *f, char *data, U_I version); // slave side
+        void read(generic_file *f, char *data, U_32 max, U_I version);  // master side
     };
 
 	/// @}
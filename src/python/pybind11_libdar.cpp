@@ -452,6 +452,10 @@ PYBIND11_MODULE(libdar, mod)
 	.value("twofish256", libdar::crypto_algo::twofish256)
 	.value("serpent256", libdar::crypto_algo::serpent256)
 	.value("camellia256", libdar::crypto_algo::camellia256)
+	.value("aes256_xts", libdar::crypto_algo::aes256_xts)
+	.value("twofish256_xts", libdar::crypto_algo::twofish256_xts)
+	.value("serpent256_xts", libdar::crypto_algo::serpent256_xts)
+	.value("camellia256_xts", libdar::crypto_algo::camellia256_xts)
 	.export_values();
 
     pybind11::class_<libdar::signator> pysignator(mod, "signator");
@@ -480,6 +484,8 @@ PYBIND11_MODULE(libdar, mod)
 
     mod.def("crypto_algo_2_string", &libdar::crypto_algo_2_string, pybind11::arg("algo"));
     mod.def("same_signatories", &libdar::same_signatories);
+    mod.def("set_derived_key_cache", &libdar::set_derived_key_cache, pybind11::arg("enabled"));
+    mod.def("clear_derived_key_cache", &libdar::clear_derived_key_cache);
 
 
 	///////////////////////////////////////////
@@ -1427,6 +1433,7 @@ PYBIND11_MODULE(libdar, mod)
 	.def("set_slicing", &libdar::archive_options_create::set_slicing)
 	.def("set_ea_mask", &libdar::archive_options_create::set_ea_mask)
 	.def("set_execute", &libdar::archive_options_create::set_execute)
+	.def("set_async_execute", &libdar::archive_options_create::set_async_execute)
 	.def("set_crypto_algo", &libdar::archive_options_create::set_crypto_algo)
 	.def("set_crypto_pass", &libdar::archive_options_create::set_crypto_pass)
 	.def("set_crypto_size", &libdar::archive_options_create::set_crypto_size)
@@ -1454,6 +1461,7 @@ PYBIND11_MODULE(libdar, mod)
 	.def("set_security_check", &libdar::archive_options_create::set_security_check)
 	.def("set_user_comment", &libdar::archive_options_create::set_user_comment)
 	.def("set_hash_algo", &libdar::archive_options_create::set_hash_algo)
+	.def("add_hash_algo", &libdar::archive_options_create::add_hash_algo)
 	.def("set_slice_min_digits", &libdar::archive_options_create::set_slice_min_digits)
 	.def("set_backup_hook", &libdar::archive_options_create::set_backup_hook)
 	.def("set_ignore_unknow_inode_type", &libdar::archive_options_create::set_ignore_unknown_inode_type)
@@ -1486,6 +1494,7 @@ PYBIND11_MODULE(libdar, mod)
 	.def("set_compression_block_size", &libdar::archive_options_isolate::set_compression_block_size)
 	.def("set_slicing", &libdar::archive_options_isolate::set_slicing)
 	.def("set_execute", &libdar::archive_options_isolate::set_execute)
+	.def("set_async_execute", &libdar::archive_options_isolate::set_async_execute)
 	.def("set_crypto_algo", &libdar::archive_options_isolate::set_crypto_algo)
 	.def("set_crypto_pass", &libdar::archive_options_isolate::set_crypto_pass)
 	.def("set_crypto_size", &libdar::archive_options_isolate::set_crypto_size)
@@ -1497,6 +1506,7 @@ PYBIND11_MODULE(libdar, mod)
 	.def("set_slice_group_ownership", &libdar::archive_options_isolate::set_slice_group_ownership)
 	.def("set_user_comment", &libdar::archive_options_isolate::set_user_comment)
 	.def("set_hash_algo", &libdar::archive_options_isolate::set_hash_algo)
+	.def("add_hash_algo", &libdar::archive_options_isolate::add_hash_algo)
 	.def("set_slice_min_digits", &libdar::archive_options_isolate::set_slice_min_digits)
 	.def("set_sequential_marks", &libdar::archive_options_isolate::set_sequential_marks)
 	.def("set_entrepot", &libdar::archive_options_isolate::set_entrepot)
@@ -1532,6 +1542,7 @@ PYBIND11_MODULE(libdar, mod)
 	.def("set_slicing", &libdar::archive_options_merge::set_slicing)
 	.def("set_ea_mask", &libdar::archive_options_merge::set_ea_mask)
 	.def("set_execute", &libdar::archive_options_merge::set_execute)
+	.def("set_async_execute", &libdar::archive_options_merge::set_async_execute)
 	.def("set_crypto_algo", &libdar::archive_options_merge::set_crypto_algo)
 	.def("set_crypto_pass", &libdar::archive_options_merge::set_crypto_pass)
 	.def("set_crypto_size", &libdar::archive_options_merge::set_crypto_size)
@@ -1549,6 +1560,7 @@ PYBIND11_MODULE(libdar, mod)
 	.def("set_sparse_file_min_size", &libdar::archive_options_merge::set_sparse_file_min_size)
 	.def("set_user_comment", &libdar::archive_options_merge::set_user_comment)
 	.def("set_hash_algo", &libdar::archive_options_merge::set_hash_algo)
+	.def("add_hash_algo", &libdar::archive_options_merge::add_hash_algo)
 	.def("set_slice_min_digits", &libdar::archive_options_merge::set_slice_min_digits)
 	.def("set_entrepot", &libdar::archive_options_merge::set_entrepot)
 	.def("set_fsa_scope", &libdar::archive_options_merge::set_fsa_scope)
@@ -1591,7 +1603,8 @@ PYBIND11_MODULE(libdar, mod)
 	.def("set_overwriting_rules", &libdar::archive_options_extract::set_overwriting_rules)
 	.def("set_only_deleted", &libdar::archive_options_extract::set_only_deleted)
 	.def("set_ignore_deleted", &libdar::archive_options_extract::set_ignore_deleted)
-	.def("set_fsa_scope", &libdar::archive_options_extract::set_fsa_scope);
+	.def("set_fsa_scope", &libdar::archive_options_extract::set_fsa_scope)
+	.def("set_restore_writers", &libdar::archive_options_extract::set_restore_writers);
 
 
     pybind11::class_<libdar::archive_options_listing>(mod, "archive_options_listing")
@@ -1645,6 +1658,7 @@ PYBIND11_MODULE(libdar, mod)
 	.def("set_pause", &libdar::archive_options_repair::set_pause)
 	.def("set_slicing", &libdar::archive_options_repair::set_slicing)
 	.def("set_execute", &libdar::archive_options_repair::set_execute)
+	.def("set_async_execute", &libdar::archive_options_repair::set_async_execute)
 	.def("set_crypto_algo", &libdar::archive_options_repair::set_crypto_algo)
 	.def("set_crypto_pass", &libdar::archive_options_repair::set_crypto_pass)
 	.def("set_crypto_size", &libdar::archive_options_repair::set_crypto_size)
@@ -1656,6 +1670,7 @@ PYBIND11_MODULE(libdar, mod)
 	.def("set_slice_group_ownership", &libdar::archive_options_repair::set_slice_group_ownership)
 	.def("set_user_comment", &libdar::archive_options_repair::set_user_comment)
 	.def("set_hash_algo", &libdar::archive_options_repair::set_hash_algo)
+	.def("add_hash_algo", &libdar::archive_options_repair::add_hash_algo)
 	.def("set_slice_min_digits", &libdar::archive_options_repair::set_slice_min_digits)
 	.def("set_entrepot", &libdar::archive_options_repair::set_entrepot)
 	.def("set_multi_threaded", &libdar::archive_options_repair::set_multi_threaded)
@@ -1778,6 +1793,80 @@ PYBIND11_MODULE(libdar, mod)
 	.def("clear", &libdar::list_entry::clear);
 
 
+	///////////////////////////////////////////
+	// list_columns classes
+	//
+
+	// a read-only view on one table of a list_columns object,
+	// it supports the python buffer protocol (memoryview(), numpy.frombuffer(),...)
+	// and keeps the list_columns python object alive as long as it exists
+
+    class py_list_column
+    {
+    public:
+	pybind11::object owner;
+	const void *ptr;
+	pybind11::ssize_t itemsize;
+	std::string format;
+	pybind11::ssize_t num;
+    };
+
+    pybind11::class_<py_list_column>(mod, "list_column", pybind11::buffer_protocol())
+	.def_buffer([](py_list_column & col) -> pybind11::buffer_info
+		    {
+			return pybind11::buffer_info(const_cast<void *>(col.ptr),
+						     col.itemsize,
+						     col.format,
+						     1,
+						     { col.num },
+						     { col.itemsize },
+						     true);
+		    })
+	.def("__len__", [](const py_list_column & col) { return col.num; });
+
+    auto py_column = [](pybind11::object self, const auto & vec) -> py_list_column
+    {
+	using item = typename std::decay<decltype(vec)>::type::value_type;
+	return py_list_column{ self,
+			       vec.data(),
+			       (pybind11::ssize_t)sizeof(item),
+			       pybind11::format_descriptor<item>::format(),
+			       (pybind11::ssize_t)vec.size() };
+    };
+
+    pybind11::class_<libdar::list_columns>(mod, "list_columns")
+	.def(pybind11::init<>())
+	.def_readonly_static("flag_hard_linked", &libdar::list_columns::flag_hard_linked)
+	.def_readonly_static("flag_data_saved", &libdar::list_columns::flag_data_saved)
+	.def_readonly_static("flag_ea", &libdar::list_columns::flag_ea)
+	.def_readonly_static("flag_ea_saved", &libdar::list_columns::flag_ea_saved)
+	.def_readonly_static("flag_fsa", &libdar::list_columns::flag_fsa)
+	.def_readonly_static("flag_fsa_saved", &libdar::list_columns::flag_fsa_saved)
+	.def_readonly_static("flag_dirty", &libdar::list_columns::flag_dirty)
+	.def_readonly_static("flag_sparse", &libdar::list_columns::flag_sparse)
+	.def_readonly_static("flag_empty_dir", &libdar::list_columns::flag_empty_dir)
+	.def_readonly_static("flag_delta_sig", &libdar::list_columns::flag_delta_sig)
+	.def_readonly_static("flag_overflow", &libdar::list_columns::flag_overflow)
+	.def("size", &libdar::list_columns::size)
+	.def("__len__", &libdar::list_columns::size)
+	.def("get_name", &libdar::list_columns::get_name)
+	.def("get_name_arena", [](pybind11::object self) { const std::string & arena = self.cast<const libdar::list_columns &>().get_name_arena(); return py_list_column{ self, arena.data(), 1, pybind11::format_descriptor<unsigned char>::format(), (pybind11::ssize_t)arena.size() }; })
+	.def("get_name_offsets", [py_column](pybind11::object self) { return py_column(self, self.cast<const libdar::list_columns &>().get_name_offsets()); })
+	.def("get_types", [py_column](pybind11::object self) { return py_column(self, self.cast<const libdar::list_columns &>().get_types()); })
+	.def("get_removed_types", [py_column](pybind11::object self) { return py_column(self, self.cast<const libdar::list_columns &>().get_removed_types()); })
+	.def("get_flags", [py_column](pybind11::object self) { return py_column(self, self.cast<const libdar::list_columns &>().get_flags()); })
+	.def("get_perms", [py_column](pybind11::object self) { return py_column(self, self.cast<const libdar::list_columns &>().get_perms()); })
+	.def("get_uids", [py_column](pybind11::object self) { return py_column(self, self.cast<const libdar::list_columns &>().get_uids()); })
+	.def("get_gids", [py_column](pybind11::object self) { return py_column(self, self.cast<const libdar::list_columns &>().get_gids()); })
+	.def("get_file_sizes", [py_column](pybind11::object self) { return py_column(self, self.cast<const libdar::list_columns &>().get_file_sizes()); })
+	.def("get_storage_sizes", [py_column](pybind11::object self) { return py_column(self, self.cast<const libdar::list_columns &>().get_storage_sizes()); })
+	.def("get_data_offsets", [py_column](pybind11::object self) { return py_column(self, self.cast<const libdar::list_columns &>().get_data_offsets()); })
+	.def("get_last_access", [py_column](pybind11::object self) { return py_column(self, self.cast<const libdar::list_columns &>().get_last_access()); })
+	.def("get_last_modif", [py_column](pybind11::object self) { return py_column(self, self.cast<const libdar::list_columns &>().get_last_modif()); })
+	.def("get_last_change", [py_column](pybind11::object self) { return py_column(self, self.cast<const libdar::list_columns &>().get_last_change()); })
+	.def("clear", &libdar::list_columns::clear);
+
+
     	///////////////////////////////////////////
 	// archive classes
 	//
@@ -1970,6 +2059,11 @@ PYBIND11_MODULE(libdar, mod)
 	.def("op_test", (libdar::statistics (py_archive::*)(const libdar::archive_options_test &, std::shared_ptr<libdar::statistics>))&py_archive::op_test)
 	.def("op_isolate", &libdar::archive::op_isolate)
 	.def("get_children_in_table", &libdar::archive::get_children_in_table)
+	.def("get_children_in_columns", &libdar::archive::get_children_in_columns,
+	     pybind11::arg("dir"),
+	     pybind11::arg("batch"),
+	     pybind11::arg("start") = 0,
+	     pybind11::arg("max_entries") = 0)
 	.def("has_subdirectory", &libdar::archive::has_subdirectory)
 	.def("get_stats", &libdar::archive::get_stats)
 	.def("get_signatories", &libdar::archive::get_signatories)
@@ -29,6 +29,10 @@ extern "C"
 } // end extern "C"
 
 #include <iostream>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <vector>
 
 #include "libdar.hpp"
 #include "testtools.hpp"
@@ -44,6 +48,8 @@ extern "C"
 #include "pile.hpp"
 #include "tools.hpp"
 #include "compressor.hpp"
+#include "crc.hpp"
+#include "catalogue_chunk.hpp"
 
 using namespace libdar;
 using namespace std;
@@ -52,13 +58,23 @@ using namespace std;
 #define FIC2 "test/dump2.bin"
 
 static shared_ptr<user_interaction> ui;
+static U_I errors = 0;
+
+static void report(bool cond, const string & what);
+static cat_file *new_file(const string & name, U_I num);
+static void dump_cat(const catalogue & cat, const string & filename);
+static catalogue *load_cat(const string & filename, U_I threads);
+static void list_cat(const catalogue & cat, vector<string> & names);
 
 void f1();
 void f2();
 void f3();
 void f4();
+void f5(U_I num);
+void f6();
+void f7();
 
-int main()
+int main(int argc, char *argv[])
 {
     U_I maj, med, min;
 
@@ -73,6 +89,10 @@ int main()
 	f2();
 	f3();
 	f4();
+	f6();
+	f7();
+	if(argc > 1)
+	    f5(atoi(argv[1]));
     }
     catch(Egeneric & e)
     {
@@ -80,7 +100,103 @@ int main()
     }
 
     ui.reset();
-    return 0;
+    return errors == 0 ? 0 : 1;
+}
+
+static void report(bool cond, const string & what)
+{
+    cout << (cond ? "OK   : " : "FAIL : ") << what << endl;
+    if(!cond)
+	++errors;
+}
+
+static cat_file *new_file(const string & name, U_I num)
+{
+    crc_n check(4);
+    cat_file *fic = new cat_file(1024, 102, 0644, datetime(1), datetime(2), datetime(3), name, path("."), 1024 + num, 0, false);
+
+    fic->set_saved_status(saved_status::saved);
+    fic->set_offset(num);
+    fic->set_storage_size(1024 + num);
+    fic->set_crc(check);
+
+    return fic;
+}
+
+static void dump_cat(const catalogue & cat, const string & filename)
+{
+    fichier_local *f = nullptr;
+    compressor *comp = nullptr;
+    pile stack;
+    pile_descriptor pdesc;
+
+    unlink(filename.c_str());
+    f = new fichier_local(ui, filename, gf_read_write, 0644, false, true, false);
+    stack.push(f);
+    comp = new compressor(compression::gzip, *f, 6);
+    stack.push(comp);
+    pdesc = & stack;
+
+    cat.dump(pdesc);
+    stack.sync_write();
+    stack.clear();
+}
+
+static catalogue *load_cat(const string & filename, U_I threads)
+{
+    fichier_local *f = nullptr;
+    compressor *comp = nullptr;
+    pile stack;
+    pile_descriptor pdesc;
+    label lax_label;
+
+    lax_label.clear();
+    f = new fichier_local(ui, filename, gf_read_only, 0644, false, false, false);
+    stack.push(f);
+    comp = new compressor(compression::gzip, *f, 6);
+    stack.push(comp);
+    pdesc = & stack;
+
+    return new catalogue(ui, pdesc, archive_format_supported_version, compression::gzip, false, lax_label, false, threads);
+}
+
+static void list_cat(const catalogue & cat, vector<string> & names)
+{
+    const cat_entree *e;
+    map<infinint, string> first_link; ///< name of the first hard link met for each etiquette
+
+    names.clear();
+    cat.reset_read();
+    while(cat.read(e))
+    {
+	const cat_nomme *nom = dynamic_cast<const cat_nomme *>(e);
+	const cat_mirage *mir = dynamic_cast<const cat_mirage *>(e);
+
+	if(nom == nullptr)
+	    names.push_back("<eod>");
+	else if(mir != nullptr)
+	{
+	    map<infinint, string>::iterator it = first_link.find(mir->get_etiquette());
+
+	    if(it == first_link.end())
+	    {
+		first_link[mir->get_etiquette()] = nom->get_name();
+		names.push_back(nom->get_name() + " (hard link)");
+	    }
+	    else
+		names.push_back(nom->get_name() + " (hard link with " + it->second + ")");
+	}
+	else if(dynamic_cast<const cat_ignored_dir *>(e) != nullptr)
+	{
+		// an ignored directory is stored as an empty directory
+	    names.push_back(nom->get_name() + "/");
+	    names.push_back("<eod>");
+	}
+	else if(dynamic_cast<const cat_directory *>(e) != nullptr)
+	    names.push_back(nom->get_name() + "/");
+	else
+	    names.push_back(nom->get_name());
+    }
 }
 
 void f1()
@@ -379,3 +495,193 @@ void f4()
 
     delete abell;
 }
+
+
+void f5(U_I num)
+{
+
+	//
+	// catalogue load benchmark, only run when an argument is given
+	// (it is the number of directories of 100 files each)
+	//
+
+    label data_name;
+    label lax_label;
+    catalogue cat(ui, datetime(12), data_name);
+    chrono::steady_clock::time_point start;
+    chrono::duration<double> elapsed;
+    crc_n check(4);
+
+    lax_label.clear();
+    cat.reset_add();
+    for(U_I d = 0; d < num; ++d)
+    {
+	cat.add(new cat_directory(1026, 104, 0755, datetime(7), datetime(8), datetime(9), string("dir") + tools_int2str(d), 0));
+	for(U_I f = 0; f < 100; ++f)
+	{
+	    cat_file *fic = new cat_file(1024, 102, 0644, datetime(1), datetime(2), datetime(3), string("file") + tools_int2str(f), path("."), 1024 + f, 0, false);
+	    fic->set_saved_status(saved_status::saved);
+	    fic->set_offset(d * 100 + f);
+	    fic->set_storage_size(1024 + f);
+	    fic->set_crc(check);
+	    cat.add(fic);
+	}
+	cat.add(new cat_eod());
+    }
+
+    unlink(FIC1);
+    try
+    {
+	fichier_local *f = new fichier_local(ui, FIC1, gf_read_write, 0644, false, true, false);
+	compressor *comp = new compressor(compression::gzip, *f, 6);
+	pile stack;
+	pile_descriptor pdesc;
+
+	stack.push(f);
+	f = nullptr;
+	stack.push(comp);
+	comp = nullptr;
+	pdesc = & stack;
+
+	cat.dump(pdesc);
+	stack.sync_write();
+	stack.clear();
+    }
+    catch(Egeneric & e)
+    {
+	cerr << e.get_message() << endl;
+	return;
+    }
+
+    for(U_I threads = 1; threads <= 4; threads *= 4)
+    {
+	try
+	{
+	    fichier_local *f = new fichier_local(ui, FIC1, gf_read_only, 0644, false, false, false);
+	    compressor *comp = new compressor(compression::gzip, *f, 6);
+	    pile stack;
+	    pile_descriptor pdesc;
+
+	    stack.push(f);
+	    f = nullptr;
+	    stack.push(comp);
+	    comp = nullptr;
+	    pdesc = & stack;
+
+	    start = chrono::steady_clock::now();
+	    catalogue lst(ui, pdesc, archive_format_supported_version, compression::gzip, false, lax_label, false, threads);
+	    elapsed = chrono::steady_clock::now() - start;
+
+	    cout << "catalogue of " << num * 101 << " entries loaded in " << elapsed.count() << " s using " << threads << " thread(s)" << endl;
+	    if(lst.get_contenu()->get_tree_size() != num * 101)
+		cerr << "unexpected catalogue size: " << libdar::deci(lst.get_contenu()->get_tree_size()).human() << endl;
+	}
+	catch(Egeneric & e)
+	{
+	    cerr << e.get_message() << endl;
+	}
+    }
+}
+
+void f6()
+{
+
+	//
+	// catalogue large enough to be dumped as chunks, read back
+	// with and without additional threads to decode the chunks
+	//
+
+    label data_name;
+    catalogue cat(ui, datetime(12), data_name);
+    U_I num = 2*CATALOGUE_CHUNK_ENTRIES + 100;
+    cat_etoile *star = new cat_etoile(new_file("linked", 0), 1);
+    cat_directory ignored(1026, 104, 0755, datetime(7), datetime(8), datetime(9), "ignored", 0);
+    vector<string> ref, res;
+
+    cat.reset_add();
+    cat.add(new cat_mirage("link_at_root", star));
+    cat.add(new cat_directory(1026, 104, 0755, datetime(7), datetime(8), datetime(9), "big", 0));
+    for(U_I i = 0; i < num; ++i)
+    {
+	if(i % 5000 == 10)
+	{
+	    string sub = string("sub") + tools_int2str(i);
+
+	    cat.add(new cat_directory(1026, 104, 0755, datetime(7), datetime(8), datetime(9), sub, 0));
+	    cat.add(new_file("inner", i));
+	    cat.add(new cat_directory(1026, 104, 0755, datetime(7), datetime(8), datetime(9), "nested", 0));
+	    cat.add(new_file("deep", i));
+	    cat.add(new cat_mirage("link_deep", star));
+	    cat.add(new cat_eod());
+	    cat.add(new cat_ignored_dir(ignored));
+	    cat.add(new cat_eod());
+	}
+	else if(i % 7000 == 20)
+	    cat.add(new cat_mirage(string("link") + tools_int2str(i), star));
+	else
+	    cat.add(new_file(string("file") + tools_int2str(i), i));
+    }
+    cat.add(new cat_eod());
+    cat.add(new cat_ignored_dir(ignored));
+    cat.add(new_file("last", 0));
+
+    list_cat(cat, ref);
+    dump_cat(cat, FIC2);
+
+    for(U_I threads = 1; threads <= 4; threads *= 4)
+    {
+	unique_ptr<catalogue> lst(load_cat(FIC2, threads));
+
+	list_cat(*lst, res);
+	report(res == ref, string("chunked catalogue read back with ") + tools_int2str(threads) + " thread(s)");
+    }
+}
+
+void f7()
+{
+
+	//
+	// catalogue which entries have been spilled to disk while it was built
+	//
+
+    label data_name;
+    catalogue cat(ui, datetime(12), data_name);
+    U_I num = 2*CATALOGUE_CHUNK_ENTRIES + 100;
+    bool thrown;
+
+    cat.reset_add();
+    cat.set_spill_directory("test");
+    cat.add(new cat_directory(1026, 104, 0755, datetime(7), datetime(8), datetime(9), "big", 0));
+    for(U_I i = 0; i < num; ++i)
+	cat.add(new_file(string("file") + tools_int2str(i), i));
+    cat.add(new cat_eod());
+    report(cat.has_spilled_entries(), "entries spilled to disk");
+
+    thrown = false;
+    try
+    {
+	catalogue copy(cat);
+    }
+    catch(Erange & e)
+    {
+	thrown = true;
+    }
+    report(thrown, "copy of a spilled catalogue refused");
+
+    thrown = false;
+    try
+    {
+	catalogue other(ui, datetime(12), data_name);
+
+	other = cat;
+    }
+    catch(Erange & e)
+    {
+	thrown = true;
+    }
+    report(thrown, "assignment from a spilled catalogue refused");
+
+    dump_cat(cat, FIC1);
+    unique_ptr<catalogue> lst(load_cat(FIC1, 1));
+    report(lst->get_contenu()->get_tree_size() == num + 1, "spilled catalogue dumped completely");
+}
@@ -0,0 +1,191 @@
+/*********************************************************************/
+// dar - disk archive - a backup/restoration program
+// Copyright (C) 2002-2026 Denis Corbin
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// to contact the author, see the AUTHOR file
+/*********************************************************************/
+
+#include "../my_config.h"
+
+#include <iostream>
+#include <memory>
+
+#include "libdar.hpp"
+#include "memory_file.hpp"
+#include "crc.hpp"
+
+using namespace libdar;
+using namespace std;
+
+    // memory_file failing once a given amount of data has been read from it
+
+class failing_file : public memory_file
+{
+public:
+    failing_file(U_I limit): failed_at(limit), lu(0) {};
+
+protected:
+    virtual U_I inherited_read(char *a, U_I size) override;
+
+private:
+    U_I failed_at;
+    U_I lu;
+};
+
+static U_I errors = 0;
+
+static void check(bool cond, const string & what);
+static void fill(generic_file & f, U_I size);
+static string content(memory_file & f);
+static void f1(U_I size);
+static void f2();
+
+int main()
+{
+    U_I maj, med, min;
+
+    get_version(maj, med, min);
+
+    try
+    {
+	f1(3*102400 + 12345); // several blocks
+	f1(102400);           // exactly one block
+	f1(5000);             // less than one block
+	f1(0);                // empty source
+	f2();
+    }
+    catch(Egeneric & e)
+    {
+	cout << "Aborting on exception: " << e.get_message() << endl;
+	++errors;
+    }
+
+    cout << (errors == 0 ? "all tests passed" : "SOME TESTS FAILED") << endl;
+
+    return errors == 0 ? 0 : 1;
+}
+
+U_I failing_file::inherited_read(char *a, U_I size)
+{
+    if(lu >= failed_at)
+	throw Erange("simulated read error");
+
+    U_I ret = memory_file::inherited_read(a, size);
+    lu += ret;
+
+    return ret;
+}
+
+static void check(bool cond, const string & what)
+{
+    cout << (cond ? "OK   : " : "FAIL : ") << what << endl;
+    if(!cond)
+	++errors;
+}
+
+static void fill(generic_file & f, U_I size)
+{
+    U_32 seed = 98765;
+    char buffer[4096];
+    U_I i = 0;
+
+    while(i < size)
+    {
+	U_I step = size - i > sizeof(buffer) ? sizeof(buffer) : size - i;
+
+	for(U_I j = 0; j < step; ++j)
+	{
+	    seed = seed * 1103515245 + 12345;
+	    buffer[j] = (char)(seed >> 16);
+	}
+	f.write(buffer, step);
+	i += step;
+    }
+    f.skip(0);
+}
+
+static string content(memory_file & f)
+{
+    string ret;
+    char buffer[4096];
+    U_I lu;
+
+    f.skip(0);
+    do
+    {
+	lu = f.read(buffer, sizeof(buffer));
+	ret += string(buffer, lu);
+    }
+    while(lu > 0);
+
+    return ret;
+}
+
+    // copy_to_overlapped() must copy the same data and give the same CRC as copy_to()
+
+static void f1(U_I size)
+{
+    const string name = "source of " + to_string(size) + " bytes: ";
+    memory_file src;
+    memory_file dst_ref;
+    memory_file dst;
+    crc *crc_ref = nullptr;
+    crc *crc_over = nullptr;
+
+    fill(src, size);
+    src.copy_to(dst_ref, infinint(4), crc_ref);
+    unique_ptr<crc> keep_ref(crc_ref);
+
+    src.skip(0);
+    src.copy_to_overlapped(dst, infinint(4), crc_over);
+    unique_ptr<crc> keep_over(crc_over);
+
+    check(dst.size() == infinint(size), name + "all data copied");
+    check(content(dst) == content(dst_ref), name + "same data as with copy_to()");
+    check(crc_ref != nullptr && crc_over != nullptr && *crc_ref == *crc_over, name + "same CRC as with copy_to()");
+}
+
+    // an error met while reading the source must reach the caller
+
+static void f2()
+{
+    const U_I limits[] = { 0, 50000, 3*102400 };
+
+    for(U_I i = 0; i < sizeof(limits) / sizeof(limits[0]); ++i)
+    {
+	const string name = "read error after " + to_string(limits[i]) + " bytes: ";
+	failing_file src(limits[i]);
+	memory_file dst;
+	crc *value = nullptr;
+	bool thrown = false;
+
+	fill(src, 5*102400);
+
+	try
+	{
+	    src.copy_to_overlapped(dst, infinint(4), value);
+	}
+	catch(Erange & e)
+	{
+	    thrown = e.get_message() == "simulated read error";
+	}
+	delete value;
+
+	check(thrown, name + "error reported to the caller");
+	check(dst.size() < infinint(5*102400), name + "copy stopped at the error");
+    }
+}
@@ -0,0 +1,316 @@
+/*********************************************************************/
+// dar - disk archive - a backup/restoration program
+// Copyright (C) 2002-2026 Denis Corbin
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// to contact the author, see the AUTHOR file
+/*********************************************************************/
+
+#include "../my_config.h"
+
+extern "C"
+{
+#if HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+}
+
+#include <iostream>
+#include <memory>
+
+#include "libdar.hpp"
+#include "crypto_sym.hpp"
+#include "tronconneuse.hpp"
+#include "fichier_local.hpp"
+
+using namespace libdar;
+using namespace std;
+
+#define TEST_FILE "./test_crypto_sym.tmp"
+
+static shared_ptr<user_interaction> ui;
+static U_I errors = 0;
+
+static void check(bool cond, const string & what);
+static crypto_sym *make_cipher(const string & pass, crypto_algo algo, const string & salt, U_I iterations = 2000);
+static bool round_trip(crypto_sym & writer, crypto_sym & reader);
+static void f1(crypto_algo algo);
+static void f2(crypto_algo algo);
+static void f3();
+
+int main()
+{
+    const crypto_algo algos[] = { crypto_algo::aes256_xts,
+				  crypto_algo::twofish256_xts,
+				  crypto_algo::serpent256_xts,
+				  crypto_algo::camellia256_xts,
+				  crypto_algo::aes256 };
+    U_I maj, med, min;
+
+    get_version(maj, med, min);
+    ui.reset(new (nothrow) shell_interaction(cout, cerr, false));
+    if(!ui)
+	cout << "ERREUR !" << endl;
+
+    for(U_I i = 0; i < sizeof(algos) / sizeof(algos[0]); ++i)
+    {
+	try
+	{
+	    f1(algos[i]);
+	    f2(algos[i]);
+	}
+	catch(Egeneric & e)
+	{
+	    cout << "FAIL : exception caught with " << crypto_algo_2_string(algos[i]) << ": " << e.get_message() << endl;
+	    ++errors;
+	}
+    }
+
+    try
+    {
+	f3();
+    }
+    catch(Egeneric & e)
+    {
+	cout << "FAIL : exception caught while testing the derived key cache: " << e.get_message() << endl;
+	++errors;
+    }
+
+    (void)unlink(TEST_FILE);
+    cout << (errors == 0 ? "all tests passed" : "SOME TESTS FAILED") << endl;
+
+    return errors == 0 ? 0 : 1;
+}
+
+static void check(bool cond, const string & what)
+{
+    cout << (cond ? "OK   : " : "FAIL : ") << what << endl;
+    if(!cond)
+	++errors;
+}
+
+static crypto_sym *make_cipher(const string & pass, crypto_algo algo, const string & salt, U_I iterations)
+{
+    crypto_sym *ret = new (nothrow) crypto_sym(secu_string(pass.c_str(), pass.size()),
+					       archive_format_supported_version,
+					       algo,
+					       salt,
+					       iterations,
+					       hash_algo::sha1,
+					       true);
+    if(ret == nullptr)
+	throw Ememory();
+
+    return ret;
+}
+
+static bool round_trip(crypto_sym & writer, crypto_sym & reader)
+{
+    const U_32 clear_size = 1000;
+    U_32 allocated = writer.clear_block_allocated_size_for(clear_size);
+    U_32 crypt_size = writer.encrypted_block_size_for(clear_size);
+    unique_ptr<char[]> clear(new (nothrow) char[allocated]);
+    unique_ptr<char[]> crypt(new (nothrow) char[crypt_size]);
+    unique_ptr<char[]> back(new (nothrow) char[allocated]);
+    U_32 size, lu;
+
+    if(!clear || !crypt || !back)
+	throw Ememory();
+
+    for(U_32 i = 0; i < clear_size; ++i)
+	clear[i] = (char)(i * 7);
+
+    size = writer.encrypt_data(3, clear.get(), clear_size, allocated, crypt.get(), crypt_size);
+    try
+    {
+	lu = reader.decrypt_data(3, crypt.get(), size, back.get(), allocated);
+    }
+    catch(Erange & e)
+    {
+	return false;
+    }
+
+    return lu == clear_size && string(back.get(), lu) == string(clear.get(), clear_size);
+}
+
+    // block level encryption, the tweak must depend on the block number
+
+static void f1(crypto_algo algo)
+{
+    const string name = crypto_algo_2_string(algo);
+    const U_32 clear_size = 4000; // not a multiple of the cipher block size
+    unique_ptr<crypto_sym> cipher(make_cipher("bonjour", algo, ""));
+    U_32 allocated = cipher->clear_block_allocated_size_for(clear_size);
+    U_32 crypt_size = cipher->encrypted_block_size_for(clear_size);
+    unique_ptr<char[]> clear(new (nothrow) char[allocated]);
+    unique_ptr<char[]> crypt_a(new (nothrow) char[crypt_size]);
+    unique_ptr<char[]> crypt_b(new (nothrow) char[crypt_size]);
+    unique_ptr<char[]> back(new (nothrow) char[allocated]);
+    U_32 size_a, size_b, lu;
+
+    if(!clear || !crypt_a || !crypt_b || !back)
+	throw Ememory();
+
+	// same pattern repeated, each cipher block must still encrypt differently
+    for(U_32 i = 0; i < clear_size; ++i)
+	clear[i] = (char)(i % 16);
+
+    size_a = cipher->encrypt_data(7, clear.get(), clear_size, allocated, crypt_a.get(), crypt_size);
+    size_b = cipher->encrypt_data(8, clear.get(), clear_size, allocated, crypt_b.get(), crypt_size);
+    check(size_a == size_b && string(crypt_a.get(), size_a) != string(crypt_b.get(), size_b),
+	  name + ": encryption depends on the block number");
+    check(string(crypt_a.get(), 16) != string(crypt_a.get() + 16, 16),
+	  name + ": identical cipher blocks encrypt differently");
+
+    lu = cipher->decrypt_data(7, crypt_a.get(), size_a, back.get(), allocated);
+    check(lu == clear_size && string(back.get(), lu) == string(clear.get(), clear_size),
+	  name + ": block decrypted back");
+
+	// another crypto_sym object built from the same password and salt must decrypt it too
+    unique_ptr<crypto_sym> reader(make_cipher("bonjour", algo, cipher->get_salt()));
+    lu = reader->decrypt_data(8, crypt_b.get(), size_b, back.get(), allocated);
+    check(lu == clear_size && string(back.get(), lu) == string(clear.get(), clear_size),
+	  name + ": block decrypted back by another object");
+}
+
+    // round trip through a tronconneuse, sequential and random access
+
+static void f2(crypto_algo algo)
+{
+    const string name = crypto_algo_2_string(algo);
+    const U_32 block_size = 10240;
+    string data;
+    string salt;
+    U_32 seed = 4321;
+    char buffer[50000];
+    U_I lu;
+
+    for(U_I i = 0; i < 200000; ++i)
+    {
+	seed = seed * 1103515245 + 12345;
+	data += (char)(seed >> 16);
+    }
+
+    {
+	fichier_local encrypted(ui, TEST_FILE, gf_write_only, 0600, false, true, false);
+	crypto_sym *cipher = make_cipher("bonjour", algo, "");
+	unique_ptr<crypto_module> ptr(cipher);
+
+	salt = cipher->get_salt();
+	tronconneuse writer(block_size, encrypted, archive_format_supported_version, ptr);
+
+	for(U_I pos = 0; pos < data.size(); pos += 12345)
+	    writer.write(data.data() + pos, data.size() - pos > 12345 ? 12345 : data.size() - pos);
+	writer.write_end_of_file();
+	writer.terminate();
+    }
+
+    {
+	fichier_local encrypted(ui, TEST_FILE, gf_read_only, 0, false, false, false);
+	unique_ptr<crypto_module> ptr(make_cipher("bonjour", algo, salt));
+	string got;
+	bool ok = true;
+
+	check(encrypted.get_size() > data.size(), name + ": data encrypted");
+	tronconneuse reader(block_size, encrypted, archive_format_supported_version, ptr);
+
+	do
+	{
+	    lu = reader.read(buffer, sizeof(buffer));
+	    got += string(buffer, lu);
+	}
+	while(lu > 0);
+	check(got == data, name + ": sequential read of encrypted data");
+
+	for(U_I pos = 190000; pos > 1000; pos /= 3)
+	{
+	    if(!reader.skip(pos))
+		ok = false;
+	    lu = reader.read(buffer, 5000);
+	    if(string(buffer, lu) != data.substr(pos, 5000))
+		ok = false;
+	}
+	check(ok, name + ": random access to encrypted data");
+    }
+
+    {
+	fichier_local encrypted(ui, TEST_FILE, gf_read_only, 0, false, false, false);
+	unique_ptr<crypto_module> ptr(make_cipher("au revoir", algo, salt));
+	tronconneuse reader(block_size, encrypted, archive_format_supported_version, ptr);
+
+	try
+	{
+	    lu = reader.read(buffer, 5000);
+	    check(string(buffer, lu) != data.substr(0, lu), name + ": wrong password does not give back the data");
+	}
+	catch(Erange & e)
+	{
+	    check(true, name + ": wrong password does not give back the data");
+	}
+    }
+}
+
+    // keys derived from passphrases are reused only for the same passphrase, salt,
+    // iteration count and key length, and derived again once the cache is cleared or disabled
+
+static void f3()
+{
+    const crypto_algo algo = crypto_algo::aes256;
+    string salt;
+
+    crypto_sym::set_key_cache(true);
+    crypto_sym::clear_key_cache();
+    check(crypto_sym::get_key_cache_size() == 0, "key cache: empty once cleared");
+
+    unique_ptr<crypto_sym> first(make_cipher("bonjour", algo, ""));
+    salt = first->get_salt();
+    check(crypto_sym::get_key_cache_size() == 1, "key cache: derived key recorded");
+
+    unique_ptr<crypto_sym> same(make_cipher("bonjour", algo, salt));
+    check(crypto_sym::get_key_cache_size() == 1, "key cache: same passphrase and salt reuse the cached key");
+    check(round_trip(*first, *same), "key cache: cached key decrypts");
+
+    unique_ptr<crypto_sym> other_salt(make_cipher("bonjour", algo, salt + "x"));
+    check(crypto_sym::get_key_cache_size() == 2, "key cache: different salt not found in cache");
+    check(!round_trip(*first, *other_salt), "key cache: different salt gives a different key");
+
+    unique_ptr<crypto_sym> other_count(make_cipher("bonjour", algo, salt, 2001));
+    check(crypto_sym::get_key_cache_size() == 3, "key cache: different iteration count not found in cache");
+    check(!round_trip(*first, *other_count), "key cache: different iteration count gives a different key");
+
+    unique_ptr<crypto_sym> other_len(make_cipher("bonjour", crypto_algo::blowfish, salt));
+    check(crypto_sym::max_key_len_libdar(crypto_algo::blowfish) != crypto_sym::max_key_len_libdar(algo),
+	  "key cache: blowfish uses another key length");
+    check(crypto_sym::get_key_cache_size() == 4, "key cache: different key length not found in cache");
+
+    unique_ptr<crypto_sym> other_pass(make_cipher("au revoir", algo, salt));
+    check(crypto_sym::get_key_cache_size() == 5, "key cache: different passphrase not found in cache");
+    check(!round_trip(*first, *other_pass), "key cache: different passphrase gives a different key");
+
+    crypto_sym::clear_key_cache();
+    check(crypto_sym::get_key_cache_size() == 0, "key cache: cleared");
+    unique_ptr<crypto_sym> after_clear(make_cipher("bonjour", algo, salt));
+    check(crypto_sym::get_key_cache_size() == 1, "key cache: key derived again after clearing");
+    check(round_trip(*first, *after_clear), "key cache: key derived again decrypts");
+
+    crypto_sym::set_key_cache(false);
+    check(crypto_sym::get_key_cache_size() == 0, "key cache: disabling clears the cache");
+    unique_ptr<crypto_sym> disabled(make_cipher("bonjour", algo, salt));
+    check(crypto_sym::get_key_cache_size() == 0, "key cache: nothing recorded when disabled");
+    check(round_trip(*first, *disabled), "key cache: key derived while disabled decrypts");
+
+    crypto_sym::set_key_cache(true);
+}
@@ -0,0 +1,89 @@
+#!/bin/sh
+
+#######################################################################
+# dar - disk archive - a backup/restoration program
+# Copyright (C) 2002-2026 Denis Corbin
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU General Public License
+# as published by the Free Software Foundation; either version 2
+# of the License, or (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+#
+# to contact the author, see the AUTHOR file
+#######################################################################
+
+# restores the latest state of a tree saved over three archives of a
+# dar_manager database with -ap option, sequentially and extracting the
+# archives concurrently, and compares the result with the saved tree,
+# including the dates and permissions of directories and hard links
+
+DAR=${DAR:-../dar_suite/dar}
+DAR_MANAGER=${DAR_MANAGER:-../dar_suite/dar_manager}
+ROOT=test_dar_manager_ap
+
+clean()
+{
+   rm -rf $ROOT
+}
+
+fail()
+{
+   echo "FAIL : $1"
+   exit 1
+}
+
+clean
+mkdir -p $ROOT/src/sub/deep || fail "cannot create test directories"
+BASE=$(cd $ROOT && pwd)
+DAR=$(cd $(dirname $DAR) && pwd)/$(basename $DAR)
+DAR_MANAGER=$(cd $(dirname $DAR_MANAGER) && pwd)/$(basename $DAR_MANAGER)
+
+echo a > $ROOT/src/a
+echo b > $ROOT/src/sub/b
+echo c > $ROOT/src/sub/deep/c
+echo h > $ROOT/src/sub/h1
+ln $ROOT/src/sub/h1 $ROOT/src/sub/deep/h2 || fail "cannot create hard link"
+chmod 750 $ROOT/src/sub
+$DAR -Q -c $BASE/full -R $BASE/src > /dev/null || fail "full backup"
+
+echo changed > $ROOT/src/a
+rm -f $ROOT/src/sub/b
+echo d > $ROOT/src/sub/d
+$DAR -Q -c $BASE/diff1 -A $BASE/full -R $BASE/src > /dev/null || fail "first differential backup"
+
+echo e > $ROOT/src/sub/deep/e
+echo again > $ROOT/src/sub/d
+chmod 711 $ROOT/src/sub/deep
+touch -d "2020-01-02 03:04:05" $ROOT/src/sub/deep
+$DAR -Q -c $BASE/diff2 -A $BASE/diff1 -R $BASE/src > /dev/null || fail "second differential backup"
+
+$DAR_MANAGER -Q -C $BASE/base.dmd || fail "database creation"
+for arch in full diff1 diff2 ; do
+    $DAR_MANAGER -Q -B $BASE/base.dmd -A $BASE/$arch || fail "adding $arch to database"
+done
+
+for opt in -ap -ap:0 -ap:1 ; do
+    rm -rf $ROOT/dst
+    mkdir $ROOT/dst
+    (cd $ROOT/dst && $DAR_MANAGER -Q -B $BASE/base.dmd $opt -r a sub > /dev/null) || fail "restoration with $opt"
+    diff -r $ROOT/src $ROOT/dst || fail "restored tree differs from source with $opt"
+    for dir in sub sub/deep ; do
+	[ "$(stat -c '%a %Y' $ROOT/src/$dir)" = "$(stat -c '%a %Y' $ROOT/dst/$dir)" ] || fail "permission or date of $dir differs with $opt"
+    done
+    [ "$(stat -c '%i' $ROOT/dst/sub/h1)" = "$(stat -c '%i' $ROOT/dst/sub/deep/h2)" ] || fail "hard link not restored with $opt"
+    echo "OK   : in-process restoration with $opt"
+done
+
+(cd $ROOT && $DAR_MANAGER -Q -B $BASE/base.dmd -ap:-1 -r a > /dev/null 2>&1) && fail "negative number of archives accepted by -ap"
+echo "OK   : negative number of archives rejected by -ap"
+
+clean
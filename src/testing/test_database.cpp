@@ -0,0 +1,291 @@
+/*********************************************************************/
+// dar - disk archive - a backup/restoration program
+// Copyright (C) 2002-2026 Denis Corbin
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// to contact the author, see the AUTHOR file
+/*********************************************************************/
+
+#include "../my_config.h"
+
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "libdar.hpp"
+#include "data_dir.hpp"
+#include "data_tree.hpp"
+#include "crc.hpp"
+#include "database_header.hpp"
+#include "cat_all_entrees.hpp"
+#include "memory_file.hpp"
+
+using namespace libdar;
+using namespace std;
+
+static U_I errors = 0;
+
+static void check(bool cond, const string & what);
+static string content(memory_file & f);
+static void collect(void *context, const string & filename, bool available_data, bool available_ea);
+static cat_directory *build_archive(U_I shift);
+static void f1();
+static void f2();
+
+int main()
+{
+    U_I maj, med, min;
+
+    get_version(maj, med, min);
+
+    try
+    {
+	f1();
+	f2();
+    }
+    catch(Egeneric & e)
+    {
+	cout << "Aborting on exception: " << e.get_message() << endl;
+	++errors;
+    }
+
+    cout << (errors == 0 ? "all tests passed" : "SOME TESTS FAILED") << endl;
+
+    return errors == 0 ? 0 : 1;
+}
+
+static void check(bool cond, const string & what)
+{
+    cout << (cond ? "OK   : " : "FAIL : ") << what << endl;
+    if(!cond)
+	++errors;
+}
+
+static string content(memory_file & f)
+{
+    string ret;
+    char buffer[1024];
+    U_I lu;
+
+    f.skip(0);
+    do
+    {
+	lu = f.read(buffer, sizeof(buffer));
+	ret += string(buffer, lu);
+    }
+    while(lu > 0);
+
+    return ret;
+}
+
+static void collect(void *context, const string & filename, bool available_data, bool available_ea)
+{
+    vector<string> *res = (vector<string> *)context;
+
+    res->push_back(filename + (available_data ? " D" : " -") + (available_ea ? "E" : "-"));
+}
+
+    // a small tree with nested directories, of which some entries change with shift
+
+static cat_directory *build_archive(U_I shift)
+{
+    cat_directory *root = new cat_directory(0, 0, 0755, datetime(1), datetime(2), datetime(3), "root", 0);
+    cat_directory *sub = new cat_directory(0, 0, 0755, datetime(4), datetime(5 + shift), datetime(6 + shift), "sub", 0);
+    cat_directory *deep = new cat_directory(0, 0, 0755, datetime(7), datetime(8), datetime(9), "deep", 0);
+
+    root->add_children(new cat_file(0, 0, 0644, datetime(10), datetime(11), datetime(12), "f1", path("."), 10, 0, false));
+    root->add_children(sub);
+    sub->add_children(new cat_file(0, 0, 0644, datetime(13), datetime(14 + shift), datetime(15 + shift), "f2", path("."), 10, 0, false));
+    sub->add_children(deep);
+    deep->add_children(new cat_file(0, 0, 0644, datetime(16), datetime(17 + shift), datetime(18 + shift), "f3", path("."), 10, 0, false));
+    if(shift == 0)
+	sub->add_children(new cat_file(0, 0, 0644, datetime(19), datetime(20), datetime(21), "gone", path("."), 10, 0, false));
+    else
+    {
+	sub->add_children(new cat_detruit("gone", 'f', datetime(22)));
+	root->add_children(new cat_file(0, 0, 0644, datetime(23), datetime(24), datetime(25), "f4", path("."), 10, 0, false));
+    }
+
+    return root;
+}
+
+    // streamed layout of the file tree (database format version 8)
+
+static void f1()
+{
+    unsigned char version = database_header_get_supported_version();
+    data_dir tree("root");
+    memory_file streamed;
+    memory_file legacy;
+    memory_file again;
+    vector<string> ref, res;
+    unique_ptr<data_dir> loaded;
+
+    for(U_I i = 1; i <= 2; ++i)
+    {
+	unique_ptr<cat_directory> arch(build_archive(i == 1 ? 0 : 100));
+
+	tree.data_tree_update_with(arch.get(), i);
+	tree.finalize_except_self(i, datetime(0), 0);
+    }
+
+    tree.show(collect, &ref, 0);
+    check(ref.size() == 7, "reference tree built");
+
+    tree.dump_streamed(streamed);
+
+	// whole tree loaded back
+
+    streamed.skip(0);
+    loaded.reset(data_dir::data_tree_read_streamed(streamed, version, nullptr));
+    check(streamed.get_position() == streamed.size(), "whole streamed tree consumed");
+    res.clear();
+    loaded->show(collect, &res, 0);
+    check(res == ref, "whole streamed tree read back");
+    loaded->dump_streamed(again);
+    check(content(again) == content(streamed), "whole streamed tree dumped identically");
+
+    for(archive_num num = 1; num <= 2; ++num)
+    {
+	vector<string> direct;
+
+	ref.clear();
+	tree.show(collect, &ref, num);
+	streamed.skip(0);
+	data_dir::show_streamed(streamed, version, collect, &direct, num);
+	check(direct == ref, string("listing from streamed records for archive ") + to_string(num));
+    }
+
+	// partial load
+
+    {
+	deque<path> wanted(1, path("sub/deep/f3"));
+	const data_dir *sub;
+	const data_dir *deep;
+
+	streamed.skip(0);
+	loaded.reset(data_dir::data_tree_read_streamed(streamed, version, &wanted));
+	check(streamed.get_position() == streamed.size(), "partial read consumed the whole tree");
+	sub = dynamic_cast<const data_dir *>(loaded->read_child("sub"));
+	check(sub != nullptr, "partial read: parent directory loaded");
+	deep = sub != nullptr ? dynamic_cast<const data_dir *>(sub->read_child("deep")) : nullptr;
+	check(deep != nullptr, "partial read: nested directory loaded");
+	check(deep != nullptr && deep->read_child("f3") != nullptr, "partial read: wanted entry loaded");
+	check(loaded->read_child("f1") == nullptr, "partial read: unrelated file skipped");
+	check(loaded->read_child("f4") == nullptr, "partial read: unrelated file skipped (2)");
+	check(sub != nullptr && sub->read_child("f2") == nullptr, "partial read: sibling skipped");
+    }
+
+    {
+	deque<path> wanted(1, path("/sub/f2"));
+	bool thrown = false;
+
+	streamed.skip(0);
+	try
+	{
+	    loaded.reset(data_dir::data_tree_read_streamed(streamed, version, &wanted));
+	}
+	catch(Erange & e)
+	{
+	    thrown = true;
+	}
+	check(thrown, "absolute path rejected");
+    }
+
+	// legacy nested layout (database format version 7)
+
+    tree.dump(legacy);
+    legacy.skip(0);
+    loaded.reset(data_dir::data_tree_read(legacy, database_header_last_nested_version));
+    ref.clear();
+    tree.show(collect, &ref, 0);
+    res.clear();
+    loaded->show(collect, &res, 0);
+    check(res == ref, "legacy tree read back");
+}
+
+    // compact per archive records (COMPACT_* flags of database format version 8)
+
+static void f2()
+{
+    const db_etat etats[] = { db_etat::et_saved, db_etat::et_patch, db_etat::et_patch_unusable, db_etat::et_inode, db_etat::et_present, db_etat::et_removed, db_etat::et_absent };
+    const U_I num_etats = sizeof(etats) / sizeof(etats[0]);
+	// same date, later date, earlier date, later again, far in the past
+    const U_I dates[] = { 1000, 1000, 5000, 2000, 2000, 90000, 3 };
+    const U_I num_dates = sizeof(dates) / sizeof(dates[0]);
+    unsigned char version = database_header_get_supported_version();
+    data_tree tree("entry");
+    data_tree loaded("entry");
+    memory_file body;
+    memory_file again;
+    memory_file legacy_ref;
+    memory_file legacy_res;
+    unique_ptr<crc> base(create_crc_from_size(4));
+    unique_ptr<crc> result(create_crc_from_size(4));
+    bool ok = true;
+
+    if(!base || !result)
+	throw Ememory();
+    base->compute("base", 4);
+    result->compute("result", 6);
+
+    for(archive_num num = 1; num <= num_etats * num_dates; ++num)
+    {
+	db_etat etat = etats[num % num_etats];
+	datetime date(dates[num % num_dates]);
+
+	    // patches always have a base crc
+	if(num % 3 == 0 || etat == db_etat::et_patch || etat == db_etat::et_patch_unusable)
+	    tree.set_data(num, date, etat, base.get(), result.get());
+	else if(num % 3 == 1)
+	    tree.set_data(num, date, etat, nullptr, result.get());
+	else
+	    tree.set_data(num, date, etat);
+	if(num % 2 == 0)
+	    tree.set_EA(num, datetime(dates[(num + 1) % num_dates]), etats[(num + 3) % num_etats]);
+    }
+
+    tree.dump_body(body);
+    body.skip(0);
+    loaded.read_body(body, version);
+    check(body.get_position() == body.size(), "compact records consumed");
+
+    for(archive_num num = 1; num <= num_etats * num_dates + 1; ++num)
+    {
+	datetime ref_date(0), res_date(0);
+	db_etat ref_etat = db_etat::et_absent, res_etat = db_etat::et_absent;
+	bool ref_found, res_found;
+
+	ref_found = tree.read_data(num, ref_date, ref_etat);
+	res_found = loaded.read_data(num, res_date, res_etat);
+	if(ref_found != res_found || (ref_found && (ref_date != res_date || ref_etat != res_etat)))
+	    ok = false;
+
+	ref_found = tree.read_EA(num, ref_date, ref_etat);
+	res_found = loaded.read_EA(num, res_date, res_etat);
+	if(ref_found != res_found || (ref_found && (ref_date != res_date || ref_etat != res_etat)))
+	    ok = false;
+    }
+    check(ok, "dates and status read back from compact records");
+
+    loaded.dump_body(again);
+    check(content(again) == content(body), "compact records dumped identically");
+
+	// the legacy format stores the crc in full, comparing it checks them too
+    tree.dump(legacy_ref);
+    loaded.dump(legacy_res);
+    check(content(legacy_res) == content(legacy_ref), "crc read back from compact records");
+}
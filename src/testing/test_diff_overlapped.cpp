@@ -0,0 +1,244 @@
+/*********************************************************************/
+// dar - disk archive - a backup/restoration program
+// Copyright (C) 2002-2026 Denis Corbin
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// to contact the author, see the AUTHOR file
+/*********************************************************************/
+
+#include "../my_config.h"
+
+#include <iostream>
+#include <memory>
+
+#include "libdar.hpp"
+#include "memory_file.hpp"
+#include "crc.hpp"
+
+    // size of the blocks generic_file::diff() reads
+#define BLOCK 102400
+
+using namespace libdar;
+using namespace std;
+
+    // memory_file failing once a given amount of data has been read from it
+
+class failing_file : public memory_file
+{
+public:
+    failing_file(U_I limit): failed_at(limit), lu(0) {};
+
+    void rewind() { lu = 0; skip(0); };
+
+protected:
+    virtual U_I inherited_read(char *a, U_I size) override;
+
+private:
+    U_I failed_at;
+    U_I lu;
+};
+
+static U_I errors = 0;
+
+static void check(bool cond, const string & what);
+static void fill(generic_file & f, U_I size);
+static void compare(memory_file & me, memory_file & you, const string & name, const infinint & expected);
+static void f1();
+static void f2();
+static void f3();
+
+int main()
+{
+    U_I maj, med, min;
+
+    get_version(maj, med, min);
+
+    try
+    {
+	f1();
+	f2();
+	f3();
+    }
+    catch(Egeneric & e)
+    {
+	cout << "Aborting on exception: " << e.get_message() << endl;
+	++errors;
+    }
+
+    cout << (errors == 0 ? "all tests passed" : "SOME TESTS FAILED") << endl;
+
+    return errors == 0 ? 0 : 1;
+}
+
+U_I failing_file::inherited_read(char *a, U_I size)
+{
+    if(lu >= failed_at)
+	throw Erange("simulated read error");
+
+    U_I ret = memory_file::inherited_read(a, size);
+    lu += ret;
+
+    return ret;
+}
+
+static void check(bool cond, const string & what)
+{
+    cout << (cond ? "OK   : " : "FAIL : ") << what << endl;
+    if(!cond)
+	++errors;
+}
+
+static void fill(generic_file & f, U_I size)
+{
+    U_32 seed = 98765;
+    char buffer[4096];
+    U_I i = 0;
+
+    while(i < size)
+    {
+	U_I step = size - i > sizeof(buffer) ? sizeof(buffer) : size - i;
+
+	for(U_I j = 0; j < step; ++j)
+	{
+	    seed = seed * 1103515245 + 12345;
+	    buffer[j] = (char)(seed >> 16);
+	}
+	f.write(buffer, step);
+	i += step;
+    }
+    f.skip(0);
+}
+
+    // the overlapped comparison must report the difference, its offset and
+    // the CRC of the identical part as the sequential one does
+
+static void compare(memory_file & me, memory_file & you, const string & name, const infinint & expected)
+{
+    crc *crc_seq = nullptr;
+    crc *crc_over = nullptr;
+    infinint off_seq, off_over;
+    bool diff_seq, diff_over;
+
+    diff_seq = me.diff(you, 0, 0, 4, crc_seq, off_seq, false);
+    unique_ptr<crc> keep_seq(crc_seq);
+    diff_over = me.diff(you, 0, 0, 4, crc_over, off_over, true);
+    unique_ptr<crc> keep_over(crc_over);
+
+    check(diff_seq && diff_over, name + ": difference reported");
+    check(off_seq == expected && off_over == expected, name + ": offset of the first difference");
+    check(crc_seq != nullptr && crc_over != nullptr && *crc_seq == *crc_over, name + ": same CRC as the sequential comparison");
+}
+
+    // difference exactly at, just before and just after a block boundary
+
+static void f1()
+{
+    const U_I offsets[] = { 3*BLOCK, 3*BLOCK - 1, 3*BLOCK + 1, BLOCK, 5*BLOCK + 17 };
+
+    for(U_I i = 0; i < sizeof(offsets) / sizeof(offsets[0]); ++i)
+    {
+	memory_file me, you;
+	char c;
+
+	fill(me, 6*BLOCK);
+	fill(you, 6*BLOCK);
+	you.skip(offsets[i]);
+	you.read(&c, 1);
+	c = ~c;
+	you.skip(offsets[i]);
+	you.write(&c, 1);
+
+	compare(me, you, "difference at offset " + to_string(offsets[i]), offsets[i]);
+    }
+
+	// identical content
+
+    memory_file me, you;
+    crc *crc_seq = nullptr;
+    crc *crc_over = nullptr;
+    infinint off;
+
+    fill(me, 4*BLOCK + 5);
+    fill(you, 4*BLOCK + 5);
+    check(!me.diff(you, 0, 0, 4, crc_seq, off, false), "identical content: no difference with sequential comparison");
+    unique_ptr<crc> keep_seq(crc_seq);
+    check(!me.diff(you, 0, 0, 4, crc_over, off, true), "identical content: no difference with overlapped comparison");
+    unique_ptr<crc> keep_over(crc_over);
+    check(*crc_seq == *crc_over, "identical content: same CRC");
+}
+
+    // same data but different lengths, at and off a block boundary
+
+static void f2()
+{
+    const U_I sizes[][2] = { { 4*BLOCK, 4*BLOCK + 10 },
+			     { 4*BLOCK + 10, 4*BLOCK },
+			     { 2*BLOCK + 300, 5*BLOCK },
+			     { 5*BLOCK, 2*BLOCK + 300 } };
+
+    for(U_I i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i)
+    {
+	memory_file me, you;
+
+	fill(me, sizes[i][0]);
+	fill(you, sizes[i][1]);
+
+	compare(me, you,
+		"lengths " + to_string(sizes[i][0]) + " and " + to_string(sizes[i][1]),
+		sizes[i][0] < sizes[i][1] ? sizes[i][0] : sizes[i][1]);
+    }
+}
+
+    // a read error met by the prefetch thread must reach the caller as it does
+    // with the sequential comparison
+
+static void f3()
+{
+    const U_I limits[] = { 2*BLOCK, 3*BLOCK + 500 };
+
+    for(U_I i = 0; i < sizeof(limits) / sizeof(limits[0]); ++i)
+    {
+	const string name = "read error after " + to_string(limits[i]) + " bytes";
+	memory_file me;
+	failing_file you(limits[i]);
+	bool overlapped = false;
+
+	fill(me, 6*BLOCK);
+	fill(you, 6*BLOCK);
+
+	do
+	{
+	    crc *value = nullptr;
+	    infinint off;
+	    bool thrown = false;
+
+	    you.rewind();
+	    try
+	    {
+		(void)me.diff(you, 0, 0, 4, value, off, overlapped);
+	    }
+	    catch(Erange & e)
+	    {
+		thrown = e.get_message() == "simulated read error";
+	    }
+	    delete value;
+
+	    check(thrown, name + (overlapped ? ": reported by the overlapped comparison" : ": reported by the sequential comparison"));
+	    overlapped = !overlapped;
+	}
+	while(overlapped);
+    }
+}
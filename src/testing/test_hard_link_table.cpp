@@ -0,0 +1,193 @@
+/*********************************************************************/
+// dar - disk archive - a backup/restoration program
+// Copyright (C) 2002-2026 Denis Corbin
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// to contact the author, see the AUTHOR file
+/*********************************************************************/
+
+    // benchmark of the hard link tracking datastructure
+    // usage: test_hard_link_table [number of hard linked inodes]
+    // (defaults to 5 million inodes having two links each)
+
+#include "../my_config.h"
+
+extern "C"
+{
+#if HAVE_STDLIB_H
+#include <stdlib.h>
+#endif
+}
+
+#include "libdar.hpp"
+#include "../libdar/hard_link_table.hpp"
+
+#include <map>
+#include <chrono>
+#include <iostream>
+
+using namespace libdar;
+using namespace std;
+
+struct inode_key
+{
+    U_64 ino;
+    U_64 dev;
+
+    bool operator == (const inode_key & ref) const { return ino == ref.ino && dev == ref.dev; };
+    bool operator < (const inode_key & ref) const { return ino < ref.ino || (ino == ref.ino && dev < ref.dev); };
+};
+
+struct inode_key_hash
+{
+    U_64 operator () (const inode_key & ref) const { return ref.ino ^ (ref.dev << 32); };
+};
+
+struct remaining
+{
+    remaining(U_I x_count, U_64 x_eti): count(x_count), etiquette(x_eti) {};
+
+    U_I count;
+    U_64 etiquette;
+};
+
+static void f1(U_64 num);
+static void f2(U_64 num);
+static void show(const string & what, chrono::steady_clock::time_point start);
+
+int main(int argc, char *argv[])
+{
+    U_64 num = 5000000;
+    U_I maj, med, min;
+
+    get_version(maj, med, min);
+    if(argc > 1)
+	num = strtoull(argv[1], nullptr, 10);
+
+    try
+    {
+	f1(num);
+	f2(num);
+    }
+    catch(Egeneric & e)
+    {
+	cerr << "Aborting on exception: " << e.get_message() << endl;
+	return 1;
+    }
+
+    return 0;
+}
+
+    // filesystem_hard_link_read usage: each inode is met twice,
+    // first time it is recorded, second time it is found and dropped
+
+static void f1(U_64 num)
+{
+    chrono::steady_clock::time_point start;
+
+    cout << "backup-like pattern with " << num << " hard linked inodes" << endl;
+
+    start = chrono::steady_clock::now();
+    {
+	hard_link_table<inode_key, remaining, inode_key_hash> table;
+	U_64 eti = 0;
+
+	for(U_64 i = 0; i < num; ++i)
+	    (void)table.emplace(inode_key{ i * 7, 2049 }, 1, eti++);
+	for(U_64 i = 0; i < num; ++i)
+	{
+	    remaining *ptr = table.find(inode_key{ i * 7, 2049 });
+	    if(ptr == nullptr || ptr->etiquette != i)
+		throw SRC_BUG;
+	    if(--(ptr->count) == 0)
+		(void)table.erase(inode_key{ i * 7, 2049 });
+	}
+	if(!table.empty())
+	    throw SRC_BUG;
+    }
+    show("hard_link_table", start);
+
+    start = chrono::steady_clock::now();
+    {
+	map<inode_key, remaining> table;
+	U_64 eti = 0;
+
+	for(U_64 i = 0; i < num; ++i)
+	    (void)table.insert(pair<inode_key, remaining>(inode_key{ i * 7, 2049 }, remaining(1, eti++)));
+	for(U_64 i = 0; i < num; ++i)
+	{
+	    map<inode_key, remaining>::iterator it = table.find(inode_key{ i * 7, 2049 });
+	    if(it == table.end() || it->second.etiquette != i)
+		throw SRC_BUG;
+	    if(--(it->second.count) == 0)
+		table.erase(it);
+	}
+	if(!table.empty())
+	    throw SRC_BUG;
+    }
+    show("std::map", start);
+}
+
+    // filesystem_hard_link_write and merging usage: all etiquettes are
+    // recorded then looked up once per additional link
+
+static void f2(U_64 num)
+{
+    chrono::steady_clock::time_point start;
+
+    cout << "restore-like pattern with " << num << " hard linked inodes" << endl;
+
+    start = chrono::steady_clock::now();
+    {
+	hard_link_table<U_64, U_64> table;
+
+	for(U_64 i = 0; i < num; ++i)
+	    (void)table.emplace(hard_link_etiquette_key(infinint(i)), i);
+	for(U_64 i = 0; i < num; ++i)
+	{
+	    U_64 *ptr = table.find(hard_link_etiquette_key(infinint(i)));
+	    if(ptr == nullptr || *ptr != i)
+		throw SRC_BUG;
+	}
+	if(table.size() != num)
+	    throw SRC_BUG;
+    }
+    show("hard_link_table", start);
+
+    start = chrono::steady_clock::now();
+    {
+	map<infinint, U_64> table;
+
+	for(U_64 i = 0; i < num; ++i)
+	    table[infinint(i)] = i;
+	for(U_64 i = 0; i < num; ++i)
+	{
+	    map<infinint, U_64>::iterator it = table.find(infinint(i));
+	    if(it == table.end() || it->second != i)
+		throw SRC_BUG;
+	}
+	if(table.size() != num)
+	    throw SRC_BUG;
+    }
+    show("std::map", start);
+}
+
+static void show(const string & what, chrono::steady_clock::time_point start)
+{
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+    cout << "   " << what << ": " << elapsed.count() << " s" << endl;
+}
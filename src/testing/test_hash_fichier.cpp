@@ -26,6 +26,10 @@ extern "C"
 #if HAVE_FCNTL_H
 #include <fcntl.h>
 #endif
+
+#if HAVE_UNISTD_H
+#include <unistd.h>
+#endif
 } // end extern "C"
 
 
@@ -35,8 +39,11 @@ extern "C"
 #include "hash_fichier.hpp"
 #include "shell_interaction.hpp"
 #include "fichier_local.hpp"
+#include "entrepot_local.hpp"
 #include "tools.hpp"
 
+#define TEST_FILE "test_hash_fichier.tmp"
+
 using namespace libdar;
 using namespace std;
 
@@ -44,7 +51,14 @@ void f1(const string & src_filename, const string & dst_filename, hash_algo algo
 void error(const string & argv0);
 libdar::hash_algo str2hash(const string & val);
 
+static void check(bool cond, const string & what);
+static string read_file(const string & filename);
+static void clean();
+static void f2();
+static void f3();
+
 static shared_ptr<user_interaction> ui;
+static U_I errors = 0;
 
 int main(int argc, char *argv[])
 {
@@ -59,22 +73,45 @@ int main(int argc, char *argv[])
     {
 	try
 	{
-	    if(argc != 4)
-		error(argv[0]);
+	    if(argc == 1)
+	    {
+		    // self test
+		try
+		{
+		    f2();
+		    f3();
+		}
+		catch(...)
+		{
+		    clean();
+		    throw;
+		}
+		clean();
+		cout << (errors == 0 ? "all tests passed" : "SOME TESTS FAILED") << endl;
+	    }
 	    else
-		f1(argv[1], argv[2], str2hash(argv[3]));
+	    {
+		if(argc != 4)
+		    error(argv[0]);
+		else
+		    f1(argv[1], argv[2], str2hash(argv[3]));
+	    }
 	}
 	catch(Egeneric & e)
 	{
 	    ui->message(e.get_message());
 	    cerr << e.get_message() << endl;
+	    ++errors;
 	}
     }
     catch(Egeneric & e)
     {
 	cout << e.get_message() << endl;
+	++errors;
     }
     ui.reset();
+
+    return errors == 0 ? 0 : 1;
 }
 
 void f1(const string & src_filename, const string & dst_filename, hash_algo algo)
@@ -126,7 +163,8 @@ void f1(const string & src_filename, const string & dst_filename, hash_algo algo
 
 void error(const string & argv0)
 {
-    ui->printf("usage: %S <source filename> <dest filename> <hash algo>", &argv0);
+    ui->printf("usage: %S [<source filename> <dest filename> <hash algo>]", &argv0);
+    ui->printf("       without argument, runs the self tests");
 }
 
 libdar::hash_algo str2hash(const string & val)
@@ -137,3 +175,104 @@ libdar::hash_algo str2hash(const string & val)
 	return libdar::hash_algo::sha1;
     throw Erange("unknown hash algorithm");
 }
+
+static void check(bool cond, const string & what)
+{
+    cout << (cond ? "OK   : " : "FAIL : ") << what << endl;
+    if(!cond)
+	++errors;
+}
+
+static string read_file(const string & filename)
+{
+    fichier_local src(filename);
+    string ret;
+    char buffer[1000];
+    U_I lu;
+
+    do
+    {
+	lu = src.read(buffer, sizeof(buffer));
+	ret += string(buffer, lu);
+    }
+    while(lu > 0);
+
+    return ret;
+}
+
+static void clean()
+{
+    (void)unlink(TEST_FILE);
+    (void)unlink(TEST_FILE ".md5");
+    (void)unlink(TEST_FILE ".sha1");
+}
+
+    // two hashes computed by the same hash_fichier, checked against
+    // the digests of one million 'a' characters
+
+static void f2()
+{
+    entrepot_local repo("", "", false);
+    deque<hash_algo> algos = { hash_algo::md5, hash_algo::sha1 };
+    fichier_global *dst = nullptr;
+    char buffer[1000];
+
+    clean();
+    repo.set_location(path(tools_getcwd()));
+    for(U_I i = 0; i < sizeof(buffer); ++i)
+	buffer[i] = 'a';
+
+    dst = repo.open(ui, TEST_FILE, gf_write_only, false, 0, true, false, algos);
+    if(dst == nullptr)
+	throw Ememory();
+
+    try
+    {
+	check(dynamic_cast<hash_fichier *>(dst) != nullptr, "a single hash_fichier computes both hashes");
+	for(U_I i = 0; i < 1000; ++i)
+	    dst->write(buffer, sizeof(buffer));
+	dst->terminate();
+    }
+    catch(...)
+    {
+	delete dst;
+	throw;
+    }
+    delete dst;
+
+    check(read_file(TEST_FILE).size() == 1000000, "data written through the hash_fichier");
+    check(read_file(TEST_FILE ".md5") == string("7707d6ae4e027c70eea2a935c2296f21  ") + TEST_FILE + "\n", "md5 digest");
+    check(read_file(TEST_FILE ".sha1") == string("34aa973cd4c4daa4f61eeb2bdbad27316534016f  ") + TEST_FILE + "\n", "sha1 digest");
+}
+
+    // the second hash file cannot be created: the first one must not
+    // receive the hash of no data when the hash_fichier is destroyed
+
+static void f3()
+{
+    entrepot_local repo("", "", false);
+    deque<hash_algo> algos = { hash_algo::md5, hash_algo::sha1 };
+    bool thrown = false;
+
+    clean();
+    repo.set_location(path(tools_getcwd()));
+
+    {
+	fichier_local existing(ui, TEST_FILE ".sha1", gf_write_only, 0600, false, true, false);
+	existing.write("x", 1);
+    }
+
+    try
+    {
+	fichier_global *dst = repo.open(ui, TEST_FILE, gf_write_only, false, 0, true, false, algos);
+	delete dst;
+    }
+    catch(Egeneric & e)
+    {
+	thrown = true;
+    }
+
+    check(thrown, "open fails when a hash file already exists");
+    check(read_file(TEST_FILE ".md5").empty(), "no digest written to the hash file already created");
+    check(read_file(TEST_FILE ".sha1") == "x", "existing hash file left untouched");
+}
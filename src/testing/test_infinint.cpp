@@ -41,6 +41,7 @@ extern "C"
 } // end extern "C"
 
 #include <iostream>
+#include <chrono>
 
 #include "libdar.hpp"
 #include "integers.hpp"
@@ -59,6 +60,7 @@ using namespace std;
 static void routine1();
 static void routine2();
 static void routine3();
+static void routine4();
 
 static shared_ptr<user_interaction>ui;
 
@@ -73,6 +75,7 @@ int main()
     routine1();
     routine2();
     routine3();
+    routine4();
     ui.reset();
 }
 
@@ -223,3 +226,38 @@ static void routine3()
     res = tools_rounded_cube_root(c);
     res = 1;
 }
+
+static void routine4()
+{
+    infinint val = 1;
+    chrono::steady_clock::time_point start;
+    chrono::duration<double> elapsed;
+    U_I len = 0;
+
+	// powers of ten and their neighbours, up to the largest value an infinint can hold in this mode
+
+    try
+    {
+	for(U_I i = 0; i < 60; ++i)
+	{
+	    infinint below = val - 1;
+	    infinint above = val + 1;
+
+	    if(libdar::deci(libdar::deci::to_string(val)).computer() != val
+	       || libdar::deci(libdar::deci::to_string(below)).computer() != below
+	       || libdar::deci(libdar::deci::to_string(above)).computer() != above)
+		ui->message(string("decimal conversion mismatch for 10^") + to_string(i));
+	    val *= infinint(10);
+	}
+    }
+    catch(Elimitint & e)
+    {
+	    // limitint cannot hold larger values
+    }
+
+    start = chrono::steady_clock::now();
+    for(U_I i = 0; i < 1000000; ++i)
+	len += libdar::deci::to_string(infinint(i) * infinint(4099)).size();
+    elapsed = chrono::steady_clock::now() - start;
+    ui->message(string("1000000 integers converted to decimal in ") + to_string(elapsed.count()) + " s (" + to_string(len) + " digits)");
+}
@@ -0,0 +1,166 @@
+/*********************************************************************/
+// dar - disk archive - a backup/restoration program
+// Copyright (C) 2002-2026 Denis Corbin
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// to contact the author, see the AUTHOR file
+/*********************************************************************/
+
+#include "../my_config.h"
+
+#include <iostream>
+#include <memory>
+
+#include "libdar.hpp"
+#include "pile.hpp"
+#include "memory_file.hpp"
+#include "tronc.hpp"
+#include "layer_statistics.hpp"
+
+using namespace libdar;
+using namespace std;
+
+static U_I errors = 0;
+
+static void check(bool cond, const string & what);
+static void check_counter(const layer_statistics::counter & val, U_64 calls, U_64 bytes, const string & what);
+static void f1();
+static void f2();
+
+int main()
+{
+    U_I maj, med, min;
+
+    get_version(maj, med, min);
+
+    try
+    {
+	f1();
+	f2();
+    }
+    catch(Egeneric & e)
+    {
+	cout << "Aborting on exception: " << e.get_message() << endl;
+	++errors;
+    }
+
+    cout << (errors == 0 ? "all tests passed" : "SOME TESTS FAILED") << endl;
+
+    return errors == 0 ? 0 : 1;
+}
+
+static void check(bool cond, const string & what)
+{
+    cout << (cond ? "OK   : " : "FAIL : ") << what << endl;
+    if(!cond)
+	++errors;
+}
+
+static void check_counter(const layer_statistics::counter & val, U_64 calls, U_64 bytes, const string & what)
+{
+    check(val.calls == calls, what + ": " + to_string(calls) + " call(s) (got " + to_string(val.calls) + ")");
+    check(val.bytes == bytes, what + ": " + to_string(bytes) + " byte(s) (got " + to_string(val.bytes) + ")");
+}
+
+    // statistics given before the layers are pushed: every layer must see
+    // each read and write, skips being only accounted on the top layer
+
+static void f1()
+{
+    shared_ptr<layer_statistics> stats(new layer_statistics());
+    pile stack;
+    memory_file *mem = new memory_file();
+    char buffer[1000];
+
+    for(U_I i = 0; i < sizeof(buffer); ++i)
+	buffer[i] = (char)i;
+    mem->write(buffer, sizeof(buffer)); // memory_file cannot skip past its end
+
+    stack.set_statistics(stats);
+    stack.push(mem);
+    stack.push(new tronc(mem, 0, gf_read_write));
+    stack.push(new tronc(stack.top(), 0, gf_read_write));
+
+    stack.write(buffer, 500);
+    stack.write(buffer + 500, 300);
+    stack.write(buffer + 800, 200);
+    stack.skip(0);
+    check(stack.read(buffer, 700) == 700, "first read");
+    check(stack.read(buffer, 400) == 300, "second read stops at end of file");
+    check(stack.read(buffer, 10) == 0, "third read at end of file");
+    stack.skip(100);
+    stack.skip_relative(50);
+    stack.skip_to_eof();
+
+    check(stats->size() == 3, "three layers recorded");
+    for(U_I i = 0; i < stats->size() && i < 3; ++i)
+    {
+	const layer_statistics::layer & lay = stats->get_layer(i);
+	const string name = "layer " + to_string(i);
+
+	check(lay.level == i, name + ": level");
+	check(lay.name == (i == 0 ? "memory_file" : "tronc"), name + ": class name " + lay.name);
+	check_counter(lay.write, 3, 1000, name + " write");
+	check_counter(lay.read, 3, 1000, name + " read");
+	check(lay.skip.calls == (i == 2 ? 4 : 0), name + ": skip calls");
+    }
+}
+
+    // statistics given to an existing stack, then a layer replaced by a new
+    // object of the same class at the same level shares the same record
+
+static void f2()
+{
+    shared_ptr<layer_statistics> stats(new layer_statistics());
+    pile stack;
+    memory_file *mem = new memory_file();
+    char buffer[200];
+    generic_file *top;
+
+    for(U_I i = 0; i < sizeof(buffer); ++i)
+	buffer[i] = (char)(i * 3);
+    mem->write(buffer, sizeof(buffer));
+
+    stack.push(mem);
+    stack.push(new tronc(mem, 0, gf_read_write));
+    check(stack.read(buffer, 20) == 20, "read before statistics are set"); // not recorded
+    stack.set_statistics(stats);
+
+    stack.skip(50);
+    check(stack.read(buffer, 100) == 100, "read from existing layers");
+    check(stats->size() == 2, "two layers recorded");
+
+    top = stack.pop();
+    delete top;
+    stack.push(new tronc(mem, 10, gf_read_write));
+    stack.skip(0);
+    check(stack.read(buffer, 40) == 40, "read from the replacing layer");
+    stack.write(buffer, 30);
+
+    check(stats->size() == 2, "replacing layer shares the record");
+    if(stats->size() == 2)
+    {
+	const layer_statistics::layer & bottom = stats->get_layer(0);
+	const layer_statistics::layer & upper = stats->get_layer(1);
+
+	check_counter(bottom.read, 2, 140, "bottom read");
+	check_counter(bottom.write, 1, 30, "bottom write");
+	check(bottom.skip.calls == 0, "bottom skip calls");
+	check_counter(upper.read, 2, 140, "upper read");
+	check_counter(upper.write, 1, 30, "upper write");
+	check(upper.skip.calls == 2, "upper skip calls");
+    }
+}
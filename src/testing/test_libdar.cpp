@@ -226,6 +226,28 @@ void f3()
 	    cout << line;
 	    ++it;
 	}
+
+	    // same listing by batches of 100 entries, checked against the table
+	list_columns batch;
+	U_I start = 0;
+	U_I num;
+	while((num = arch->get_children_in_columns("etc", batch, start, 100)) > 0)
+	{
+	    for(U_I i = 0; i < num; ++i)
+	    {
+		const list_entry & ref = contents[start + i];
+		bool saved = (batch.get_flags()[i] & list_columns::flag_data_saved) != 0;
+
+		if(batch.get_name(i) != ref.get_name()
+		   || batch.get_types()[i] != ref.get_type()
+		   || saved != ref.has_data_present_in_the_archive())
+		    cout << "column mismatch for " << ref.get_name() << endl;
+	    }
+	    start += num;
+	}
+	if(start != contents.size())
+	    cout << "columns provided " << start << " entries instead of " << contents.size() << endl;
+
 	delete arch;
 	arch = nullptr;
     }
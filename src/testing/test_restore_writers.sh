@@ -0,0 +1,87 @@
+#!/bin/sh
+
+#######################################################################
+# dar - disk archive - a backup/restoration program
+# Copyright (C) 2002-2026 Denis Corbin
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU General Public License
+# as published by the Free Software Foundation; either version 2
+# of the License, or (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+#
+# to contact the author, see the AUTHOR file
+#######################################################################
+
+# restores small files into an existing read-only directory, with and
+# without writer threads (-G option), and checks the failures met by the
+# writer threads are counted and reported the same way as without them
+# (requires libthreadar, when run as root the restoration is done as nobody)
+
+DAR=${DAR:-../dar_suite/dar}
+ROOT=test_restore_writers
+NUM=5
+
+clean()
+{
+   chmod -R u+w $ROOT 2> /dev/null
+   rm -rf $ROOT
+}
+
+fail()
+{
+   echo "FAIL : $1"
+   clean
+   exit 1
+}
+
+as_user()
+{
+   if [ "$(id -u)" = "0" ] ; then
+       setpriv --reuid=65534 --regid=65534 --clear-groups "$@"
+   else
+       "$@"
+   fi
+}
+
+restore()
+{
+   rm -rf $ROOT/dst
+   mkdir -p $ROOT/dst/d || fail "cannot create destination"
+   if [ "$(id -u)" = "0" ] ; then
+       chown 65534 $ROOT/dst/d
+   fi
+   chmod 555 $ROOT/dst/d
+   chmod 755 $ROOT/dst
+   as_user $DAR -N -Q -x $ROOT/arch -R $ROOT/dst -O -G "$1" > $ROOT/out.txt 2>&1
+   echo $?
+}
+
+clean
+mkdir -p $ROOT/src/d || fail "cannot create test directories"
+chmod 755 $ROOT
+for i in $(seq 1 $NUM) ; do
+    echo "$i" > $ROOT/src/d/file$i
+done
+$DAR -Q -c $ROOT/arch -R $ROOT/src > /dev/null || fail "backup"
+chmod 644 $ROOT/arch.1.dar
+
+code=$(restore 1,1,1)
+[ "$code" = "5" ] || fail "restoration without writer threads returned $code instead of 5"
+grep -q " $NUM inode(s) failed to restore" $ROOT/out.txt || fail "failures not counted without writer threads"
+
+code=$(restore 1,1,4)
+[ "$code" = "5" ] || fail "restoration with writer threads returned $code instead of 5"
+grep -q " $NUM inode(s) failed to restore" $ROOT/out.txt || fail "failures not counted with writer threads"
+[ "$(grep -c "Error while restoring" $ROOT/out.txt)" = "$NUM" ] || fail "failures not reported with writer threads"
+
+echo "OK   : failures of writer threads are counted"
+clean
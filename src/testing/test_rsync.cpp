@@ -27,11 +27,17 @@
 #include "generic_rsync.hpp"
 #include "fichier_local.hpp"
 #include "null_file.hpp"
+#include "memory_file.hpp"
+#include "crc.hpp"
+#include "deci.hpp"
 
 extern "C"
 {
 }
 
+#include <chrono>
+#include <iomanip>
+
 #ifndef RS_DEFAULT_BLOCK_LEN
 #define RS_DEFAULT_BLOCK_LEN 2048
 #endif
@@ -46,6 +52,7 @@ void usage(const char *argv0)
     cout << "usage: " << argv0 << " sig   <src file> <sig result>" << endl;
     cout << "       " << argv0 << " delta <sig file> <new file> <delta result>" << endl;
     cout << "       " << argv0 << " patch <base file> <sig file> <patched result>" << endl;
+    cout << "       " << argv0 << " bench <base file> <new file>" << endl;
 }
 
 void go_sig(const string & src_file,
@@ -59,6 +66,9 @@ void go_patch(const string & base_file,
 	      const string & sig_file,
 	      const string & patched_result);
 
+void go_bench(const string & base_file,
+	      const string & new_file);
+
 int main(int argc, char *argv[])
 {
     U_I maj, med, min;
@@ -71,6 +81,8 @@ int main(int argc, char *argv[])
 	{
 	    if(string(argv[1]) == "sig")
 		go_sig(argv[2], argv[3]);
+	    else if(string(argv[1]) == "bench")
+		go_bench(argv[2], argv[3]);
 	    else
 	    {
 		if(argc == 5)
@@ -171,3 +183,84 @@ void go_patch(const string & base_file,
     go.copy_to(res);
     go.terminate();
 }
+
+static void report(const string & step, chrono::steady_clock::time_point start, const infinint & amount)
+{
+    double sec = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    U_I bytes = 0;
+    infinint tmp = amount;
+
+    tmp.unstack(bytes);
+    cout << setw(6) << step << ": " << fixed << setprecision(3) << sec << " s";
+    if(sec > 0)
+	cout << " (" << setprecision(1) << (double)bytes / sec / 1048576 << " MiB/s)";
+    cout << endl;
+}
+
+void go_bench(const string & base_file,
+	      const string & new_file)
+{
+    U_I crc_size = 4;
+    chrono::steady_clock::time_point start;
+    fichier_local base = fichier_local(base_file);
+    fichier_local newer = fichier_local(new_file);
+    memory_file sig;
+    memory_file delta;
+    null_file black_hole = null_file(gf_read_write);
+    crc *expected = nullptr;
+    crc *patched = nullptr;
+    const crc *dummy = nullptr;
+
+	// signature of the base file
+
+    start = chrono::steady_clock::now();
+    {
+	generic_rsync go(&sig,
+			 RS_DEFAULT_BLOCK_LEN,
+			 rsync_sig_magic::blake2,
+			 &base);
+	go.copy_to(black_hole);
+	go.terminate();
+    }
+    report("sig", start, base.get_size());
+
+	// delta of the new file against the base file signature
+
+    start = chrono::steady_clock::now();
+    {
+	generic_rsync go(&sig,
+			 &newer,
+			 crc_size,
+			 &dummy);
+	go.copy_to(delta);
+	go.terminate();
+    }
+    report("delta", start, newer.get_size());
+    if(dummy != nullptr)
+	delete dummy;
+    cout << "delta size: " << libdar::deci(delta.size()).human() << endl;
+
+	// patching the base file, this is what restoration does
+
+    newer.skip(0);
+    newer.reset_crc(crc_size);
+    newer.copy_to(black_hole);
+    expected = newer.get_crc();
+
+    base.skip(0);
+    delta.skip(0);
+    start = chrono::steady_clock::now();
+    {
+	generic_rsync go(&base,
+			 &delta);
+	go.copy_to(black_hole, crc_size, patched);
+	go.terminate();
+    }
+    report("patch", start, newer.get_size());
+
+    if(expected == nullptr || patched == nullptr)
+	throw SRC_BUG;
+    cout << "patched data " << (*expected == *patched ? "matches" : "DIFFERS FROM") << " the new file" << endl;
+    delete expected;
+    delete patched;
+}
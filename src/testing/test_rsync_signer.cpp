@@ -0,0 +1,197 @@
+/*********************************************************************/
+// dar - disk archive - a backup/restoration program
+// Copyright (C) 2002-2026 Denis Corbin
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// to contact the author, see the AUTHOR file
+/*********************************************************************/
+
+#include "../my_config.h"
+
+#include <iostream>
+#include <memory>
+
+#include "libdar.hpp"
+#include "generic_rsync.hpp"
+#include "memory_file.hpp"
+#include "crc.hpp"
+
+#ifndef RS_DEFAULT_BLOCK_LEN
+#define RS_DEFAULT_BLOCK_LEN 2048
+#endif
+
+using namespace libdar;
+using namespace std;
+
+static U_I errors = 0;
+
+#if LIBRSYNC_AVAILABLE
+static void check(bool cond, const string & what);
+static void fill(memory_file & f, U_I size, U_32 seed);
+static string content(memory_file & f);
+static void sign(memory_file & src, memory_file & sig, memory_file & copy, U_I read_size);
+static void f1(U_I size);
+#endif
+
+int main()
+{
+    U_I maj, med, min;
+
+    get_version(maj, med, min);
+
+#if LIBRSYNC_AVAILABLE
+    try
+    {
+	f1(3*1024*1024 + 333); // signed from a separated thread when libthreadar is available
+	f1(70000);             // one full block then the end of file
+	f1(1000);              // always signed inline
+    }
+    catch(Egeneric & e)
+    {
+	cout << "Aborting on exception: " << e.get_message() << endl;
+	++errors;
+    }
+#else
+    cout << "librsync support not available, nothing to test" << endl;
+#endif
+
+    cout << (errors == 0 ? "all tests passed" : "SOME TESTS FAILED") << endl;
+
+    return errors == 0 ? 0 : 1;
+}
+
+#if LIBRSYNC_AVAILABLE
+
+static void check(bool cond, const string & what)
+{
+    cout << (cond ? "OK   : " : "FAIL : ") << what << endl;
+    if(!cond)
+	++errors;
+}
+
+static void fill(memory_file & f, U_I size, U_32 seed)
+{
+    char buffer[4096];
+    U_I i = 0;
+
+    f.reset();
+    while(i < size)
+    {
+	U_I step = size - i > sizeof(buffer) ? sizeof(buffer) : size - i;
+
+	for(U_I j = 0; j < step; ++j)
+	{
+	    seed = seed * 1103515245 + 12345;
+	    buffer[j] = (char)(seed >> 16);
+	}
+	f.write(buffer, step);
+	i += step;
+    }
+    f.skip(0);
+}
+
+static string content(memory_file & f)
+{
+    string ret;
+    char buffer[4096];
+    U_I lu;
+
+    f.skip(0);
+    do
+    {
+	lu = f.read(buffer, sizeof(buffer));
+	ret += string(buffer, lu);
+    }
+    while(lu > 0);
+
+    return ret;
+}
+
+    // reads src through a generic_rsync in sign mode by blocks of read_size bytes
+
+static void sign(memory_file & src, memory_file & sig, memory_file & copy, U_I read_size)
+{
+    unique_ptr<char[]> buffer(new (nothrow) char[read_size]);
+    U_I lu;
+
+    if(!buffer)
+	throw Ememory();
+
+    src.skip(0);
+    generic_rsync go(&sig, RS_DEFAULT_BLOCK_LEN, rsync_sig_magic::blake2, &src);
+    do
+    {
+	lu = go.read(buffer.get(), read_size);
+	copy.write(buffer.get(), lu);
+    }
+    while(lu > 0);
+    go.terminate();
+}
+
+    // the signature computed from large reads (separated thread) must be the one
+    // computed from small reads (inline), and must be usable to build a delta
+
+static void f1(U_I size)
+{
+    const string name = to_string(size) + " bytes: ";
+    memory_file base;
+    memory_file sig_inline, sig_thread;
+    memory_file copy_inline, copy_thread;
+
+    fill(base, size, 1234);
+
+    sign(base, sig_inline, copy_inline, 1000);
+    sign(base, sig_thread, copy_thread, 102400);
+
+    check(content(copy_thread) == content(base) && content(copy_inline) == content(base),
+	  name + "data read unchanged through the signature computation");
+    check(sig_thread.size() > 0 && content(sig_thread) == content(sig_inline),
+	  name + "same signature from large and small reads");
+
+	// delta from the signature then patch of the base
+
+    memory_file modified;
+    memory_file delta;
+    memory_file patched;
+
+    fill(modified, size, 1234);
+    modified.skip(size / 2);
+    modified.write("modified in the middle", 22);
+    modified.skip_to_eof();
+    modified.write("appended", 8);
+
+    sig_thread.skip(0);
+    modified.skip(0);
+    {
+	const crc *checksum = nullptr;
+	generic_rsync go(&sig_thread, &modified, infinint(4), &checksum);
+	unique_ptr<const crc> keep(checksum);
+
+	go.copy_to(delta);
+	go.terminate();
+    }
+
+    base.skip(0);
+    delta.skip(0);
+    {
+	generic_rsync go(&base, &delta);
+	go.copy_to(patched);
+	go.terminate();
+    }
+    check(content(patched) == content(modified), name + "patch built from that signature restores the modified data");
+}
+
+#endif
@@ -70,7 +70,7 @@ static void f1()
     where->set_location(path("./test"));
     try
     {
-	sar sar1(ui, gf_write_only, "destination", "txt", 100, 110, true, false, 0, where, internal_name, data_name, false, 0, hash_algo::none, false, 0);
+	sar sar1(ui, gf_write_only, "destination", "txt", 100, 110, true, false, 0, where, internal_name, data_name, false, 0, deque<hash_algo>(), false, 0);
         fichier_local src = fichier_local(ui, "./test/source.txt", gf_read_only, 0666, false, false, false);
         src.copy_to(sar1);
     }
@@ -0,0 +1,240 @@
+/*********************************************************************/
+// dar - disk archive - a backup/restoration program
+// Copyright (C) 2002-2026 Denis Corbin
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// to contact the author, see the AUTHOR file
+/*********************************************************************/
+
+#include "../my_config.h"
+
+extern "C"
+{
+#if HAVE_SYS_STAT_H
+#include <sys/stat.h>
+#endif
+
+#if HAVE_SYS_TYPES_H
+#include <sys/types.h>
+#endif
+
+#if HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+}
+
+#include <chrono>
+#include <fstream>
+#include <set>
+
+#include "libdar.hpp"
+#include "sar.hpp"
+#include "sar_async.hpp"
+#include "entrepot_local.hpp"
+#include "fichier_global.hpp"
+
+using namespace libdar;
+using namespace std;
+
+#define TEST_DIR "./test_sar_async.dir"
+
+static shared_ptr<user_interaction> ui;
+static U_I errors = 0;
+
+static void check(bool cond, const string & what);
+static bool exists(const string & filename);
+static void f1();
+static void f2();
+static void f3();
+
+int main()
+{
+    U_I maj, med, min;
+
+    get_version(maj, med, min);
+    ui.reset(new (nothrow) shell_interaction(cout, cerr, false));
+    if(!ui)
+	cout << "ERREUR !" << endl;
+
+    (void)system("rm -rf " TEST_DIR);
+    (void)mkdir(TEST_DIR, 0755);
+
+    try
+    {
+	f1();
+	f2();
+	f3();
+    }
+    catch(Egeneric & e)
+    {
+	ui->message(string("Aborting on exception: ") + e.get_message());
+	++errors;
+    }
+
+    cout << (errors == 0 ? "all tests passed" : "SOME TESTS FAILED") << endl;
+    ui.reset();
+
+    return errors == 0 ? 0 : 1;
+}
+
+static void check(bool cond, const string & what)
+{
+    cout << (cond ? "OK   : " : "FAIL : ") << what << endl;
+    if(!cond)
+	++errors;
+}
+
+static bool exists(const string & filename)
+{
+    struct stat buf;
+
+    return stat(filename.c_str(), &buf) == 0;
+}
+
+    // hook pool: completion, back-pressure and failure reporting
+
+static void f1()
+{
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    double elapsed;
+    string cmd, msg;
+
+    {
+	sar_hook_pool pool(2);
+
+	for(U_I i = 0; i < 4; ++i)
+	    pool.submit(string("sleep 1; touch " TEST_DIR "/hook_") + to_string(i));
+	pool.submit("exit 3");
+	pool.wait_all();
+	elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+	for(U_I i = 0; i < 4; ++i)
+	    check(exists(string(TEST_DIR "/hook_") + to_string(i)), string("hook ") + to_string(i) + " executed");
+
+	    // 4 commands of 1 second with 2 in flight: about 2 seconds, not 4 nor 1
+	check(elapsed >= 1.9, "no more than 2 commands in flight");
+	check(elapsed < 3.9, "commands run concurrently");
+
+	check(pool.pop_failure(cmd, msg), "failure reported");
+	check(cmd == "exit 3", "failed command identified");
+	check(!pool.pop_failure(cmd, msg), "single failure reported");
+    }
+}
+
+    // slice opener: creation, release and cleanup of unused slice
+
+static void f2()
+{
+    shared_ptr<entrepot> where(new (nothrow) entrepot_local("", "", false));
+    fichier_global *ptr = nullptr;
+
+    if(!where)
+	throw Ememory();
+    where->set_location(path(TEST_DIR));
+
+    {
+	sar_slice_opener opener(ui, where, "used.1.dar", gf_write_only, false, 0);
+
+	ptr = opener.release();
+	check(ptr != nullptr, "slice created ahead");
+	if(ptr != nullptr)
+	{
+	    ptr->write("x", 1);
+	    delete ptr;
+	    ptr = nullptr;
+	}
+    }
+    check(exists(TEST_DIR "/used.1.dar"), "released slice kept");
+
+    {
+	sar_slice_opener opener(ui, where, "unused.1.dar", gf_write_only, false, 0);
+	(void)opener.get_filename();
+    }
+    check(!exists(TEST_DIR "/unused.1.dar"), "unused slice removed");
+
+    {
+	sar_slice_opener opener(ui, where, "used.1.dar", gf_write_only, false, 0);
+
+	ptr = opener.release();
+	check(ptr == nullptr, "existing slice not overwritten");
+	if(ptr != nullptr)
+	    delete ptr;
+    }
+    check(exists(TEST_DIR "/used.1.dar"), "existing slice still present");
+}
+
+    // sar with background hooks: every slice hooked once, last one synchronously
+
+static void f3()
+{
+    shared_ptr<entrepot> where(new (nothrow) entrepot_local("", "", false));
+    label internal_name;
+    label data_name;
+    char buffer[1000];
+    set<string> seen;
+    string line;
+    bool last_is_last = false;
+
+    if(!where)
+	throw Ememory();
+    where->set_location(path(TEST_DIR));
+    internal_name.generate_internal_filename();
+    data_name.clear();
+    for(U_I i = 0; i < sizeof(buffer); ++i)
+	buffer[i] = (char)(i % 251);
+
+    {
+	sar out(ui,
+		gf_write_only,
+		"slices",
+		"dar",
+		1000,
+		1000,
+		false,
+		true,
+		0,
+		where,
+		internal_name,
+		data_name,
+		false,
+		0,
+		deque<hash_algo>(),
+		0,
+		false,
+		"echo %n %c >> " TEST_DIR "/hooks.log",
+		2);
+
+	for(U_I i = 0; i < 20; ++i)
+	    out.write(buffer, sizeof(buffer));
+	out.terminate();
+    }
+
+    ifstream log(TEST_DIR "/hooks.log");
+    while(getline(log, line))
+    {
+	string num = line.substr(0, line.find(' '));
+
+	check(seen.find(num) == seen.end(), string("slice ") + num + " hooked once");
+	seen.insert(num);
+	last_is_last = line.find("last_slice") != string::npos;
+    }
+
+    check(seen.size() > 20, "all slices hooked");
+    check(last_is_last, "last slice hooked last");
+    for(U_I i = 1; i <= seen.size(); ++i)
+	check(exists(string(TEST_DIR "/slices.") + to_string(i) + ".dar"), string("slice ") + to_string(i) + " exists");
+    check(!exists(string(TEST_DIR "/slices.") + to_string(seen.size() + 1) + ".dar"), "slice created ahead removed");
+}
@@ -0,0 +1,72 @@
+#!/bin/sh
+
+#######################################################################
+# dar - disk archive - a backup/restoration program
+# Copyright (C) 2002-2026 Denis Corbin
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU General Public License
+# as published by the Free Software Foundation; either version 2
+# of the License, or (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+#
+# to contact the author, see the AUTHOR file
+#######################################################################
+
+# chains a full backup, a differential backup made the usual way and a
+# differential backup made with --streamed-ref based on the previous one,
+# then checks the restoration of the whole chain matches the filesystem
+
+DAR=${DAR:-../dar_suite/dar}
+ROOT=test_streamed_ref
+
+clean()
+{
+   rm -rf $ROOT
+}
+
+fail()
+{
+   echo "FAIL : $1"
+   exit 1
+}
+
+clean
+mkdir -p $ROOT/src/sub/deep $ROOT/restore || fail "cannot create test directories"
+for f in a c e g i k m o q s u w y ; do
+    echo "$f" > $ROOT/src/$f
+    echo "$f" > $ROOT/src/sub/$f
+    echo "$f" > $ROOT/src/sub/deep/$f
+done
+
+$DAR -Q -c $ROOT/full -R $ROOT/src > /dev/null || fail "full backup"
+
+    # removed entries recorded by the first differential
+    # backup must sort among the other entries
+
+rm -f $ROOT/src/c $ROOT/src/sub/m $ROOT/src/sub/deep/y
+echo changed > $ROOT/src/k
+echo new > $ROOT/src/sub/b
+$DAR -Q -c $ROOT/diff1 -A $ROOT/full -R $ROOT/src > /dev/null || fail "differential backup"
+
+rm -f $ROOT/src/e $ROOT/src/sub/deep/a
+echo again > $ROOT/src/sub/deep/o
+echo back > $ROOT/src/c
+$DAR -Q -c $ROOT/diff2 -A $ROOT/diff1 --streamed-ref -R $ROOT/src > /dev/null || fail "differential backup with streamed reference"
+
+for arch in full diff1 diff2 ; do
+    $DAR -Q -x $ROOT/$arch -R $ROOT/restore -w > /dev/null || fail "restoration of $arch"
+done
+
+diff -r $ROOT/src $ROOT/restore || fail "restored tree differs from source"
+
+echo "OK   : streamed reference chained after a differential backup"
+clean
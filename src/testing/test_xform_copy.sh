@@ -0,0 +1,77 @@
+#!/bin/sh
+
+#######################################################################
+# dar - disk archive - a backup/restoration program
+# Copyright (C) 2002-2026 Denis Corbin
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU General Public License
+# as published by the Free Software Foundation; either version 2
+# of the License, or (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+#
+# to contact the author, see the AUTHOR file
+#######################################################################
+
+# reslices an archive with dar_xform between local slices (data copied
+# with copy_file_range() when available) to smaller, larger and unequal
+# slices, then reslices it from a pipe (usual copy), and checks each result
+# tests fine and restores the saved tree
+
+DAR=${DAR:-../dar_suite/dar}
+DAR_XFORM=${DAR_XFORM:-../dar_suite/dar_xform}
+ROOT=test_xform_copy
+
+clean()
+{
+   rm -rf $ROOT
+}
+
+fail()
+{
+   echo "FAIL : $1"
+   exit 1
+}
+
+check()
+{
+   rm -rf $ROOT/dst
+   mkdir $ROOT/dst
+   $DAR -Q -t $ROOT/$1 > /dev/null || fail "testing archive resliced $2"
+   $DAR -Q -x $ROOT/$1 -R $ROOT/dst > /dev/null || fail "restoring archive resliced $2"
+   diff -r $ROOT/src $ROOT/dst || fail "restored tree differs from source when resliced $2"
+   echo "OK   : archive resliced $2"
+}
+
+clean
+mkdir -p $ROOT/src/sub || fail "cannot create test directories"
+dd if=/dev/urandom of=$ROOT/src/big bs=1024 count=700 2> /dev/null || fail "cannot create test file"
+dd if=/dev/urandom of=$ROOT/src/sub/medium bs=1000 count=123 2> /dev/null || fail "cannot create test file"
+echo small > $ROOT/src/sub/small
+
+$DAR -Q -c $ROOT/orig -s 100k -R $ROOT/src > /dev/null || fail "backup"
+
+$DAR_XFORM -Q -s 37k $ROOT/orig $ROOT/smaller > /dev/null || fail "reslicing to smaller slices"
+check smaller "to smaller slices"
+
+$DAR_XFORM -Q -s 250k $ROOT/smaller $ROOT/larger > /dev/null || fail "reslicing to larger slices"
+check larger "to larger slices"
+
+$DAR_XFORM -Q -S 13k -s 61k $ROOT/larger $ROOT/unequal > /dev/null || fail "reslicing with a different first slice size"
+check unequal "with a different first slice size"
+
+$DAR_XFORM -Q $ROOT/unequal $ROOT/single > /dev/null || fail "reslicing to a single slice"
+check single "to a single slice"
+
+cat $ROOT/single.1.dar | $DAR_XFORM -Q -s 50k - $ROOT/piped > /dev/null || fail "reslicing from a pipe"
+check piped "from a pipe"
+
+clean
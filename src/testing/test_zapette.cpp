@@ -0,0 +1,403 @@
+/*********************************************************************/
+// dar - disk archive - a backup/restoration program
+// Copyright (C) 2002-2026 Denis Corbin
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+// to contact the author, see the AUTHOR file
+/*********************************************************************/
+
+#include "../my_config.h"
+
+extern "C"
+{
+#if HAVE_SYS_TYPES_H
+#include <sys/types.h>
+#endif
+
+#if HAVE_SYS_WAIT_H
+#include <sys/wait.h>
+#endif
+
+#if HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+
+#if HAVE_STRING_H
+#include <string.h>
+#endif
+}
+
+#include <iostream>
+#include <memory>
+
+#include "libdar.hpp"
+#include "tuyau.hpp"
+#include "zapette.hpp"
+#include "slave_zapette.hpp"
+#include "zapette_protocol.hpp"
+#include "contextual.hpp"
+
+using namespace libdar;
+using namespace std;
+
+    // read-only data given to the slave side, recording the largest read asked
+
+class source : public generic_file, public contextual
+{
+public:
+    source(const string & content): generic_file(gf_read_only), payload(content), pos(0), largest(0) { contextual::set_info_status(CONTEXT_INIT); };
+
+    U_I get_largest_read() const { return largest; };
+
+    virtual bool skippable(skippability direction, const infinint & amount) override { return true; };
+    virtual bool skip(const infinint & p) override;
+    virtual bool skip_to_eof() override { pos = payload.size(); return true; };
+    virtual bool skip_relative(S_I x) override { return skip(infinint(pos + x)); };
+    virtual bool truncatable(const infinint & p) const override { return false; };
+    virtual infinint get_position() const override { return pos; };
+    virtual const slice_header & get_slice_info() const override { return header; };
+
+protected:
+    virtual void inherited_read_ahead(const infinint & amount) override {};
+    virtual U_I inherited_read(char *a, U_I size) override;
+    virtual void inherited_write(const char *a, U_I size) override { throw SRC_BUG; };
+    virtual void inherited_truncate(const infinint & p) override { throw SRC_BUG; };
+    virtual void inherited_sync_write() override {};
+    virtual void inherited_flush_read() override {};
+    virtual void inherited_terminate() override {};
+
+private:
+    string payload;
+    U_I pos;
+    U_I largest;
+    slice_header header;
+};
+
+static shared_ptr<user_interaction> ui;
+static U_I errors = 0;
+static string payload;
+
+static void check(bool cond, const string & what);
+static pid_t launch(int & to_slave, int & from_slave, int (*slave)(generic_file *in, generic_file *out));
+static int exit_code(pid_t child);
+static int new_slave(generic_file *in, generic_file *out);
+static int old_slave(generic_file *in, generic_file *out);
+static bool read_all(zapette & zap);
+static void f1();
+static void f2();
+static void f3();
+
+int main()
+{
+    U_I maj, med, min;
+    U_32 seed = 12345;
+
+    get_version(maj, med, min);
+    ui.reset(new (nothrow) shell_interaction(cout, cerr, false));
+    if(!ui)
+	cout << "ERREUR !" << endl;
+
+	// larger than the read-ahead window of protocol version 2
+    payload.reserve(3*1024*1024 + 777);
+    for(U_I i = 0; i < 3*1024*1024 + 777; ++i)
+    {
+	seed = seed * 1103515245 + 12345;
+	payload += (char)(seed >> 16);
+    }
+
+    try
+    {
+	f1();
+	f2();
+	f3();
+    }
+    catch(Egeneric & e)
+    {
+	cout << "Aborting on exception: " << e.get_message() << endl;
+	++errors;
+    }
+
+    cout << (errors == 0 ? "all tests passed" : "SOME TESTS FAILED") << endl;
+
+    return errors == 0 ? 0 : 1;
+}
+
+static void check(bool cond, const string & what)
+{
+    cout << (cond ? "OK   : " : "FAIL : ") << what << endl;
+    if(!cond)
+	++errors;
+}
+
+bool source::skip(const infinint & p)
+{
+    if(p > payload.size())
+    {
+	pos = payload.size();
+	return false;
+    }
+
+    infinint tmp = p;
+
+    pos = 0;
+    tmp.unstack(pos);
+    return true;
+}
+
+U_I source::inherited_read(char *a, U_I size)
+{
+    U_I ret = payload.size() - pos;
+
+    if(size > largest)
+	largest = size;
+    if(ret > size)
+	ret = size;
+    (void)memcpy(a, payload.data() + pos, ret);
+    pos += ret;
+
+    return ret;
+}
+
+    // forks a process running slave() on a pair of pipes which other ends are returned
+
+static pid_t launch(int & to_slave, int & from_slave, int (*slave)(generic_file *in, generic_file *out))
+{
+    int orders[2];
+    int answers[2];
+    pid_t ret;
+
+    if(pipe(orders) != 0 || pipe(answers) != 0)
+	throw Erange("cannot create pipes");
+
+    ret = fork();
+    if(ret < 0)
+	throw Erange("cannot fork");
+
+    if(ret == 0)
+    {
+	int code = 3;
+
+	close(orders[1]);
+	close(answers[0]);
+	try
+	{
+	    code = slave(new tuyau(ui, orders[0], gf_read_only),
+			 new tuyau(ui, answers[1], gf_write_only));
+	}
+	catch(Egeneric & e)
+	{
+	    cout << "slave side: " << e.get_message() << endl;
+	}
+	_exit(code);
+    }
+
+    close(orders[0]);
+    close(answers[1]);
+    to_slave = orders[1];
+    from_slave = answers[0];
+
+    return ret;
+}
+
+static int exit_code(pid_t child)
+{
+    int status;
+
+    if(waitpid(child, &status, 0) != child || !WIFEXITED(status))
+	return -1;
+
+    return WEXITSTATUS(status);
+}
+
+    // slave_zapette of this release: returns 0 when the contextual status
+    // has not been modified by the protocol negotiation and version 2 has been used,
+    // 1 when the status is not as expected, 2 when version 1 has been used
+
+static int new_slave(generic_file *in, generic_file *out)
+{
+    source *src = new source(payload);
+    slave_zapette slave(ui, in, out, src);
+
+    slave.action();
+    if(src->get_info_status() != CONTEXT_INIT)
+	return 1;
+
+    return src->get_largest_read() > 65535 ? 0 : 2;
+}
+
+    // slave_zapette as implemented before protocol version 2 existed: returns 0
+    // when the contextual status has been restored by the zapette
+
+static int old_slave(generic_file *in, generic_file *out)
+{
+    unique_ptr<generic_file> input(in);
+    unique_ptr<generic_file> output(out);
+    source src(payload);
+    request req;
+    answer ans;
+    char buffer[65536];
+
+    do
+    {
+	req.read(in, ZAPETTE_PROTOCOL_V1);
+	ans.serial_num = req.serial_num;
+	if(req.size != REQUEST_SIZE_SPECIAL_ORDER)
+	{
+	    ans.type = ANSWER_TYPE_DATA;
+	    ans.size = src.skip(req.offset) ? src.read(buffer, req.size) : 0;
+	    ans.write(out, buffer, ZAPETTE_PROTOCOL_V1);
+	}
+	else if(req.offset == REQUEST_OFFSET_END_TRANSMIT)
+	{
+	    ans.type = ANSWER_TYPE_DATA;
+	    ans.size = 0;
+	    ans.write(out, nullptr, ZAPETTE_PROTOCOL_V1);
+	}
+	else if(req.offset == REQUEST_OFFSET_GET_FILESIZE)
+	{
+	    ans.type = ANSWER_TYPE_INFININT;
+	    ans.arg = payload.size();
+	    ans.write(out, nullptr, ZAPETTE_PROTOCOL_V1);
+	}
+	else if(req.offset == REQUEST_OFFSET_CHANGE_CONTEXT_STATUS)
+	{
+	    ans.type = ANSWER_TYPE_INFININT;
+	    ans.arg = 1;
+	    src.set_info_status(req.info);
+	    ans.write(out, nullptr, ZAPETTE_PROTOCOL_V1);
+	}
+	else
+	    throw Erange("unexpected special order");
+    }
+    while(req.size != REQUEST_SIZE_SPECIAL_ORDER || req.offset != REQUEST_OFFSET_END_TRANSMIT);
+
+    return src.get_info_status() == CONTEXT_INIT ? 0 : 1;
+}
+
+    // reads the data sequentially then at a few random places and compares with the original
+
+static bool read_all(zapette & zap)
+{
+    const U_I sizes[] = { 1, 100, 4096, 70000, 300000, 17 };
+    const U_I offsets[] = { 2*1024*1024 + 5, 12, 3*1024*1024, 262143, 3*1024*1024 + 770 };
+    string got;
+    char buffer[300000];
+    U_I lu, i = 0;
+
+    if(zap.get_position() != 0)
+	return false;
+
+    do
+    {
+	lu = zap.read(buffer, sizes[i % 6]);
+	got += string(buffer, lu);
+	++i;
+    }
+    while(lu > 0);
+
+    if(got != payload)
+	return false;
+
+    for(i = 0; i < 5; ++i)
+    {
+	if(!zap.skip(offsets[i]))
+	    return false;
+	lu = zap.read(buffer, 4096);
+	if(string(buffer, lu) != payload.substr(offsets[i], 4096))
+	    return false;
+    }
+
+    return true;
+}
+
+    // zapette and slave_zapette of this release use version 2
+
+static void f1()
+{
+    int to_slave, from_slave;
+    pid_t child = launch(to_slave, from_slave, &new_slave);
+    bool ok;
+
+    {
+	zapette zap(ui, new tuyau(ui, from_slave, gf_read_only), new tuyau(ui, to_slave, gf_write_only), false);
+
+	ok = read_all(zap);
+	zap.terminate();
+    }
+    check(ok, "data read with protocol version 2");
+    check(exit_code(child) == 0, "slave negotiated version 2 and kept its contextual status");
+}
+
+    // zapette of this release with a slave_zapette only knowing version 1
+
+static void f2()
+{
+    int to_slave, from_slave;
+    pid_t child = launch(to_slave, from_slave, &old_slave);
+    bool ok;
+
+    {
+	zapette zap(ui, new tuyau(ui, from_slave, gf_read_only), new tuyau(ui, to_slave, gf_write_only), false);
+
+	ok = read_all(zap);
+	zap.terminate();
+    }
+    check(ok, "data read with protocol version 1");
+    check(exit_code(child) == 0, "contextual status of the version 1 slave restored");
+}
+
+    // zapette of a release only knowing version 1 with the slave_zapette of this release
+
+static void f3()
+{
+    int to_slave, from_slave;
+    pid_t child = launch(to_slave, from_slave, &new_slave);
+    tuyau out(ui, to_slave, gf_write_only);
+    tuyau in(ui, from_slave, gf_read_only);
+    request req;
+    answer ans;
+    char buffer[65536];
+    bool ok = true;
+
+    req.serial_num = 0;
+    req.size = REQUEST_SIZE_SPECIAL_ORDER;
+    req.offset = REQUEST_OFFSET_GET_FILESIZE;
+    req.info = "";
+    req.write(&out, ZAPETTE_PROTOCOL_V1);
+    ans.read(&in, nullptr, 0, ZAPETTE_PROTOCOL_V1);
+    if(ans.serial_num != 0 || ans.type != ANSWER_TYPE_INFININT || ans.arg != payload.size())
+	ok = false;
+
+    for(U_I i = 1; i < 5; ++i)
+    {
+	req.serial_num = i;
+	req.size = 65535;
+	req.offset = i * 100000;
+	req.write(&out, ZAPETTE_PROTOCOL_V1);
+	ans.read(&in, buffer, sizeof(buffer), ZAPETTE_PROTOCOL_V1);
+	if(ans.serial_num != (char)i || ans.type != ANSWER_TYPE_DATA || string(buffer, ans.size) != payload.substr(i * 100000, 65535))
+	    ok = false;
+    }
+
+    req.serial_num = 5;
+    req.size = REQUEST_SIZE_SPECIAL_ORDER;
+    req.offset = REQUEST_OFFSET_END_TRANSMIT;
+    req.write(&out, ZAPETTE_PROTOCOL_V1);
+    ans.read(&in, nullptr, 0, ZAPETTE_PROTOCOL_V1);
+
+    check(ok, "version 1 requests answered by the slave of this release");
+    check(exit_code(child) == 2, "slave of this release kept version 1 with a version 1 zapette");
+}